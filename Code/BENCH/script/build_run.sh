@@ -0,0 +1,79 @@
+#!/usr/bin/env bash
+# build_run.sh — build the benchmark harness and run one routine.
+#   ./build_run.sh <case_name> <routine> [n] [jobz]
+# routine: dsyev | dsyevd | dsyevr | dstedc | dsytrd
+# Env: BENCH_WARMUP, BENCH_REPS, BENCH_BOOT, BENCH_CI, BENCH_NOISE,
+#      BENCH_HISTORY, BENCH_FAIL_ON_REGRESSION (see ../src/bench_run.c).
+# The case name is recorded as the backend and `git describe` as the
+# revision, so history lines from different builds can be compared.
+set -euo pipefail
+
+export OMP_NUM_THREADS=${OMP_NUM_THREADS:-1}
+export OPENBLAS_NUM_THREADS=${OPENBLAS_NUM_THREADS:-1}
+export ARMPL_NUM_THREADS=${ARMPL_NUM_THREADS:-1}
+
+TAG="${1:-}"
+ROUTINE="${2:-}"
+[ -n "$TAG" ] && [ -n "$ROUTINE" ] || { echo "Usage: $0 <case_name> <routine> [n] [jobz]"; exit 1; }
+N="${3:-4000}"
+JOBZ="${4:-V}"
+REV="$(git describe --always --dirty 2>/dev/null || echo unknown)"
+
+# ====== 1) Compiler setup ======
+CC="${CC:-gcc}"
+CFLAGS_BASE="-O3 -std=c11 -D_POSIX_C_SOURCE=200809L \
+  -mcpu=native -mtune=native \
+  -fno-math-errno -fno-trapping-math -ffp-contract=fast \
+  -I../../common/src -DEIG_BACKEND=\"$TAG\" -DBENCH_REV=\"$REV\""
+LIBS_FORTRAN="-lgfortran"
+LIBS_MATH="-lm"
+
+# ====== 2) Library presets ======
+CFLAGS_NETLIB="$CFLAGS_BASE -I../../LAPACK/build/include"
+LDFLAGS_NETLIB="../../LAPACK/build/lib/liblapack.a ../../LAPACK/build/lib/libblas.a $LIBS_FORTRAN $LIBS_MATH"
+
+CFLAGS_OB="$CFLAGS_BASE -I../../openblas/openblas_install/include"
+LDFLAGS_OB="../../openblas/openblas_install/lib/libopenblas.a $LIBS_FORTRAN $LIBS_MATH -lpthread -ldl"
+
+ARMPL_PREFIX="../../armpl/arm-performance-libraries_25.07_rpm/armpl_local/armpl_25.07_gcc"
+CFLAGS_AP="$CFLAGS_BASE -I$ARMPL_PREFIX/include"
+LDFLAGS_AP="$ARMPL_PREFIX/lib/libarmpl.a -lpthread -ldl $LIBS_FORTRAN $LIBS_MATH"
+
+# ====== 3) Sources (no timing wrappers: clean calls only) ======
+SRCS=("../src/bench_run.c" "../../common/src/bench_stats.c"
+      "../../common/src/numa_alloc.c" "../../common/src/mat_io.c")
+
+# ====== 4) Case selection ======
+case "$TAG" in
+  bench-openblas) CFLAGS="$CFLAGS_OB";     LDFLAGS="$LDFLAGS_OB" ;;
+  bench-netlib)   CFLAGS="$CFLAGS_NETLIB"; LDFLAGS="$LDFLAGS_NETLIB" ;;
+  bench-armpl)    CFLAGS="$CFLAGS_AP";     LDFLAGS="$LDFLAGS_AP" ;;
+  *)
+      echo "[X] Unknown TAG: $TAG"
+      echo "    Available: bench-openblas | bench-netlib | bench-armpl"
+      exit 1;;
+esac
+
+# ====== 5) Output & Build ======
+OUT_DIR="../output"
+OBJ_DIR="$OUT_DIR/obj"
+BIN_DIR="$OUT_DIR/bin"
+mkdir -p "$OBJ_DIR" "$BIN_DIR"
+
+OBJS=()
+for f in "${SRCS[@]}"; do
+  base="$(basename "$f" .c)"
+  obj="$OBJ_DIR/${base}.o"
+  echo "[BUILD] CC=$CC | SRC=$f"
+  $CC $CFLAGS -c "$f" -o "$obj"
+  OBJS+=("$obj")
+done
+
+BIN="$BIN_DIR/$TAG"
+echo "[LINK ] ${OBJS[*]} -> $BIN"
+$CC "${OBJS[@]}" $LDFLAGS -lpthread -o "$BIN"
+
+# ====== 6) Run ======
+echo "[RUN  ] EXE=$BIN $ROUTINE $N $JOBZ"
+echo "[INFO ] OMP_NUM_THREADS=$OMP_NUM_THREADS OPENBLAS_NUM_THREADS=$OPENBLAS_NUM_THREADS ARMPL_NUM_THREADS=$ARMPL_NUM_THREADS"
+exec "$BIN" "$ROUTINE" "$N" "$JOBZ"
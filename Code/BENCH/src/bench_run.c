@@ -0,0 +1,352 @@
+// bench_run.c — warmed-up, repeated timings of one LAPACK eigen routine with
+// robust statistics and a cross-build results history.
+//
+// Usage: bench_run <dsyev|dsyevd|dsyevr|dstedc|dsytrd> [n] [jobz]
+//   - A is the KMS matrix (rho = 0.95), or MATRIX_INPUT=<file> (n from the
+//     file). A pristine copy is kept; before every run the working A (for
+//     dstedc: D and E of the reduced matrix) is restored from it outside the
+//     timed region. Workspaces are queried and allocated once (mem_alloc:
+//     MEM_PREFAULT / MEM_LOCK / NUMA_POLICY apply).
+//   - BENCH_WARMUP runs (default 2) are discarded, then BENCH_REPS samples
+//     (default 10) are timed, each around the LAPACK call only.
+//   - Reported: every sample, median, min, max, Q1/Q3/IQR and a bootstrap
+//     CI of the median (BENCH_BOOT resamples, default 2000; BENCH_CI level,
+//     default 0.95), the CPU clock range seen across the samples and the
+//     governor. The result is flagged NOISY when IQR/median > BENCH_NOISE
+//     (default 0.05) or the clock moved by more than 5% (bench_stats.h).
+//   - The result is appended to BENCH_HISTORY (default
+//     ../output/bench_history.tsv) after being compared with the last result
+//     of the same backend and the best other backend for the same host,
+//     routine, n, jobz and thread count. BENCH_FAIL_ON_REGRESSION=1 exits
+//     with status 4 on a regression (for CI).
+//   - The last stdout line is a machine-readable RESULT record.
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "bench_stats.h"   /* ../../common/src: statistics, CPU clock, history */
+#include "numa_alloc.h"    /* ../../common/src: mem_alloc (NUMA_POLICY, MEM_PREFAULT, MEM_LOCK) */
+#include "mat_io.h"        /* ../../common/src: MATRIX_INPUT=<.mtx|.npy|raw> instead of KMS */
+
+#ifndef EIG_BACKEND
+#define EIG_BACKEND "unknown"     /* build_run.sh passes the case name */
+#endif
+#ifndef BENCH_REV
+#define BENCH_REV "unknown"       /* build_run.sh passes `git describe` */
+#endif
+
+/* --------- Fortran LAPACK symbols (vendor-agnostic) --------- */
+extern void dsyev_(const char *JOBZ, const char *UPLO, const int *N,
+                   double *A, const int *LDA, double *W,
+                   double *WORK, const int *LWORK, int *INFO);
+
+extern void dsyevd_(const char *JOBZ, const char *UPLO, const int *N,
+                    double *A, const int *LDA, double *W,
+                    double *WORK, const int *LWORK,
+                    int *IWORK, const int *LIWORK,
+                    int *INFO);
+
+extern void dsyevr_(const char *JOBZ, const char *RANGE, const char *UPLO, const int *N,
+                    double *A, const int *LDA, const double *VL, const double *VU,
+                    const int *IL, const int *IU, const double *ABSTOL,
+                    int *M, double *W, double *Z, const int *LDZ, int *ISUPPZ,
+                    double *WORK, const int *LWORK, int *IWORK, const int *LIWORK,
+                    int *INFO);
+
+extern void dsytrd_(const char *UPLO, const int *N,
+                    double *A, const int *LDA,
+                    double *D, double *E, double *TAU,
+                    double *WORK, const int *LWORK, int *INFO);
+
+extern void dstedc_(const char *COMPZ, const int *N,
+                    double *D, double *E,
+                    double *Z, const int *LDZ,
+                    double *WORK, const int *LWORK,
+                    int *IWORK, const int *LIWORK,
+                    int *INFO);
+
+/* --------- Utilities --------- */
+static void ensure_dir(const char *path) {
+    if (mkdir(path, 0777) != 0 && errno != EEXIST) {
+        perror("mkdir");
+        exit(5);
+    }
+}
+
+static double elapsed_seconds(struct timespec a, struct timespec b) {
+    return (b.tv_sec - a.tv_sec) + (b.tv_nsec - a.tv_nsec) / 1e9;
+}
+
+/* Fill A (n x n, column-major) with a classic SPD KMS test matrix:
+   A_ij = rho^{|i-j|} + delta*(i==j), with |rho|<1, delta>=0. */
+static void fill_kms(double *A, int n, double rho, double delta)
+{
+    if (!(rho > -1.0 && rho < 1.0)) rho = 0.95;
+    if (delta < 0.0) delta = 0.0;
+
+    double arho = fabs(rho);
+    double *rp = (double*)malloc((size_t)n * sizeof(double));
+    if (!rp) { fprintf(stderr, "Allocation failed (rp)\n"); exit(6); }
+
+    rp[0] = 1.0;
+    for (int k = 1; k < n; ++k) rp[k] = rp[k-1] * arho;
+
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i <= j; ++i) {
+            double v = rp[j - i];
+            if (i == j) v += delta;
+            A[i + (size_t)j * n] = v;
+            A[j + (size_t)i * n] = v;
+        }
+    }
+    free(rp);
+}
+
+static const char *env_or(const char *name, const char *dflt) {
+    const char *v = getenv(name);
+    return (v && *v) ? v : dflt;
+}
+
+/* BLAS thread count as the environment sets it (OpenBLAS > OpenMP > ArmPL) */
+static int env_threads(void) {
+    const char *names[] = { "OPENBLAS_NUM_THREADS", "OMP_NUM_THREADS", "ARMPL_NUM_THREADS" };
+    for (int i = 0; i < 3; ++i) {
+        const char *v = getenv(names[i]);
+        if (v && atoi(v) > 0) return atoi(v);
+    }
+    return 1;
+}
+
+/* --------- One benchmark case: buffers sized once, restored per run --------- */
+typedef enum { R_DSYEV, R_DSYEVD, R_DSYEVR, R_DSTEDC, R_DSYTRD } routine_t;
+
+typedef struct {
+    routine_t r;
+    int n, lda, lwork, liwork;
+    char jobz, uplo, compz;
+    double *A0, *A;          /* pristine / working matrix */
+    double *D0, *E0;         /* dstedc: pristine tridiagonal */
+    double *W, *E, *TAU, *Z, *WORK;
+    int *IWORK, *ISUPPZ;
+    size_t bytes_A, bytes_W;
+} bench_case_t;
+
+/* Workspace query for the routine; sets lwork/liwork. Returns INFO. */
+static int query(bench_case_t *c)
+{
+    int info = 0, lw = -1, liw = -1, iwk = 0, m = 0;
+    double wk = 0.0;
+    const int n = c->n, lda = c->lda, ldz = n;
+    const char range = 'A';
+    const double vl = 0.0, vu = 0.0, abstol = 0.0;
+    const int il = 1, iu = n;
+    switch (c->r) {
+    case R_DSYEV:  dsyev_(&c->jobz, &c->uplo, &n, c->A, &lda, c->W, &wk, &lw, &info); break;
+    case R_DSYEVD: dsyevd_(&c->jobz, &c->uplo, &n, c->A, &lda, c->W, &wk, &lw, &iwk, &liw, &info); break;
+    case R_DSYEVR: dsyevr_(&c->jobz, &range, &c->uplo, &n, c->A, &lda, &vl, &vu, &il, &iu, &abstol,
+                           &m, c->W, c->Z, &ldz, c->ISUPPZ, &wk, &lw, &iwk, &liw, &info); break;
+    case R_DSTEDC: dstedc_(&c->compz, &n, c->W, c->E, c->Z, &ldz, &wk, &lw, &iwk, &liw, &info); break;
+    case R_DSYTRD: dsytrd_(&c->uplo, &n, c->A, &lda, c->W, c->E, c->TAU, &wk, &lw, &info); break;
+    }
+    c->lwork  = (int)wk > 0 ? (int)wk : 1;
+    c->liwork = iwk > 0 ? iwk : 1;
+    return info;
+}
+
+/* Restore the inputs the routine overwrites (untimed). */
+static void restore(bench_case_t *c)
+{
+    const size_t n = (size_t)c->n;
+    if (c->r == R_DSTEDC) {
+        memcpy(c->W, c->D0, n * sizeof(double));
+        if (n > 1) memcpy(c->E, c->E0, (n - 1) * sizeof(double));
+    } else {
+        memcpy(c->A, c->A0, c->bytes_A);
+    }
+}
+
+static int run_once(bench_case_t *c)
+{
+    int info = 0, m = 0;
+    const int n = c->n, lda = c->lda, ldz = n;
+    const char range = 'A';
+    const double vl = 0.0, vu = 0.0, abstol = 0.0;
+    const int il = 1, iu = n;
+    switch (c->r) {
+    case R_DSYEV:  dsyev_(&c->jobz, &c->uplo, &n, c->A, &lda, c->W, c->WORK, &c->lwork, &info); break;
+    case R_DSYEVD: dsyevd_(&c->jobz, &c->uplo, &n, c->A, &lda, c->W, c->WORK, &c->lwork,
+                           c->IWORK, &c->liwork, &info); break;
+    case R_DSYEVR: dsyevr_(&c->jobz, &range, &c->uplo, &n, c->A, &lda, &vl, &vu, &il, &iu, &abstol,
+                           &m, c->W, c->Z, &ldz, c->ISUPPZ, c->WORK, &c->lwork,
+                           c->IWORK, &c->liwork, &info); break;
+    case R_DSTEDC: dstedc_(&c->compz, &n, c->W, c->E, c->Z, &ldz, c->WORK, &c->lwork,
+                           c->IWORK, &c->liwork, &info); break;
+    case R_DSYTRD: dsytrd_(&c->uplo, &n, c->A, &lda, c->W, c->E, c->TAU, c->WORK, &c->lwork, &info); break;
+    }
+    return info;
+}
+
+int main(int argc, char **argv)
+{
+    static const char *NAMES[] = { "dsyev", "dsyevd", "dsyevr", "dstedc", "dsytrd" };
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <dsyev|dsyevd|dsyevr|dstedc|dsytrd> [n] [jobz]\n", argv[0]);
+        return 1;
+    }
+    bench_case_t c;
+    memset(&c, 0, sizeof(c));
+    int found = 0;
+    for (int i = 0; i < 5; ++i) if (strcmp(argv[1], NAMES[i]) == 0) { c.r = (routine_t)i; found = 1; }
+    if (!found) { fprintf(stderr, "Unknown routine: %s\n", argv[1]); return 1; }
+    c.n     = (argc > 2) ? atoi(argv[2]) : 4000;
+    c.jobz  = (argc > 3 && (argv[3][0] == 'N' || argv[3][0] == 'n')) ? 'N' : 'V';
+    c.uplo  = 'U';
+    c.compz = (c.jobz == 'V') ? 'I' : 'N';
+
+    const int warmup = atoi(env_or("BENCH_WARMUP", "2"));
+    const int reps   = atoi(env_or("BENCH_REPS", "10")) > 0 ? atoi(env_or("BENCH_REPS", "10")) : 10;
+    const int boot   = atoi(env_or("BENCH_BOOT", "2000"));
+    const double ci_level  = atof(env_or("BENCH_CI", "0.95"));
+    const double noise_rel = atof(env_or("BENCH_NOISE", "0.05"));
+    const char *history    = env_or("BENCH_HISTORY", "../output/bench_history.tsv");
+    const int threads = env_threads();
+
+    /* ---- Input: file (MATRIX_INPUT) or synthetic KMS ---- */
+    const char *input = getenv("MATRIX_INPUT");
+    mat_header_t hdr;
+    if (input) {
+        if (mat_probe(input, &hdr) != 0) { fprintf(stderr, "Cannot read %s\n", input); return 1; }
+        c.n = hdr.n;
+    }
+    if (c.n < 1) { fprintf(stderr, "Invalid n\n"); return 1; }
+    c.lda = c.n;
+    const size_t n = (size_t)c.n;
+    c.bytes_A = n * n * sizeof(double);
+
+    const mem_policy_t mpol = mem_policy_from_env();
+    c.A0  = (double*)mem_alloc(c.bytes_A, mpol, 0);
+    c.A   = (double*)mem_alloc(c.bytes_A, mpol, 0);
+    c.W   = (double*)malloc(n * sizeof(double));
+    c.E   = (double*)malloc(n * sizeof(double));
+    c.TAU = (double*)malloc(n * sizeof(double));
+    c.D0  = (double*)malloc(n * sizeof(double));
+    c.E0  = (double*)malloc(n * sizeof(double));
+    c.ISUPPZ = (int*)malloc(2 * n * sizeof(int));
+    const int need_Z = (c.r == R_DSYEVR || c.r == R_DSTEDC);
+    c.Z = need_Z ? (double*)mem_alloc(c.bytes_A, mpol, 0) : NULL;
+    if (!c.A0 || !c.A || !c.W || !c.E || !c.TAU || !c.D0 || !c.E0 || !c.ISUPPZ || (need_Z && !c.Z)) {
+        fprintf(stderr, "Allocation failed.\n");
+        return 1;
+    }
+    if (input) {
+        if (mat_read(input, &hdr, c.A0, c.lda) != 0) { fprintf(stderr, "Failed to load %s\n", input); return 1; }
+    } else {
+        fill_kms(c.A0, c.n, 0.95, 0.0);
+    }
+    memcpy(c.A, c.A0, c.bytes_A);
+
+    int info = 0;
+    if (c.r == R_DSTEDC) {
+        /* the tridiagonal of A is the pristine input; reduced once, untimed */
+        bench_case_t t = c;
+        t.r = R_DSYTRD;
+        if ((info = query(&t)) != 0) { fprintf(stderr, "DSYTRD workspace query failed, info=%d\n", info); return 2; }
+        t.WORK = (double*)malloc((size_t)t.lwork * sizeof(double));
+        if (!t.WORK) { fprintf(stderr, "Allocation failed (WORK for DSYTRD)\n"); return 1; }
+        if ((info = run_once(&t)) != 0) { fprintf(stderr, "DSYTRD failed, info=%d\n", info); return 2; }
+        free(t.WORK);
+        memcpy(c.D0, c.W, n * sizeof(double));
+        memcpy(c.E0, c.E, n * sizeof(double));
+    }
+
+    if ((info = query(&c)) != 0) { fprintf(stderr, "%s workspace query failed, info=%d\n", NAMES[c.r], info); return 2; }
+    c.bytes_W = (size_t)c.lwork * sizeof(double);
+    c.WORK  = (double*)mem_alloc(c.bytes_W, mpol, 0);
+    c.IWORK = (int*)malloc((size_t)c.liwork * sizeof(int));
+    if (!c.WORK || !c.IWORK) { fprintf(stderr, "Allocation failed (WORK/IWORK)\n"); return 1; }
+
+    char host[128] = "?";
+    gethostname(host, sizeof(host) - 1);
+    char gov[64];
+    bench_cpu_governor(gov, sizeof(gov));
+    printf("Bench: %s n=%d jobz=%c | backend %s rev %s | threads=%d | host %s\n",
+           NAMES[c.r], c.n, c.jobz, EIG_BACKEND, BENCH_REV, threads, host);
+    printf("Plan : %d warm-up + %d timed runs, A restored from a pristine copy before each (untimed)\n",
+           warmup, reps);
+    printf("CPU  : governor %s%s\n", gov,
+           (strcmp(gov, "performance") != 0 && strcmp(gov, "?") != 0) ? " (not 'performance': expect clock ramps)" : "");
+
+    /* ---- Warm-up (caches, page tables, BLAS thread pool, CPU clock) ---- */
+    for (int w = 0; w < warmup; ++w) {
+        restore(&c);
+        if ((info = run_once(&c)) != 0) { fprintf(stderr, "%s failed, info=%d\n", NAMES[c.r], info); return 2; }
+    }
+
+    /* ---- Timed samples ---- */
+    double *samples = (double*)malloc((size_t)reps * sizeof(double));
+    if (!samples) { fprintf(stderr, "Allocation failed (samples)\n"); return 1; }
+    double mhz_min = 0.0, mhz_max = 0.0;
+    for (int k = 0; k < reps; ++k) {
+        restore(&c);
+        const double f0 = bench_cpu_mhz();
+        struct timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        info = run_once(&c);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        const double f1 = bench_cpu_mhz();
+        if (info != 0) { fprintf(stderr, "%s failed, info=%d\n", NAMES[c.r], info); return 2; }
+        samples[k] = elapsed_seconds(t0, t1);
+        const double lo = f0 < f1 ? f0 : f1, hi = f0 > f1 ? f0 : f1;
+        if (lo > 0.0 && (mhz_min == 0.0 || lo < mhz_min)) mhz_min = lo;
+        if (hi > mhz_max) mhz_max = hi;
+        printf("  run %3d: %.6f s  (CPU %.0f -> %.0f MHz)\n", k + 1, samples[k], f0, f1);
+    }
+
+    /* ---- Statistics, noise verdict, history ---- */
+    bench_record_t rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.host = host; rec.backend = EIG_BACKEND; rec.rev = BENCH_REV; rec.routine = NAMES[c.r];
+    rec.n = c.n; rec.jobz = c.jobz; rec.threads = threads;
+    rec.mhz_min = mhz_min; rec.mhz_max = mhz_max;
+    bench_summarize(samples, reps, boot, ci_level, &rec.s);
+    char why[160];
+    rec.noisy = bench_is_noisy(&rec.s, mhz_min, mhz_max, noise_rel, why, sizeof(why));
+
+    const bench_summary_t *s = &rec.s;
+    printf("median %.6f s  min %.6f  max %.6f  mean %.6f\n", s->median, s->min, s->max, s->mean);
+    printf("IQR    %.6f s  [Q1 %.6f, Q3 %.6f]  (%.1f%% of median)\n",
+           s->iqr, s->q1, s->q3, s->median > 0.0 ? 100.0 * s->iqr / s->median : 0.0);
+    printf("CI%.0f   [%.6f, %.6f] s for the median (bootstrap)\n", 100.0 * s->ci_level, s->ci_lo, s->ci_hi);
+    if (mhz_max > 0.0) printf("CPU    %.0f .. %.0f MHz across samples\n", mhz_min, mhz_max);
+    if (rec.noisy) printf("NOISY: %s\n", why);
+
+    const char *slash = strrchr(history, '/');
+    if (slash) {
+        char dir[512];
+        snprintf(dir, sizeof(dir), "%.*s", (int)(slash - history), history);
+        if (dir[0]) ensure_dir(dir);
+    }
+    const int regression = bench_history_compare(history, &rec, noise_rel, stdout);
+    if (bench_history_append(history, &rec) != 0) fprintf(stderr, "Cannot append to %s\n", history);
+
+    printf("RESULT routine=%s n=%d jobz=%c threads=%d backend=%s rev=%s reps=%d median=%.6f "
+           "min=%.6f q1=%.6f q3=%.6f ci_lo=%.6f ci_hi=%.6f noisy=%d regression=%d\n",
+           NAMES[c.r], c.n, c.jobz, threads, EIG_BACKEND, BENCH_REV, reps, s->median,
+           s->min, s->q1, s->q3, s->ci_lo, s->ci_hi, rec.noisy, regression);
+
+    free(samples);
+    free(c.IWORK); mem_free(c.WORK, c.bytes_W);
+    mem_free(c.Z, c.bytes_A); free(c.ISUPPZ); free(c.E0); free(c.D0);
+    free(c.TAU); free(c.E); free(c.W);
+    mem_free(c.A, c.bytes_A); mem_free(c.A0, c.bytes_A);
+
+    const char *fail = getenv("BENCH_FAIL_ON_REGRESSION");
+    return (regression && fail && fail[0] == '1') ? 4 : 0;
+}
@@ -12,7 +12,8 @@ TAG="${1:-}"
 CC=${CC:-gcc}
 CFLAGS_BASE="-O3 -std=c11 -D_POSIX_C_SOURCE=199309L \
   -mcpu=native -mtune=native \
-  -fno-math-errno -fno-trapping-math -ffp-contract=fast"
+  -fno-math-errno -fno-trapping-math -ffp-contract=fast \
+  -I../../common/src -DEIG_BACKEND=\"$TAG\""   # EIG_BACKEND: part of the eig_cache key
 LIBS_FORTRAN="-lgfortran"
 LIBS_MATH="-lm"
 
@@ -26,7 +27,7 @@ LDFLAGS_NETLIB="../../LAPACK/build/lib/liblapack.a ../../LAPACK/build/lib/libbla
 
 # OpenBLAS (static)
 #CFLAGS_OB="$CFLAGS_BASE -I../../openblas/openblas_install/include"
-CFLAGS_OB="$CFLAGS_BASE -DOPENBLAS_USE64BITINT -I../../openblas/openblas_install/include"
+CFLAGS_OB="$CFLAGS_BASE -I../../openblas/openblas_install/include"
 
 LDFLAGS_OB="../../openblas/openblas_install/lib/libopenblas.a $LIBS_FORTRAN $LIBS_MATH -lpthread -ldl"
 
@@ -38,35 +39,46 @@ LDFLAGS_AP="$ARMPL_PREFIX/lib/libarmpl.a -lpthread -ldl $LIBS_FORTRAN $LIBS_MATH
 # ====== 3. Sources ======
 SRC_DIR="../src"
 SRC_STEDC_RUN="$SRC_DIR/stedc_run.c"
-SRC_WRAP_TIMERS="$SRC_DIR/wrap_timers.c"
-SRC_WRAP_STEDC="$SRC_DIR/wrap_stedc.c"
-
-# ====== 4. STEDC subtree symbols to wrap ======
-WRAP_SYMS=(
-  dstedc_
-  dlamrg_ dlasrt_ dlacpy_ dsteqr_
-  dlaed0_ dlaed1_ dlaed2_ dlaed3_ dlaed4_ dlaed5_ dlaed6_ dlaed7_ dlaed8_ dlaed9_ dlaeda_
-  dgemm_ dgemv_ dcopy_ dscal_ drot_
-  cblas_dgemm cblas_dgemv
-
-)
-WRAP_LDFLAGS=(); for s in "${WRAP_SYMS[@]}"; do WRAP_LDFLAGS+=("-Wl,--wrap=${s}"); done
-
-
-
-
+SRC_STEMR_BENCH="$SRC_DIR/stemr_bench.c"   # DSTEDC('I') vs DSTEMR on tridiagonal generators
+SRC_TRIGEN="../../common/src/tridiag_gen.c"
+SRC_BAND="../../common/src/band_eig.c"     # tridiag_gen's KMS via DSBTRD
+SRC_INVIT="../../common/src/inv_iter.c"   # STEDC_SOLVER=invit: DSTEIN cluster pool
+SRC_WRAP_TIMERS="../../common/src/wrap_timers.c"
+SRC_WRAP_STEDC="../../common/src/wrap_gen.c"   # wrappers generated from wrap_syms.def
+SRC_MATIO="../../common/src/mat_io.c"   # MATRIX_INPUT=<file> readers
+SRC_CACHE="../../common/src/eig_cache.c" # EIG_CACHE stage cache
+SRC_NUMA="../../common/src/numa_alloc.c" # MEM_PREFAULT / MEM_LOCK
+SRC_MEM="../../common/src/mem_budget.c"  # per-stage page-fault accounting, LWORK helpers (band_eig)
+
+# ====== 4. Symbols to wrap: every WRAP_FN in common/src/wrap_syms.def ======
+# WRAP_TIMING=0 drops the wrappers; WRAP_MASK=... narrows them at run time.
+WRAP_DEF="../../common/src/wrap_syms.def"
+WRAP_SYMS=($(grep -o '^WRAP_FN([A-Za-z_0-9]*' "$WRAP_DEF" | sed 's/^WRAP_FN(//'))
+WRAP_LDFLAGS=(); CFLAGS_WRAP=""
+# -u X pulls X out of the static archive even when only the wrapper calls it.
+if [[ "${WRAP_TIMING:-1}" == "1" ]]; then
+  for s in "${WRAP_SYMS[@]}"; do WRAP_LDFLAGS+=("-Wl,--wrap=${s}" "-Wl,-u,${s}"); done
+else
+  CFLAGS_WRAP="-DWRAP_TIMING_DISABLE"   # stubs only, calls go straight to the library
+fi
 
 # ====== 5. Case Selection (ONLY ONE CASE as requested) ======
 case "$TAG" in
   # OpenBLAS + STEDC driver + per-subroutine timing wrappers
   stedc-profile-openblas)
-      SRCS=("$SRC_STEDC_RUN" "$SRC_WRAP_TIMERS" "$SRC_WRAP_STEDC")
+      SRCS=("$SRC_STEDC_RUN" "$SRC_INVIT" "$SRC_WRAP_TIMERS" "$SRC_WRAP_STEDC" "$SRC_MATIO" "$SRC_CACHE" "$SRC_NUMA" "$SRC_MEM")
+      CFLAGS="$CFLAGS_OB"
+      LDFLAGS="$LDFLAGS_OB ${WRAP_LDFLAGS[*]}"
+      ;;
+  # OpenBLAS + DSTEDC vs DSTEMR benchmark: ./build_run.sh stemr-bench-openblas [n] [nev] [gen ...]
+  stemr-bench-openblas)
+      SRCS=("$SRC_STEMR_BENCH" "$SRC_TRIGEN" "$SRC_BAND" "$SRC_MEM" "$SRC_WRAP_TIMERS" "$SRC_WRAP_STEDC")
       CFLAGS="$CFLAGS_OB"
       LDFLAGS="$LDFLAGS_OB ${WRAP_LDFLAGS[*]}"
       ;;
   *)
       echo "[X] Unknown TAG: $TAG"
-      echo "    Available: stedc-profile-openblas"
+      echo "    Available: stedc-profile-openblas | stemr-bench-openblas"
       exit 1;;
 esac
 
@@ -81,7 +93,7 @@ for f in "${SRCS[@]}"; do
   base="$(basename "$f" .c)"
   obj="$OBJ_DIR/${base}.o"
   echo "[BUILD] CC=$CC | SRC=$f | CFLAGS=$CFLAGS"
-  $CC $CFLAGS -c "$f" -o "$obj"
+  $CC $CFLAGS $CFLAGS_WRAP -c "$f" -o "$obj"
   OBJS+=("$obj")
 done
 
@@ -91,4 +103,4 @@ $CC "${OBJS[@]}" $LDFLAGS -o "$BIN"
 
 echo "[RUN  ] LIB=$TAG | EXE=$BIN"
 echo "[INFO ] OMP_NUM_THREADS=$OMP_NUM_THREADS OPENBLAS_NUM_THREADS=$OPENBLAS_NUM_THREADS ARMPL_NUM_THREADS=$ARMPL_NUM_THREADS"
-exec "$BIN"
+exec "$BIN" "${@:2}"
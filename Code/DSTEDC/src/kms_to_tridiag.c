@@ -1,15 +1,31 @@
 // kms_to_tridiag.c — Build KMS SPD, reduce with DSYTRD, return tridiagonal D,E.
-// Portable: no LAPACKE, vendor-agnostic Fortran symbols.
+// Portable: no LAPACKE, vendor-agnostic Fortran symbols. Double only
+// (PRECISION/src/prec_run.c has the S / Z reductions).
+// Results are shared with stedc_run.c through the "sytrd" stage of
+// common/src/eig_cache.h, so repeated (n, rho, delta) skip the reduction.
+// BAND_ROUTE=auto|<kd> (common/src/band_eig.h): when KMS is numerically
+// banded, build it directly in band storage and reduce with DSBTRD instead,
+// O(n kd) memory and O(n^2 kd) flops.
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
 
+#include "eig_cache.h"
+#include "band_eig.h"
+
+#ifndef EIG_BACKEND
+#define EIG_BACKEND "unknown"     /* build_run.sh passes the case name */
+#endif
+
 /* Fortran LAPACK symbols */
 extern void dsytrd_(const char *UPLO, const int *N,
                     double *A, const int *LDA,
                     double *D, double *E, double *TAU,
                     double *WORK, const int *LWORK, int *INFO);
+extern void dsbtrd_(const char *VECT, const char *UPLO, const int *N, const int *KD,
+                    double *AB, const int *LDAB, double *D, double *E,
+                    double *Q, const int *LDQ, double *WORK, int *INFO);
 
 /* KMS filler: A_ij = rho^{|i-j|} + delta * (i==j), column-major */
 static void fill_kms(double *A, int n, double rho, double delta)
@@ -40,6 +56,8 @@ static void fill_kms(double *A, int n, double rho, double delta)
    - Output:
        D[0..n-1] = diagonal of T
        E[0..n-2] = off-diagonal of T  (E has length n-1; the last entry is unused by LAPACK)
+   - Consults the stage cache first when EIG_CACHE=1 (banner on stderr on a hit).
+   - Banded KMS (BAND_ROUTE) goes through DSBTRD: same spectrum, different T.
    - Returns 0 on success, nonzero on failure. */
 int kms_to_tridiag(int n, double rho, double delta, double *D, double *E)
 {
@@ -47,6 +65,36 @@ int kms_to_tridiag(int n, double rho, double delta, double *D, double *E)
     int lda = n, info = 0, lwork = -1;
     char uplo = 'U';
 
+    /* 0) Route + cache: D and E of the same (n, rho, delta, backend[, kd]) */
+    const double btol = band_tol_from_env();
+    int kd = band_route(n, band_route_auto() ? band_width_kms(n, rho, delta, btol) : -1);
+    if (kd >= 0 && band_route_forced() >= 0)
+        band_report_dropped(stderr, kd, band_dropped_kms(n, rho, delta, kd), btol);
+    const char *stage = kd >= 0 ? "sbtrd" : "sytrd";
+    uint64_t key_in = eig_cache_key_kms(n, uplo, rho, delta, EIG_BACKEND);
+    if (kd >= 0) key_in = eig_cache_hash(key_in, &kd, sizeof(kd));
+    const uint64_t key = eig_cache_key_stage(key_in, stage, uplo);
+    eig_cache_field_t f[2] = { { "D", D, (size_t)n, 0 }, { "E", E, (size_t)(n - 1), 0 } };
+    if (eig_cache_load(stage, key, f, 2) >= 0 && f[0].found && (n == 1 || f[1].found)) {
+        eig_cache_banner(stderr, kd >= 0 ? "DSBTRD (D, E)" : "DSYTRD (D, E)");
+        return 0;
+    }
+
+    /* Band path: KMS straight into band storage, DSBTRD (no Q) */
+    if (kd >= 0) {
+        const int ldab = kd + 1, ldq = 1;
+        const char vect = 'N';
+        double qdummy = 0.0;
+        double *AB = (double*)malloc((size_t)ldab * (size_t)n * sizeof(double));
+        double *BW = (double*)malloc((size_t)n * sizeof(double));
+        if (!AB || !BW) { free(BW); free(AB); return -2; }
+        band_fill_kms(n, kd, rho, delta, uplo, AB, ldab);
+        dsbtrd_(&vect, &uplo, &n, &kd, AB, &ldab, D, E, &qdummy, &ldq, BW, &info);
+        if (info == 0) eig_cache_store(stage, key, f, 2);
+        free(BW); free(AB);
+        return info;
+    }
+
     /* 1) Allocate and fill dense KMS matrix */
     double *A   = (double*)malloc((size_t)n * (size_t)n * sizeof(double));
     double *TAU = (double*)malloc((size_t)n * sizeof(double)); /* DSYTRD needs TAU (n-1 used) */
@@ -65,6 +113,11 @@ int kms_to_tridiag(int n, double rho, double delta, double *D, double *E)
 
     /* 3) Actual reduction: A -> T (D,E,TAU), reflectors stored in A (not needed for STEDC) */
     dsytrd_(&uplo, &n, A, &lda, D, E, TAU, WORK, &lwork, &info);
+    if (info == 0) {
+        const eig_cache_field_t fs[3] = { { "D", D, (size_t)n, 0 }, { "E", E, (size_t)(n - 1), 0 },
+                                          { "TAU", TAU, (size_t)(n - 1), 0 } };
+        eig_cache_store("sytrd", key, fs, 3);
+    }
 
     free(WORK);
     free(TAU);
@@ -1,14 +1,39 @@
 // stedc_run.c — Build a KMS SPD matrix A, reduce to tridiagonal, then
 // DSTEDC('V') to get eigenvalues + eigenvectors of A (divide & conquer).
 // Portable Fortran symbols; no vendor headers; column-major layout.
+// Double only; the S / Z staged pipelines are PRECISION/src/prec_run.c.
+// With EIG_CACHE=1, stage results are looked up in / stored to
+// common/src/eig_cache.h before each stage: "sytrd" (D, E, TAU [+ Q]) and
+// "stedc" (W [+ Z]); a hit is announced by a banner above the timings.
+// MEM_PREFAULT=touch|populate [MEM_LOCK=1] faults (and locks) A and each
+// stage's WORK in before that stage's clock starts; page faults and context
+// switches are reported per stage either way (common/src/mem_budget.h).
+// STEDC_SOLVER=mrrr replaces stage 3 by DSTEMR on T (O(n k) per k vectors,
+// no merge GEMMs) followed by one DGEMM Z = Q*Y; STEDC_NEV=k keeps only the
+// smallest k pairs. Cached under stage "stemr". See stemr_bench.c for the
+// side-by-side comparison on the tridiagonal generators.
+// STEDC_SOLVER=invit: eigenvalues by DSTEBZ bisection (or DSTERF with
+// INVIT_SOURCE=sterf), vectors by cluster-parallel inverse iteration
+// (common/src/inv_iter.h, INVIT_THREADS), then the same DGEMM; stage "stein".
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <errno.h>
 #include <time.h>
 #include <sys/stat.h>
 #include <math.h>
 
+#include "mat_io.h"     /* ../../common/src: MATRIX_INPUT=<.mtx|.npy|raw> instead of KMS */
+#include "eig_cache.h"  /* ../../common/src: EIG_CACHE / EIG_CACHE_DIR / EIG_CACHE_VECTORS */
+#include "numa_alloc.h" /* ../../common/src: MEM_PREFAULT / MEM_LOCK (mem_prefault)         */
+#include "mem_budget.h" /* ../../common/src: per-stage page faults (mem_usage_t)             */
+#include "inv_iter.h"   /* ../../common/src: cluster-parallel DSTEIN (STEDC_SOLVER=invit)     */
+
+#ifndef EIG_BACKEND
+#define EIG_BACKEND "unknown"     /* build_run.sh passes the case name */
+#endif
+
 /* --------- Fortran LAPACK symbols (vendor-agnostic) --------- */
 extern void dsytrd_(const char *UPLO, const int *N,
                     double *A, const int *LDA,
@@ -26,6 +51,23 @@ extern void dstedc_(const char *COMPZ, const int *N,
                     int *IWORK, const int *LIWORK,
                     int *INFO);
 
+extern void dstemr_(const char *JOBZ, const char *RANGE, const int *N, double *D, double *E,
+                    const double *VL, const double *VU, const int *IL, const int *IU,
+                    int *M, double *W, double *Z, const int *LDZ, const int *NZC,
+                    int *ISUPPZ, int *TRYRAC, double *WORK, const int *LWORK,
+                    int *IWORK, const int *LIWORK, int *INFO);
+
+extern void dstebz_(const char *RANGE, const char *ORDER, const int *N, const double *VL,
+                    const double *VU, const int *IL, const int *IU, const double *ABSTOL,
+                    const double *D, const double *E, int *M, int *NSPLIT, double *W,
+                    int *IBLOCK, int *ISPLIT, double *WORK, int *IWORK, int *INFO);
+
+extern void dsterf_(const int *N, double *D, double *E, int *INFO);
+
+extern void dgemm_(const char *TRANSA, const char *TRANSB, const int *M, const int *N, const int *K,
+                   const double *ALPHA, const double *A, const int *LDA, const double *B, const int *LDB,
+                   const double *BETA, double *C, const int *LDC);
+
 /* --------- Utilities --------- */
 static void ensure_dir(const char *path) {
     if (mkdir(path, 0777) != 0 && errno != EEXIST) {
@@ -38,6 +80,14 @@ static double elapsed_seconds(struct timespec a, struct timespec b) {
     return (b.tv_sec - a.tv_sec) + (b.tv_nsec - a.tv_nsec) / 1e9;
 }
 
+/* MEM_PREFAULT / MEM_LOCK: fault (and lock) a buffer in before a clock starts */
+static void prefault_if(void *p, size_t bytes)
+{
+    static int pf = -1, lock = 0;
+    if (pf < 0) { pf = (int)mem_prefault_from_env(); lock = mem_lock_from_env(); }
+    if (p && (pf != MEM_PREFAULT_OFF || lock)) mem_prefault(p, bytes, lock);
+}
+
 /* Fill A (n x n, column-major) with a classic SPD KMS test matrix:
    A_ij = rho^{|i-j|} + delta*(i==j), with |rho|<1, delta>=0. */
 static void fill_kms(double *A, int n, double rho, double delta)
@@ -64,6 +114,171 @@ static void fill_kms(double *A, int n, double rho, double delta)
     free(rp);
 }
 
+/* (Re)build A from its source after a rejected cache entry overwrote it. */
+static int refill_A(const char *input, const mat_header_t *hdr, mat_mapping_t *map,
+                    double **A, int n, int lda, double rho, double delta)
+{
+    if (!input) { fill_kms(*A, n, rho, delta); return 0; }
+    if (!map->base) return mat_read(input, hdr, *A, lda);
+    mat_unmap(map);
+    if (mat_map(input, hdr, map) != 0) return -1;
+    *A = map->a;
+    return 0;
+}
+
+/* Eigenvectors Y (n x m) of T -> columns of Q's storage: Z = Q*Y via ZT
+   (COMPZ='V'), or Y itself (COMPZ='I'). */
+static void back_transform(char compz, int n, double *Q, int ldq, const double *Y, int ldy,
+                           int m, double *ZT)
+{
+    if (compz == 'V') {
+        const char tn = 'N';
+        const double one = 1.0, zero = 0.0;
+        dgemm_(&tn, &tn, &n, &m, &n, &one, Q, &ldq, Y, &ldy, &zero, ZT, &n);
+        for (int j = 0; j < m; ++j)
+            memcpy(Q + (size_t)j * ldq, ZT + (size_t)j * n, (size_t)n * sizeof(double));
+    } else if (compz == 'I') {
+        for (int j = 0; j < m; ++j)
+            memcpy(Q + (size_t)j * ldq, Y + (size_t)j * ldy, (size_t)n * sizeof(double));
+    }
+}
+
+/* MRRR stage: DSTEMR on (D, E) for the smallest *m pairs (all when *m == n),
+   then Z = Q*Y into the first *m columns of Q (COMPZ='V'), or Y itself
+   (COMPZ='I'). W overwrites D[0..m-1]. Workspace is allocated outside the
+   clocks; *t_mr times DSTEMR, *t_mm the back-transform. Returns INFO. */
+static int stemr_stage(char compz, int n, double *D, double *E, double *Q, int ldq,
+                       int *m, double *t_mr, double *t_mm)
+{
+    const char jobz = (compz == 'N') ? 'N' : 'V';
+    const char range = (*m < n) ? 'I' : 'A';
+    const double vl = 0.0, vu = 0.0;
+    const int il = 1, iu = *m, nzc = *m;
+    int mfound = 0, tryrac = 1, lwork = -1, liwork = -1, iwkopt = 0, info = 0;
+    double wkopt = 0.0, zq = 0.0;
+
+    double *W = (double*)malloc((size_t)n * sizeof(double));
+    double *EN = (double*)malloc((size_t)n * sizeof(double));      /* DSTEMR wants E(N) as scratch */
+    double *Y = (jobz == 'V') ? (double*)malloc((size_t)n * (size_t)nzc * sizeof(double)) : NULL;
+    double *ZT = (compz == 'V') ? (double*)malloc((size_t)n * (size_t)nzc * sizeof(double)) : NULL;
+    int *ISUPPZ = (int*)malloc(2 * (size_t)n * sizeof(int));
+    if (!W || !EN || !ISUPPZ || (jobz == 'V' && !Y) || (compz == 'V' && !ZT)) {
+        fprintf(stderr, "Allocation failed (DSTEMR buffers)\n");
+        free(ISUPPZ); free(ZT); free(Y); free(EN); free(W);
+        return -100;
+    }
+    if (n > 1) memcpy(EN, E, (size_t)(n - 1) * sizeof(double));
+    EN[n - 1] = 0.0;
+    const int ldy = n, nzq = -1;
+    dstemr_(&jobz, &range, &n, D, EN, &vl, &vu, &il, &iu, &mfound, W, Y ? Y : &zq, &ldy, &nzq,
+            ISUPPZ, &tryrac, &wkopt, &lwork, &iwkopt, &liwork, &info);
+    lwork  = (int)wkopt > 0 ? (int)wkopt : 1;
+    liwork = iwkopt > 0 ? iwkopt : 1;
+    double *WORK = (double*)malloc((size_t)lwork * sizeof(double));
+    int *IWORK   = (int*)malloc((size_t)liwork * sizeof(int));
+    if (info != 0 || !WORK || !IWORK) {
+        fprintf(stderr, "DSTEMR workspace query/allocation failed, info=%d\n", info);
+        free(IWORK); free(WORK); free(ISUPPZ); free(ZT); free(Y); free(EN); free(W);
+        return info ? info : -100;
+    }
+    prefault_if(WORK, (size_t)lwork * sizeof(double));
+    prefault_if(IWORK, (size_t)liwork * sizeof(int));
+
+    struct timespec t0, t1, t2;
+    tryrac = 1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    dstemr_(&jobz, &range, &n, D, EN, &vl, &vu, &il, &iu, &mfound, W, Y ? Y : &zq, &ldy, &nzc,
+            ISUPPZ, &tryrac, WORK, &lwork, IWORK, &liwork, &info);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (info != 0) fprintf(stderr, "DSTEMR failed, info=%d\n", info);
+    if (info == 0) back_transform(compz, n, Q, ldq, Y, ldy, mfound, ZT);
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+    *t_mr = elapsed_seconds(t0, t1);
+    *t_mm = elapsed_seconds(t1, t2);
+    if (info == 0) { memcpy(D, W, (size_t)mfound * sizeof(double)); *m = mfound; }
+
+    free(IWORK); free(WORK); free(ISUPPZ); free(ZT); free(Y); free(EN); free(W);
+    return info;
+}
+
+/* Bisection + inverse iteration stage: DSTEBZ (RANGE='I' 1..*m, ORDER='B'),
+   or DSTERF for all values when INVIT_SOURCE=sterf (T taken as unreduced),
+   then the cluster-parallel DSTEIN of common/src/inv_iter.h; back-transform
+   as in stemr_stage. *t_ev times the eigenvalues, *t_iv inverse iteration,
+   *t_mm the back-transform. Returns INFO (> 0: vectors not converged). */
+static int invit_stage(char compz, int n, double *D, double *E, double *Q, int ldq,
+                       int *m, double *t_ev, double *t_iv, double *t_mm, inv_iter_stats_t *st)
+{
+    const char *src = getenv("INVIT_SOURCE");
+    const int sterf = src && strcmp(src, "sterf") == 0;
+    const char range = (*m < n) ? 'I' : 'A', order = 'B';
+    const double vl = 0.0, vu = 0.0, abstol = 0.0;
+    const int il = 1, iu = *m;
+    int mfound = 0, nsplit = 0, info = 0;
+
+    double *W  = (double*)malloc((size_t)n * sizeof(double));
+    double *DW = (double*)malloc((size_t)n * sizeof(double));          /* DSTERF overwrites D, E */
+    double *EW = (double*)malloc((size_t)n * sizeof(double));
+    double *WORK = (double*)malloc(4 * (size_t)n * sizeof(double));
+    int *IBLOCK = (int*)malloc((size_t)n * sizeof(int));
+    int *ISPLIT = (int*)malloc((size_t)n * sizeof(int));
+    int *IWORK  = (int*)malloc(3 * (size_t)n * sizeof(int));
+    double *Y  = (compz != 'N') ? (double*)malloc((size_t)n * (size_t)(*m) * sizeof(double)) : NULL;
+    double *ZT = (compz == 'V') ? (double*)malloc((size_t)n * (size_t)(*m) * sizeof(double)) : NULL;
+    if (!W || !DW || !EW || !WORK || !IBLOCK || !ISPLIT || !IWORK || (compz != 'N' && !Y) || (compz == 'V' && !ZT)) {
+        fprintf(stderr, "Allocation failed (inverse iteration buffers)\n");
+        info = -100;
+        goto DONE;
+    }
+
+    struct timespec t0, t1, t2, t3;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    if (sterf) {
+        memcpy(DW, D, (size_t)n * sizeof(double));
+        if (n > 1) memcpy(EW, E, (size_t)(n - 1) * sizeof(double));
+        dsterf_(&n, DW, EW, &info);
+        memcpy(W, DW, (size_t)n * sizeof(double));
+        mfound = *m;
+    } else {
+        dstebz_(&range, &order, &n, &vl, &vu, &il, &iu, &abstol, D, E, &mfound, &nsplit,
+                W, IBLOCK, ISPLIT, WORK, IWORK, &info);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (info != 0) { fprintf(stderr, "%s failed, info=%d\n", sterf ? "DSTERF" : "DSTEBZ", info); goto DONE; }
+
+    if (compz != 'N') {
+        info = inv_iter_vectors(n, D, E, mfound, W, sterf ? NULL : IBLOCK, sterf ? NULL : ISPLIT,
+                                Y, n, 0, st);
+        if (info != 0) { fprintf(stderr, "Inverse iteration failed, info=%d\n", info); goto DONE; }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+    back_transform(compz, n, Q, ldq, Y, n, mfound, ZT);
+    clock_gettime(CLOCK_MONOTONIC, &t3);
+    *t_ev = elapsed_seconds(t0, t1);
+    *t_iv = elapsed_seconds(t1, t2);
+    *t_mm = elapsed_seconds(t2, t3);
+
+    /* ORDER='B' groups by block: sort W with its vectors (selection sort on columns is O(m n)
+       moves at worst; blocks are rare for SPD input) */
+    for (int i = 0; i < mfound; ++i) {
+        int k = i;
+        for (int j = i + 1; j < mfound; ++j) if (W[j] < W[k]) k = j;
+        if (k == i) continue;
+        const double tw = W[i]; W[i] = W[k]; W[k] = tw;
+        if (compz != 'N')
+            for (int r = 0; r < n; ++r) {
+                double *a = Q + r + (size_t)i * ldq, *b = Q + r + (size_t)k * ldq;
+                const double tz = *a; *a = *b; *b = tz;
+            }
+    }
+    memcpy(D, W, (size_t)mfound * sizeof(double));
+    *m = mfound;
+
+DONE:
+    free(ZT); free(Y); free(IWORK); free(ISPLIT); free(IBLOCK); free(WORK); free(EW); free(DW); free(W);
+    return info;
+}
+
 int main(void)
 {
     extern char* openblas_get_config(void);
@@ -72,13 +287,16 @@ int main(void)
     printf("OpenBLAS config: %s\n", openblas_get_config());
     printf("OpenBLAS core  : %s\n", openblas_get_corename());
     /* ---- Config ---- */
-    const int   n    = 4000;     // matrix size
-    const int   lda  = n;
-    const char  uplo = 'U';      // keep 'U' along the whole chain
+    int         n    = 4000;     // matrix size (taken from the file when MATRIX_INPUT is set)
+    char        uplo = 'U';      // keep 'U' along the whole chain (flipped for C-order .npy mappings)
     const char  compz = 'V';     // we want eigenvectors of A (not only T)
 //    const char  compz = 'N';
     const double rho   = 0.95;   // KMS parameter: 0.8 easy ... 0.98 harder
     const double delta = 0.0;    // small positive shift if you want more safety
+    const char  *solver_env = getenv("STEDC_SOLVER");
+    const int    mrrr = solver_env && strcmp(solver_env, "mrrr") == 0;   // DSTEMR instead of DSTEDC
+    const int    invit = solver_env && strcmp(solver_env, "invit") == 0; // DSTEBZ + parallel DSTEIN
+    const char  *solver = mrrr ? "DSTEMR" : invit ? "DSTEIN" : "DSTEDC";
 
     /* Print mode at the beginning */
     if (compz == 'N')
@@ -88,37 +306,137 @@ int main(void)
     else if (compz == 'V')
         printf("Mode: STEDC (Eigenvalues + eigenvectors of A, COMPZ='V')\n");
 
-    /* ---- Allocate ---- */
-    double *A   = (double*)malloc((size_t)n * (size_t)lda * sizeof(double)); // will become Q, then Z
+    /* ---- Input: file (MATRIX_INPUT) or synthetic KMS ---- */
+    const char *input = getenv("MATRIX_INPUT");
+    const char *no_mmap = getenv("MATRIX_MMAP");           // MATRIX_MMAP=0 forces a copy
+    mat_header_t hdr;
+    mat_mapping_t map = {0};
+    struct timespec tl0, tl1;
+    clock_gettime(CLOCK_MONOTONIC, &tl0);
+    if (input && mat_probe(input, &hdr) != 0) { fprintf(stderr, "Cannot read %s\n", input); return 1; }
+    if (input) n = hdr.n;
+    const int lda = n;
+    const char *nev_env = getenv("STEDC_NEV");
+    int mz = n;                                            // eigenpairs computed (STEDC_NEV, MRRR / invit)
+    if ((mrrr || invit) && nev_env && atoi(nev_env) > 0 && atoi(nev_env) < n) mz = atoi(nev_env);
+    const char *stage_eig = mrrr ? "stemr" : invit ? "stein" : "stedc";
+    if (mrrr)  printf("Solver: DSTEMR (MRRR), %d of %d eigenpairs\n", mz, n);
+    if (invit) printf("Solver: %s + parallel inverse iteration, %d of %d eigenpairs\n",
+                      (getenv("INVIT_SOURCE") && strcmp(getenv("INVIT_SOURCE"), "sterf") == 0) ? "DSTERF" : "DSTEBZ",
+                      mz, n);
+
+    /* ---- Allocate (a zero-copy file mapping replaces A when the layout allows) ---- */
+    double *A = NULL;                                                         // will become Q, then Z
+    if (input && !(no_mmap && no_mmap[0] == '0') && mat_can_map(&hdr, lda) && mat_map(input, &hdr, &map) == 0) {
+        A = map.a;
+        uplo = mat_uplo(&map, uplo);
+    } else {
+        A = (double*)malloc((size_t)n * (size_t)lda * sizeof(double));
+    }
     double *D   = (double*)malloc((size_t)n * sizeof(double));
     double *E   = (double*)malloc((size_t)(n>0? n-1 : 0) * sizeof(double));
     double *TAU = (double*)malloc((size_t)(n>0? n-1 : 0) * sizeof(double));
     if (!A || !D || (!E && n>1) || (!TAU && n>1)) {
         fprintf(stderr, "Allocation failed.\n");
-        free(TAU); free(E); free(D); free(A);
+        free(TAU); free(E); free(D); if (map.base) mat_unmap(&map); else free(A);
         return 1;
     }
+    prefault_if(A, (size_t)n * (size_t)lda * sizeof(double));
+    prefault_if(D, (size_t)n * sizeof(double));
+    prefault_if(E, (size_t)(n > 0 ? n - 1 : 0) * sizeof(double));
+    prefault_if(TAU, (size_t)(n > 0 ? n - 1 : 0) * sizeof(double));
+
+    /* ---- Fill A: read the file, or build dense SPD KMS A ---- */
+    if (input && !map.base && mat_read(input, &hdr, A, lda) != 0) {
+        fprintf(stderr, "Failed to load %s\n", input);
+        goto CLEANUP_ERR;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &tl1);
+    double time_load = elapsed_seconds(tl0, tl1);
+    if (input)
+        printf("Input: %s (%s, n=%d, %s) loaded in %.3f s\n", input, mat_format_name(hdr.format), n,
+               map.base ? (map.transposed ? "mmap, C order -> UPLO flipped" : "mmap") : "copied", time_load);
+
+    /* ---- Cache: key from the KMS parameters (A not even built on a full hit) or from A's bytes ---- */
+    const int use_cache = eig_cache_enabled();
+    const size_t nn = (size_t)n * (size_t)lda;
+    int have_A = (input != NULL);          // KMS A is only filled once a stage misses
+    int hit_trd = 0, hit_eig = 0;
+    double time_hash = 0.0;
+    uint64_t key_trd = 0, key_eig = 0;
+    if (use_cache) {
+        struct timespec th0, th1;
+        clock_gettime(CLOCK_MONOTONIC, &th0);
+        const uint64_t key_in = input ? eig_cache_key_matrix(n, A, lda, uplo, EIG_BACKEND)
+                                      : eig_cache_key_kms(n, uplo, rho, delta, EIG_BACKEND);
+        clock_gettime(CLOCK_MONOTONIC, &th1);
+        time_hash = elapsed_seconds(th0, th1);
+        key_trd = eig_cache_key_stage(key_in, "sytrd", uplo);
+        key_eig = eig_cache_key_stage((mrrr || invit) ? eig_cache_hash(key_in, &mz, sizeof(mz)) : key_in, stage_eig, compz);
+        printf("Cache: %s (key %016llx, hashed in %.3f s)\n", eig_cache_dir(),
+               (unsigned long long)key_in, time_hash);
+
+        /* final stage first: eigenvalues (+ vectors for COMPZ != 'N') */
+        eig_cache_field_t fe[2] = { { "W", D, (size_t)mz, 0 }, { "Z", compz != 'N' ? A : NULL, (size_t)lda * mz, 0 } };
+        const int rc = eig_cache_load(stage_eig, key_eig, fe, 2);
+        hit_eig = rc >= 0 && fe[0].found && (compz == 'N' || fe[1].found);
+        if (rc == -2 || (!hit_eig && fe[1].found)) have_A = 0;
+    }
 
-    /* ---- Build dense SPD KMS A ---- */
-    fill_kms(A, n, rho, delta);
+    double time_sytrd = 0.0, time_dorgtr = 0.0, time_dstedc = 0.0, time_gemm = 0.0;   // gemm: MRRR / invit Q*Y
+    double time_invit = 0.0;                                                         // invit: DSTEIN pool
+    inv_iter_stats_t ist = {0};
+    double *Z = A;          // reuse A's storage for Z (Q overwritten to Q*Y)
+    int ldz = lda;
+    if (hit_eig) {
+        printf("Cache: %s hit, skipping DSYTRD/DORGTR/%s\n", stage_eig, solver);
+        goto REPORT;
+    }
+    if (!have_A && refill_A(input, &hdr, &map, &A, n, lda, rho, delta) != 0) {
+        fprintf(stderr, "Failed to load %s\n", input);
+        goto CLEANUP_ERR;
+    }
+    Z = A;
+
+    /* ---- 0) Reduction stage from the cache: D, E, TAU and (COMPZ='V') Q ---- */
+    if (use_cache) {
+        eig_cache_field_t ft_[4] = {
+            { "D", D, (size_t)n, 0 }, { "E", E, (size_t)(n > 0 ? n - 1 : 0), 0 },
+            { "TAU", TAU, (size_t)(n > 0 ? n - 1 : 0), 0 }, { "Q", compz == 'V' ? A : NULL, nn, 0 } };
+        const int rc = eig_cache_load("sytrd", key_trd, ft_, 4);
+        hit_trd = rc >= 0 && ft_[0].found && ft_[1].found && (compz != 'V' || ft_[3].found);
+        if ((rc == -2 || (!hit_trd && ft_[3].found)) &&
+            refill_A(input, &hdr, &map, &A, n, lda, rho, delta) != 0) {
+            fprintf(stderr, "Failed to load %s\n", input);
+            goto CLEANUP_ERR;
+        }
+        Z = A;
+        if (hit_trd) printf("Cache: SYTRD hit, skipping DSYTRD/DORGTR\n");
+    }
 
-    /* ---- 1) Reduce A -> T via DSYTRD ---- */
     int info = 0, lwork = -1;
     double wkopt;
     struct timespec t0, t1, t2, t3, t4, t5;
+    mem_usage_t u_trd[2], u_org[2], u_stc[2];   // page faults / context switches per stage
+    double *WORK = NULL;
+    if (hit_trd) goto STEDC;
 
+    /* ---- 1) Reduce A -> T via DSYTRD ---- */
     dsytrd_(&uplo, &n, A, &lda, D, E, TAU, &wkopt, &lwork, &info);
     if (info != 0) { fprintf(stderr, "DSYTRD workspace query failed, info=%d\n", info); goto CLEANUP_ERR; }
     lwork = (int)wkopt;
     if (lwork < 1) lwork = 1;
-    double *WORK = (double*)malloc((size_t)lwork * sizeof(double));
+    WORK = (double*)malloc((size_t)lwork * sizeof(double));
     if (!WORK) { fprintf(stderr, "Allocation failed (WORK for DSYTRD)\n"); goto CLEANUP_ERR; }
+    prefault_if(WORK, (size_t)lwork * sizeof(double));
 
+    mem_usage_now(&u_trd[0]);
     clock_gettime(CLOCK_MONOTONIC, &t0);
     dsytrd_(&uplo, &n, A, &lda, D, E, TAU, WORK, &lwork, &info);
     clock_gettime(CLOCK_MONOTONIC, &t1);
+    mem_usage_now(&u_trd[1]);
     if (info != 0) { fprintf(stderr, "DSYTRD failed, info=%d\n", info); free(WORK); goto CLEANUP_ERR; }
-    double time_sytrd = elapsed_seconds(t0, t1);
+    time_sytrd = elapsed_seconds(t0, t1);
     free(WORK); WORK = NULL;
 
     /* ---- 2) Form Q explicitly in-place using DORGTR ---- */
@@ -128,21 +446,47 @@ int main(void)
     if (lwork < 1) lwork = 1;
     WORK = (double*)malloc((size_t)lwork * sizeof(double));
     if (!WORK) { fprintf(stderr, "Allocation failed (WORK for DORGTR)\n"); goto CLEANUP_ERR; }
+    prefault_if(WORK, (size_t)lwork * sizeof(double));
 
+    mem_usage_now(&u_org[0]);
     clock_gettime(CLOCK_MONOTONIC, &t2);
     dorgtr_(&uplo, &n, A, &lda, TAU, WORK, &lwork, &info);
     clock_gettime(CLOCK_MONOTONIC, &t3);
+    mem_usage_now(&u_org[1]);
     if (info != 0) { fprintf(stderr, "DORGTR failed, info=%d\n", info); free(WORK); goto CLEANUP_ERR; }
-    double time_dorgtr = elapsed_seconds(t2, t3);
+    time_dorgtr = elapsed_seconds(t2, t3);
     free(WORK); WORK = NULL;
 
-    /* ---- 3) DSTEDC('V') ---- */
-    double *Z = A;          // reuse A's storage for Z (Q overwritten to Q*Y)
-    int ldz = lda;
+    /* D and E are overwritten by DSTEDC: store the reduction now */
+    if (use_cache) {
+        const eig_cache_field_t fs[4] = {
+            { "D", D, (size_t)n, 0 }, { "E", E, (size_t)(n > 0 ? n - 1 : 0), 0 },
+            { "TAU", TAU, (size_t)(n > 0 ? n - 1 : 0), 0 },
+            { "Q", (compz == 'V' && eig_cache_vectors() > 1) ? A : NULL, nn, 0 } };
+        eig_cache_store("sytrd", key_trd, fs, 4);
+    }
+
+STEDC:
+    /* ---- 3') STEDC_SOLVER=mrrr: DSTEMR on T, then Z = Q*Y ---- */
+    if (mrrr) {
+        mem_usage_now(&u_stc[0]);
+        info = stemr_stage(compz, n, D, E, A, lda, &mz, &time_dstedc, &time_gemm);
+        mem_usage_now(&u_stc[1]);
+        if (info != 0) goto CLEANUP_ERR;
+        goto STORE_EIG;
+    }
+    /* ---- 3'') STEDC_SOLVER=invit: bisection, parallel inverse iteration, Z = Q*Y ---- */
+    if (invit) {
+        mem_usage_now(&u_stc[0]);
+        info = invit_stage(compz, n, D, E, A, lda, &mz, &time_dstedc, &time_invit, &time_gemm, &ist);
+        mem_usage_now(&u_stc[1]);
+        if (info != 0) goto CLEANUP_ERR;
+        goto STORE_EIG;
+    }
 
+    /* ---- 3) DSTEDC('V') ---- */
     int liwork = -1, iwkopt;
     lwork = -1; wkopt = 0.0;
-    clock_gettime(CLOCK_MONOTONIC, &t4);
     dstedc_(&compz, &n, D, E, Z, &ldz, &wkopt, &lwork, &iwkopt, &liwork, &info);
     if (info != 0) { fprintf(stderr, "DSTEDC workspace query failed, info=%d\n", info); goto CLEANUP_ERR; }
     lwork  = (int)wkopt;
@@ -153,18 +497,53 @@ int main(void)
     WORK        = (double*)malloc((size_t)lwork  * sizeof(double));
     int *IWORK  = (int*)   malloc((size_t)liwork * sizeof(int));
     if (!WORK || !IWORK) { fprintf(stderr, "Allocation failed (WORK/IWORK for DSTEDC)\n"); free(IWORK); free(WORK); goto CLEANUP_ERR; }
+    prefault_if(WORK, (size_t)lwork * sizeof(double));
+    prefault_if(IWORK, (size_t)liwork * sizeof(int));
 
+    /* timed from here: the workspace query and allocation are not part of DSTEDC */
+    mem_usage_now(&u_stc[0]);
+    clock_gettime(CLOCK_MONOTONIC, &t4);
     dstedc_(&compz, &n, D, E, Z, &ldz, WORK, &lwork, IWORK, &liwork, &info);
     clock_gettime(CLOCK_MONOTONIC, &t5);
+    mem_usage_now(&u_stc[1]);
     if (info != 0) { fprintf(stderr, "DSTEDC failed, info=%d\n", info); free(IWORK); free(WORK); goto CLEANUP_ERR; }
-    double time_dstedc = elapsed_seconds(t4, t5);
+    time_dstedc = elapsed_seconds(t4, t5);
     free(IWORK); free(WORK);
 
+STORE_EIG:
+    if (use_cache) {
+        const eig_cache_field_t fs[2] = {
+            { "W", D, (size_t)mz, 0 }, { "Z", (compz != 'N' && eig_cache_vectors()) ? Z : NULL, (size_t)ldz * mz, 0 } };
+        eig_cache_store(stage_eig, key_eig, fs, 2);
+    }
+
+REPORT:
     /* ---- Report timings ---- */
-    printf("DSYTRD (A -> T) took %.3f s\n", time_sytrd);
-    printf("DORGTR (form Q) took %.3f s\n", time_dorgtr);
-    printf("DSTEDC('V')      took %.3f s\n", time_dstedc);
-    printf("Total            took %.3f s\n", time_sytrd + time_dorgtr + time_dstedc);
+    const char *cached = hit_eig ? "all stages" : hit_trd ? "DSYTRD/DORGTR" : NULL;
+    if (cached) eig_cache_banner(stdout, cached);
+    printf("LOAD   (input)  took %.3f s\n", time_load);
+    if (use_cache) printf("HASH   (key)    took %.3f s\n", time_hash);
+    printf("DSYTRD (A -> T) took %.3f s%s\n", time_sytrd, (hit_trd || hit_eig) ? " (cached)" : "");
+    printf("DORGTR (form Q) took %.3f s%s\n", time_dorgtr, (hit_trd || hit_eig) ? " (cached)" : "");
+    if (mrrr) {
+        printf("DSTEMR (%5d)   took %.3f s%s\n", mz, time_dstedc, hit_eig ? " (cached)" : "");
+        printf("DGEMM  (Q*Y)    took %.3f s%s\n", time_gemm, hit_eig ? " (cached)" : "");
+    } else if (invit) {
+        printf("DSTEBZ (%5d)   took %.3f s%s\n", mz, time_dstedc, hit_eig ? " (cached)" : "");
+        printf("DSTEIN (pool)   took %.3f s%s\n", time_invit, hit_eig ? " (cached)" : "");
+        if (!hit_eig)
+            printf("       %d clusters (largest %d) on %d threads, busy %.3f .. %.3f s\n",
+                   ist.nclusters, ist.largest, ist.nthreads, ist.busy_min, ist.busy_max);
+        printf("DGEMM  (Q*Y)    took %.3f s%s\n", time_gemm, hit_eig ? " (cached)" : "");
+    } else {
+        printf("DSTEDC('V')      took %.3f s%s\n", time_dstedc, hit_eig ? " (cached)" : "");
+    }
+    printf("Total            took %.3f s\n", time_sytrd + time_dorgtr + time_dstedc + time_invit + time_gemm);
+    if (!hit_trd && !hit_eig) {
+        mem_usage_report(stdout, "dsytrd", &u_trd[0], &u_trd[1]);
+        mem_usage_report(stdout, "dorgtr", &u_org[0], &u_org[1]);
+    }
+    if (!hit_eig) mem_usage_report(stdout, stage_eig, &u_stc[0], &u_stc[1]);
 
     /* ---- Write outputs ---- */
     const char *outdir = "../output";
@@ -177,24 +556,37 @@ int main(void)
 
     FILE *ft = fopen(path_time, "w");
     if (ft) {
-        fprintf(ft, "Mode: STEDC (COMPZ='%c')\n", compz);
+        if (cached) eig_cache_banner(ft, cached);
+        fprintf(ft, "Mode: %s (COMPZ='%c', %d of %d pairs)\n", solver, compz, mz, n);
+        fprintf(ft, "LOAD    %.6f s (%s)\n", time_load, input ? input : "KMS");
+        if (use_cache)
+            fprintf(ft, "CACHE   hash %.6f s, sytrd %s, %s %s\n", time_hash,
+                    (hit_trd || hit_eig) ? "hit" : "miss", stage_eig, hit_eig ? "hit" : "miss");
         fprintf(ft, "DSYTRD  %.6f s\n", time_sytrd);
         fprintf(ft, "DORGTR  %.6f s\n", time_dorgtr);
-        fprintf(ft, "DSTEDC  %.6f s\n", time_dstedc);
-        fprintf(ft, "TOTAL   %.6f s\n", time_sytrd + time_dorgtr + time_dstedc);
+        fprintf(ft, "%s  %.6f s\n", invit ? "DSTEBZ" : solver, time_dstedc);
+        if (invit) fprintf(ft, "DSTEIN  %.6f s (%d clusters, largest %d, %d threads)\n",
+                           time_invit, ist.nclusters, ist.largest, ist.nthreads);
+        if (mrrr || invit) fprintf(ft, "DGEMM   %.6f s\n", time_gemm);
+        fprintf(ft, "TOTAL   %.6f s\n", time_sytrd + time_dorgtr + time_dstedc + time_invit + time_gemm);
+        if (!hit_trd && !hit_eig) {
+            mem_usage_report(ft, "dsytrd", &u_trd[0], &u_trd[1]);
+            mem_usage_report(ft, "dorgtr", &u_org[0], &u_org[1]);
+        }
+        if (!hit_eig) mem_usage_report(ft, stage_eig, &u_stc[0], &u_stc[1]);
         fclose(ft);
     }
 
     FILE *fw = fopen(path_w, "w");
     if (fw) {
-        for (int i = 0; i < n; ++i) fprintf(fw, "%.12e\n", D[i]);
+        for (int i = 0; i < mz; ++i) fprintf(fw, "%.12e\n", D[i]);
         fclose(fw);
     }
 
     /* Z columns are eigenvectors of A */
     FILE *fv = fopen(path_v, "w");
     if (fv) {
-        for (int j = 0; j < n; ++j) {
+        for (int j = 0; j < mz; ++j) {
             for (int i = 0; i < n; ++i) {
                 fprintf(fv, "%.6e%c", Z[i + (size_t)j * n], (i == n-1) ? '\n' : ' ');
             }
@@ -202,10 +594,10 @@ int main(void)
         fclose(fv);
     }
 
-    free(TAU); free(E); free(D); free(A);
+    free(TAU); free(E); free(D); if (map.base) mat_unmap(&map); else free(A);
     return 0;
 
 CLEANUP_ERR:
-    free(TAU); free(E); free(D); free(A);
+    free(TAU); free(E); free(D); if (map.base) mat_unmap(&map); else free(A);
     return 2;
 }
@@ -0,0 +1,205 @@
+// stemr_bench.c — tridiagonal eigenvectors: DSTEDC('I') (divide & conquer)
+// vs DSTEMR (MRRR), all n pairs and the smallest `nev`, on the generators of
+// common/src/tridiag_gen.h (including the clustered Wilkinson / glued cases).
+//
+// Usage: stemr_bench [n] [nev] [gen ...]
+//   n    default 2000;  nev  default n/10;  gens default: all
+// Per (generator, solver): seconds (workspace query and allocation outside
+// the clock), Z + workspace bytes, and
+//   orth   max |Z^T Z - I| / (n eps)                 (DSYRK, O(n^2 m))
+//   resid  max |T z - lambda z| / (||T||_1 n eps)
+//   dW     max |lambda - lambda_DSTEDC| / ||T||_1
+// Table on stdout and in ../output/stemr_bench.txt; the per-call summary of
+// the wrappers (DLARRE / DLARRV / DLAR1V vs the DLAED* tree) at exit.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <math.h>
+#include <float.h>
+#include <sys/stat.h>
+
+#include "tridiag_gen.h"   /* ../../common/src: kms 121 wilkinson glued clement random */
+
+extern void dstedc_(const char *COMPZ, const int *N, double *D, double *E,
+                    double *Z, const int *LDZ, double *WORK, const int *LWORK,
+                    int *IWORK, const int *LIWORK, int *INFO);
+extern void dstemr_(const char *JOBZ, const char *RANGE, const int *N, double *D, double *E,
+                    const double *VL, const double *VU, const int *IL, const int *IU,
+                    int *M, double *W, double *Z, const int *LDZ, const int *NZC,
+                    int *ISUPPZ, int *TRYRAC, double *WORK, const int *LWORK,
+                    int *IWORK, const int *LIWORK, int *INFO);
+extern void dsyrk_(const char *UPLO, const char *TRANS, const int *N, const int *K,
+                   const double *ALPHA, const double *A, const int *LDA,
+                   const double *BETA, double *C, const int *LDC);
+
+/* --------- Utilities --------- */
+static void ensure_dir(const char *path) {
+    if (mkdir(path, 0777) != 0 && errno != EEXIST) {
+        perror("mkdir");
+        exit(5);
+    }
+}
+
+static double elapsed_seconds(struct timespec a, struct timespec b) {
+    return (b.tv_sec - a.tv_sec) + (b.tv_nsec - a.tv_nsec) / 1e9;
+}
+
+/* max |Z^T Z - I| over the m x m Gram matrix (upper triangle) */
+static double orth_error(int n, int m, const double *Z, int ldz)
+{
+    double *G = (double*)malloc((size_t)m * (size_t)m * sizeof(double));
+    if (!G) return NAN;
+    const char uplo = 'U', trans = 'T';
+    const double one = 1.0, zero = 0.0;
+    dsyrk_(&uplo, &trans, &m, &n, &one, Z, &ldz, &zero, G, &m);
+    double e = 0.0;
+    for (int j = 0; j < m; ++j)
+        for (int i = 0; i <= j; ++i) {
+            const double v = fabs(G[i + (size_t)j * m] - (i == j ? 1.0 : 0.0));
+            if (v > e) e = v;
+        }
+    free(G);
+    return e;
+}
+
+typedef struct {
+    const char *solver;
+    int    m;
+    double seconds, orth, resid, dw;
+    size_t bytes;
+    int    info;
+} run_t;
+
+/* DSTEDC('I'): all eigenpairs of T */
+static run_t run_stedc(int n, const double *D0, const double *E0, double *W, double *Z)
+{
+    run_t r = { "DSTEDC", n, 0, 0, 0, 0, 0, 0 };
+    const char compz = 'I';
+    double *E = (double*)malloc((size_t)n * sizeof(double));
+    if (!E) { r.info = -100; return r; }
+    memcpy(W, D0, (size_t)n * sizeof(double));
+    memcpy(E, E0, (size_t)n * sizeof(double));
+    int lwork = -1, liwork = -1, iwkopt = 0, info = 0;
+    double wkopt = 0.0;
+    dstedc_(&compz, &n, W, E, Z, &n, &wkopt, &lwork, &iwkopt, &liwork, &info);
+    lwork = (int)wkopt > 0 ? (int)wkopt : 1;
+    liwork = iwkopt > 0 ? iwkopt : 1;
+    double *WORK = (double*)malloc((size_t)lwork * sizeof(double));
+    int *IWORK = (int*)malloc((size_t)liwork * sizeof(int));
+    if (!WORK || !IWORK) { r.info = -100; free(IWORK); free(WORK); free(E); return r; }
+    r.bytes = ((size_t)n * n + (size_t)lwork) * sizeof(double) + (size_t)liwork * sizeof(int);
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    dstedc_(&compz, &n, W, E, Z, &n, WORK, &lwork, IWORK, &liwork, &info);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    r.seconds = elapsed_seconds(t0, t1);
+    r.info = info;
+    free(IWORK); free(WORK); free(E);
+    return r;
+}
+
+/* DSTEMR: all pairs (nev >= n) or the smallest nev (RANGE='I') */
+static run_t run_stemr(int n, int nev, const double *D0, const double *E0, double *W, double *Z)
+{
+    const char jobz = 'V', range = (nev < n) ? 'I' : 'A';
+    run_t r = { range == 'A' ? "DSTEMR" : "DSTEMR-I", 0, 0, 0, 0, 0, 0, 0 };
+    double *D = (double*)malloc((size_t)n * sizeof(double));
+    double *E = (double*)malloc((size_t)n * sizeof(double));
+    int *ISUPPZ = (int*)malloc(2 * (size_t)n * sizeof(int));
+    if (!D || !E || !ISUPPZ) { r.info = -100; free(ISUPPZ); free(E); free(D); return r; }
+    const double vl = 0.0, vu = 0.0;
+    const int il = 1, iu = nev < n ? nev : n;
+    int m = 0, nzc = -1, tryrac = 1, lwork = -1, liwork = -1, iwkopt = 0, info = 0;
+    double wkopt = 0.0, zq = 0.0;
+    memcpy(D, D0, (size_t)n * sizeof(double));
+    memcpy(E, E0, (size_t)n * sizeof(double));
+    dstemr_(&jobz, &range, &n, D, E, &vl, &vu, &il, &iu, &m, W, &zq, &n, &nzc, ISUPPZ, &tryrac,
+            &wkopt, &lwork, &iwkopt, &liwork, &info);
+    nzc = iu;                                   /* Z has room for iu columns */
+    lwork = (int)wkopt > 0 ? (int)wkopt : 1;
+    liwork = iwkopt > 0 ? iwkopt : 1;
+    double *WORK = (double*)malloc((size_t)lwork * sizeof(double));
+    int *IWORK = (int*)malloc((size_t)liwork * sizeof(int));
+    if (!WORK || !IWORK) { r.info = -100; free(IWORK); free(WORK); free(ISUPPZ); free(E); free(D); return r; }
+    r.bytes = ((size_t)n * nzc + (size_t)lwork) * sizeof(double) + ((size_t)liwork + 2 * (size_t)n) * sizeof(int);
+
+    struct timespec t0, t1;
+    tryrac = 1;                                 /* the query may have cleared it */
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    dstemr_(&jobz, &range, &n, D, E, &vl, &vu, &il, &iu, &m, W, Z, &n, &nzc, ISUPPZ, &tryrac,
+            WORK, &lwork, IWORK, &liwork, &info);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    r.seconds = elapsed_seconds(t0, t1);
+    r.m = m;
+    r.info = info;
+    free(IWORK); free(WORK); free(ISUPPZ); free(E); free(D);
+    return r;
+}
+
+int main(int argc, char **argv)
+{
+    const int n   = (argc > 1) ? atoi(argv[1]) : 2000;
+    const int nev = (argc > 2 && atoi(argv[2]) > 0) ? atoi(argv[2]) : (n / 10 > 0 ? n / 10 : 1);
+    static const char *all[] = { "kms", "121", "wilkinson", "glued", "clement", "random" };
+    const char **gens = (argc > 3) ? (const char**)(argv + 3) : all;
+    const int ngen = (argc > 3) ? argc - 3 : (int)(sizeof(all) / sizeof(all[0]));
+    if (n < 2) { fprintf(stderr, "n must be >= 2\n"); return 1; }
+
+    double *D  = (double*)malloc((size_t)n * sizeof(double));
+    double *E  = (double*)malloc((size_t)n * sizeof(double));
+    double *W0 = (double*)malloc((size_t)n * sizeof(double));
+    double *W  = (double*)malloc((size_t)n * sizeof(double));
+    double *Z  = (double*)malloc((size_t)n * (size_t)n * sizeof(double));
+    if (!D || !E || !W0 || !W || !Z) { fprintf(stderr, "Allocation failed.\n"); return 1; }
+
+    const char *outdir = "../output";
+    ensure_dir(outdir);
+    char path[256];
+    snprintf(path, sizeof(path), "%s/stemr_bench.txt", outdir);
+    FILE *ft = fopen(path, "w");
+
+    printf("Tridiagonal eigenvectors: DSTEDC('I') vs DSTEMR | n=%d, nev=%d\n", n, nev);
+    const char *hdr = "%-10s %-9s %6s %9s %9s %9s %9s %10s\n";
+    printf(hdr, "gen", "solver", "m", "seconds", "orth", "resid", "dW", "MB");
+    if (ft) {
+        fprintf(ft, "n=%d nev=%d (orth in n*eps, resid in ||T|| n*eps, dW relative to ||T||)\n", n, nev);
+        fprintf(ft, hdr, "gen", "solver", "m", "seconds", "orth", "resid", "dW", "MB");
+    }
+
+    const double eps = DBL_EPSILON;
+    for (int g = 0; g < ngen; ++g) {
+        if (tridiag_gen(gens[g], n, 0.95, D, E) != 0) {
+            fprintf(stderr, "Unknown generator %s (have: %s)\n", gens[g], TRIDIAG_GEN_NAMES);
+            continue;
+        }
+        const double tn = tridiag_norm1(n, D, E);
+        for (int k = 0; k < 3; ++k) {
+            /* DSTEDC first: its eigenvalues W0 are the reference for dW */
+            run_t r = (k == 0) ? run_stedc(n, D, E, W0, Z) : run_stemr(n, k == 1 ? n : nev, D, E, W, Z);
+            const double *Wk = (k == 0) ? W0 : W;
+            if (r.info != 0) {                  /* e.g. DSTEMR INFO=2X: DLARRV gave up on a cluster */
+                printf("%-10s %-9s FAILED, info=%d\n", gens[g], r.solver, r.info);
+                if (ft) fprintf(ft, "%-10s %-9s FAILED, info=%d\n", gens[g], r.solver, r.info);
+                continue;
+            }
+            r.orth  = orth_error(n, r.m, Z, n) / (n * eps);
+            r.resid = tridiag_residual(n, D, E, r.m, Wk, Z, n) / (tn * n * eps);
+            for (int i = 0; i < r.m; ++i) {
+                const double d = fabs(Wk[i] - W0[i]) / tn;
+                if (d > r.dw) r.dw = d;
+            }
+            const char *row = "%-10s %-9s %6d %9.4f %9.2e %9.2e %9.2e %10.1f\n";
+            printf(row, gens[g], r.solver, r.m, r.seconds, r.orth, r.resid, r.dw, r.bytes / 1048576.0);
+            if (ft) fprintf(ft, row, gens[g], r.solver, r.m, r.seconds, r.orth, r.resid, r.dw,
+                            r.bytes / 1048576.0);
+        }
+    }
+    if (ft) fclose(ft);
+
+    free(Z); free(W); free(W0); free(E); free(D);
+    return 0;
+}
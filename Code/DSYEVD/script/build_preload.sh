@@ -0,0 +1,41 @@
+#!/usr/bin/env bash
+# build_preload.sh — build the LAPACK/BLAS timers (common/src/wrap_syms.def) as
+# an LD_PRELOAD library (wrap_gen.c -DWRAP_PRELOAD) and optionally run a
+# program under it, unmodified.
+#   ./build_preload.sh                                   build only
+#   ./build_preload.sh python3 ../../DSYEV_DSYEVD/src/benchmark_dsyev_vs_dsyevd.py
+#   ./build_preload.sh ./some_dynamically_linked_binary args...
+# Env:
+#   WRAP_SYM_PREFIX / WRAP_SYM_SUFFIX  renamed symbols, e.g. SciPy wheels:
+#                                      WRAP_SYM_PREFIX=scipy_ (LP64) or
+#                                      WRAP_SYM_PREFIX=scipy_ WRAP_SYM_SUFFIX=64_ WRAP_ILP64=1
+#   WRAP_ILP64=1                       64-bit LAPACK integers
+#   WRAP_MEM=1, WRAP_MASK=..., WRAP_SHM=1  as in the --wrap build (see wrap_timers.h)
+#   WRAP_SIGNAL=1                      dump on SIGUSR1 (USR2: SIGUSR2; off by default)
+set -euo pipefail
+
+# ====== 1) Compiler setup ======
+CC="${CC:-gcc}"
+CFLAGS="-O2 -std=c11 -D_POSIX_C_SOURCE=199309L -fPIC -DWRAP_PRELOAD -I../../common/src"
+[ -n "${WRAP_SYM_PREFIX:-}" ] && CFLAGS="$CFLAGS -DWRAP_SYM_PREFIX=$WRAP_SYM_PREFIX"
+[ -n "${WRAP_SYM_SUFFIX:-}" ] && CFLAGS="$CFLAGS -DWRAP_SYM_SUFFIX=$WRAP_SYM_SUFFIX"
+[ "${WRAP_ILP64:-0}" = "1" ]  && CFLAGS="$CFLAGS -DOPENBLAS_USE64BITINT"
+
+# ====== 2) Sources ======
+SRC_DIR="../../common/src"
+SRCS=("$SRC_DIR/wrap_gen.c" "$SRC_DIR/wrap_timers.c")
+
+# ====== 3) Build ======
+OUT_DIR="../output"
+LIB_DIR="$OUT_DIR/lib"
+mkdir -p "$LIB_DIR"
+LIB="$LIB_DIR/libwrap_syevd${WRAP_SYM_PREFIX:+_$WRAP_SYM_PREFIX}${WRAP_SYM_SUFFIX:+$WRAP_SYM_SUFFIX}.so"
+echo "[BUILD] CC=$CC | SRC=${SRCS[*]} | CFLAGS=$CFLAGS"
+$CC $CFLAGS -shared "${SRCS[@]}" -o "$LIB" -ldl -pthread
+LIB="$(cd "$(dirname "$LIB")" && pwd)/$(basename "$LIB")"
+echo "[OK   ] $LIB"
+
+# ====== 4) Run (optional) ======
+[ $# -gt 0 ] || { echo "[INFO ] use: LD_PRELOAD=$LIB <program>"; exit 0; }
+echo "[RUN  ] LD_PRELOAD=$LIB $*"
+exec env LD_PRELOAD="$LIB${LD_PRELOAD:+:$LD_PRELOAD}" "$@"
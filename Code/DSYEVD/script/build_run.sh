@@ -12,10 +12,19 @@ TAG="${1:-}"
 CC_DEFAULT="${CC:-gcc}"
 CFLAGS_BASE="-O3 -std=c11 -D_POSIX_C_SOURCE=199309L \
   -mcpu=native -mtune=native \
-  -fno-math-errno -fno-trapping-math -ffp-contract=fast"
+  -fno-math-errno -fno-trapping-math -ffp-contract=fast \
+  -I../../common/src -DEIG_BACKEND=\"$TAG\""   # EIG_BACKEND: part of the eig_cache key
 LIBS_FORTRAN="-lgfortran"
 LIBS_MATH="-lm"
 
+# libnuma (mbind/move_pages) for NUMA_POLICY=interleave|local and placement
+# reports; WITH_NUMA=0 builds without it (all policies fall back to default)
+if [[ "${WITH_NUMA:-1}" == "1" ]]; then
+  CFLAGS_NUMA="-DHAVE_LIBNUMA"; LIBS_NUMA="-lnuma"
+else
+  CFLAGS_NUMA=""; LIBS_NUMA=""
+fi
+
 # macOS: try to use lld so that --wrap works
 UNAME_S="$(uname -s || true)"
 if [[ "${UNAME_S}" == "Darwin" ]]; then
@@ -31,8 +40,8 @@ CC="${CC_DEFAULT}"
 CFLAGS_NETLIB="$CFLAGS_BASE -I../../LAPACK/build/include"
 LDFLAGS_NETLIB="../../LAPACK/build/lib/liblapack.a ../../LAPACK/build/lib/libblas.a $LIBS_FORTRAN $LIBS_MATH"
 
-# OpenBLAS (static, ILP64 示例；若是 LP64 可去掉 -DOPENBLAS_USE64BITINT)
-CFLAGS_OB="$CFLAGS_BASE -DOPENBLAS_USE64BITINT -I../../openblas/openblas_install/include"
+# OpenBLAS（静态，LP64：openblas/build_*.sh 未设 INTERFACE64；ILP64 库需另加 -DOPENBLAS_USE64BITINT）
+CFLAGS_OB="$CFLAGS_BASE -I../../openblas/openblas_install/include"
 LDFLAGS_OB="../../openblas/openblas_install/lib/libopenblas.a $LIBS_FORTRAN $LIBS_MATH -lpthread -ldl"
 
 # ArmPL (static, 1 thread)
@@ -43,44 +52,44 @@ LDFLAGS_AP="$ARMPL_PREFIX/lib/libarmpl.a -lpthread -ldl $LIBS_FORTRAN $LIBS_MATH
 # ====== 3) Sources ======
 SRC_DIR="../src"
 SRC_MAIN="$SRC_DIR/syevd.c"
-SRC_WRAP_TIMERS="$SRC_DIR/wrap_timers.c"
-SRC_WRAP_TREE="$SRC_DIR/wrap_syevd.c"     # 你整合好的 wrapper 文件
+SRC_WRAP_TIMERS="../../common/src/wrap_timers.c"
+SRC_WRAP_TREE="../../common/src/wrap_gen.c"    # wrappers generated from wrap_syms.def
+SRC_NUMA="../../common/src/numa_alloc.c"
+SRC_MATIO="../../common/src/mat_io.c"
+SRC_MEM="../../common/src/mem_budget.c"
+SRC_CACHE="../../common/src/eig_cache.c"
+SRC_BAND="../../common/src/band_eig.c"     # BAND_ROUTE / (kd+1, n) .npy input: DSBEVD path
 
-# ====== 4) Symbols to --wrap (DSYEVD 全链路 + 回带 + 常见 BLAS) ======
-WRAP_SYMS=(
-  # top & tridiag/tri eigensolvers
-  dsyevd_ dsytrd_ dorgtr_ dsterf_
-  # STEDC + helpers
-  dstedc_ dsteqr_ dlamrg_ dlasrt_ dlacpy_
-  # D&C subtree
-  dlaed0_ dlaed1_ dlaed2_ dlaed3_ dlaed4_ dlaed5_ dlaed6_ dlaed7_ dlaed8_ dlaed9_ dlaeda_
-  # back-transform chain
-  dormtr_ dormql_ dormqr_ dlarft_ dlarfb_ dlarf_
-  # BLAS commonly used
-  dgemm_ dgemv_ dtrmm_ dtrmv_ dger_ dcopy_ dscal_ drot_
-  # if you call CBLAS directly
-  cblas_dgemm cblas_dgemv
-)
-WRAP_LDFLAGS=()
-for s in "${WRAP_SYMS[@]}"; do WRAP_LDFLAGS+=("-Wl,--wrap=${s}"); done
+# ====== 4) Symbols to --wrap: every WRAP_FN in common/src/wrap_syms.def ======
+# WRAP_TIMING=0 drops the wrappers (no --wrap, no per-call overhead);
+# WRAP_MASK=... narrows the timed set at run time (see wrap_timers.h).
+WRAP_DEF="../../common/src/wrap_syms.def"
+WRAP_SYMS=($(grep -o '^WRAP_FN([A-Za-z_0-9]*' "$WRAP_DEF" | sed 's/^WRAP_FN(//'))
+WRAP_LDFLAGS=(); CFLAGS_WRAP=""
+# -u X pulls X out of the static archive even when only the wrapper calls it.
+if [[ "${WRAP_TIMING:-1}" == "1" ]]; then
+  for s in "${WRAP_SYMS[@]}"; do WRAP_LDFLAGS+=("-Wl,--wrap=${s}" "-Wl,-u,${s}"); done
+else
+  CFLAGS_WRAP="-DWRAP_TIMING_DISABLE"   # stubs only, calls go straight to the library
+fi
 
 # ====== 5) Case selection ======
 case "$TAG" in
   # OpenBLAS + DSYEVD driver + per-subroutine timing wrappers
   syevd-profile-openblas)
-      SRCS=("$SRC_MAIN" "$SRC_WRAP_TIMERS" "$SRC_WRAP_TREE")
+      SRCS=("$SRC_MAIN" "$SRC_WRAP_TIMERS" "$SRC_WRAP_TREE" "$SRC_NUMA" "$SRC_MATIO" "$SRC_MEM" "$SRC_CACHE" "$SRC_BAND")
       CFLAGS="$CFLAGS_OB"
       LDFLAGS="$LDFLAGS_OB ${WRAP_LDFLAGS[*]}"
       ;;
   # 可选：Netlib
   syevd-profile-netlib)
-      SRCS=("$SRC_MAIN" "$SRC_WRAP_TIMERS" "$SRC_WRAP_TREE")
+      SRCS=("$SRC_MAIN" "$SRC_WRAP_TIMERS" "$SRC_WRAP_TREE" "$SRC_NUMA" "$SRC_MATIO" "$SRC_MEM" "$SRC_CACHE" "$SRC_BAND")
       CFLAGS="$CFLAGS_NETLIB"
       LDFLAGS="$LDFLAGS_NETLIB ${WRAP_LDFLAGS[*]}"
       ;;
   # 可选：ArmPL
   syevd-profile-armpl)
-      SRCS=("$SRC_MAIN" "$SRC_WRAP_TIMERS" "$SRC_WRAP_TREE")
+      SRCS=("$SRC_MAIN" "$SRC_WRAP_TIMERS" "$SRC_WRAP_TREE" "$SRC_NUMA" "$SRC_MATIO" "$SRC_MEM" "$SRC_CACHE" "$SRC_BAND")
       CFLAGS="$CFLAGS_AP"
       LDFLAGS="$LDFLAGS_AP ${WRAP_LDFLAGS[*]}"
       ;;
@@ -101,13 +110,13 @@ for f in "${SRCS[@]}"; do
   base="$(basename "$f" .c)"
   obj="$OBJ_DIR/${base}.o"
   echo "[BUILD] CC=$CC | SRC=$f"
-  $CC $CFLAGS -c "$f" -o "$obj"
+  $CC $CFLAGS $CFLAGS_WRAP $CFLAGS_NUMA -c "$f" -o "$obj"
   OBJS+=("$obj")
 done
 
 BIN="$BIN_DIR/$TAG"
 echo "[LINK ] ${OBJS[*]} -> $BIN"
-$CC "${OBJS[@]}" $LDFLAGS -o "$BIN"
+$CC "${OBJS[@]}" $LDFLAGS $LIBS_NUMA -lpthread -o "$BIN"
 
 echo "[RUN  ] EXE=$BIN"
 echo "[INFO ] OMP_NUM_THREADS=$OMP_NUM_THREADS OPENBLAS_NUM_THREADS=$OPENBLAS_NUM_THREADS ARMPL_NUM_THREADS=$ARMPL_NUM_THREADS"
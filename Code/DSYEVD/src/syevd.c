@@ -1,5 +1,19 @@
 // syevd.c — Build a KMS SPD matrix A, then call DSYEVD to get
 // eigenvalues (+ eigenvectors if JOBZ='V'). Column-major, vendor-agnostic.
+// MEM_BUDGET=<size> falls back to DSYEVR / DSYEV when the D&C workspace
+// would not fit (see common/src/mem_budget.h).
+// With EIG_CACHE=1, results are cached per (input, routine, JOBZ) in
+// common/src/eig_cache.h; a repeated run loads W (+ eigenvectors) instead of
+// calling the solver and says so in a banner above the timings.
+// MEM_PREFAULT=touch|populate [MEM_LOCK=1] faults (and locks) every buffer in
+// before the clock starts; page faults and context switches are reported per
+// stage (load / alloc / solve) either way.
+// BAND_ROUTE=auto measures the numerical bandwidth (BAND_TOL) and sends
+// banded inputs to DSBEVD instead (common/src/band_eig.h); BAND_ROUTE=<kd>
+// forces that path and warns when the entries it drops exceed BAND_TOL.
+// A (kd+1, n) .npy as MATRIX_INPUT is LAPACK band storage: it is read
+// straight into AB for DSBEVD, with no n x n copy of A (JOBZ='N').
+// Double only; SSYEVD / ZHEEVD runs are PRECISION/src/prec_run.c.
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -8,12 +22,31 @@
 #include <sys/stat.h>
 #include <math.h>
 
-/* --------- Fortran LAPACK symbol (vendor-agnostic) --------- */
+#include "numa_alloc.h"   /* ../../common/src: NUMA_POLICY=..., MEM_PREFAULT=..., MEM_LOCK=1  */
+#include "mat_io.h"       /* ../../common/src: MATRIX_INPUT=<.mtx|.npy|raw> instead of KMS   */
+#include "mem_budget.h"   /* ../../common/src: MEM_BUDGET=<size>, RSS accounting             */
+#include "eig_cache.h"    /* ../../common/src: EIG_CACHE / EIG_CACHE_DIR / EIG_CACHE_VECTORS */
+#include "band_eig.h"     /* ../../common/src: BAND_ROUTE / BAND_TOL / BAND_RATIO, DSBEVD    */
+
+#ifndef EIG_BACKEND
+#define EIG_BACKEND "unknown"     /* build_run.sh passes the case name */
+#endif
+
+/* --------- Fortran LAPACK symbols (vendor-agnostic) --------- */
 extern void dsyevd_(const char *JOBZ, const char *UPLO, const int *N,
                     double *A, const int *LDA, double *W,
                     double *WORK, const int *LWORK,
                     int *IWORK, const int *LIWORK,
                     int *INFO);
+extern void dsyevr_(const char *JOBZ, const char *RANGE, const char *UPLO, const int *N,
+                    double *A, const int *LDA, const double *VL, const double *VU,
+                    const int *IL, const int *IU, const double *ABSTOL,
+                    int *M, double *W, double *Z, const int *LDZ, int *ISUPPZ,
+                    double *WORK, const int *LWORK, int *IWORK, const int *LIWORK,
+                    int *INFO);
+extern void dsyev_(const char *JOBZ, const char *UPLO, const int *N,
+                   double *A, const int *LDA, double *W,
+                   double *WORK, const int *LWORK, int *INFO);
 
 /* (Optional, works when linking OpenBLAS; harmless if you remove) */
 extern char* openblas_get_config(void);
@@ -59,9 +92,8 @@ static void fill_kms(double *A, int n, double rho, double delta)
 int main(void)
 {
     /* ---- Config ---- */
-    const int   n     = 4000;   // matrix size
-    const int   lda   = n;
-    const char  uplo  = 'U';    // keep 'U' consistently
+    int         n     = 4000;   // matrix size (taken from the file when MATRIX_INPUT is set)
+    char        uplo  = 'U';    // keep 'U' consistently (flipped for C-order .npy mappings)
     const char  jobz  = 'N';    // 'V' for eigenvectors, 'N' for values only
     const double rho   = 0.95;  // KMS difficulty: 0.8 easy ... 0.98 harder
     const double delta = 0.0;   // small positive shift if desired
@@ -77,45 +109,197 @@ int main(void)
     else
         printf("Mode: DSYEVD (Eigenvalues + eigenvectors, JOBZ='V')\n");
 
-    /* ---- Allocate ---- */
-    double *A = (double*)malloc((size_t)n * (size_t)lda * sizeof(double)); // input & (on exit) eigenvectors
+    const mem_policy_t mpol = mem_policy_from_env();
+    printf("NUMA policy: %s\n", mem_policy_name(mpol));
+
+    /* ---- Input: file (MATRIX_INPUT) or synthetic KMS ---- */
+    const char *input = getenv("MATRIX_INPUT");
+    const char *no_mmap = getenv("MATRIX_MMAP");           // MATRIX_MMAP=0 forces a copy
+    mat_header_t hdr;
+    mat_mapping_t map = {0};
+    struct timespec tl0, tl1;
+    mem_usage_t u_load0, u_load1, u_ws, u_solve0, u_solve1;   // page faults / context switches per stage
+    clock_gettime(CLOCK_MONOTONIC, &tl0);
+    mem_usage_now(&u_load0);
+    if (input && mat_probe(input, &hdr) != 0) { fprintf(stderr, "Cannot read %s\n", input); return 1; }
+    if (input) n = hdr.n;
+    const int lda = n;
+    const int band_in = input && hdr.band_rows > 0;                      // band-storage file: AB, no dense A
+
+    /* ---- Memory plan: LWORK/LIWORK per method, fall back when D&C would not fit ---- */
+    const size_t budget = mem_budget_from_env();
+    eig_footprint_t fp[EIG_METHOD_OOC];
+    eig_method_t method = band_in ? EIG_METHOD_DC : eig_plan_for_budget(jobz, uplo, n, budget, fp, stdout);
+    if (method == EIG_METHOD_OOC) {
+        fprintf(stderr, "No in-core method fits (MEM_BUDGET, or LWORK > INT_MAX); "
+                        "use ../../OOC/script/build_run.sh ooc-openblas %d %c\n", n, jobz);
+        return 3;
+    }
+    const char *routine = eig_method_routine(method);
+    int kd = band_in ? hdr.band_rows - 1 : -1;                             // >= 0: band path
+
+    /* ---- Allocate (a zero-copy file mapping replaces A when the layout allows) ---- */
+    const size_t bytes_A = (band_in && jobz == 'N') ? sizeof(double)      // band input: A only holds eigenvectors
+                                                    : (size_t)n * (size_t)lda * sizeof(double);
+    const size_t bytes_AB = band_in ? (size_t)(kd + 1) * (size_t)n * sizeof(double) : 0;
+    double *A = NULL;                                                      // input & (on exit) eigenvectors
+    double *AB = band_in ? (double*)mem_alloc(bytes_AB, mpol, 0) : NULL;   // band-storage input
+    if (input && !(no_mmap && no_mmap[0] == '0') && mat_can_map(&hdr, lda) && mat_map(input, &hdr, &map) == 0) {
+        A = map.a;
+        uplo = mat_uplo(&map, uplo);
+    } else {
+        A = (double*)mem_alloc(bytes_A, mpol, 0);
+    }
     double *W = (double*)malloc((size_t)n * sizeof(double));               // eigenvalues
-    if (!A || !W) {
+    if (!A || !W || (band_in && !AB)) {
         fprintf(stderr, "Allocation failed.\n");
-        free(W); free(A);
+        free(W); mem_free(AB, bytes_AB); if (map.base) mat_unmap(&map); else mem_free(A, bytes_A);
         return 1;
     }
 
-    /* ---- Build dense SPD KMS A ---- */
-    fill_kms(A, n, rho, delta);
+    /* ---- Fill A (or AB): read the file, or build dense SPD KMS A ---- */
+    if (input && !map.base && (band_in ? mat_read_band(input, &hdr, AB, kd + 1) : mat_read(input, &hdr, A, lda)) != 0) {
+        fprintf(stderr, "Failed to load %s\n", input);
+        goto CLEANUP_ERR;
+    }
 
-    /* ---- Workspace query ---- */
-    int info = 0;
-    int lwork = -1, liwork = -1, iwkopt = 0;
-    double wkopt = 0.0;
+    /* ---- Band route: KMS bandwidth in closed form, files measured on A (O(n^2));
+       a forced KD reports the Frobenius mass it drops. Band-storage input keeps its KD ---- */
+    const double btol = band_tol_from_env();
+    if (!band_in && band_route_auto()) {
+        kd = input ? band_width(n, A, lda, uplo, btol) : band_width_kms(n, rho, delta, btol);
+        printf("Band: numerical half-bandwidth %d of %d (BAND_TOL=%.1e)\n", kd, n - 1, btol);
+    }
+    if (!band_in) kd = band_route(n, kd);
+    else if (band_route_forced() >= 0) printf("Band: BAND_ROUTE ignored, band-storage input has KD=%d\n", kd);
+    if (!band_in && kd >= 0 && band_route_forced() >= 0)
+        band_report_dropped(stdout, kd, input ? band_dropped(n, A, lda, uplo, kd)
+                                              : band_dropped_kms(n, rho, delta, kd), btol);
+    if (kd >= 0) {
+        method = EIG_METHOD_DC;            // no DSYEVR buffers; the band path sizes its own workspace
+        routine = "DSBEVD";
+        printf("Band: routing to DSBEVD with KD=%d\n", kd);
+    }
 
-    dsyevd_(&jobz, &uplo, &n, A, &lda, W, &wkopt, &lwork, &iwkopt, &liwork, &info);
-    if (info != 0) { fprintf(stderr, "DSYEVD workspace query failed, info=%d\n", info); goto CLEANUP_ERR; }
+    /* ---- Cache lookup: KMS keyed by its parameters (filled only on a miss), files by content ---- */
+    const int use_cache = eig_cache_enabled();
+    int hit = 0;
+    uint64_t key = 0;
+    if (use_cache) {
+        const uint64_t key_in = band_in ? eig_cache_key_band(n, kd, AB, kd + 1, uplo, EIG_BACKEND)
+                              : input   ? eig_cache_key_matrix(n, A, lda, uplo, EIG_BACKEND)
+                                        : eig_cache_key_kms(n, uplo, rho, delta, EIG_BACKEND);
+        key = eig_cache_key_stage(kd >= 0 && !band_in ? eig_cache_hash(key_in, &kd, sizeof(kd)) : key_in, routine, jobz);
+        eig_cache_field_t f[2] = { { "W", W, (size_t)n, 0 }, { "V", jobz == 'V' ? A : NULL, (size_t)n * lda, 0 } };
+        const int rc = eig_cache_load(routine, key, f, 2);
+        hit = rc >= 0 && f[0].found && (jobz == 'N' || f[1].found);
+        if (input && !band_in && (rc == -2 || (!hit && f[1].found))) {   /* A was overwritten: load it again */
+            if (map.base) { mat_unmap(&map); A = (mat_map(input, &hdr, &map) == 0) ? map.a : NULL; }
+            if (!A || (!map.base && mat_read(input, &hdr, A, lda) != 0)) {
+                fprintf(stderr, "Failed to load %s\n", input);
+                goto CLEANUP_ERR;
+            }
+        }
+        printf("Cache: %s %s (key %016llx)\n", eig_cache_dir(), hit ? "hit" : "miss", (unsigned long long)key);
+    }
+    if (!input && !hit) fill_kms(A, n, rho, delta);
+    clock_gettime(CLOCK_MONOTONIC, &tl1);
+    double time_load = elapsed_seconds(tl0, tl1);
+    mem_usage_now(&u_load1);
+    if (band_in)
+        printf("Input: %s (%s band storage, n=%d, KD=%d, copied into AB) loaded in %.3f s\n",
+               input, mat_format_name(hdr.format), n, kd, time_load);
+    else if (input)
+        printf("Input: %s (%s, n=%d, %s) loaded in %.3f s\n", input, mat_format_name(hdr.format), n,
+               map.base ? (map.transposed ? "mmap, C order -> UPLO flipped" : "mmap") : "copied", time_load);
 
-    lwork  = (int)wkopt;   if (lwork  < 1) lwork  = 1;
-    liwork = iwkopt;       if (liwork < 1) liwork = 1;
+    /* ---- Workspace (sizes from the plan's LAPACK query) ---- */
+    int info = 0;
+    int lwork  = kd >= 0 ? 1 : fp[method].lwork;
+    int liwork = (kd < 0 && fp[method].liwork > 0) ? fp[method].liwork : 1;
+    band_eig_times_t bt = {0};
 
-    double *WORK = (double*)malloc((size_t)lwork  * sizeof(double));
-    int    *IWORK= (int*)   malloc((size_t)liwork * sizeof(int));
-    if (!WORK || !IWORK) { fprintf(stderr, "Allocation failed (WORK/IWORK)\n"); free(IWORK); free(WORK); goto CLEANUP_ERR; }
+    const size_t bytes_W  = (size_t)lwork  * sizeof(double);
+    const size_t bytes_IW = (size_t)liwork * sizeof(int);
+    const size_t bytes_Z  = (method == EIG_METHOD_MRRR && jobz == 'V') ? bytes_A : sizeof(double);
+    double *WORK = (double*)mem_alloc(bytes_W,  mpol, 0);
+    int    *IWORK= (int*)   mem_alloc(bytes_IW, mpol, 0);
+    double *Z    = (method == EIG_METHOD_MRRR) ? (double*)mem_alloc(bytes_Z, mpol, 0) : NULL;  // DSYEVR output
+    int    *ISUPPZ = (method == EIG_METHOD_MRRR) ? (int*)malloc(2 * (size_t)n * sizeof(int)) : NULL;
+    if (!WORK || !IWORK || (method == EIG_METHOD_MRRR && (!Z || !ISUPPZ))) {
+        fprintf(stderr, "Allocation failed (WORK/IWORK)\n");
+        free(ISUPPZ); mem_free(Z, bytes_Z); mem_free(IWORK, bytes_IW); mem_free(WORK, bytes_W);
+        goto CLEANUP_ERR;
+    }
 
-    /* ---- Call DSYEVD & time it ---- */
+    /* ---- Prefault / lock (MEM_PREFAULT, MEM_LOCK): no first-touch faults inside the timed solve.
+       mem_alloc'd buffers are done at allocation; W/ISUPPZ (malloc) and a file-mapped A here ---- */
+    const mem_prefault_t prefault = mem_prefault_from_env();
+    const int lock = mem_lock_from_env();
+    if (prefault != MEM_PREFAULT_OFF || lock) {
+        mem_prefault(W, (size_t)n * sizeof(double), lock);
+        if (ISUPPZ) mem_prefault(ISUPPZ, 2 * (size_t)n * sizeof(int), lock);
+        if (map.base) mem_prefault(A, bytes_A, lock);
+    }
+    mem_usage_now(&u_ws);
+
+    /* ---- Call the selected solver & time it (RSS high-water mark restarted) ---- */
+    mem_reset_peak();
+    const long rss_before = mem_rss_kb();
     struct timespec t0, t1;
+    mem_usage_now(&u_solve0);
     clock_gettime(CLOCK_MONOTONIC, &t0);
-    dsyevd_(&jobz, &uplo, &n, A, &lda, W, WORK, &lwork, IWORK, &liwork, &info);
+    if (hit) {
+        /* W (and V into A) came from the cache */
+    } else if (band_in) {
+        info = band_eig_solve_ab(jobz, uplo, n, kd, AB, kd + 1, W, A, jobz == 'V' ? lda : 1, &bt);
+    } else if (kd >= 0) {
+        info = band_eig_solve(jobz, uplo, n, kd, A, lda, W, &bt);   // packs A, eigenvectors back into A
+    } else if (method == EIG_METHOD_DC) {
+        dsyevd_(&jobz, &uplo, &n, A, &lda, W, WORK, &lwork, IWORK, &liwork, &info);
+    } else if (method == EIG_METHOD_MRRR) {
+        const char range = 'A';
+        const double vl = 0.0, vu = 0.0, abstol = 0.0;
+        const int il = 1, iu = n, ldz = (jobz == 'V') ? n : 1;
+        int mfound = 0;
+        dsyevr_(&jobz, &range, &uplo, &n, A, &lda, &vl, &vu, &il, &iu, &abstol,
+                &mfound, W, Z, &ldz, ISUPPZ, WORK, &lwork, IWORK, &liwork, &info);
+    } else {
+        dsyev_(&jobz, &uplo, &n, A, &lda, W, WORK, &lwork, &info);
+    }
     clock_gettime(CLOCK_MONOTONIC, &t1);
-    if (info != 0) { fprintf(stderr, "DSYEVD failed, info=%d\n", info); free(IWORK); free(WORK); goto CLEANUP_ERR; }
+    mem_usage_now(&u_solve1);
+    const long rss_peak = mem_peak_rss_kb();
+    if (info != 0) {
+        fprintf(stderr, "%s failed, info=%d\n", routine, info);
+        free(ISUPPZ); mem_free(Z, bytes_Z); mem_free(IWORK, bytes_IW); mem_free(WORK, bytes_W);
+        goto CLEANUP_ERR;
+    }
     double time_syevd = elapsed_seconds(t0, t1);
+    const double *V = (method == EIG_METHOD_MRRR && !hit) ? Z : A;   // eigenvectors (JOBZ='V')
+    if (use_cache && !hit) {
+        const eig_cache_field_t f[2] = { { "W", W, (size_t)n, 0 },
+                                         { "V", (jobz == 'V' && eig_cache_vectors()) ? (double*)V : NULL, (size_t)n * lda, 0 } };
+        eig_cache_store(routine, key, f, 2);
+    }
 
-    free(IWORK); free(WORK);
-
-    /* ---- Report timings ---- */
-    printf("DSYEVD took %.3f s\n", time_syevd);
+    /* ---- Report timings, memory + where the pages actually ended up ---- */
+    if (hit) eig_cache_banner(stdout, routine);
+    printf("LOAD   took %.3f s\n", time_load);
+    printf("%-6s took %.3f s%s\n", routine, time_syevd, hit ? " (cached)" : "");
+    if (kd >= 0 && !hit)
+        printf("Band: KD=%d pack %.3f s + DSBEVD %.3f s, LWORK=%d LIWORK=%d (%.1f MB with AB)\n",
+               kd, bt.pack, bt.solve, bt.lwork, bt.liwork, bt.bytes / 1048576.0);
+    printf("Memory: LWORK=%d (%.1f MB) LIWORK=%d (%.1f MB) peak RSS %.1f MB (+%.1f MB during solve)\n",
+           lwork, bytes_W / 1048576.0, liwork, bytes_IW / 1048576.0,
+           rss_peak / 1024.0, (rss_peak - rss_before) / 1024.0);
+    printf("Prefault: %s%s\n", mem_prefault_name(prefault), lock ? " + mlock" : "");
+    mem_usage_report(stdout, "load",  &u_load0,  &u_load1);
+    mem_usage_report(stdout, "alloc", &u_load1,  &u_ws);
+    mem_usage_report(stdout, "solve", &u_solve0, &u_solve1);
+    mem_report_placement(stdout, "A",     A,     bytes_A);
+    mem_report_placement(stdout, "WORK",  WORK,  bytes_W);
+    mem_report_placement(stdout, "IWORK", IWORK, bytes_IW);
 
     /* ---- Write outputs (same pattern as before) ---- */
     const char *outdir = "../output";
@@ -128,10 +312,27 @@ int main(void)
 
     FILE *ft = fopen(path_time, "w");
     if (ft) {
-        fprintf(ft, "Mode: DSYEVD (JOBZ='%c', UPLO='%c')\n", jobz, uplo);
-        fprintf(ft, "DSYEVD %.6f s\n", time_syevd);
+        if (hit) eig_cache_banner(ft, routine);
+        fprintf(ft, "Mode: %s (JOBZ='%c', UPLO='%c')\n", routine, jobz, uplo);
+        fprintf(ft, "LOAD   %.6f s (%s)\n", time_load, input ? input : "KMS");
+        fprintf(ft, "%-6s %.6f s%s\n", routine, time_syevd, hit ? " (cached)" : "");
+        if (kd >= 0)
+            fprintf(ft, "BAND   KD=%d pack %.6f s DSBEVD %.6f s LWORK %d LIWORK %d (%zu bytes)\n",
+                    kd, bt.pack, bt.solve, bt.lwork, bt.liwork, bt.bytes);
+        fprintf(ft, "MEM_BUDGET %zu bytes (0 = unlimited), method %s\n", budget, eig_method_name(method));
+        fprintf(ft, "LWORK  %d (%zu bytes)\nLIWORK %d (%zu bytes)\n", lwork, bytes_W, liwork, bytes_IW);
+        fprintf(ft, "RSS    peak %ld KiB, +%ld KiB during solve\n", rss_peak, rss_peak - rss_before);
+        fprintf(ft, "Prefault: %s%s\n", mem_prefault_name(prefault), lock ? " + mlock" : "");
+        mem_usage_report(ft, "load",  &u_load0,  &u_load1);
+        mem_usage_report(ft, "alloc", &u_load1,  &u_ws);
+        mem_usage_report(ft, "solve", &u_solve0, &u_solve1);
+        fprintf(ft, "NUMA policy: %s\n", mem_policy_name(mpol));
+        mem_report_placement(ft, "A",     A,     bytes_A);
+        mem_report_placement(ft, "WORK",  WORK,  bytes_W);
+        mem_report_placement(ft, "IWORK", IWORK, bytes_IW);
         fclose(ft);
     }
+    mem_free(IWORK, bytes_IW); mem_free(WORK, bytes_W); free(ISUPPZ);
 
     FILE *fw = fopen(path_w, "w");
     if (fw) {
@@ -139,23 +340,24 @@ int main(void)
         fclose(fw);
     }
 
-    /* On exit, A contains eigenvectors in columns (if JOBZ='V') */
+    /* On exit, V (A, or Z for DSYEVR) contains eigenvectors in columns (if JOBZ='V') */
     if (jobz == 'V') {
         FILE *fv = fopen(path_v, "w");
         if (fv) {
             for (int j = 0; j < n; ++j) {
                 for (int i = 0; i < n; ++i) {
-                    fprintf(fv, "%.6e%c", A[i + (size_t)j * n], (i == n-1) ? '\n' : ' ');
+                    fprintf(fv, "%.6e%c", V[i + (size_t)j * n], (i == n-1) ? '\n' : ' ');
                 }
             }
             fclose(fv);
         }
     }
 
-    free(W); free(A);
+    mem_free(Z, bytes_Z);
+    free(W); mem_free(AB, bytes_AB); if (map.base) mat_unmap(&map); else mem_free(A, bytes_A);
     return 0;
 
 CLEANUP_ERR:
-    free(W); free(A);
+    free(W); mem_free(AB, bytes_AB); if (map.base) mat_unmap(&map); else mem_free(A, bytes_A);
     return 2;
 }
@@ -47,6 +47,7 @@ LDFLAGS_AP="$ARMPL_PREFIX/lib/libarmpl.a -lpthread -ldl $LIBS_FORTRAN $LIBS_MATH
 
 
 # ====== 3. Case Selection ======
+EXTRA_SRCS=()
 case "$TAG" in
 
   dsyev-lapack)
@@ -57,7 +58,8 @@ case "$TAG" in
 
   dsyev_dsyevd_compare-openblas)
       SRC="../src/dsyev_dsyevd_compare.c"
-      CFLAGS="$CFLAGS_OB"
+      EXTRA_SRCS=("../../common/src/mem_budget.c")   # mem_peak_rss_kb / mem_reset_peak
+      CFLAGS="$CFLAGS_OB -I../../common/src"
       LDFLAGS="$LDFLAGS_OB"
       ;;
 
@@ -104,9 +106,16 @@ BIN="$BIN_DIR/$TAG"
 
 echo "[BUILD] CC=$CC | SRC=$SRC | CFLAGS=$CFLAGS"
 $CC $CFLAGS -c "$SRC" -o "$OBJ"
-
-echo "[LINK ] $OBJ -> $BIN"
-$CC "$OBJ" $LDFLAGS -o "$BIN"
+OBJS=("$OBJ")
+for f in "${EXTRA_SRCS[@]}"; do
+  obj="$OBJ_DIR/$(basename "$f" .c).o"
+  echo "[BUILD] CC=$CC | SRC=$f"
+  $CC $CFLAGS -c "$f" -o "$obj"
+  OBJS+=("$obj")
+done
+
+echo "[LINK ] ${OBJS[*]} -> $BIN"
+$CC "${OBJS[@]}" $LDFLAGS -o "$BIN"
 
 echo "[RUN  ] LIB=$TAG | EXE=$BIN"
 echo "[INFO ] OMP_NUM_THREADS=$OMP_NUM_THREADS OPENBLAS_NUM_THREADS=$OPENBLAS_NUM_THREADS ARMPL_NUM_THREADS=$ARMPL_NUM_THREADS"
@@ -15,6 +15,8 @@
   #define MKDIR(path) mkdir(path, 0777)
 #endif
 
+#include "mem_budget.h"   /* ../../common/src: peak RSS (VmHWM) and its reset */
+
 /* Fortran LAPACK prototypes */
 extern void dsyev_(const char *JOBZ, const char *UPLO, const int *N,
                    double *A, const int *LDA,
@@ -102,7 +104,7 @@ int main(void) {
 
     ensure_output_dir();
 
-    if (jobz == 'N') {
+    if (JOBZ == 'N') {
         printf("Mode: Eigenvalues only (JOBZ = 'N')\n");
     } else {
         printf("Mode: Eigenvalues and Eigenvectors (JOBZ = 'V')\n");
@@ -141,9 +143,11 @@ int main(void) {
     double *work1 = (double*)malloc((size_t)lwork * sizeof(double));
     if (!work1) { fprintf(stderr, "Alloc work1 failed\n"); return 2; }
 
+    mem_reset_peak();   /* each routine gets its own peak */
     double t0 = now_seconds();
     dsyev_(&JOBZ, &UPLO, &N, A1, &LDA, W1, work1, &lwork, &info);
     double t1 = now_seconds();
+    long peak_dsyev = mem_peak_rss_kb();
 
     if (info != 0) {
         fprintf(stderr, "DSYEV failed: INFO=%d\n", info);
@@ -179,9 +183,11 @@ int main(void) {
         return 3;
     }
 
+    mem_reset_peak();   /* each routine gets its own peak */
     t0 = now_seconds();
     dsyevd_(&JOBZ, &UPLO, &N, A2, &LDA, W2, work2, &lwork2, iwork2, &liwork2, &info);
     t1 = now_seconds();
+    long peak_dsyevd = mem_peak_rss_kb();
 
     if (info != 0) {
         fprintf(stderr, "DSYEVD failed: INFO=%d\n", info);
@@ -196,6 +202,12 @@ int main(void) {
     /* -------- report (stdout not timed) -------- */
     printf("[DSYEV ] n=%d time=%.6f s\n", N, time_dsyev);
     printf("[DSYEVD] n=%d time=%.6f s\n", N, time_dsyevd);
+    /* workspace requested by each routine + resident peak while it ran
+       (A0/A1/A2 are all live, so the peaks include 3 n^2 doubles) */
+    printf("[DSYEV ] LWORK=%d (%.1f MB) peak RSS=%.1f MB\n",
+           lwork, lwork * 8.0 / 1048576.0, peak_dsyev / 1024.0);
+    printf("[DSYEVD] LWORK=%d (%.1f MB) LIWORK=%d (%.1f MB) peak RSS=%.1f MB\n",
+           lwork2, lwork2 * 8.0 / 1048576.0, liwork2, liwork2 * 4.0 / 1048576.0, peak_dsyevd / 1024.0);
     fflush(stdout);
 
     /* -------- persist outputs (not timed) -------- */
@@ -212,6 +224,8 @@ int main(void) {
     if (tf) {
         fprintf(tf, "DSYEV  %.9f\n",  time_dsyev);
         fprintf(tf, "DSYEVD %.9f\n",  time_dsyevd);
+        fprintf(tf, "DSYEV  LWORK=%d peak_rss_kb=%ld\n", lwork, peak_dsyev);
+        fprintf(tf, "DSYEVD LWORK=%d LIWORK=%d peak_rss_kb=%ld\n", lwork2, liwork2, peak_dsyevd);
         fclose(tf);
     } else {
         perror("fopen ../output/timings.txt");
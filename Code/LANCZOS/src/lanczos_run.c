@@ -0,0 +1,191 @@
+// lanczos_run.c — top-k eigenpairs of the KMS matrix without forming it:
+// the symmetric Toeplitz operator of common/src/struct_op.h (FFT circulant
+// embedding, O(n log n) per product, O(n) memory) under the thick-restart
+// Lanczos of common/src/lanczos.h.
+//
+// Usage: lanczos_run [n] [k] [ncv]
+//   n default 1000000, k default 10, ncv default max(3k, k+60).
+// Env:
+//   LANCZOS_WHICH  LA (largest, default) | SA (smallest). The bottom of the
+//                  KMS spectrum is a cluster at (1-rho)/(1+rho) with gaps
+//                  ~1/n^2 of ||A||; Lanczos needs a shift-invert operator
+//                  there and stalls at maxit without one.
+//   LANCZOS_TOL    residual tolerance relative to ||A|| (default 1e-10)
+//   LANCZOS_MAXIT  restarts (default 500)
+//   LANCZOS_CHECK  1: also run DSYEVR RANGE='I' on the dense KMS matrix and
+//                  report max |lambda - lambda_dense| / ||A||; default on
+//                  for n <= 4000, off above (n^2 memory, n^3 time).
+// The check of every run: ||A v - lambda v|| / ||A|| through the operator
+// and max |V^T V - I|. Eigenvalues in ../output/lanczos_eigenvalues.txt,
+// timings in ../output/lanczos_time.txt.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <math.h>
+#include <sys/stat.h>
+
+#include "struct_op.h"  /* ../../common/src: FFT-embedded Toeplitz operator */
+#include "lanczos.h"    /* ../../common/src: thick-restart Lanczos           */
+
+#ifndef EIG_BACKEND
+#define EIG_BACKEND "unknown"     /* build_run.sh passes the case name */
+#endif
+
+extern void dsyevr_(const char *JOBZ, const char *RANGE, const char *UPLO, const int *N,
+                    double *A, const int *LDA, const double *VL, const double *VU,
+                    const int *IL, const int *IU, const double *ABSTOL, int *M, double *W,
+                    double *Z, const int *LDZ, int *ISUPPZ, double *WORK, const int *LWORK,
+                    int *IWORK, const int *LIWORK, int *INFO);
+
+/* --------- Utilities --------- */
+static void ensure_dir(const char *path) {
+    if (mkdir(path, 0777) != 0 && errno != EEXIST) {
+        perror("mkdir");
+        exit(5);
+    }
+}
+
+static double elapsed_seconds(struct timespec a, struct timespec b) {
+    return (b.tv_sec - a.tv_sec) + (b.tv_nsec - a.tv_nsec) / 1e9;
+}
+
+/* The k extremal eigenvalues of the dense KMS matrix (DSYEVR, values only),
+   ordered like lanczos_extremal's output. Returns INFO, -100 on allocation. */
+static int dense_reference(int n, double rho, int k, int which, double *Wref)
+{
+    const size_t nn = (size_t)n * (size_t)n;
+    double *A = (double*)malloc(nn * sizeof(double));
+    double *W = (double*)malloc((size_t)n * sizeof(double));
+    int *ISUPPZ = (int*)malloc(2 * (size_t)k * sizeof(int));
+    if (!A || !W || !ISUPPZ) { free(ISUPPZ); free(W); free(A); return -100; }
+    for (int j = 0; j < n; ++j)
+        for (int i = 0; i < n; ++i) A[i + (size_t)j * n] = pow(rho, abs(i - j));
+
+    const char jobz = 'N', range = 'I', uplo = 'U';
+    const double vl = 0.0, vu = 0.0, abstol = 0.0;
+    const int il = which > 0 ? n - k + 1 : 1, iu = which > 0 ? n : k, ldz = 1;
+    int m = 0, lwork = -1, liwork = -1, iwkopt = 0, info = 0;
+    double wkopt = 0.0, zq = 0.0;
+    dsyevr_(&jobz, &range, &uplo, &n, A, &n, &vl, &vu, &il, &iu, &abstol, &m, W, &zq, &ldz,
+            ISUPPZ, &wkopt, &lwork, &iwkopt, &liwork, &info);
+    lwork = (int)wkopt; liwork = iwkopt;
+    double *WORK = (double*)malloc((size_t)lwork * sizeof(double));
+    int *IWORK = (int*)malloc((size_t)liwork * sizeof(int));
+    if (!WORK || !IWORK) info = -100;
+    else dsyevr_(&jobz, &range, &uplo, &n, A, &n, &vl, &vu, &il, &iu, &abstol, &m, W, &zq, &ldz,
+                 ISUPPZ, WORK, &lwork, IWORK, &liwork, &info);
+    if (info == 0)
+        for (int i = 0; i < k; ++i) Wref[i] = which > 0 ? W[m - 1 - i] : W[i];
+    free(IWORK); free(WORK); free(ISUPPZ); free(W); free(A);
+    return info;
+}
+
+int main(int argc, char **argv)
+{
+    const int n   = (argc > 1) ? atoi(argv[1]) : 1000000;
+    const int k   = (argc > 2) ? atoi(argv[2]) : 10;
+    const int ncv = (argc > 3) ? atoi(argv[3]) : 0;
+    const char *wh_env  = getenv("LANCZOS_WHICH");
+    const char *tol_env = getenv("LANCZOS_TOL");
+    const char *it_env  = getenv("LANCZOS_MAXIT");
+    const char *chk_env = getenv("LANCZOS_CHECK");
+    const int which = (wh_env && (wh_env[0] == 'S' || wh_env[0] == 's')) ? -1 : 1;
+    const double tol = tol_env ? atof(tol_env) : 1e-10;
+    const int maxit = it_env ? atoi(it_env) : 500;
+    const int check = chk_env ? atoi(chk_env) != 0 : n <= 4000;
+    const double rho = 0.95, delta = 0.0;     // KMS as in the dense drivers
+    if (n < 3 || k < 1 || k > n - 2) { fprintf(stderr, "Need n >= 3 and 1 <= k <= n-2\n"); return 1; }
+
+    printf("Mode: matrix-free Lanczos, %d %s eigenpairs of KMS(rho=%.2f) | n=%d | backend %s\n",
+           k, which > 0 ? "largest" : "smallest", rho, n, EIG_BACKEND);
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    struct_op_t *op = toeplitz_op_kms(n, rho, delta);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (!op) { fprintf(stderr, "Toeplitz operator setup failed (n=%d)\n", n); return 1; }
+    const double time_setup = elapsed_seconds(t0, t1);
+
+    double *W = (double*)malloc((size_t)k * sizeof(double));
+    double *V = (double*)malloc((size_t)n * (size_t)k * sizeof(double));
+    double *r = (double*)malloc((size_t)n * sizeof(double));
+    if (!W || !V || !r) { fprintf(stderr, "Allocation failed.\n"); return 1; }
+
+    lanczos_stats_t st;
+    const int info = lanczos_extremal(op, k, which, ncv, tol, maxit, W, V, n, &st);
+    if (info < 0) { fprintf(stderr, "lanczos_extremal failed, info=%d\n", info); return 2; }
+    if (info > 0) printf("Warning: %d of %d pairs not converged after %d restarts\n", info, k, st.restarts);
+
+    /* ---- Check: operator residuals and orthogonality ---- */
+    const double anorm = op->norm_bound;
+    double res_max = 0.0, orth = 0.0;
+    double *res = (double*)malloc((size_t)k * sizeof(double));
+    for (int j = 0; j < k; ++j) {
+        const double *v = V + (size_t)j * n;
+        struct_op_apply(op, v, r);
+        double s = 0.0;
+        for (int i = 0; i < n; ++i) { const double d = r[i] - W[j] * v[i]; s += d * d; }
+        if (res) res[j] = sqrt(s) / anorm;
+        if (sqrt(s) / anorm > res_max) res_max = sqrt(s) / anorm;
+        for (int l = 0; l <= j; ++l) {
+            const double *u = V + (size_t)l * n;
+            double g = 0.0;
+            for (int i = 0; i < n; ++i) g += u[i] * v[i];
+            if (fabs(g - (l == j ? 1.0 : 0.0)) > orth) orth = fabs(g - (l == j ? 1.0 : 0.0));
+        }
+    }
+    double dw = -1.0;
+    if (check) {
+        double *Wref = (double*)malloc((size_t)k * sizeof(double));
+        const int ri = Wref ? dense_reference(n, rho, k, which, Wref) : -100;
+        if (ri != 0) fprintf(stderr, "DSYEVR reference failed, info=%d\n", ri);
+        else {
+            dw = 0.0;
+            for (int j = 0; j < k; ++j) if (fabs(W[j] - Wref[j]) / anorm > dw) dw = fabs(W[j] - Wref[j]) / anorm;
+        }
+        free(Wref);
+    }
+
+    /* ---- Report ---- */
+    const double mb = 1048576.0;
+    const double dense_mb = (double)n * (double)n * sizeof(double) / mb;
+    printf("Operator: %s, setup %.3f s, %.1f MB (dense A: %.1f MB), ||A|| <= %.6f\n",
+           op->kind, time_setup, op->bytes / mb, dense_mb, anorm);
+    printf("Lanczos:  %d matvecs, %d restarts, %.1f MB basis + work\n", st.matvecs, st.restarts, st.bytes / mb);
+    printf("Apply    took %.3f s (%.3f ms per product)\n", st.apply_seconds,
+           st.matvecs ? 1e3 * st.apply_seconds / st.matvecs : 0.0);
+    printf("Ortho    took %.3f s (Gram-Schmidt DGEMV + restart DGEMM)\n", st.ortho_seconds);
+    printf("Total    took %.3f s\n", time_setup + st.seconds);
+    printf("Check: max ||Av - lv||/||A|| = %.3e, max |V^T V - I| = %.3e", res_max, orth);
+    if (dw >= 0.0) printf(", max |l - l_DSYEVR|/||A|| = %.3e", dw);
+    printf("\n");
+    for (int j = 0; j < k && j < 10; ++j) printf("  l[%d] = %.15e\n", j, W[j]);
+
+    const char *outdir = "../output";
+    ensure_dir(outdir);
+    char path_time[256], path_w[256];
+    snprintf(path_time, sizeof(path_time), "%s/lanczos_time.txt", outdir);
+    snprintf(path_w,    sizeof(path_w),    "%s/lanczos_eigenvalues.txt", outdir);
+    FILE *ft = fopen(path_time, "w");
+    if (ft) {
+        fprintf(ft, "n=%d k=%d which=%s tol=%.1e backend=%s\n", n, k, which > 0 ? "LA" : "SA", tol, EIG_BACKEND);
+        fprintf(ft, "SETUP   %.6f s\nAPPLY   %.6f s (%d matvecs)\nORTHO   %.6f s (%d restarts)\nTOTAL   %.6f s\n",
+                time_setup, st.apply_seconds, st.matvecs, st.ortho_seconds, st.restarts, time_setup + st.seconds);
+        fprintf(ft, "MEMORY  operator %.1f MB, basis %.1f MB, dense %.1f MB\n", op->bytes / mb, st.bytes / mb, dense_mb);
+        fprintf(ft, "RESID   %.3e\nORTH    %.3e\n", res_max, orth);
+        if (dw >= 0.0) fprintf(ft, "DW      %.3e\n", dw);
+        fclose(ft);
+    }
+    FILE *fw = fopen(path_w, "w");
+    if (fw) {
+        for (int j = 0; j < k; ++j) fprintf(fw, "%.15e %.3e\n", W[j], res ? res[j] : 0.0);
+        fclose(fw);
+    }
+
+    free(res); free(r); free(V); free(W);
+    struct_op_free(op);
+    return 0;
+}
@@ -0,0 +1,97 @@
+#!/usr/bin/env bash
+# build_run.sh — build and run the distributed-memory (MPI) eigensolver.
+#   ./build_run.sh <case_name> [n] [nb]
+# All eigenpairs of the n x n KMS matrix in a 2-D block-cyclic layout over
+# RANKS processes (default 4, on localhost; MPI_GRID=PxQ picks the grid).
+# Native stages (common/src/dist_eig.h) unless SCALAPACK_LIBS names a
+# ScaLAPACK (+BLACS) to link, which switches to PDSYTRD/PDSTEDC/PDORMTR.
+# Stage timings per rank are printed by rank 0. The LAPACK/BLAS wrappers
+# are off by default (WRAP_TIMING=0): every rank would print its own
+# summary at exit, interleaved; WRAP_TIMING=1 turns them back on.
+set -euo pipefail
+
+export OMP_NUM_THREADS=${OMP_NUM_THREADS:-1}
+export OPENBLAS_NUM_THREADS=${OPENBLAS_NUM_THREADS:-1}
+export ARMPL_NUM_THREADS=${ARMPL_NUM_THREADS:-1}
+
+TAG="${1:-}"
+[ -n "$TAG" ] || { echo "Usage: $0 <case_name> [n] [nb]"; exit 1; }
+N="${2:-4000}"
+NB="${3:-64}"
+RANKS="${RANKS:-4}"
+
+# ====== 1) Compiler setup ======
+CC="${MPICC:-mpicc}"
+CFLAGS_BASE="-O3 -std=c11 -D_POSIX_C_SOURCE=199309L \
+  -mcpu=native -mtune=native \
+  -fno-math-errno -fno-trapping-math -ffp-contract=fast \
+  -I../../common/src -DEIG_BACKEND=\"$TAG\""
+LIBS_FORTRAN="-lgfortran"
+LIBS_MATH="-lm"
+
+# ====== 2) Library presets ======
+CFLAGS_NETLIB="$CFLAGS_BASE -I../../LAPACK/build/include"
+LDFLAGS_NETLIB="../../LAPACK/build/lib/liblapack.a ../../LAPACK/build/lib/libblas.a $LIBS_FORTRAN $LIBS_MATH"
+
+CFLAGS_OB="$CFLAGS_BASE -I../../openblas/openblas_install/include"
+LDFLAGS_OB="../../openblas/openblas_install/lib/libopenblas.a $LIBS_FORTRAN $LIBS_MATH -lpthread -ldl"
+
+ARMPL_PREFIX="../../armpl/arm-performance-libraries_25.07_rpm/armpl_local/armpl_25.07_gcc"
+CFLAGS_AP="$CFLAGS_BASE -I$ARMPL_PREFIX/include"
+LDFLAGS_AP="$ARMPL_PREFIX/lib/libarmpl.a -lpthread -ldl $LIBS_FORTRAN $LIBS_MATH"
+
+# ScaLAPACK goes before the LAPACK/BLAS it calls
+CFLAGS_SCA=""; LDFLAGS_SCA=""
+if [[ -n "${SCALAPACK_LIBS:-}" ]]; then
+  CFLAGS_SCA="-DHAVE_SCALAPACK"; LDFLAGS_SCA="$SCALAPACK_LIBS"
+fi
+
+# ====== 3) Sources ======
+SRCS=("../src/mpi_run.c" "../../common/src/dist_eig.c"
+      "../../common/src/wrap_timers.c" "../../common/src/wrap_gen.c")
+
+# ====== 4) Symbols to --wrap: every WRAP_FN in common/src/wrap_syms.def ======
+WRAP_DEF="../../common/src/wrap_syms.def"
+WRAP_SYMS=($(grep -o '^WRAP_FN([A-Za-z_0-9]*' "$WRAP_DEF" | sed 's/^WRAP_FN(//'))
+WRAP_LDFLAGS=(); CFLAGS_WRAP=""
+# -u X pulls X out of the static archive even when only the wrapper calls it.
+if [[ "${WRAP_TIMING:-0}" == "1" ]]; then
+  for s in "${WRAP_SYMS[@]}"; do WRAP_LDFLAGS+=("-Wl,--wrap=${s}" "-Wl,-u,${s}"); done
+else
+  CFLAGS_WRAP="-DWRAP_TIMING_DISABLE"
+fi
+
+# ====== 5) Case selection ======
+case "$TAG" in
+  mpi-openblas) CFLAGS="$CFLAGS_OB";     LDFLAGS="$LDFLAGS_SCA $LDFLAGS_OB ${WRAP_LDFLAGS[*]}" ;;
+  mpi-netlib)   CFLAGS="$CFLAGS_NETLIB"; LDFLAGS="$LDFLAGS_SCA $LDFLAGS_NETLIB ${WRAP_LDFLAGS[*]}" ;;
+  mpi-armpl)    CFLAGS="$CFLAGS_AP";     LDFLAGS="$LDFLAGS_SCA $LDFLAGS_AP ${WRAP_LDFLAGS[*]}" ;;
+  *)
+      echo "[X] Unknown TAG: $TAG"
+      echo "    Available: mpi-openblas | mpi-netlib | mpi-armpl"
+      exit 1;;
+esac
+
+# ====== 6) Output & Build ======
+OUT_DIR="../output"
+OBJ_DIR="$OUT_DIR/obj"
+BIN_DIR="$OUT_DIR/bin"
+mkdir -p "$OBJ_DIR" "$BIN_DIR"
+
+OBJS=()
+for f in "${SRCS[@]}"; do
+  base="$(basename "$f" .c)"
+  obj="$OBJ_DIR/${base}.o"
+  echo "[BUILD] CC=$CC | SRC=$f"
+  $CC $CFLAGS $CFLAGS_SCA $CFLAGS_WRAP -c "$f" -o "$obj"
+  OBJS+=("$obj")
+done
+
+BIN="$BIN_DIR/$TAG"
+echo "[LINK ] ${OBJS[*]} -> $BIN"
+$CC "${OBJS[@]}" $LDFLAGS -lpthread -o "$BIN"
+
+# --oversubscribe: localhost testing with more ranks than cores
+echo "[RUN  ] mpirun -np $RANKS $BIN $N $NB"
+echo "[INFO ] OMP_NUM_THREADS=$OMP_NUM_THREADS OPENBLAS_NUM_THREADS=$OPENBLAS_NUM_THREADS ARMPL_NUM_THREADS=$ARMPL_NUM_THREADS"
+exec mpirun ${MPIRUN_FLAGS:---oversubscribe} -np "$RANKS" "$BIN" "$N" "$NB"
@@ -0,0 +1,390 @@
+// mpi_run.c — all eigenpairs of the n x n KMS matrix across MPI ranks: A is
+// generated directly in the 2-D block-cyclic layout (no rank ever holds it
+// whole), reduced, solved and back-transformed distributed; per-rank stage
+// timings are gathered to rank 0 and printed in the wrapper summary format.
+//
+// Usage: mpirun -np P mpi_run [n] [nb]
+//   n default 4000, nb (block size) default 64.
+// Build: native stages of common/src/dist_eig.h by default; -DHAVE_SCALAPACK
+// (build_run.sh with SCALAPACK_LIBS set) runs PDSYTRD / PDSTEDC / PDORMTR
+// on the same layout instead (the stages of PDSYEVD, timed one by one).
+// Env:
+//   MPI_GRID     PxQ process grid (default: most square, P <= Q)
+//   MPI_CHECK    1: rank 0 also runs DSYEVD on the whole matrix and reports
+//                max |lambda - lambda_dense| / ||A||; default on for
+//                n <= 2000 (n^2 memory on rank 0)
+//   MPI_SAMPLES  eigenvectors gathered for ||A z - lambda z|| / ||A|| and
+//                their mutual orthogonality (default 8, spread evenly)
+// Outputs (rank 0): ../output/mpi_time.txt, ../output/mpi_eigenvalues.txt.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <math.h>
+#include <sys/stat.h>
+#include <mpi.h>
+
+#include "dist_eig.h"   /* ../../common/src: block-cyclic layout, native stages */
+
+#ifndef EIG_BACKEND
+#define EIG_BACKEND "unknown"     /* build_run.sh passes the case name */
+#endif
+
+extern void dsyevd_(const char *JOBZ, const char *UPLO, const int *N,
+                    double *A, const int *LDA, double *W,
+                    double *WORK, const int *LWORK,
+                    int *IWORK, const int *LIWORK,
+                    int *INFO);
+
+#ifdef HAVE_SCALAPACK
+extern void Cblacs_get(int icontxt, int what, int *val);
+extern void Cblacs_gridinit(int *icontxt, const char *order, int nprow, int npcol);
+extern void Cblacs_gridexit(int icontxt);
+extern void descinit_(int *DESC, const int *M, const int *N, const int *MB, const int *NB,
+                      const int *IRSRC, const int *ICSRC, const int *ICTXT, const int *LLD, int *INFO);
+extern void pdsytrd_(const char *UPLO, const int *N, double *A, const int *IA, const int *JA,
+                     const int *DESCA, double *D, double *E, double *TAU,
+                     double *WORK, const int *LWORK, int *INFO);
+extern void pdstedc_(const char *COMPZ, const int *N, double *D, double *E,
+                     double *Q, const int *IQ, const int *JQ, const int *DESCQ,
+                     double *WORK, const int *LWORK, int *IWORK, const int *LIWORK, int *INFO);
+extern void pdormtr_(const char *SIDE, const char *UPLO, const char *TRANS, const int *M, const int *N,
+                     const double *A, const int *IA, const int *JA, const int *DESCA, const double *TAU,
+                     double *C, const int *IC, const int *JC, const int *DESCC,
+                     double *WORK, const int *LWORK, int *INFO);
+#endif
+
+/* --------- Utilities --------- */
+static void ensure_dir(const char *path) {
+    if (mkdir(path, 0777) != 0 && errno != EEXIST) {
+        perror("mkdir");
+        exit(5);
+    }
+}
+
+static double kms(int i, int j, double rho) { return pow(rho, abs(i - j)); }
+
+#ifdef HAVE_SCALAPACK
+/* PDSYTRD, PDSTEDC, PDORMTR: the stages of PDSYEVD, with D and E summed to
+   every rank from the diagonal / subdiagonal PDSYTRD leaves in A. */
+static int scalapack_syevd(const dist_grid_t *g, dist_mat_t *A, double *W, dist_mat_t *Z,
+                           dist_eig_stats_t *st)
+{
+    memset(st, 0, sizeof(*st));
+    const int n = A->n, nb = A->nb, izero = 0, ione = 1;
+    int ctxt = 0, info = 0, descA[9], descZ[9];
+    Cblacs_get(-1, 0, &ctxt);
+    Cblacs_gridinit(&ctxt, "R", g->nprow, g->npcol);
+    descinit_(descA, &n, &n, &nb, &nb, &izero, &izero, &ctxt, &A->lld, &info);
+    descinit_(descZ, &n, &n, &nb, &nb, &izero, &izero, &ctxt, &Z->lld, &info);
+
+    double *Dl = (double*)malloc((size_t)(A->nloc + 1) * sizeof(double));
+    double *El = (double*)malloc((size_t)(A->nloc + 1) * sizeof(double));
+    double *tau = (double*)malloc((size_t)(A->nloc + 1) * sizeof(double));
+    double *E = (double*)calloc((size_t)n, sizeof(double));
+    double wq = 0.0;
+    int lwork = -1, liwork = -1, iwq = 0;
+    if (!Dl || !El || !tau || !E) info = -1;
+
+    double t0 = MPI_Wtime();
+    if (info == 0) {
+        pdsytrd_("L", &n, A->a, &ione, &ione, descA, Dl, El, tau, &wq, &lwork, &info);
+        lwork = (int)wq > 0 ? (int)wq : 1;
+        double *work = (double*)malloc((size_t)lwork * sizeof(double));
+        if (!work) info = -1;
+        else pdsytrd_("L", &n, A->a, &ione, &ione, descA, Dl, El, tau, work, &lwork, &info);
+        free(work);
+    }
+    st->t_reduce = MPI_Wtime() - t0;
+    st->n_reduce = 1;
+
+    t0 = MPI_Wtime();
+    if (info == 0) {
+        memset(W, 0, (size_t)n * sizeof(double));
+        for (int lj = 0; lj < A->nloc; ++lj) {
+            const int gj = dist_l2g(lj, nb, g->mycol, g->npcol);
+            for (int li = 0; li < A->mloc; ++li) {
+                const int gi = dist_l2g(li, nb, g->myrow, g->nprow);
+                if (gi == gj) W[gj] = A->a[li + (size_t)lj * A->lld];
+                else if (gi == gj + 1) E[gj] = A->a[li + (size_t)lj * A->lld];
+            }
+        }
+        const double tc = MPI_Wtime();
+        MPI_Allreduce(MPI_IN_PLACE, W, n, MPI_DOUBLE, MPI_SUM, g->comm);
+        MPI_Allreduce(MPI_IN_PLACE, E, n, MPI_DOUBLE, MPI_SUM, g->comm);
+        st->t_comm += MPI_Wtime() - tc;
+        st->n_comm += 2;
+        st->bytes_comm += 2.0 * n * sizeof(double);
+
+        lwork = -1; liwork = -1;
+        pdstedc_("I", &n, W, E, Z->a, &ione, &ione, descZ, &wq, &lwork, &iwq, &liwork, &info);
+        lwork = (int)wq > 0 ? (int)wq : 1;
+        liwork = iwq > 0 ? iwq : 1;
+        double *work = (double*)malloc((size_t)lwork * sizeof(double));
+        int *iwork = (int*)malloc((size_t)liwork * sizeof(int));
+        if (!work || !iwork) info = -1;
+        else pdstedc_("I", &n, W, E, Z->a, &ione, &ione, descZ, work, &lwork, iwork, &liwork, &info);
+        free(iwork); free(work);
+    }
+    st->t_tridiag = MPI_Wtime() - t0;
+    st->n_tridiag = 1;
+
+    t0 = MPI_Wtime();
+    if (info == 0) {
+        lwork = -1;
+        pdormtr_("L", "L", "N", &n, &n, A->a, &ione, &ione, descA, tau,
+                 Z->a, &ione, &ione, descZ, &wq, &lwork, &info);
+        lwork = (int)wq > 0 ? (int)wq : 1;
+        double *work = (double*)malloc((size_t)lwork * sizeof(double));
+        if (!work) info = -1;
+        else pdormtr_("L", "L", "N", &n, &n, A->a, &ione, &ione, descA, tau,
+                      Z->a, &ione, &ione, descZ, work, &lwork, &info);
+        free(work);
+    }
+    st->t_backtr = MPI_Wtime() - t0;
+    st->n_backtr = 1;
+
+    free(E); free(tau); free(El); free(Dl);
+    Cblacs_gridexit(ctxt);
+    MPI_Allreduce(MPI_IN_PLACE, &info, 1, MPI_INT, MPI_MAX, g->comm);
+    return info;
+}
+#endif
+
+/* Global column j of the distributed Z on every rank (x: n). */
+static void gather_column(const dist_grid_t *g, const dist_mat_t *Z, int j, double *x)
+{
+    memset(x, 0, (size_t)Z->n * sizeof(double));
+    if ((j / Z->nb) % g->npcol == g->mycol) {
+        const int lj = dist_g2l(j, Z->nb, g->npcol);
+        for (int li = 0; li < Z->mloc; ++li)
+            x[dist_l2g(li, Z->nb, g->myrow, g->nprow)] = Z->a[li + (size_t)lj * Z->lld];
+    }
+    MPI_Allreduce(MPI_IN_PLACE, x, Z->n, MPI_DOUBLE, MPI_SUM, g->comm);
+}
+
+/* y = A x for the KMS matrix, rows and columns generated per rank. */
+static void kms_apply(const dist_grid_t *g, const dist_mat_t *A, double rho, const double *x, double *y)
+{
+    memset(y, 0, (size_t)A->n * sizeof(double));
+    for (int li = 0; li < A->mloc; ++li) {
+        const int gi = dist_l2g(li, A->nb, g->myrow, g->nprow);
+        double s = 0.0;
+        for (int lj = 0; lj < A->nloc; ++lj) {
+            const int gj = dist_l2g(lj, A->nb, g->mycol, g->npcol);
+            s += kms(gi, gj, rho) * x[gj];
+        }
+        y[gi] = s;
+    }
+    MPI_Allreduce(MPI_IN_PLACE, y, A->n, MPI_DOUBLE, MPI_SUM, g->comm);
+}
+
+/* Rank 0: all eigenvalues of the whole matrix with DSYEVD. */
+static int dense_reference(int n, double rho, double *W)
+{
+    double *A = (double*)malloc((size_t)n * n * sizeof(double));
+    if (!A) return -100;
+    for (int j = 0; j < n; ++j)
+        for (int i = 0; i < n; ++i) A[i + (size_t)j * n] = kms(i, j, rho);
+    const char jobz = 'N', uplo = 'L';
+    int lwork = -1, liwork = -1, iwkopt = 0, info = 0;
+    double wkopt = 0.0;
+    dsyevd_(&jobz, &uplo, &n, A, &n, W, &wkopt, &lwork, &iwkopt, &liwork, &info);
+    lwork = (int)wkopt; liwork = iwkopt;
+    double *WORK = (double*)malloc((size_t)lwork * sizeof(double));
+    int *IWORK = (int*)malloc((size_t)liwork * sizeof(int));
+    if (!WORK || !IWORK) info = -100;
+    else dsyevd_(&jobz, &uplo, &n, A, &n, W, WORK, &lwork, IWORK, &liwork, &info);
+    free(IWORK); free(WORK); free(A);
+    return info;
+}
+
+/* One rank's table in the layout of the wrapper summary (wrap_timers.c). */
+#define NSTAGE 4
+static void print_rank_table(int r, int size, int prow, int pcol, const char *const *names,
+                             const double *calls, const double *secs)
+{
+    int idx[NSTAGE];
+    for (int i = 0; i < NSTAGE; ++i) idx[i] = i;
+    for (int i = 1; i < NSTAGE; ++i)                       /* by time, descending */
+        for (int j = i; j > 0 && secs[idx[j]] > secs[idx[j - 1]]; --j) { int t = idx[j]; idx[j] = idx[j - 1]; idx[j - 1] = t; }
+    double tot_c = 0.0, tot_t = 0.0;
+    fprintf(stderr, "\n==== Rank %d/%d (grid %d,%d) Stage Timing (wall time) ====\n", r, size, prow, pcol);
+    for (int q = 0; q < NSTAGE; ++q) {
+        const int i = idx[q];
+        if (calls[i] <= 0.0) continue;
+        fprintf(stderr, "%-11s calls=%6llu  time=%10.6f s  avg=%9.6f s\n",
+                names[i], (unsigned long long)calls[i], secs[i], secs[i] / calls[i]);
+        if (i < NSTAGE - 1) { tot_c += calls[i]; tot_t += secs[i]; }
+    }
+    fprintf(stderr, "---------------------------------------------\n");
+    fprintf(stderr, "TOTAL       calls=%6llu  time=%10.6f s  (%s inside the stages)\n",
+            (unsigned long long)tot_c, tot_t, names[NSTAGE - 1]);
+    fprintf(stderr, "=============================================\n");
+}
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    const int n  = (argc > 1) ? atoi(argv[1]) : 4000;
+    const int nb = (argc > 2) ? atoi(argv[2]) : 64;
+    const char *grid_env = getenv("MPI_GRID");
+    const char *chk_env  = getenv("MPI_CHECK");
+    const char *smp_env  = getenv("MPI_SAMPLES");
+    const double rho = 0.95;                      // KMS as in the dense drivers
+    int nprow = 0, npcol = 0;
+    if (grid_env) sscanf(grid_env, "%dx%d", &nprow, &npcol);
+
+    dist_grid_t g;
+    if (n < 2 || nb < 1 || dist_grid_init(MPI_COMM_WORLD, nprow, npcol, &g) != 0) {
+        int r = 0; MPI_Comm_rank(MPI_COMM_WORLD, &r);
+        if (r == 0) fprintf(stderr, "Need n >= 2, nb >= 1 and MPI_GRID PxQ with P*Q = ranks\n");
+        MPI_Finalize();
+        return 1;
+    }
+    const int root = (g.rank == 0);
+    const int check = chk_env ? atoi(chk_env) != 0 : n <= 2000;
+    int samples = smp_env ? atoi(smp_env) : 8;
+    if (samples > n) samples = n;
+    if (samples < 0) samples = 0;
+#ifdef HAVE_SCALAPACK
+    const char *path = "ScaLAPACK PDSYTRD/PDSTEDC/PDORMTR";
+    const char *names[NSTAGE] = { "pdsytrd_", "pdstedc_", "pdormtr_", "allreduce" };
+#else
+    const char *path = "native sytd2/stemr/ormtr";
+    const char *names[NSTAGE] = { "dist_sytd2", "dist_stemr", "dist_ormtr", "allreduce" };
+#endif
+    if (root)
+        printf("Mode: MPI %s | KMS(rho=%.2f) n=%d nb=%d | %d ranks, grid %dx%d | backend %s\n",
+               path, rho, n, nb, g.size, g.nprow, g.npcol, EIG_BACKEND);
+
+    /* ---- A in block-cyclic layout, generated where it lives ---- */
+    dist_mat_t A, Z;
+    int bad = (dist_mat_alloc(&g, n, nb, &A) != 0) | (dist_mat_alloc(&g, n, nb, &Z) != 0);
+    double *W = (double*)malloc((size_t)n * sizeof(double));
+    double *x = (double*)malloc((size_t)n * sizeof(double));
+    double *y = (double*)malloc((size_t)n * sizeof(double));
+    double *zs = (double*)malloc((size_t)n * (samples > 0 ? samples : 1) * sizeof(double));
+    bad |= !W || !x || !y || !zs;
+    MPI_Allreduce(MPI_IN_PLACE, &bad, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    if (bad) {
+        if (root) fprintf(stderr, "Allocation failed (local %d x %d)\n", A.mloc, A.nloc);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    for (int lj = 0; lj < A.nloc; ++lj) {
+        const int gj = dist_l2g(lj, nb, g.mycol, g.npcol);
+        for (int li = 0; li < A.mloc; ++li)
+            A.a[li + (size_t)lj * A.lld] = kms(dist_l2g(li, nb, g.myrow, g.nprow), gj, rho);
+    }
+
+    /* ---- Solve ---- */
+    dist_eig_stats_t st;
+    MPI_Barrier(MPI_COMM_WORLD);
+    const double t_start = MPI_Wtime();
+#ifdef HAVE_SCALAPACK
+    const int info = scalapack_syevd(&g, &A, W, &Z, &st);
+#else
+    const int info = dist_syevd(&g, &A, W, &Z, &st);
+#endif
+    double t_total = MPI_Wtime() - t_start;
+    MPI_Allreduce(MPI_IN_PLACE, &t_total, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    if (info != 0) {
+        if (root) fprintf(stderr, "Distributed eigensolver failed, info=%d\n", info);
+        MPI_Finalize();
+        return 2;
+    }
+
+    /* ---- Per-rank stage tables, printed by rank 0 in rank order ---- */
+    double mine[2 * NSTAGE] = { (double)st.n_reduce, (double)st.n_tridiag, (double)st.n_backtr, (double)st.n_comm,
+                                st.t_reduce, st.t_tridiag, st.t_backtr, st.t_comm };
+    double *all = root ? (double*)malloc((size_t)g.size * 2 * NSTAGE * sizeof(double)) : NULL;
+    MPI_Gather(mine, 2 * NSTAGE, MPI_DOUBLE, all, 2 * NSTAGE, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    double bytes = st.bytes_comm;
+    MPI_Allreduce(MPI_IN_PLACE, &bytes, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+    /* ---- Check: sampled residuals / orthogonality, optional dense eigenvalues ---- */
+    const double anorm = fmax(fabs(W[0]), fabs(W[n - 1]));
+    double res_max = 0.0, orth = 0.0;
+    for (int s = 0; s < samples; ++s) {
+        const int j = (samples > 1) ? (int)((long long)s * (n - 1) / (samples - 1)) : 0;
+        double *z = zs + (size_t)s * n;
+        gather_column(&g, &Z, j, z);
+        kms_apply(&g, &A, rho, z, y);
+        double r2 = 0.0;
+        for (int i = 0; i < n; ++i) { const double d = y[i] - W[j] * z[i]; r2 += d * d; }
+        if (sqrt(r2) / anorm > res_max) res_max = sqrt(r2) / anorm;
+        for (int q = 0; q <= s; ++q) {
+            double d = 0.0;
+            for (int i = 0; i < n; ++i) d += zs[(size_t)q * n + i] * z[i];
+            if (fabs(d - (q == s ? 1.0 : 0.0)) > orth) orth = fabs(d - (q == s ? 1.0 : 0.0));
+        }
+    }
+    double dw = -1.0;
+    if (root && check) {
+        const int ri = dense_reference(n, rho, x);
+        if (ri != 0) fprintf(stderr, "DSYEVD reference failed, info=%d\n", ri);
+        else {
+            dw = 0.0;
+            for (int i = 0; i < n; ++i) if (fabs(W[i] - x[i]) / anorm > dw) dw = fabs(W[i] - x[i]) / anorm;
+        }
+    }
+
+    /* ---- Report ---- */
+    if (root) {
+        double smax[NSTAGE] = {0}, smin[NSTAGE];
+        for (int i = 0; i < NSTAGE; ++i) smin[i] = 1e300;
+        for (int r = 0; r < g.size; ++r) {
+            const double *e = all + (size_t)r * 2 * NSTAGE;
+            print_rank_table(r, g.size, r / g.npcol, r % g.npcol, names, e, e + NSTAGE);
+            for (int i = 0; i < NSTAGE; ++i) {
+                if (e[NSTAGE + i] > smax[i]) smax[i] = e[NSTAGE + i];
+                if (e[NSTAGE + i] < smin[i]) smin[i] = e[NSTAGE + i];
+            }
+        }
+        fflush(stderr);
+        const double mb = 1048576.0;
+        printf("Local A:  %d x %d on rank 0 (%.1f MB of %.1f MB dense)\n",
+               A.mloc, A.nloc, (double)A.lld * A.nloc * sizeof(double) / mb, (double)n * n * sizeof(double) / mb);
+        for (int i = 0; i < NSTAGE; ++i)
+            printf("%-10s took %.3f s max over ranks (min %.3f s)\n", names[i], smax[i], smin[i]);
+        printf("Comm     %.1f MB sent per rank (max)\n", bytes / mb);
+        printf("Total    took %.3f s\n", t_total);
+        printf("Check: %d sampled z: max ||Az - lz||/||A|| = %.3e, max |Z^T Z - I| = %.3e", samples, res_max, orth);
+        if (dw >= 0.0) printf(", max |l - l_DSYEVD|/||A|| = %.3e", dw);
+        printf("\n");
+
+        const char *outdir = "../output";
+        ensure_dir(outdir);
+        char path_time[256], path_w[256];
+        snprintf(path_time, sizeof(path_time), "%s/mpi_time.txt", outdir);
+        snprintf(path_w,    sizeof(path_w),    "%s/mpi_eigenvalues.txt", outdir);
+        FILE *ft = fopen(path_time, "w");
+        if (ft) {
+            fprintf(ft, "n=%d nb=%d ranks=%d grid=%dx%d path=%s backend=%s\n",
+                    n, nb, g.size, g.nprow, g.npcol, path, EIG_BACKEND);
+            for (int r = 0; r < g.size; ++r) {
+                const double *e = all + (size_t)r * 2 * NSTAGE;
+                fprintf(ft, "RANK %d", r);
+                for (int i = 0; i < NSTAGE; ++i) fprintf(ft, "  %s %.6f s (%.0f)", names[i], e[NSTAGE + i], e[i]);
+                fprintf(ft, "\n");
+            }
+            fprintf(ft, "TOTAL   %.6f s\nCOMM    %.1f MB per rank\n", t_total, bytes / mb);
+            fprintf(ft, "RESID   %.3e\nORTH    %.3e\n", res_max, orth);
+            if (dw >= 0.0) fprintf(ft, "DW      %.3e\n", dw);
+            fclose(ft);
+        }
+        FILE *fw = fopen(path_w, "w");
+        if (fw) {
+            for (int i = 0; i < n; ++i) fprintf(fw, "%.15e\n", W[i]);
+            fclose(fw);
+        }
+    }
+
+    free(all); free(zs); free(y); free(x); free(W);
+    dist_mat_free(&Z); dist_mat_free(&A);
+    dist_grid_free(&g);
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,85 @@
+#!/usr/bin/env bash
+# build_run.sh — build the out-of-core driver and run gen + solve.
+#   ./build_run.sh <case_name> [n] [jobz]
+# n defaults to 2000 (a 32 MB smoke test); out-of-core scale has to be
+# asked for explicitly, e.g. n=40000 writes a 12.8 GB input, and a solve
+# with vectors needs four more files of that size (scratch copy of A, Q2,
+# DSTEDC workspace, vectors). The driver prints its I/O model up front.
+# The input/output matrices live in $OOC_DATA (default ../output/data):
+#   kms_<n>.bin (generated once, streamed) and vectors_<n>.bin.
+# Knobs: OOC_NB (bandwidth), OOC_PANEL_MB, OOC_SAMPLES, OOC_SCRATCH
+# (see ../src/ooc_run.c).
+set -euo pipefail
+
+export OMP_NUM_THREADS=${OMP_NUM_THREADS:-1}
+export OPENBLAS_NUM_THREADS=${OPENBLAS_NUM_THREADS:-1}
+export ARMPL_NUM_THREADS=${ARMPL_NUM_THREADS:-1}
+
+TAG="${1:-}"
+[ -n "$TAG" ] || { echo "Usage: $0 <case_name> [n] [jobz]"; exit 1; }
+N="${2:-2000}"
+JOBZ="${3:-V}"
+
+# ====== 1) Compiler setup ======
+CC="${CC:-gcc}"
+CFLAGS_BASE="-O3 -std=c11 -D_POSIX_C_SOURCE=200809L \
+  -mcpu=native -mtune=native \
+  -fno-math-errno -fno-trapping-math -ffp-contract=fast \
+  -I../../common/src"
+LIBS_FORTRAN="-lgfortran"
+LIBS_MATH="-lm"
+
+# ====== 2) Library presets ======
+CFLAGS_NETLIB="$CFLAGS_BASE -I../../LAPACK/build/include"
+LDFLAGS_NETLIB="../../LAPACK/build/lib/liblapack.a ../../LAPACK/build/lib/libblas.a $LIBS_FORTRAN $LIBS_MATH"
+
+CFLAGS_OB="$CFLAGS_BASE -I../../openblas/openblas_install/include"
+LDFLAGS_OB="../../openblas/openblas_install/lib/libopenblas.a $LIBS_FORTRAN $LIBS_MATH -lpthread -ldl"
+
+ARMPL_PREFIX="../../armpl/arm-performance-libraries_25.07_rpm/armpl_local/armpl_25.07_gcc"
+CFLAGS_AP="$CFLAGS_BASE -I$ARMPL_PREFIX/include"
+LDFLAGS_AP="$ARMPL_PREFIX/lib/libarmpl.a -lpthread -ldl $LIBS_FORTRAN $LIBS_MATH"
+
+# ====== 3) Sources ======
+SRCS=("../src/ooc_run.c" "../../common/src/mmap_matrix.c")
+
+# ====== 4) Case selection ======
+case "$TAG" in
+  ooc-openblas) CFLAGS="$CFLAGS_OB";     LDFLAGS="$LDFLAGS_OB" ;;
+  ooc-netlib)   CFLAGS="$CFLAGS_NETLIB"; LDFLAGS="$LDFLAGS_NETLIB" ;;
+  ooc-armpl)    CFLAGS="$CFLAGS_AP";     LDFLAGS="$LDFLAGS_AP" ;;
+  *)
+      echo "[X] Unknown TAG: $TAG"
+      echo "    Available: ooc-openblas | ooc-netlib | ooc-armpl"
+      exit 1;;
+esac
+
+# ====== 5) Output & Build ======
+OUT_DIR="../output"
+OBJ_DIR="$OUT_DIR/obj"
+BIN_DIR="$OUT_DIR/bin"
+DATA_DIR="${OOC_DATA:-$OUT_DIR/data}"
+mkdir -p "$OBJ_DIR" "$BIN_DIR" "$DATA_DIR"
+
+OBJS=()
+for f in "${SRCS[@]}"; do
+  base="$(basename "$f" .c)"
+  obj="$OBJ_DIR/${base}.o"
+  echo "[BUILD] CC=$CC | SRC=$f"
+  $CC $CFLAGS -c "$f" -o "$obj"
+  OBJS+=("$obj")
+done
+
+BIN="$BIN_DIR/$TAG"
+echo "[LINK ] ${OBJS[*]} -> $BIN"
+$CC "${OBJS[@]}" $LDFLAGS -o "$BIN"
+
+# ====== 6) Run ======
+IN="$DATA_DIR/kms_${N}.bin"
+OUT="$DATA_DIR/vectors_${N}.bin"
+echo "[INFO ] n=$N: $(( N * N * 8 / 1048576 )) MB per matrix file in $DATA_DIR"
+[[ -f "$IN" ]] || "$BIN" gen "$IN" "$N"
+
+echo "[RUN  ] EXE=$BIN solve $IN $N $OUT $JOBZ"
+echo "[INFO ] OMP_NUM_THREADS=$OMP_NUM_THREADS OPENBLAS_NUM_THREADS=$OPENBLAS_NUM_THREADS ARMPL_NUM_THREADS=$ARMPL_NUM_THREADS"
+exec "$BIN" solve "$IN" "$N" "$OUT" "$JOBZ"
@@ -0,0 +1,586 @@
+// ooc_run.c — Out-of-core symmetric eigensolver on memory-mapped files.
+//
+//   ooc_run gen   <A.bin> <n> [rho]                      stream a KMS matrix to disk
+//   ooc_run solve <A.bin> <n> <Z.bin> [jobz] [--inplace]
+//
+// A.bin / Z.bin are raw column-major doubles (n*n*8 bytes, no header).
+//
+// Pipeline ('solve'), two-stage so that the part touching the n x n matrix
+// does a bounded number of passes over it:
+//   1) A is copied panel by panel into an unlinked scratch file (or, with
+//      --inplace, reduced directly inside A.bin, which is then overwritten).
+//   2) Dense -> band (UPLO='L', bandwidth kd = OOC_NB), tiled: per panel of
+//      kd columns, DGEQRF on its sub-band block, then Q^T*A22*Q on the
+//      trailing matrix in two sweeps over its lower triangle, in column tiles
+//      of OOC_PANEL_MB: X = A22*V (DSYMM/DGEMM, read only), then
+//      A22 -= V*W^T + W*V^T (DSYR2K/DGEMM). Each tile is released (written
+//      back and dropped) after use, so every panel costs two reads and one
+//      write of the trailing triangle, about n^3/kd * 8 bytes in all,
+//      whatever the RAM. The reflectors stay below the band in A. (The
+//      kernel moves ~128 KB around each touched page, so for n < 16k whole
+//      columns move: up to 3x that.)
+//   3) Band -> tridiagonal in core: DSBTRD on the (kd+1) x n band. With
+//      JOBZ='V' its rotations are accumulated in an n x n scratch mapping Q2;
+//      they sweep all of Q2 for every column, so once Q2 outgrows the page
+//      cache this costs up to n^3/(2*kd) * 8 bytes each way.
+//   4) DSTEDC('I') on (D,E) writes the eigenvectors of T straight into the
+//      mapped Z.bin; its n^2 workspace is another scratch mapping, and its
+//      merges shrink geometrically (about two passes over both).
+//      (JOBZ='N': DSTERF only, no Z.bin is produced.)
+//   5) Back-transform Z <- Q1*Q2*Z per column panel of OOC_PANEL_MB: DGEMM
+//      with Q2 into an in-core panel, DORMQR with each band panel's
+//      reflectors, copy back. Q2 and the reflectors are read once per panel.
+//   6) Check (JOBZ='V', OOC_SAMPLES eigenvectors spread over the spectrum):
+//      max ||A z - lambda z|| / ||A|| from one streamed pass over the input,
+//      and max |Z^T Z - I| among the samples. --inplace overwrites A, so
+//      only orthogonality is checked there.
+// The I/O model (bytes through the mappings per stage) is printed up front;
+// each stage then reports what actually reached storage next to it.
+// Storage: A (scratch copy unless --inplace), Q2, the DSTEDC workspace and
+// Z.bin, n^2 * 8 bytes each.
+//
+// Env knobs:
+//   OOC_NB        bandwidth kd of stage 2 (default 64); a wider band cuts
+//                 stage 2/3 I/O by 1/kd but costs DSBTRD O(n^2*kd) flops
+//   OOC_PANEL_MB  memory for one reduction tile / back-transform panel of
+//                 n-row columns (default 256 MB)
+//   OOC_SAMPLES   eigenvectors checked (default 8, 0 = no check)
+//   OOC_SCRATCH   directory for scratch files (default $TMPDIR, then /tmp)
+//
+// Reported per stage: wall time, bytes read/written to storage (and the
+// model), major faults.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+
+#include "mmap_matrix.h"
+#include "now_sec.h"
+
+/* --------- Fortran LAPACK/BLAS symbols (vendor-agnostic) --------- */
+extern void dgeqrf_(const int *M, const int *N, double *A, const int *LDA,
+                    double *TAU, double *WORK, const int *LWORK, int *INFO);
+
+extern void dlarft_(const char *DIRECT, const char *STOREV, const int *N, const int *K,
+                    const double *V, const int *LDV, const double *TAU,
+                    double *T, const int *LDT);
+
+extern void dlacpy_(const char *UPLO, const int *M, const int *N,
+                    const double *A, const int *LDA, double *B, const int *LDB);
+
+extern void dsymm_(const char *SIDE, const char *UPLO, const int *M, const int *N,
+                   const double *ALPHA, const double *A, const int *LDA,
+                   const double *B, const int *LDB,
+                   const double *BETA, double *C, const int *LDC);
+
+extern void dgemm_(const char *TRANSA, const char *TRANSB, const int *M, const int *N, const int *K,
+                   const double *ALPHA, const double *A, const int *LDA,
+                   const double *B, const int *LDB,
+                   const double *BETA, double *C, const int *LDC);
+
+extern void dtrmm_(const char *SIDE, const char *UPLO, const char *TRANSA, const char *DIAG,
+                   const int *M, const int *N, const double *ALPHA,
+                   const double *A, const int *LDA, double *B, const int *LDB);
+
+extern void dsyr2k_(const char *UPLO, const char *TRANS, const int *N, const int *K,
+                    const double *ALPHA, const double *A, const int *LDA,
+                    const double *B, const int *LDB,
+                    const double *BETA, double *C, const int *LDC);
+
+extern void dsbtrd_(const char *VECT, const char *UPLO, const int *N, const int *KD,
+                    double *AB, const int *LDAB, double *D, double *E,
+                    double *Q, const int *LDQ, double *WORK, int *INFO);
+
+extern void dsterf_(const int *N, double *D, double *E, int *INFO);
+
+extern void dstedc_(const char *COMPZ, const int *N,
+                    double *D, double *E,
+                    double *Z, const int *LDZ,
+                    double *WORK, const int *LWORK,
+                    int *IWORK, const int *LIWORK,
+                    int *INFO);
+
+extern void dormqr_(const char *SIDE, const char *TRANS,
+                    const int *M, const int *N, const int *K,
+                    const double *A, const int *LDA, const double *TAU,
+                    double *C, const int *LDC,
+                    double *WORK, const int *LWORK, int *INFO);
+
+/* --------- Utilities --------- */
+static void ensure_dir(const char *path) {
+    if (mkdir(path, 0777) != 0 && errno != EEXIST) {
+        perror("mkdir");
+        exit(5);
+    }
+}
+
+static int env_int(const char *name, int dflt) {
+    const char *v = getenv(name);
+    return (v && atoi(v) > 0) ? atoi(v) : dflt;
+}
+
+/* ---- per-stage accounting: time, storage I/O (measured and modelled), major faults ---- */
+typedef struct {
+    const char *name;
+    double t0, secs;
+    unsigned long long rd0, wr0, rd, wr;
+    long majflt0, majflt;
+    double mrd, mwr;      /* I/O model, bytes */
+} stage_t;
+
+static void stage_begin(stage_t *s, const char *name) {
+    struct rusage ru; getrusage(RUSAGE_SELF, &ru);
+    s->name = name;
+    io_counters(&s->rd0, &s->wr0);
+    s->majflt0 = ru.ru_majflt;
+    s->t0 = now_sec();
+}
+
+static void stage_end(stage_t *s) {
+    struct rusage ru;
+    s->secs = now_sec() - s->t0;
+    getrusage(RUSAGE_SELF, &ru);
+    io_counters(&s->rd, &s->wr);
+    s->rd -= s->rd0; s->wr -= s->wr0;
+    s->majflt = ru.ru_majflt - s->majflt0;
+}
+
+static void stage_print(FILE *f, const stage_t *s) {
+    fprintf(f, "%-14s %10.3f s   read=%10.1f MB (model %10.1f)  write=%10.1f MB (model %10.1f)  majflt=%ld\n",
+            s->name, s->secs, s->rd / 1048576.0, s->mrd / 1048576.0,
+            s->wr / 1048576.0, s->mwr / 1048576.0, s->majflt);
+}
+
+/* ---------------- 'gen': KMS matrix streamed column by column ---------------- */
+static int gen_kms_file(const char *path, int n, double rho)
+{
+    if (!(rho > -1.0 && rho < 1.0)) rho = 0.95;
+    double arho = fabs(rho);
+
+    double *rp  = (double*)malloc((size_t)n * sizeof(double));
+    double *col = (double*)malloc((size_t)n * sizeof(double));
+    if (!rp || !col) { free(col); free(rp); fprintf(stderr, "Allocation failed (gen)\n"); return 1; }
+    rp[0] = 1.0;
+    for (int k = 1; k < n; ++k) rp[k] = rp[k-1] * arho;
+
+    FILE *f = fopen(path, "wb");
+    if (!f) { perror("fopen"); free(col); free(rp); return 2; }
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i < n; ++i) col[i] = rp[i > j ? i - j : j - i];
+        if (fwrite(col, sizeof(double), (size_t)n, f) != (size_t)n) {
+            perror("fwrite"); fclose(f); free(col); free(rp); return 3;
+        }
+    }
+    fclose(f);
+    free(col); free(rp);
+    printf("Wrote KMS(n=%d, rho=%.3f) to %s (%.1f MB)\n",
+           n, rho, path, (double)n * n * 8 / 1048576.0);
+    return 0;
+}
+
+/* ---------------- dense -> band (UPLO='L'), tiled ----------------
+   Panels start at j = 0, kd, 2kd, ... while more than one row lies below
+   the band (ooc_panel_rows > 1). Panel j: QR of A[j+kd:n, j:j+kd] leaves R
+   inside the band and the reflectors V below it; the trailing matrix
+   A22 = A[j+kd:n, j+kd:n] becomes Q^T*A22*Q with Q = I - V*T*V^T:
+       X = A22*V*T,  W = X - 1/2 * V*(T^T*V^T*X),  A22 -= V*W^T + W*V^T.
+   A22 is only touched through its lower triangle, one column tile of
+   `tc` columns at a time, and each tile is released right after use. */
+static int ooc_panel_rows(int n, int kd, int j) { return n - j - kd; }
+
+static int sy2sb_lower_tiled(mmap_matrix_t *A, int kd, int tc, double *TAU)
+{
+    const char lo = 'L', le = 'L', ri = 'R', up = 'U', no = 'N', tr = 'T', fw = 'F', cw = 'C';
+    const double one = 1.0, mone = -1.0, mhalf = -0.5, zero = 0.0;
+    const int n = A->rows, lda = A->rows, ldt = kd;
+    double *a = A->a;
+    int info = 0;
+
+    int m0 = ooc_panel_rows(n, kd, 0);
+    if (m0 <= 1) return 0;
+    int lwq = -1; double wq = 0.0;
+    dgeqrf_(&m0, &kd, a, &lda, TAU, &wq, &lwq, &info);
+    if (info != 0) return info;
+    lwq = (int)wq; if (lwq < 1) lwq = 1;
+
+    double *V  = (double*)malloc((size_t)m0 * kd * sizeof(double));
+    double *X  = (double*)malloc((size_t)m0 * kd * sizeof(double));
+    double *T  = (double*)malloc((size_t)kd * kd * sizeof(double));
+    double *M  = (double*)malloc((size_t)kd * kd * sizeof(double));
+    double *QW = (double*)malloc((size_t)lwq * sizeof(double));
+    if (!V || !X || !T || !M || !QW) { info = -100; goto OUT; }
+
+    for (int j = 0; ooc_panel_rows(n, kd, j) > 1 && info == 0; j += kd) {
+        const int s = j + kd, m = n - s, k = (m < kd) ? m : kd;
+        double *pan = &a[s + (size_t)j * lda];
+
+        /* panel: QR, V (unit lower trapezoid) and T in core */
+        mmap_matrix_prefetch(A, j, s);
+        dgeqrf_(&m, &kd, pan, &lda, &TAU[j], QW, &lwq, &info);
+        if (info != 0) break;
+        dlacpy_(&lo, &m, &k, pan, &lda, V, &m);
+        for (int c = 0; c < k; ++c) {
+            for (int i = 0; i < c; ++i) V[i + (size_t)c * m] = 0.0;
+            V[c + (size_t)c * m] = 1.0;
+        }
+        dlarft_(&fw, &cw, &m, &k, V, &m, &TAU[j], T, &ldt);
+        mmap_matrix_release(A, j, s);
+
+        /* sweep 1 (read only): X = A22*V */
+        memset(X, 0, (size_t)m * k * sizeof(double));
+        for (int c0 = 0; c0 < m; c0 += tc) {
+            const int w = (c0 + tc < m) ? tc : m - c0, c1 = c0 + w, r = m - c1;
+            double *d = &a[(s + c0) + (size_t)(s + c0) * lda];
+            dsymm_(&le, &lo, &w, &k, &one, d, &lda, &V[c0], &m, &one, &X[c0], &m);
+            if (r > 0) {
+                dgemm_(&no, &no, &r, &k, &w, &one, d + w, &lda, &V[c0], &m, &one, &X[c1], &m);
+                dgemm_(&tr, &no, &w, &k, &r, &one, d + w, &lda, &V[c1], &m, &one, &X[c0], &m);
+            }
+            mmap_matrix_release(A, s + c0, s + c1);
+        }
+
+        /* W = X*T - 1/2 * V*(T^T*V^T*X*T), in place in X */
+        dtrmm_(&ri, &up, &no, &no, &m, &k, &one, T, &ldt, X, &m);
+        dgemm_(&tr, &no, &k, &k, &m, &one, V, &m, X, &m, &zero, M, &ldt);
+        dtrmm_(&le, &up, &tr, &no, &k, &k, &one, T, &ldt, M, &ldt);
+        dgemm_(&no, &no, &m, &k, &k, &mhalf, V, &m, M, &ldt, &one, X, &m);
+
+        /* sweep 2 (read + write): A22 -= V*W^T + W*V^T */
+        for (int c0 = 0; c0 < m; c0 += tc) {
+            const int w = (c0 + tc < m) ? tc : m - c0, c1 = c0 + w, r = m - c1;
+            double *d = &a[(s + c0) + (size_t)(s + c0) * lda];
+            dsyr2k_(&lo, &no, &w, &k, &mone, &V[c0], &m, &X[c0], &m, &one, d, &lda);
+            if (r > 0) {
+                dgemm_(&no, &tr, &r, &w, &k, &mone, &V[c1], &m, &X[c0], &m, &one, d + w, &lda);
+                dgemm_(&no, &tr, &r, &w, &k, &mone, &X[c1], &m, &V[c0], &m, &one, d + w, &lda);
+            }
+            mmap_matrix_release(A, s + c0, s + c1);
+        }
+    }
+
+OUT:
+    free(QW); free(M); free(T); free(X); free(V);
+    return info;
+}
+
+/* Lower band of the reduced A into LAPACK band storage AB ((kd+1) x n). */
+static void band_extract(const mmap_matrix_t *A, int kd, int pc, double *AB)
+{
+    const int n = A->rows, ldab = kd + 1;
+    for (int j0 = 0; j0 < n; j0 += pc) {
+        const int j1 = (j0 + pc < n) ? j0 + pc : n;
+        for (int j = j0; j < j1; ++j) {
+            const int len = (n - j < ldab) ? n - j : ldab;
+            memcpy(&AB[(size_t)j * ldab], &A->a[j + (size_t)j * n], (size_t)len * sizeof(double));
+        }
+        mmap_matrix_release(A, j0, j1);
+    }
+}
+
+/* ---------------- I/O model: bytes through the mappings per stage ----------------
+   Worst case, i.e. nothing survives in the page cache between touches; the
+   reduction and back-transform release every tile/panel, so for them this is
+   what storage sees whatever the RAM. */
+enum { ST_INPUT, ST_SY2SB, ST_SBTRD, ST_TRI, ST_BT, ST_CHECK, NSTAGE };
+
+static void io_model(int n, int kd, int pc, char jobz, int inplace, int samples, stage_t st[NSTAGE])
+{
+    const double e = sizeof(double), nn = (double)n * n * e;
+    double refl = 0.0;   /* bytes of reflectors below the band */
+
+    st[ST_INPUT].mrd = inplace ? 0.0 : nn;
+    st[ST_INPUT].mwr = inplace ? 0.0 : nn;
+
+    for (int j = 0; ooc_panel_rows(n, kd, j) > 1; j += kd) {
+        const double m = ooc_panel_rows(n, kd, j), tri = m * (m + 1) / 2 * e, pan = (m + kd) * kd * e;
+        st[ST_SY2SB].mrd += 2 * tri + pan;
+        st[ST_SY2SB].mwr += tri + pan;
+        refl += m * kd * e;
+    }
+
+    st[ST_SBTRD].mrd = (double)n * (kd + 1) * e;
+    if (jobz == 'V') {
+        const double q2 = (double)n * n * n / (2.0 * kd) * e;
+        st[ST_SBTRD].mrd += q2;
+        st[ST_SBTRD].mwr  = q2;
+        st[ST_TRI].mrd = st[ST_TRI].mwr = 2 * 2 * nn;
+        const double np = ceil((double)n / pc);
+        st[ST_BT].mrd = np * (nn + refl) + nn;
+        st[ST_BT].mwr = nn;
+        if (samples > 0) st[ST_CHECK].mrd = (inplace ? 0.0 : nn) + (double)samples * n * e;
+    }
+}
+
+static int solve(const char *in_path, int n, const char *out_path, char jobz, int inplace)
+{
+    const char lo = 'L', left = 'L', notrans = 'N', compz = 'I';
+    const char vect = (jobz == 'V') ? 'V' : 'N';
+    int kd = env_int("OOC_NB", 64);
+    if (kd > n - 1) kd = (n > 1) ? n - 1 : 1;
+    const int panel_mb = env_int("OOC_PANEL_MB", 256);
+    int samples = getenv("OOC_SAMPLES") ? atoi(getenv("OOC_SAMPLES")) : 8;
+    if (samples > n) samples = n;
+    if (samples < 0 || jobz != 'V') samples = 0;
+    int pc = (int)(((size_t)panel_mb << 20) / ((size_t)n * sizeof(double)));
+    if (pc < 1) pc = 1;
+    if (pc > n) pc = n;
+
+    printf("Mode: OOC two-stage (n=%d, JOBZ='%c', kd=%d, tile/panel=%d cols, %s)\n",
+           n, jobz, kd, pc, inplace ? "in place" : "scratch copy");
+
+    int rc = 0, info = 0;
+    stage_t st[NSTAGE] = {{0}};
+    static const char *const model_note[NSTAGE] = {
+        "copy A into scratch",
+        "2 reads + 1 write of the trailing triangle per kd-panel",
+        "band in core; Q2 rotations sweep the n x n scratch",
+        "merges: about two passes over Z and the workspace",
+        "Q2 and the reflectors once per Z panel",
+        "A once, streamed",
+    };
+    static const char *const stage_name[NSTAGE] = {
+        "input", "SY2SB(tiles)", "SBTRD", "DSTEDC('I')", "ORMQR*Q2(pan)", "check"
+    };
+    io_model(n, kd, pc, jobz, inplace, samples, st);
+    {
+        const double ram = (double)sysconf(_SC_PHYS_PAGES) * (double)sysconf(_SC_PAGESIZE);
+        printf("I/O model (MB through the mappings, worst case; RAM %.1f GB, matrix %.1f MB):\n",
+               ram / 1073741824.0, (double)n * n * 8 / 1048576.0);
+        for (int k = 0; k < NSTAGE; ++k) {
+            if (k == ST_TRI && jobz != 'V') continue;
+            if ((k == ST_BT && jobz != 'V') || (k == ST_CHECK && samples == 0)) continue;
+            printf("  %-14s read=%12.1f  write=%12.1f   %s\n", stage_name[k],
+                   st[k].mrd / 1048576.0, st[k].mwr / 1048576.0, model_note[k]);
+        }
+        if ((size_t)n * sizeof(double) < ((size_t)128 << 10))
+            printf("  note: a column (%.1f KB) is below the kernel's ~128 KB read-around / folio size,\n"
+                   "        so whole columns move and SY2SB traffic runs up to 3x the triangle model\n",
+                   n * 8 / 1024.0);
+    }
+
+    mmap_matrix_t A = { .fd = -1 }, Z = { .fd = -1 }, WK = { .fd = -1 }, Q2 = { .fd = -1 };
+    double *D   = (double*)malloc((size_t)n * sizeof(double));
+    double *E   = (double*)malloc((size_t)n * sizeof(double));
+    double *TAU = (double*)calloc((size_t)n, sizeof(double));
+    double *AB  = (double*)calloc((size_t)(kd + 1) * n, sizeof(double));
+    double *SBW = (double*)malloc((size_t)n * sizeof(double));
+    int *IWORK  = NULL;
+    double *BTW = NULL, *PAN = NULL, *ZS = NULL, *Y = NULL;
+    double res_max = -1.0, orth = -1.0;
+    if (!D || !E || !TAU || !AB || !SBW) { fprintf(stderr, "Allocation failed.\n"); rc = 1; goto DONE; }
+
+    /* ---- 1) input mapping ---- */
+    stage_begin(&st[ST_INPUT], stage_name[ST_INPUT]);
+    if (inplace) {
+        if (mmap_matrix_open(&A, in_path, n, n, 1) != 0) { rc = 2; goto DONE; }
+    } else {
+        mmap_matrix_t in = { .fd = -1 };
+        if (mmap_matrix_open(&in, in_path, n, n, 0) != 0) { rc = 2; goto DONE; }
+        if (mmap_matrix_scratch(&A, NULL, n, n) != 0) { mmap_matrix_close(&in); rc = 2; goto DONE; }
+        for (int j = 0; j < n; j += pc) {
+            int j1 = (j + pc < n) ? j + pc : n;
+            memcpy(&A.a[(size_t)j * n], &in.a[(size_t)j * n], (size_t)(j1 - j) * n * sizeof(double));
+            mmap_matrix_release(&A, j, j1);
+            mmap_matrix_release(&in, j, j1);
+        }
+        mmap_matrix_close(&in);
+    }
+    stage_end(&st[ST_INPUT]);
+
+    /* ---- 2) dense -> band ---- */
+    stage_begin(&st[ST_SY2SB], stage_name[ST_SY2SB]);
+    info = sy2sb_lower_tiled(&A, kd, pc, TAU);
+    stage_end(&st[ST_SY2SB]);
+    if (info != 0) { fprintf(stderr, "Tiled dense->band reduction failed, info=%d\n", info); rc = 3; goto DONE; }
+
+    /* ---- 3) band -> tridiagonal, in core (Q2 in scratch) ---- */
+    if (jobz == 'V' && mmap_matrix_scratch(&Q2, NULL, n, n) != 0) { rc = 3; goto DONE; }
+    stage_begin(&st[ST_SBTRD], stage_name[ST_SBTRD]);
+    band_extract(&A, kd, pc, AB);
+    {
+        const int ldab = kd + 1, ldq = (jobz == 'V') ? n : 1;
+        dsbtrd_(&vect, &lo, &n, &kd, AB, &ldab, D, E, (jobz == 'V') ? Q2.a : SBW, &ldq, SBW, &info);
+    }
+    if (jobz == 'V') mmap_matrix_release(&Q2, 0, n);
+    stage_end(&st[ST_SBTRD]);
+    free(AB); AB = NULL;
+    if (info != 0) { fprintf(stderr, "DSBTRD failed, info=%d\n", info); rc = 3; goto DONE; }
+
+    /* ---- 4) tridiagonal eigensolver ---- */
+    if (jobz == 'N') {
+        stage_begin(&st[ST_TRI], "DSTERF");
+        dsterf_(&n, D, E, &info);
+        stage_end(&st[ST_TRI]);
+        if (info != 0) { fprintf(stderr, "DSTERF failed, info=%d\n", info); rc = 4; goto DONE; }
+    } else {
+        if (mmap_matrix_create(&Z, out_path, n, n) != 0) { rc = 4; goto DONE; }
+
+        int lwork = -1, liwork = -1, iwkopt = 0; double wkopt = 0.0;
+        dstedc_(&compz, &n, D, E, Z.a, &n, &wkopt, &lwork, &iwkopt, &liwork, &info);
+        if (info != 0) { fprintf(stderr, "DSTEDC workspace query failed, info=%d\n", info); rc = 4; goto DONE; }
+        lwork  = (int)wkopt; if (lwork  < 1) lwork  = 1;
+        liwork = iwkopt;     if (liwork < 1) liwork = 1;
+        if (mmap_matrix_scratch(&WK, NULL, lwork, 1) != 0) { rc = 4; goto DONE; }
+        IWORK = (int*)malloc((size_t)liwork * sizeof(int));
+        if (!IWORK) { fprintf(stderr, "Allocation failed (IWORK)\n"); rc = 4; goto DONE; }
+
+        stage_begin(&st[ST_TRI], stage_name[ST_TRI]);
+        dstedc_(&compz, &n, D, E, Z.a, &n, WK.a, &lwork, IWORK, &liwork, &info);
+        mmap_matrix_close(&WK);
+        mmap_matrix_release(&Z, 0, n);
+        stage_end(&st[ST_TRI]);
+        if (info != 0) { fprintf(stderr, "DSTEDC failed, info=%d\n", info); rc = 4; goto DONE; }
+
+        /* ---- 5) back-transform Z <- Q1*Q2*Z, one column panel at a time ---- */
+        const double one = 1.0, zero = 0.0;
+        int lw = -1, m0 = ooc_panel_rows(n, kd, 0); double wq = 0.0;
+        if (m0 > 1) {
+            dormqr_(&left, &notrans, &m0, &pc, &kd, A.a, &n, TAU, Z.a, &n, &wq, &lw, &info);
+            if (info != 0) { fprintf(stderr, "DORMQR workspace query failed, info=%d\n", info); rc = 5; goto DONE; }
+        }
+        lw = (int)wq; if (lw < 1) lw = 1;
+        BTW = (double*)malloc((size_t)lw * sizeof(double));
+        PAN = (double*)malloc((size_t)n * pc * sizeof(double));
+        if (!BTW || !PAN) { fprintf(stderr, "Allocation failed (back-transform panel)\n"); rc = 5; goto DONE; }
+
+        int jlast = 0;
+        while (ooc_panel_rows(n, kd, jlast + kd) > 1) jlast += kd;
+
+        stage_begin(&st[ST_BT], stage_name[ST_BT]);
+        for (int p = 0; p < n && info == 0; p += pc) {
+            const int w = (p + pc < n) ? pc : n - p;
+            mmap_matrix_prefetch(&Z, p, p + w);
+            dgemm_(&notrans, &notrans, &n, &w, &n, &one, Q2.a, &n, &Z.a[(size_t)p * n], &n, &zero, PAN, &n);
+            mmap_matrix_release(&Q2, 0, n);
+            for (int j = jlast; m0 > 1 && j >= 0 && info == 0; j -= kd) {
+                const int s = j + kd, m = n - s, k = (m < kd) ? m : kd;
+                dormqr_(&left, &notrans, &m, &w, &k, &A.a[s + (size_t)j * n], &n, &TAU[j],
+                        &PAN[s], &n, BTW, &lw, &info);
+            }
+            mmap_matrix_release(&A, 0, n);
+            memcpy(&Z.a[(size_t)p * n], PAN, (size_t)w * n * sizeof(double));
+            mmap_matrix_release(&Z, p, p + w);
+        }
+        stage_end(&st[ST_BT]);
+        if (info != 0) { fprintf(stderr, "DORMQR failed, info=%d\n", info); rc = 5; goto DONE; }
+    }
+
+    /* ---- 6) check: sampled residuals (streamed A) and orthogonality ---- */
+    if (samples > 0) {
+        stage_begin(&st[ST_CHECK], stage_name[ST_CHECK]);
+        ZS = (double*)malloc((size_t)n * samples * sizeof(double));
+        Y  = (double*)calloc((size_t)n * samples, sizeof(double));
+        if (!ZS || !Y) { fprintf(stderr, "Allocation failed (check)\n"); rc = 6; goto DONE; }
+        for (int q = 0; q < samples; ++q) {
+            const int j = (samples > 1) ? (int)((long long)q * (n - 1) / (samples - 1)) : 0;
+            memcpy(&ZS[(size_t)q * n], &Z.a[(size_t)j * n], (size_t)n * sizeof(double));
+        }
+        mmap_matrix_release(&Z, 0, n);
+        orth = 0.0;
+        for (int q = 0; q < samples; ++q)
+            for (int r = 0; r <= q; ++r) {
+                double d = 0.0;
+                for (int i = 0; i < n; ++i) d += ZS[(size_t)r * n + i] * ZS[(size_t)q * n + i];
+                if (fabs(d - (r == q ? 1.0 : 0.0)) > orth) orth = fabs(d - (r == q ? 1.0 : 0.0));
+            }
+        if (!inplace) {
+            const double one = 1.0;
+            mmap_matrix_t in = { .fd = -1 };
+            if (mmap_matrix_open(&in, in_path, n, n, 0) != 0) { rc = 6; goto DONE; }
+            for (int p = 0; p < n; p += pc) {
+                const int w = (p + pc < n) ? pc : n - p;
+                mmap_matrix_prefetch(&in, p, p + w);
+                dgemm_(&notrans, &notrans, &n, &samples, &w, &one, &in.a[(size_t)p * n], &n,
+                       &ZS[p], &n, &one, Y, &n);
+                mmap_matrix_release(&in, p, p + w);
+            }
+            mmap_matrix_close(&in);
+            const double anorm = fmax(fabs(D[0]), fabs(D[n - 1]));
+            res_max = 0.0;
+            for (int q = 0; q < samples; ++q) {
+                const int j = (samples > 1) ? (int)((long long)q * (n - 1) / (samples - 1)) : 0;
+                double r2 = 0.0;
+                for (int i = 0; i < n; ++i) {
+                    const double d = Y[(size_t)q * n + i] - D[j] * ZS[(size_t)q * n + i];
+                    r2 += d * d;
+                }
+                if (sqrt(r2) / anorm > res_max) res_max = sqrt(r2) / anorm;
+            }
+        }
+        stage_end(&st[ST_CHECK]);
+    }
+
+    /* ---- Report ---- */
+    {
+        struct rusage ru; getrusage(RUSAGE_SELF, &ru);
+        double total = 0.0;
+        for (int k = 0; k < NSTAGE; ++k) if (st[k].name) { stage_print(stdout, &st[k]); total += st[k].secs; }
+        printf("%-14s %10.3f s   peak RSS=%.1f MB (matrix: %.1f MB)\n", "TOTAL", total,
+               ru.ru_maxrss / 1024.0, (double)n * n * 8 / 1048576.0);
+        if (samples > 0) {
+            printf("Check: %d sampled z: ", samples);
+            if (res_max >= 0.0) printf("max ||Az - lz||/||A|| = %.3e, ", res_max);
+            else                printf("residual n/a (--inplace overwrote A), ");
+            printf("max |Z^T Z - I| = %.3e\n", orth);
+        }
+
+        const char *outdir = "../output";
+        ensure_dir(outdir);
+        FILE *ft = fopen("../output/ooc_time.txt", "w");
+        if (ft) {
+            fprintf(ft, "Mode: OOC two-stage (n=%d, JOBZ='%c', kd=%d, panel=%d, %s)\n",
+                    n, jobz, kd, pc, inplace ? "in place" : "scratch copy");
+            for (int k = 0; k < NSTAGE; ++k) if (st[k].name) stage_print(ft, &st[k]);
+            fprintf(ft, "TOTAL %.6f s  peak_rss_mb=%.1f\n", total, ru.ru_maxrss / 1024.0);
+            if (res_max >= 0.0) fprintf(ft, "RESID %.3e\n", res_max);
+            if (orth >= 0.0)    fprintf(ft, "ORTH  %.3e\n", orth);
+            fclose(ft);
+        }
+        FILE *fw = fopen("../output/ooc_eigenvalues.txt", "w");
+        if (fw) {
+            for (int i = 0; i < n; ++i) fprintf(fw, "%.12e\n", D[i]);
+            fclose(fw);
+        }
+        if (jobz == 'V') printf("Eigenvectors (column-major, %d x %d) in %s\n", n, n, out_path);
+    }
+
+DONE:
+    free(Y); free(ZS); free(PAN); free(BTW); free(IWORK);
+    mmap_matrix_close(&WK);
+    mmap_matrix_close(&Q2);
+    mmap_matrix_close(&Z);
+    mmap_matrix_close(&A);
+    free(SBW); free(AB); free(TAU); free(E); free(D);
+    return rc;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 4 && strcmp(argv[1], "gen") == 0) {
+        int n = atoi(argv[3]);
+        double rho = (argc > 4) ? atof(argv[4]) : 0.95;
+        if (n <= 0) { fprintf(stderr, "Invalid n\n"); return 1; }
+        return gen_kms_file(argv[2], n, rho);
+    }
+    if (argc >= 5 && strcmp(argv[1], "solve") == 0) {
+        int n = atoi(argv[3]);
+        char jobz = 'V';
+        int inplace = 0;
+        for (int k = 5; k < argc; ++k) {
+            if (strcmp(argv[k], "--inplace") == 0) inplace = 1;
+            else if (argv[k][0] == 'N' || argv[k][0] == 'n') jobz = 'N';
+        }
+        if (n <= 0) { fprintf(stderr, "Invalid n\n"); return 1; }
+        return solve(argv[2], n, argv[4], jobz, inplace);
+    }
+    fprintf(stderr,
+            "Usage:\n"
+            "  %s gen   <A.bin> <n> [rho]\n"
+            "  %s solve <A.bin> <n> <Z.bin> [V|N] [--inplace]\n", argv[0], argv[0]);
+    return 1;
+}
@@ -0,0 +1,352 @@
+// pipe_run.c — stage-pipelined throughput mode for a stream of matrices.
+// Every job is the stedc_run.c chain on its own KMS matrix (rho varies per
+// job): DSYTRD -> DORGTR -> DSTEDC('V'). The sequential baseline runs the
+// chain job after job with multithreaded BLAS; the pipeline
+// (common/src/stage_pipe.h) gives every stage its own cores and overlaps
+// consecutive jobs, e.g. job i+1 in the memory-bound reduction while job i
+// is in the D&C merges, with one single-threaded-BLAS worker per core.
+//
+// Usage: pipe_run [n] [jobs]                    defaults 800, 24
+// Env:
+//   PIPE_CORES             cores per stage "sytrd,orgtr,stedc" (default:
+//                          the CPUs of the affinity mask, split in
+//                          proportion to the baseline's stage times; with
+//                          fewer CPUs than stages, stages share them)
+//   PIPE_DEPTH             matrices in flight (default: workers + 2)
+//   PIPE_QUEUE             queue entries between stages (default 2)
+//   PIPE_BASELINE          0 skips the sequential baseline
+//   PIPE_BASELINE_THREADS  BLAS threads of the baseline (default: all CPUs)
+// The KMS fill is part of the first stage in both modes (the stream's
+// input). Eigenvalues of every job are compared between the two modes.
+// Results: stdout + ../output/pipe_time.txt
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <math.h>
+#include <sched.h>
+#include <sys/stat.h>
+
+#include "stage_pipe.h" /* ../../common/src: pinned stage workers, bounded queues */
+
+#ifndef EIG_BACKEND
+#define EIG_BACKEND "unknown"     /* build_run.sh passes the case name */
+#endif
+
+/* --------- Fortran LAPACK symbols (vendor-agnostic) --------- */
+extern void dsytrd_(const char *UPLO, const int *N,
+                    double *A, const int *LDA,
+                    double *D, double *E, double *TAU,
+                    double *WORK, const int *LWORK, int *INFO);
+
+extern void dorgtr_(const char *UPLO, const int *N,
+                    double *A, const int *LDA, double *TAU,
+                    double *WORK, const int *LWORK, int *INFO);
+
+extern void dstedc_(const char *COMPZ, const int *N,
+                    double *D, double *E,
+                    double *Z, const int *LDZ,
+                    double *WORK, const int *LWORK,
+                    int *IWORK, const int *LIWORK,
+                    int *INFO);
+
+/* BLAS thread count at run time, where the backend has it: OpenBLAS's pool
+   is process-wide; ArmPL follows the OpenMP ICV of the calling thread. */
+extern void openblas_set_num_threads(int) __attribute__((weak));
+extern void omp_set_num_threads(int)      __attribute__((weak));
+
+#define NSTAGE 3
+static const char *STAGE_NAME[NSTAGE] = { "DSYTRD", "DORGTR", "DSTEDC" };
+
+/* --------- Utilities --------- */
+static void ensure_dir(const char *path) {
+    if (mkdir(path, 0777) != 0 && errno != EEXIST) {
+        perror("mkdir");
+        exit(5);
+    }
+}
+
+static double elapsed_seconds(struct timespec a, struct timespec b) {
+    return (b.tv_sec - a.tv_sec) + (b.tv_nsec - a.tv_nsec) / 1e9;
+}
+
+static int env_int(const char *name, int dflt) {
+    const char *v = getenv(name);
+    return (v && *v) ? atoi(v) : dflt;
+}
+
+static int set_blas_threads(int nt)
+{
+    if (openblas_set_num_threads) openblas_set_num_threads(nt);
+    if (omp_set_num_threads) omp_set_num_threads(nt);
+    return openblas_set_num_threads || omp_set_num_threads;
+}
+
+/* --------- Jobs --------- */
+
+typedef struct { double *A, *D, *E, *TAU; } slot_t;      /* one matrix in flight */
+typedef struct { double *work; int *iwork; } ws_t;       /* one worker's warm workspace */
+
+typedef struct {
+    int     n;
+    int     lwork[NSTAGE], liwork;
+    ws_t   *ws[NSTAGE];          /* per stage, one per worker */
+    double *W;                   /* jobs x n eigenvalues      */
+} pipe_ctx_t;
+
+static double job_rho(long job) { return 0.50 + 0.45 * (double)((job * 37) % 100) / 100.0; }
+
+/* KMS A_ij = rho^{|i-j|}, both triangles (as stedc_run.c); D holds the powers */
+static void fill_kms(double *A, double *rp, int n, double rho)
+{
+    rp[0] = 1.0;
+    for (int k = 1; k < n; ++k) rp[k] = rp[k-1] * rho;
+    for (int j = 0; j < n; ++j)
+        for (int i = 0; i <= j; ++i) {
+            A[i + (size_t)j * n] = rp[j - i];
+            A[j + (size_t)i * n] = rp[j - i];
+        }
+}
+
+static int run_stage(int stage, int worker, long job, void *vslot, void *varg)
+{
+    pipe_ctx_t *c = (pipe_ctx_t*)varg;
+    slot_t *s = (slot_t*)vslot;
+    const ws_t *w = &c->ws[stage][worker];
+    const char uplo = 'U', compz = 'V';
+    const int n = c->n;
+    int info = 0;
+    switch (stage) {
+    case 0:
+        fill_kms(s->A, s->D, n, job_rho(job));
+        dsytrd_(&uplo, &n, s->A, &n, s->D, s->E, s->TAU, w->work, &c->lwork[0], &info);
+        break;
+    case 1:
+        dorgtr_(&uplo, &n, s->A, &n, s->TAU, w->work, &c->lwork[1], &info);
+        break;
+    default:
+        dstedc_(&compz, &n, s->D, s->E, s->A, &n, w->work, &c->lwork[2], w->iwork, &c->liwork, &info);
+        if (info == 0) memcpy(c->W + (size_t)job * n, s->D, (size_t)n * sizeof(double));
+        break;
+    }
+    if (info != 0) fprintf(stderr, "[pipe] job %ld: %s INFO=%d\n", job, STAGE_NAME[stage], info);
+    return info;
+}
+
+static int slot_alloc(slot_t *s, int n)
+{
+    s->A   = (double*)malloc((size_t)n * n * sizeof(double));
+    s->D   = (double*)malloc((size_t)n * sizeof(double));
+    s->E   = (double*)malloc((size_t)n * sizeof(double));
+    s->TAU = (double*)malloc((size_t)n * sizeof(double));
+    if (!s->A || !s->D || !s->E || !s->TAU) return -1;
+    memset(s->A, 0, (size_t)n * n * sizeof(double));     /* faulted before any clock */
+    return 0;
+}
+
+static void slot_free(slot_t *s) { free(s->A); free(s->D); free(s->E); free(s->TAU); }
+
+static int ws_alloc(const pipe_ctx_t *c, int stage, ws_t *w)
+{
+    w->work  = (double*)malloc((size_t)c->lwork[stage] * sizeof(double));
+    w->iwork = stage == 2 ? (int*)malloc((size_t)c->liwork * sizeof(int)) : NULL;
+    if (!w->work || (stage == 2 && !w->iwork)) return -1;
+    memset(w->work, 0, (size_t)c->lwork[stage] * sizeof(double));
+    return 0;
+}
+
+/* Workspace sizes of the three stages for order n (queries on a scratch A). */
+static int query_workspace(pipe_ctx_t *c)
+{
+    const char uplo = 'U', compz = 'V';
+    const int n = c->n, q = -1;
+    int info = 0, iwkopt = 0;
+    double wkopt = 0.0, d = 0.0;
+    dsytrd_(&uplo, &n, &d, &n, &d, &d, &d, &wkopt, &q, &info);
+    if (info != 0) return info;
+    c->lwork[0] = (int)wkopt;
+    dorgtr_(&uplo, &n, &d, &n, &d, &wkopt, &q, &info);
+    if (info != 0) return info;
+    c->lwork[1] = (int)wkopt;
+    dstedc_(&compz, &n, &d, &d, &d, &n, &wkopt, &q, &iwkopt, &q, &info);
+    if (info != 0) return info;
+    c->lwork[2] = (int)wkopt;
+    c->liwork   = iwkopt;
+    return 0;
+}
+
+/* Stage core counts: PIPE_CORES, else one each plus the rest of the ncpu
+   CPUs handed out greedily to the stage with the largest time per core. */
+static void partition(int ncpu, const double *t, int *cores)
+{
+    const char *env = getenv("PIPE_CORES");
+    if (env && *env) {
+        const char *p = env;
+        for (int s = 0; s < NSTAGE; ++s) {
+            cores[s] = (*p) ? atoi(p) : 1;
+            if (cores[s] < 1) cores[s] = 1;
+            while (*p && *p != ',') ++p;
+            if (*p == ',') ++p;
+        }
+        return;
+    }
+    for (int s = 0; s < NSTAGE; ++s) cores[s] = 1;
+    for (int left = ncpu - NSTAGE; left > 0; --left) {
+        int best = 0;
+        for (int s = 1; s < NSTAGE; ++s)
+            if (t[s] / cores[s] > t[best] / cores[best]) best = s;
+        cores[best]++;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const int  n    = (argc > 1) ? atoi(argv[1]) : 800;
+    const long jobs = (argc > 2) ? atol(argv[2]) : 24;
+    if (n <= 0 || jobs <= 0) { fprintf(stderr, "Usage: %s [n] [jobs]\n", argv[0]); return 1; }
+
+    int cpus[CPU_SETSIZE], ncpu = 0;
+    cpu_set_t mask;
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0)
+        for (int c = 0; c < CPU_SETSIZE; ++c)
+            if (CPU_ISSET(c, &mask)) cpus[ncpu++] = c;
+    if (ncpu == 0) cpus[ncpu++] = 0;
+
+    pipe_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.n = n;
+    int info = query_workspace(&ctx);
+    if (info != 0) { fprintf(stderr, "[pipe] workspace query failed: INFO=%d\n", info); return 2; }
+    ctx.W = (double*)calloc((size_t)jobs * n, sizeof(double));
+    double *Wb = (double*)calloc((size_t)jobs * n, sizeof(double));
+    if (!ctx.W || !Wb) { fprintf(stderr, "Allocation failed (W)\n"); return 6; }
+
+    /* ---- Sequential baseline: worker 0 of each stage, one slot ---- */
+    const int do_base = env_int("PIPE_BASELINE", 1) != 0;
+    const int base_nt = env_int("PIPE_BASELINE_THREADS", ncpu);
+    double t_stage[NSTAGE] = { 1.0, 1.0, 1.0 }, t_base = 0.0;
+    long base_failed = 0;
+    for (int s = 0; s < NSTAGE; ++s) {
+        ctx.ws[s] = (ws_t*)calloc(1, sizeof(ws_t));
+        if (!ctx.ws[s] || ws_alloc(&ctx, s, &ctx.ws[s][0]) != 0) {
+            fprintf(stderr, "Allocation failed (workspace)\n"); return 6;
+        }
+    }
+    if (do_base) {
+        slot_t s0;
+        if (slot_alloc(&s0, n) != 0) { fprintf(stderr, "Allocation failed (slot)\n"); return 6; }
+        if (set_blas_threads(base_nt))
+            printf("[pipe] baseline: %ld x n=%d sequential, BLAS threads=%d\n", jobs, n, base_nt);
+        else
+            printf("[pipe] baseline: %ld x n=%d sequential, BLAS threads from the environment\n", jobs, n);
+        double *Wp = ctx.W;
+        ctx.W = Wb;
+        for (int s = 0; s < NSTAGE; ++s) t_stage[s] = 0.0;
+        for (long j = 0; j < jobs; ++j)
+            for (int s = 0; s < NSTAGE; ++s) {
+                struct timespec t0, t1;
+                clock_gettime(CLOCK_MONOTONIC, &t0);
+                const int rc = run_stage(s, 0, j, &s0, &ctx);
+                clock_gettime(CLOCK_MONOTONIC, &t1);
+                t_stage[s] += elapsed_seconds(t0, t1);
+                if (rc != 0) { base_failed++; break; }
+            }
+        ctx.W = Wp;
+        for (int s = 0; s < NSTAGE; ++s) t_base += t_stage[s];
+        slot_free(&s0);
+    }
+
+    /* ---- Partition and warm workspaces for every worker ---- */
+    int cores[NSTAGE];
+    partition(ncpu, t_stage, cores);
+    int nworkers = 0;
+    for (int s = 0; s < NSTAGE; ++s) nworkers += cores[s];
+    int *cpu_of = (int*)malloc((size_t)nworkers * sizeof(int));
+    if (!cpu_of) { fprintf(stderr, "Allocation failed (cpus)\n"); return 6; }
+    for (int w = 0; w < nworkers; ++w) cpu_of[w] = cpus[w % ncpu];   /* wraps: stages share CPUs */
+
+    stage_pipe_stage_t stages[NSTAGE];
+    for (int s = 0, off = 0; s < NSTAGE; off += cores[s], ++s) {
+        ws_t *grown = (ws_t*)realloc(ctx.ws[s], (size_t)cores[s] * sizeof(ws_t));
+        if (!grown) { fprintf(stderr, "Allocation failed (workspace)\n"); return 6; }
+        ctx.ws[s] = grown;
+        for (int w = 1; w < cores[s]; ++w)
+            if (ws_alloc(&ctx, s, &ctx.ws[s][w]) != 0) { fprintf(stderr, "Allocation failed (workspace)\n"); return 6; }
+        stages[s].name  = STAGE_NAME[s];
+        stages[s].run   = run_stage;
+        stages[s].cpus  = cpu_of + off;
+        stages[s].ncpus = cores[s];
+    }
+
+    int depth = env_int("PIPE_DEPTH", nworkers + 2), qcap = env_int("PIPE_QUEUE", 2);
+    if (depth < 1) depth = 1;
+    if (qcap < 1)  qcap = 1;
+    slot_t *slots = (slot_t*)calloc((size_t)depth, sizeof(slot_t));
+    void  **sp    = (void**)calloc((size_t)depth, sizeof(void*));
+    if (!slots || !sp) { fprintf(stderr, "Allocation failed (slots)\n"); return 6; }
+    for (int i = 0; i < depth; ++i) {
+        if (slot_alloc(&slots[i], n) != 0) { fprintf(stderr, "Allocation failed (slot)\n"); return 6; }
+        sp[i] = &slots[i];
+    }
+
+    /* ---- Pipeline ---- */
+    set_blas_threads(1);
+    printf("[pipe] pipeline: %d CPUs, cores %s=%d %s=%d %s=%d%s, slots=%d, queue=%d\n",
+           ncpu, STAGE_NAME[0], cores[0], STAGE_NAME[1], cores[1], STAGE_NAME[2], cores[2],
+           nworkers > ncpu ? " (oversubscribed)" : "", depth, qcap);
+    stage_pipe_stats_t st[NSTAGE];
+    stage_pipe_summary_t sum;
+    const int rc = stage_pipe_run(stages, NSTAGE, sp, depth, qcap, jobs, &ctx, st, &sum);
+    if (rc < 0) { fprintf(stderr, "[pipe] pipeline failed to start\n"); return 7; }
+
+    /* ---- Report ---- */
+    double maxdiff = 0.0;
+    if (do_base)
+        for (size_t i = 0; i < (size_t)jobs * n; ++i) {
+            const double d = fabs(ctx.W[i] - Wb[i]);
+            if (d > maxdiff) maxdiff = d;
+        }
+    const double rate_pipe = jobs / sum.seconds;
+    const double rate_base = do_base ? jobs / t_base : 0.0;
+
+    printf("\n%-8s %5s %6s %10s %10s %10s %6s\n", "stage", "cores", "jobs", "busy(s)", "starve(s)", "blocked(s)", "util");
+    for (int s = 0; s < NSTAGE; ++s)
+        printf("%-8s %5d %6ld %10.4f %10.4f %10.4f %5.1f%%\n", STAGE_NAME[s], cores[s], st[s].jobs,
+               st[s].busy, st[s].starve, st[s].blocked,
+               100.0 * st[s].busy / (cores[s] * sum.seconds));
+    printf("\nPipeline  %.4f s  %.3f matrices/s  latency avg %.4f s max %.4f s  feed wait %.4f s  failed %d\n",
+           sum.seconds, rate_pipe, sum.lat_avg, sum.lat_max, sum.feed_wait, rc);
+    if (do_base) {
+        printf("Baseline  %.4f s  %.3f matrices/s  (%s %.4f | %s %.4f | %s %.4f s)  failed %ld\n",
+               t_base, rate_base, STAGE_NAME[0], t_stage[0], STAGE_NAME[1], t_stage[1],
+               STAGE_NAME[2], t_stage[2], base_failed);
+        printf("Speedup   %.2fx   max |W_pipe - W_base| = %.3e\n", rate_pipe / rate_base, maxdiff);
+    }
+
+    ensure_dir("../output");
+    FILE *ft = fopen("../output/pipe_time.txt", "w");
+    if (ft) {
+        fprintf(ft, "Backend: %s  n=%d jobs=%ld CPUs=%d slots=%d queue=%d\n", EIG_BACKEND, n, jobs, ncpu, depth, qcap);
+        for (int s = 0; s < NSTAGE; ++s)
+            fprintf(ft, "%-8s cores=%d busy=%.6f starve=%.6f blocked=%.6f\n", STAGE_NAME[s], cores[s],
+                    st[s].busy, st[s].starve, st[s].blocked);
+        fprintf(ft, "PIPELINE %.6f s  %.6f matrices/s  lat_avg=%.6f lat_max=%.6f\n",
+                sum.seconds, rate_pipe, sum.lat_avg, sum.lat_max);
+        if (do_base) {
+            fprintf(ft, "BASELINE %.6f s  %.6f matrices/s  threads=%d\n", t_base, rate_base, base_nt);
+            fprintf(ft, "SPEEDUP  %.6f  max_eig_diff=%.3e\n", rate_pipe / rate_base, maxdiff);
+        }
+        fclose(ft);
+    }
+
+    for (int i = 0; i < depth; ++i) slot_free(&slots[i]);
+    for (int s = 0; s < NSTAGE; ++s) {
+        for (int w = 0; w < cores[s]; ++w) { free(ctx.ws[s][w].work); free(ctx.ws[s][w].iwork); }
+        free(ctx.ws[s]);
+    }
+    free(sp); free(slots); free(cpu_of); free(Wb); free(ctx.W);
+    return (rc > 0 || base_failed > 0) ? 3 : 0;
+}
@@ -0,0 +1,387 @@
+// prec_run.c — the DSYEVD / DSTEDC pipelines in single precision (SSYEVD,
+// SSYTRD -> SORGTR -> SSTEDC) and complex Hermitian (ZHEEVD,
+// ZHETRD -> ZUNGTR -> ZSTEDC), with the same per-stage breakdown as
+// DSYEVD/src/syevd.c and DSTEDC/src/stedc_run.c. One source, one precision
+// per build: -DPREC_S, -DPREC_D (default, the reference) or -DPREC_Z.
+// It is a separate driver, not a precision switch on syevd.c / stedc_run.c /
+// kms_to_tridiag.c: those stay double-only, with their cache, band-route,
+// MEM_BUDGET and OOC paths, none of which exist here. The d build is the
+// bridge: same matrix and stages as the double drivers, so s and z runs are
+// compared against it, not against them.
+//
+// Usage: prec_run [n] [mode] [jobz]
+//   mode  evd    : xSYEVD / ZHEEVD in one call (default)
+//         staged : xSYTRD / ZHETRD, xORGTR / ZUNGTR, xSTEDC('V') timed apart
+//   jobz  V (default) or N (evd only)
+// Matrix: KMS A_ij = rho^|i-j| (rho = 0.95). For Z the Hermitian
+// A_ij = rho^|i-j| * exp(i*theta*(i-j)) = D K D^H (D diagonal unitary), so all
+// three builds have the same eigenvalues and their outputs can be diffed.
+// MATRIX_INPUT=<file> loads a real matrix (mat_io) and converts it.
+// Per stage: time, an arithmetic rate from the textbook flop counts
+// (complex flops counted as 4 real ones) and, for the reduction, the rate
+// at which its matrix-vector half streams the trailing matrix
+// (n^3/3 elements read): that is the figure float32 should halve the time of.
+// PREC_CHECK=0 skips the residual check of the largest eigenpair (it keeps a
+// copy of A).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <math.h>
+#include <sys/stat.h>
+
+#include "mat_io.h"     /* ../../common/src: MATRIX_INPUT=<.mtx|.npy|raw> instead of KMS */
+#include "mem_budget.h" /* ../../common/src: per-stage page faults (mem_usage_t)          */
+
+#ifndef EIG_BACKEND
+#define EIG_BACKEND "unknown"     /* build_run.sh passes the case name */
+#endif
+
+/* --------- Precision selection --------- */
+#if defined(PREC_S)
+typedef float  real_t;
+typedef float  elem_t;
+#  define PREC_CH   's'
+#  define PREC_DESC "single precision real"
+#  define R_EVD     "SSYEVD"
+#  define R_TRD     "SSYTRD"
+#  define R_ORG     "SORGTR"
+#  define R_STC     "SSTEDC"
+#elif defined(PREC_Z)
+typedef double real_t;
+typedef struct { double re, im; } elem_t;
+#  define PREC_CH   'z'
+#  define PREC_DESC "double complex Hermitian"
+#  define R_EVD     "ZHEEVD"
+#  define R_TRD     "ZHETRD"
+#  define R_ORG     "ZUNGTR"
+#  define R_STC     "ZSTEDC"
+#  define PREC_COMPLEX 1
+#else
+typedef double real_t;
+typedef double elem_t;
+#  define PREC_CH   'd'
+#  define PREC_DESC "double precision real"
+#  define R_EVD     "DSYEVD"
+#  define R_TRD     "DSYTRD"
+#  define R_ORG     "DORGTR"
+#  define R_STC     "DSTEDC"
+#endif
+#ifndef PREC_COMPLEX
+#  define PREC_COMPLEX 0
+#endif
+
+/* --------- Fortran LAPACK symbols (vendor-agnostic) --------- */
+#if defined(PREC_S)
+extern void ssyevd_(const char *JOBZ, const char *UPLO, const int *N, float *A, const int *LDA,
+                    float *W, float *WORK, const int *LWORK, int *IWORK, const int *LIWORK, int *INFO);
+extern void ssytrd_(const char *UPLO, const int *N, float *A, const int *LDA, float *D, float *E,
+                    float *TAU, float *WORK, const int *LWORK, int *INFO);
+extern void sorgtr_(const char *UPLO, const int *N, float *A, const int *LDA, const float *TAU,
+                    float *WORK, const int *LWORK, int *INFO);
+extern void sstedc_(const char *COMPZ, const int *N, float *D, float *E, float *Z, const int *LDZ,
+                    float *WORK, const int *LWORK, int *IWORK, const int *LIWORK, int *INFO);
+#elif defined(PREC_Z)
+extern void zheevd_(const char *JOBZ, const char *UPLO, const int *N, elem_t *A, const int *LDA,
+                    double *W, elem_t *WORK, const int *LWORK, double *RWORK, const int *LRWORK,
+                    int *IWORK, const int *LIWORK, int *INFO);
+extern void zhetrd_(const char *UPLO, const int *N, elem_t *A, const int *LDA, double *D, double *E,
+                    elem_t *TAU, elem_t *WORK, const int *LWORK, int *INFO);
+extern void zungtr_(const char *UPLO, const int *N, elem_t *A, const int *LDA, const elem_t *TAU,
+                    elem_t *WORK, const int *LWORK, int *INFO);
+extern void zstedc_(const char *COMPZ, const int *N, double *D, double *E, elem_t *Z, const int *LDZ,
+                    elem_t *WORK, const int *LWORK, double *RWORK, const int *LRWORK,
+                    int *IWORK, const int *LIWORK, int *INFO);
+#else
+extern void dsyevd_(const char *JOBZ, const char *UPLO, const int *N, double *A, const int *LDA,
+                    double *W, double *WORK, const int *LWORK, int *IWORK, const int *LIWORK, int *INFO);
+extern void dsytrd_(const char *UPLO, const int *N, double *A, const int *LDA, double *D, double *E,
+                    double *TAU, double *WORK, const int *LWORK, int *INFO);
+extern void dorgtr_(const char *UPLO, const int *N, double *A, const int *LDA, const double *TAU,
+                    double *WORK, const int *LWORK, int *INFO);
+extern void dstedc_(const char *COMPZ, const int *N, double *D, double *E, double *Z, const int *LDZ,
+                    double *WORK, const int *LWORK, int *IWORK, const int *LIWORK, int *INFO);
+#endif
+
+/* One calling convention for all precisions: RWORK/LRWORK only reach the
+   complex routines. */
+static void x_evd(char jobz, char uplo, int n, elem_t *A, int lda, real_t *W, elem_t *work, int lwork,
+                  real_t *rwork, int lrwork, int *iwork, int liwork, int *info)
+{
+#if defined(PREC_S)
+    (void)rwork; (void)lrwork;
+    ssyevd_(&jobz, &uplo, &n, A, &lda, W, work, &lwork, iwork, &liwork, info);
+#elif defined(PREC_Z)
+    zheevd_(&jobz, &uplo, &n, A, &lda, W, work, &lwork, rwork, &lrwork, iwork, &liwork, info);
+#else
+    (void)rwork; (void)lrwork;
+    dsyevd_(&jobz, &uplo, &n, A, &lda, W, work, &lwork, iwork, &liwork, info);
+#endif
+}
+
+static void x_trd(char uplo, int n, elem_t *A, int lda, real_t *D, real_t *E, elem_t *TAU,
+                  elem_t *work, int lwork, int *info)
+{
+#if defined(PREC_S)
+    ssytrd_(&uplo, &n, A, &lda, D, E, TAU, work, &lwork, info);
+#elif defined(PREC_Z)
+    zhetrd_(&uplo, &n, A, &lda, D, E, TAU, work, &lwork, info);
+#else
+    dsytrd_(&uplo, &n, A, &lda, D, E, TAU, work, &lwork, info);
+#endif
+}
+
+static void x_org(char uplo, int n, elem_t *A, int lda, const elem_t *TAU, elem_t *work, int lwork, int *info)
+{
+#if defined(PREC_S)
+    sorgtr_(&uplo, &n, A, &lda, TAU, work, &lwork, info);
+#elif defined(PREC_Z)
+    zungtr_(&uplo, &n, A, &lda, TAU, work, &lwork, info);
+#else
+    dorgtr_(&uplo, &n, A, &lda, TAU, work, &lwork, info);
+#endif
+}
+
+static void x_stc(char compz, int n, real_t *D, real_t *E, elem_t *Z, int ldz, elem_t *work, int lwork,
+                  real_t *rwork, int lrwork, int *iwork, int liwork, int *info)
+{
+#if defined(PREC_S)
+    (void)rwork; (void)lrwork;
+    sstedc_(&compz, &n, D, E, Z, &ldz, work, &lwork, iwork, &liwork, info);
+#elif defined(PREC_Z)
+    zstedc_(&compz, &n, D, E, Z, &ldz, work, &lwork, rwork, &lrwork, iwork, &liwork, info);
+#else
+    (void)rwork; (void)lrwork;
+    dstedc_(&compz, &n, D, E, Z, &ldz, work, &lwork, iwork, &liwork, info);
+#endif
+}
+
+/* workspace size returned by a query (real part for complex WORK) */
+static int ws_len(const elem_t *w)
+{
+#if PREC_COMPLEX
+    const int v = (int)w->re;
+#else
+    const int v = (int)*w;
+#endif
+    return v > 0 ? v : 1;
+}
+
+/* --------- Utilities --------- */
+static void ensure_dir(const char *path) {
+    if (mkdir(path, 0777) != 0 && errno != EEXIST) {
+        perror("mkdir");
+        exit(5);
+    }
+}
+
+static double elapsed_seconds(struct timespec a, struct timespec b) {
+    return (b.tv_sec - a.tv_sec) + (b.tv_nsec - a.tv_nsec) / 1e9;
+}
+
+static inline elem_t make_elem(double re, double im)
+{
+#if PREC_COMPLEX
+    elem_t e = { re, im };
+    return e;
+#else
+    (void)im;
+    return (elem_t)re;
+#endif
+}
+
+/* KMS (real) or its unitarily similar Hermitian variant (complex) */
+static void fill_kms(elem_t *A, int n, double rho)
+{
+    const double theta = PREC_COMPLEX ? 0.3 : 0.0;   /* phase only for the Hermitian variant */
+    double *rp = (double*)malloc((size_t)n * sizeof(double));
+    if (!rp) { fprintf(stderr, "Allocation failed (rp)\n"); exit(6); }
+    rp[0] = 1.0;
+    for (int k = 1; k < n; ++k) rp[k] = rp[k-1] * rho;
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i <= j; ++i) {
+            const double v = rp[j - i];
+            const double ph = theta * (double)(i - j);
+            A[i + (size_t)j * n] = make_elem(v * cos(ph),  v * sin(ph));
+            A[j + (size_t)i * n] = make_elem(v * cos(ph), -v * sin(ph));
+        }
+    }
+    free(rp);
+}
+
+/* ||A v - lambda v||_2 / |lambda| for column j of Z (A kept in A0) */
+static double residual(const elem_t *A0, const elem_t *Z, int n, int j, double lambda)
+{
+    double r2 = 0.0;
+    const elem_t *v = Z + (size_t)j * n;
+    for (int i = 0; i < n; ++i) {
+        double sr = 0.0, si = 0.0;
+        for (int k = 0; k < n; ++k) {
+            const elem_t a = A0[i + (size_t)k * n];
+#if PREC_COMPLEX
+            sr += a.re * v[k].re - a.im * v[k].im;
+            si += a.re * v[k].im + a.im * v[k].re;
+#else
+            sr += (double)a * (double)v[k];
+#endif
+        }
+#if PREC_COMPLEX
+        sr -= lambda * v[i].re; si -= lambda * v[i].im;
+#else
+        sr -= lambda * (double)v[i];
+#endif
+        r2 += sr * sr + si * si;
+    }
+    return sqrt(r2) / (fabs(lambda) > 0.0 ? fabs(lambda) : 1.0);
+}
+
+static void report(FILE *out, const char *name, double t, double flops, double stream_bytes,
+                   const mem_usage_t *a, const mem_usage_t *b)
+{
+    fprintf(out, "%-7s took %9.3f s  %7.2f GFLOP/s", name, t, t > 0.0 ? flops / t * 1e-9 : 0.0);
+    if (stream_bytes > 0.0) fprintf(out, "  %7.2f GB/s streamed", t > 0.0 ? stream_bytes / t * 1e-9 : 0.0);
+    fprintf(out, "  (minflt %ld)\n", b->minflt - a->minflt);
+}
+
+int main(int argc, char **argv)
+{
+    int n = (argc > 1) ? atoi(argv[1]) : 4000;
+    const int staged = (argc > 2 && strcmp(argv[2], "staged") == 0);
+    const char jobz = staged ? 'V' : ((argc > 3 && (argv[3][0] == 'N' || argv[3][0] == 'n')) ? 'N' : 'V');
+    const char uplo = 'U';
+    const double rho = 0.95;
+    const char *chk = getenv("PREC_CHECK");
+    const int check = !(chk && chk[0] == '0') && jobz == 'V';
+
+    /* ---- Input: file (MATRIX_INPUT, real, converted) or synthetic KMS ---- */
+    const char *input = getenv("MATRIX_INPUT");
+    mat_header_t hdr;
+    if (input) {
+        if (mat_probe(input, &hdr) != 0) { fprintf(stderr, "Cannot read %s\n", input); return 1; }
+        n = hdr.n;
+    }
+    if (n < 1) { fprintf(stderr, "Invalid n\n"); return 1; }
+    const int lda = n;
+    const size_t nn = (size_t)n * (size_t)n;
+
+    printf("Precision: %c (%s, %zu-byte elements) | backend %s | n=%d | %s%s\n",
+           PREC_CH, PREC_DESC, sizeof(elem_t), EIG_BACKEND, n,
+           staged ? R_TRD " -> " R_ORG " -> " R_STC "('V')" : R_EVD, staged ? "" : (jobz == 'V' ? " JOBZ='V'" : " JOBZ='N'"));
+
+    elem_t *A  = (elem_t*)malloc(nn * sizeof(elem_t));
+    real_t *W  = (real_t*)malloc((size_t)n * sizeof(real_t));
+    elem_t *A0 = check ? (elem_t*)malloc(nn * sizeof(elem_t)) : NULL;
+    if (!A || !W || (check && !A0)) { fprintf(stderr, "Allocation failed.\n"); return 1; }
+    if (input) {
+        double *tmp = (double*)malloc(nn * sizeof(double));
+        if (!tmp || mat_read(input, &hdr, tmp, lda) != 0) { fprintf(stderr, "Failed to load %s\n", input); return 1; }
+        for (size_t k = 0; k < nn; ++k) A[k] = make_elem(tmp[k], 0.0);
+        free(tmp);
+    } else {
+        fill_kms(A, n, rho);
+    }
+    if (check) memcpy(A0, A, nn * sizeof(elem_t));
+
+    const double cplx = PREC_COMPLEX ? 4.0 : 1.0;      /* real flops per complex flop */
+    const double n3 = (double)n * n * n;
+    double t_total = 0.0;
+    int info = 0;
+    mem_usage_t u[4];
+    char lines[3][192];
+    int nlines = 0;
+
+    if (!staged) {
+        /* ---- One driver call ---- */
+        elem_t wq; real_t rq = 0; int iq = 0;
+        x_evd(jobz, uplo, n, A, lda, W, &wq, -1, &rq, -1, &iq, -1, &info);
+        if (info != 0) { fprintf(stderr, "%s workspace query failed, info=%d\n", R_EVD, info); return 2; }
+        const int lwork = ws_len(&wq), lrwork = (int)rq > 0 ? (int)rq : 1, liwork = iq > 0 ? iq : 1;
+        elem_t *WORK  = (elem_t*)malloc((size_t)lwork * sizeof(elem_t));
+        real_t *RWORK = PREC_COMPLEX ? (real_t*)malloc((size_t)lrwork * sizeof(real_t)) : NULL;
+        int    *IWORK = (int*)malloc((size_t)liwork * sizeof(int));
+        if (!WORK || !IWORK || (PREC_COMPLEX && !RWORK)) { fprintf(stderr, "Allocation failed (WORK)\n"); return 1; }
+        struct timespec t0, t1;
+        mem_usage_now(&u[0]);
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        x_evd(jobz, uplo, n, A, lda, W, WORK, lwork, RWORK, lrwork, IWORK, liwork, &info);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        mem_usage_now(&u[1]);
+        if (info != 0) { fprintf(stderr, "%s failed, info=%d\n", R_EVD, info); return 2; }
+        t_total = elapsed_seconds(t0, t1);
+        /* reduction 4/3 n^3 (+ back-transform 2 n^3 and D&C ~ 4/3 n^3 with vectors) */
+        const double fl = cplx * (4.0 / 3.0 * n3 + (jobz == 'V' ? (2.0 + 4.0 / 3.0) * n3 : 0.0));
+        report(stdout, R_EVD, t_total, fl, 0.0, &u[0], &u[1]);
+        free(IWORK); free(RWORK); free(WORK);
+    } else {
+        /* ---- Staged: reduction, Q, tridiagonal D&C onto Q ---- */
+        real_t *E   = (real_t*)malloc((size_t)n * sizeof(real_t));
+        elem_t *TAU = (elem_t*)malloc((size_t)n * sizeof(elem_t));
+        if (!E || !TAU) { fprintf(stderr, "Allocation failed.\n"); return 1; }
+        const char *names[3] = { R_TRD, R_ORG, R_STC };
+        const double fl[3] = { cplx * 4.0 / 3.0 * n3, cplx * 4.0 / 3.0 * n3, cplx * 4.0 / 3.0 * n3 };
+        const double streamed[3] = { n3 / 3.0 * sizeof(elem_t), 0.0, 0.0 };
+        double t[3];
+        for (int s = 0; s < 3; ++s) {
+            elem_t wq; real_t rq = 0; int iq = 0;
+            if (s == 0) x_trd(uplo, n, A, lda, W, E, TAU, &wq, -1, &info);
+            if (s == 1) x_org(uplo, n, A, lda, TAU, &wq, -1, &info);
+            if (s == 2) x_stc('V', n, W, E, A, lda, &wq, -1, &rq, -1, &iq, -1, &info);
+            if (info != 0) { fprintf(stderr, "%s workspace query failed, info=%d\n", names[s], info); return 2; }
+            const int lwork = ws_len(&wq), lrwork = (int)rq > 0 ? (int)rq : 1, liwork = iq > 0 ? iq : 1;
+            elem_t *WORK  = (elem_t*)malloc((size_t)lwork * sizeof(elem_t));
+            real_t *RWORK = (s == 2 && PREC_COMPLEX) ? (real_t*)malloc((size_t)lrwork * sizeof(real_t)) : NULL;
+            int    *IWORK = (s == 2) ? (int*)malloc((size_t)liwork * sizeof(int)) : NULL;
+            if (!WORK || (s == 2 && !IWORK) || (s == 2 && PREC_COMPLEX && !RWORK)) {
+                fprintf(stderr, "Allocation failed (WORK for %s)\n", names[s]);
+                return 1;
+            }
+            struct timespec t0, t1;
+            mem_usage_now(&u[0]);
+            clock_gettime(CLOCK_MONOTONIC, &t0);
+            if (s == 0) x_trd(uplo, n, A, lda, W, E, TAU, WORK, lwork, &info);
+            if (s == 1) x_org(uplo, n, A, lda, TAU, WORK, lwork, &info);
+            if (s == 2) x_stc('V', n, W, E, A, lda, WORK, lwork, RWORK, lrwork, IWORK, liwork, &info);
+            clock_gettime(CLOCK_MONOTONIC, &t1);
+            mem_usage_now(&u[1]);
+            free(IWORK); free(RWORK); free(WORK);
+            if (info != 0) { fprintf(stderr, "%s failed, info=%d\n", names[s], info); return 2; }
+            t[s] = elapsed_seconds(t0, t1);
+            t_total += t[s];
+            report(stdout, names[s], t[s], fl[s], streamed[s], &u[0], &u[1]);
+            snprintf(lines[nlines++], sizeof(lines[0]), "%-7s %.6f s", names[s], t[s]);
+        }
+        free(TAU); free(E);
+    }
+    printf("Total   took %9.3f s\n", t_total);
+    printf("Eigenvalues: min %.8e  max %.8e\n", (double)W[0], (double)W[n - 1]);
+    double res = -1.0;
+    if (check) {
+        res = residual(A0, A, n, n - 1, (double)W[n - 1]);
+        printf("Residual ||A v - l v|| / |l| (largest pair): %.3e\n", res);
+    }
+
+    /* ---- Write outputs ---- */
+    const char *outdir = "../output";
+    ensure_dir(outdir);
+    char path_time[256], path_w[256];
+    snprintf(path_time, sizeof(path_time), "%s/prec_%c_%s_time.txt", outdir, PREC_CH, staged ? "staged" : "evd");
+    snprintf(path_w,    sizeof(path_w),    "%s/prec_%c_eigenvalues.txt", outdir, PREC_CH);
+    FILE *ft = fopen(path_time, "w");
+    if (ft) {
+        fprintf(ft, "Precision %c (%s), n=%d, backend %s, %s\n", PREC_CH, PREC_DESC, n, EIG_BACKEND,
+                staged ? "staged" : R_EVD);
+        for (int k = 0; k < nlines; ++k) fprintf(ft, "%s\n", lines[k]);
+        fprintf(ft, "TOTAL   %.6f s\n", t_total);
+        if (check) fprintf(ft, "RESID   %.3e\n", res);
+        fclose(ft);
+    }
+    FILE *fw = fopen(path_w, "w");
+    if (fw) {
+        for (int i = 0; i < n; ++i) fprintf(fw, "%.12e\n", (double)W[i]);
+        fclose(fw);
+    }
+    free(A0); free(W); free(A);
+    return 0;
+}
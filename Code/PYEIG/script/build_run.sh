@@ -0,0 +1,93 @@
+#!/usr/bin/env bash
+# build_run.sh — build the pyeig Python extension and run the demo on it.
+#   ./build_run.sh <case_name> [n]
+# The module lands in ../output/lib (PYTHONPATH=../output/lib to import it).
+# It links the same static library presets as the C drivers, so those
+# archives must be position-independent: OpenBLAS' libopenblas.a is; for
+# Netlib configure LAPACK with -DCMAKE_POSITION_INDEPENDENT_CODE=ON.
+# PYTHON=... selects the interpreter (default python3); WRAP_TIMING=0
+# drops the wrapper timers as in the driver scripts.
+set -euo pipefail
+
+export OMP_NUM_THREADS=${OMP_NUM_THREADS:-1}
+export OPENBLAS_NUM_THREADS=${OPENBLAS_NUM_THREADS:-1}
+export ARMPL_NUM_THREADS=${ARMPL_NUM_THREADS:-1}
+
+TAG="${1:-}"
+[ -n "$TAG" ] || { echo "Usage: $0 <case_name> [n]"; exit 1; }
+N="${2:-2000}"
+
+# ====== 1) Compiler setup ======
+PYTHON="${PYTHON:-python3}"
+PY_INC="$("$PYTHON" -c 'import sysconfig; print(sysconfig.get_paths()["include"])')"
+PY_EXT="$("$PYTHON" -c 'import sysconfig; print(sysconfig.get_config_var("EXT_SUFFIX") or ".so")')"
+CC="${CC:-gcc}"
+# _POSIX_C_SOURCE as in pyconfig.h (Python.h defines it too; same value, no clash)
+CFLAGS_BASE="-O3 -std=c11 -D_POSIX_C_SOURCE=200809L -fPIC \
+  -mcpu=native -mtune=native \
+  -fno-math-errno -fno-trapping-math -ffp-contract=fast \
+  -I../../common/src -I$PY_INC -DEIG_BACKEND=\"$TAG\""
+LIBS_FORTRAN="-lgfortran"
+LIBS_MATH="-lm"
+
+# ====== 2) Library presets ======
+CFLAGS_NETLIB="$CFLAGS_BASE -I../../LAPACK/build/include"
+LDFLAGS_NETLIB="../../LAPACK/build/lib/liblapack.a ../../LAPACK/build/lib/libblas.a $LIBS_FORTRAN $LIBS_MATH"
+
+CFLAGS_OB="$CFLAGS_BASE -I../../openblas/openblas_install/include"
+LDFLAGS_OB="../../openblas/openblas_install/lib/libopenblas.a $LIBS_FORTRAN $LIBS_MATH -lpthread -ldl"
+
+ARMPL_PREFIX="../../armpl/arm-performance-libraries_25.07_rpm/armpl_local/armpl_25.07_gcc"
+CFLAGS_AP="$CFLAGS_BASE -I$ARMPL_PREFIX/include"
+LDFLAGS_AP="$ARMPL_PREFIX/lib/libarmpl.a -lpthread -ldl $LIBS_FORTRAN $LIBS_MATH"
+
+# ====== 3) Sources ======
+SRCS=("../src/pyeig.c" "../../common/src/wrap_timers.c" "../../common/src/wrap_gen.c"
+      "../../common/src/numa_alloc.c" "../../common/src/mem_budget.c")
+
+# ====== 4) Symbols to --wrap: every WRAP_FN in common/src/wrap_syms.def ======
+WRAP_DEF="../../common/src/wrap_syms.def"
+WRAP_SYMS=($(grep -o '^WRAP_FN([A-Za-z_0-9]*' "$WRAP_DEF" | sed 's/^WRAP_FN(//'))
+WRAP_LDFLAGS=(); CFLAGS_WRAP=""
+# -u X pulls X out of the static archive even when only the wrapper calls it.
+if [[ "${WRAP_TIMING:-1}" == "1" ]]; then
+  for s in "${WRAP_SYMS[@]}"; do WRAP_LDFLAGS+=("-Wl,--wrap=${s}" "-Wl,-u,${s}"); done
+else
+  CFLAGS_WRAP="-DWRAP_TIMING_DISABLE"
+fi
+
+# ====== 5) Case selection ======
+case "$TAG" in
+  pyeig-openblas) CFLAGS="$CFLAGS_OB";     LDFLAGS="$LDFLAGS_OB ${WRAP_LDFLAGS[*]}" ;;
+  pyeig-netlib)   CFLAGS="$CFLAGS_NETLIB"; LDFLAGS="$LDFLAGS_NETLIB ${WRAP_LDFLAGS[*]}" ;;
+  pyeig-armpl)    CFLAGS="$CFLAGS_AP";     LDFLAGS="$LDFLAGS_AP ${WRAP_LDFLAGS[*]}" ;;
+  *)
+      echo "[X] Unknown TAG: $TAG"
+      echo "    Available: pyeig-openblas | pyeig-netlib | pyeig-armpl"
+      exit 1;;
+esac
+
+# ====== 6) Output & Build ======
+OUT_DIR="../output"
+OBJ_DIR="$OUT_DIR/obj"
+LIB_DIR="$OUT_DIR/lib"
+mkdir -p "$OBJ_DIR" "$LIB_DIR"
+
+OBJS=()
+for f in "${SRCS[@]}"; do
+  base="$(basename "$f" .c)"
+  obj="$OBJ_DIR/${base}.o"
+  echo "[BUILD] CC=$CC | SRC=$f"
+  $CC $CFLAGS $CFLAGS_WRAP -c "$f" -o "$obj"
+  OBJS+=("$obj")
+done
+
+# -Bsymbolic: LAPACK/BLAS calls inside the module bind to its own copy,
+# not to another BLAS already loaded into the interpreter (e.g. NumPy's)
+MOD="$LIB_DIR/pyeig$PY_EXT"
+echo "[LINK ] ${OBJS[*]} -> $MOD"
+$CC -shared -Wl,-Bsymbolic "${OBJS[@]}" $LDFLAGS -lpthread -o "$MOD"
+
+echo "[RUN  ] PYTHONPATH=$LIB_DIR $PYTHON ../src/pyeig_demo.py $N"
+echo "[INFO ] OMP_NUM_THREADS=$OMP_NUM_THREADS OPENBLAS_NUM_THREADS=$OPENBLAS_NUM_THREADS ARMPL_NUM_THREADS=$ARMPL_NUM_THREADS"
+PYTHONPATH="$LIB_DIR${PYTHONPATH:+:$PYTHONPATH}" exec "$PYTHON" ../src/pyeig_demo.py "$N"
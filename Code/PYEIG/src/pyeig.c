@@ -0,0 +1,456 @@
+// pyeig.c — CPython extension: the native drivers' eigen paths on caller
+// buffers, with the same backend, wrapper timers and per-stage clocks.
+//
+//   import pyeig
+//   a = numpy.asfortranarray(A)            # float64, n x n, overwritten
+//   w = numpy.empty(n)                     # float64, n, eigenvalues
+//   t = pyeig.syevd(a, w)                  # DSYEVD; a <- eigenvectors
+//   t = pyeig.syev(a, w, jobz='N')         # DSYEV
+//   t = pyeig.stedc(a, w)                  # DSYTRD -> DORGTR -> DSTEDC('V')
+//   pyeig.wrap_timers()                    # {"dsytrd_": (calls, s), ...}
+//   pyeig.wrap_reset()
+//
+// Arguments are taken through the buffer protocol, so NumPy arrays (or any
+// other exporter) are used in place: no copy, no transpose. `a` must be a
+// writable float64 buffer that is Fortran-contiguous n x n, or flat with
+// n*n elements (read column-major); `w` a writable contiguous float64
+// buffer with at least n elements. C-ordered arrays are rejected rather
+// than copied (numpy.asfortranarray makes the one copy explicit).
+//
+// The GIL is released for workspace allocation and the LAPACK calls, so
+// other Python threads keep running. Each call returns a dict with the
+// stage times in seconds (same clock and boundaries as DSYEVD/src/syevd.c
+// and DSTEDC/src/stedc_run.c), "total", and per-stage page faults and
+// context switches under "faults". MEM_PREFAULT / MEM_LOCK apply to the
+// workspaces as in the drivers. LAPACK errors raise RuntimeError.
+//
+// Built by PYEIG/script/build_run.sh against the same library presets, with
+// the --wrap timers linked in (WRAP_TIMING=0 drops them); wrap_timers()
+// returns the registry the C drivers print at exit.
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "numa_alloc.h"   /* ../../common/src: MEM_PREFAULT / MEM_LOCK (mem_prefault) */
+#include "mem_budget.h"   /* ../../common/src: per-stage page faults (mem_usage_t)    */
+#include "wrap_timers.h"  /* ../../common/src: wrapper registry read access          */
+
+#ifndef EIG_BACKEND
+#define EIG_BACKEND "unknown"     /* build_run.sh passes the case name */
+#endif
+
+/* --------- Fortran LAPACK symbols (vendor-agnostic) --------- */
+extern void dsyevd_(const char *JOBZ, const char *UPLO, const int *N,
+                    double *A, const int *LDA, double *W,
+                    double *WORK, const int *LWORK,
+                    int *IWORK, const int *LIWORK,
+                    int *INFO);
+
+extern void dsyev_(const char *JOBZ, const char *UPLO, const int *N,
+                   double *A, const int *LDA, double *W,
+                   double *WORK, const int *LWORK, int *INFO);
+
+extern void dsytrd_(const char *UPLO, const int *N,
+                    double *A, const int *LDA,
+                    double *D, double *E, double *TAU,
+                    double *WORK, const int *LWORK, int *INFO);
+
+extern void dorgtr_(const char *UPLO, const int *N,
+                    double *A, const int *LDA, const double *TAU,
+                    double *WORK, const int *LWORK, int *INFO);
+
+extern void dstedc_(const char *COMPZ, const int *N,
+                    double *D, double *E,
+                    double *Z, const int *LDZ,
+                    double *WORK, const int *LWORK,
+                    int *IWORK, const int *LIWORK,
+                    int *INFO);
+
+/* --------- Utilities --------- */
+static double elapsed_seconds(struct timespec a, struct timespec b) {
+    return (b.tv_sec - a.tv_sec) + (b.tv_nsec - a.tv_nsec) / 1e9;
+}
+
+static void prefault_if(void *p, size_t bytes)
+{
+    static int pf = -1, lock = 0;
+    if (pf < 0) { pf = (int)mem_prefault_from_env(); lock = mem_lock_from_env(); }
+    if (p && (pf != MEM_PREFAULT_OFF || lock)) mem_prefault(p, bytes, lock);
+}
+
+static int is_float64(const Py_buffer *v)
+{
+    if (v->itemsize != (Py_ssize_t)sizeof(double)) return 0;
+    const char *f = v->format ? v->format : "B";
+    if (*f == '@' || *f == '=' || *f == '<') ++f;
+    return strcmp(f, "d") == 0;
+}
+
+/* a: writable float64, Fortran-contiguous n x n or flat n*n. Sets *n. */
+static int get_matrix(PyObject *obj, Py_buffer *v, int *n)
+{
+    if (PyObject_GetBuffer(obj, v, PyBUF_WRITABLE | PyBUF_FORMAT | PyBUF_STRIDES) != 0) return -1;
+    const char *why = NULL;
+    Py_ssize_t m = -1;
+    if (!is_float64(v))                                   why = "a must be a float64 buffer";
+    else if (!PyBuffer_IsContiguous(v, 'F'))              why = "a must be Fortran-contiguous (numpy.asfortranarray)";
+    else if (v->ndim == 2 && v->shape[0] == v->shape[1])  m = v->shape[0];
+    else if (v->ndim == 1) {
+        m = (Py_ssize_t)llround(sqrt((double)v->shape[0]));
+        if (m * m != v->shape[0]) why = "flat a must have n*n elements";
+    } else                                                why = "a must be square (n x n)";
+    if (!why && (m < 1 || m > INT_MAX))                   why = "a has an unsupported size";
+    if (why) {
+        PyErr_SetString(PyExc_ValueError, why);
+        PyBuffer_Release(v);
+        return -1;
+    }
+    *n = (int)m;
+    return 0;
+}
+
+/* w: writable contiguous float64 with at least n elements */
+static int get_vector(PyObject *obj, Py_buffer *v, int n)
+{
+    if (PyObject_GetBuffer(obj, v, PyBUF_WRITABLE | PyBUF_FORMAT | PyBUF_ANY_CONTIGUOUS) != 0) return -1;
+    if (!is_float64(v) || v->len < (Py_ssize_t)n * (Py_ssize_t)sizeof(double)) {
+        PyErr_Format(PyExc_ValueError, "w must be a contiguous float64 buffer with at least %d elements", n);
+        PyBuffer_Release(v);
+        return -1;
+    }
+    return 0;
+}
+
+static int get_flag(const char *s, const char *allowed, const char *what, char *out)
+{
+    const char c = (char)(s[0] >= 'a' && s[0] <= 'z' ? s[0] - 32 : s[0]);
+    if (s[0] == '\0' || s[1] != '\0' || !strchr(allowed, c)) {
+        PyErr_Format(PyExc_ValueError, "%s must be one of '%s'", what, allowed);
+        return -1;
+    }
+    *out = c;
+    return 0;
+}
+
+/* result dict helpers; a failed insert leaves the exception set */
+static int put_double(PyObject *d, const char *key, double x)
+{
+    PyObject *v = PyFloat_FromDouble(x);
+    const int rc = v ? PyDict_SetItemString(d, key, v) : -1;
+    Py_XDECREF(v);
+    return rc;
+}
+
+static int put_faults(PyObject *faults, const char *stage, const mem_usage_t *a, const mem_usage_t *b)
+{
+    PyObject *v = Py_BuildValue("{s:l,s:l,s:l,s:l}",
+                                "minflt", b->minflt - a->minflt, "majflt", b->majflt - a->majflt,
+                                "nvcsw", b->nvcsw - a->nvcsw, "nivcsw", b->nivcsw - a->nivcsw);
+    const int rc = v ? PyDict_SetItemString(faults, stage, v) : -1;
+    Py_XDECREF(v);
+    return rc;
+}
+
+static PyObject *new_result(const char *routine, int n, char jobz, char uplo)
+{
+    return Py_BuildValue("{s:s,s:i,s:C,s:C,s:s}", "routine", routine, "n", n,
+                         "jobz", (int)jobz, "uplo", (int)uplo, "backend", EIG_BACKEND);
+}
+
+/* --------- syevd / syev: one driver call, as DSYEVD/src/syevd.c --------- */
+typedef struct {
+    char jobz, uplo;
+    int n;
+    double *A, *W;
+    int use_d;                      /* 1: DSYEVD, 0: DSYEV */
+    int info, stage;                /* stage that failed: 0 query, 1 alloc, 2 solve;
+                                       info -1000: out of memory, -1001: LWORK > INT_MAX */
+    double time_alloc, time_solve;
+    mem_usage_t u[3];
+} drv_t;
+
+static void drv_run(drv_t *s)
+{
+    const int lda = s->n;
+    int lwork = -1, liwork = -1, iwkopt = 0;
+    double wkopt = 0.0;
+    struct timespec ta0, ta1, t0, t1;
+
+    s->stage = 0;
+    if (s->use_d) dsyevd_(&s->jobz, &s->uplo, &s->n, s->A, &lda, s->W, &wkopt, &lwork, &iwkopt, &liwork, &s->info);
+    else          dsyev_(&s->jobz, &s->uplo, &s->n, s->A, &lda, s->W, &wkopt, &lwork, &s->info);
+    if (s->info != 0) return;
+    if (s->use_d) wkopt = eig_dsyevd_lwork(s->jobz, s->n, wkopt);   /* LWMIN wraps past n ~ 32k */
+    if (eig_lwork_int(wkopt, &lwork) != 0) { s->info = -1001; return; }
+    liwork = iwkopt > 0 ? iwkopt : 1;
+
+    s->stage = 1;
+    mem_usage_now(&s->u[0]);
+    clock_gettime(CLOCK_MONOTONIC, &ta0);
+    double *WORK = (double*)malloc((size_t)lwork * sizeof(double));
+    int *IWORK = s->use_d ? (int*)malloc((size_t)liwork * sizeof(int)) : NULL;
+    if (!WORK || (s->use_d && !IWORK)) { free(IWORK); free(WORK); s->info = -1000; return; }
+    prefault_if(WORK, (size_t)lwork * sizeof(double));
+    prefault_if(IWORK, s->use_d ? (size_t)liwork * sizeof(int) : 0);
+    clock_gettime(CLOCK_MONOTONIC, &ta1);
+    mem_usage_now(&s->u[1]);
+    s->time_alloc = elapsed_seconds(ta0, ta1);
+
+    s->stage = 2;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    if (s->use_d) dsyevd_(&s->jobz, &s->uplo, &s->n, s->A, &lda, s->W, WORK, &lwork, IWORK, &liwork, &s->info);
+    else          dsyev_(&s->jobz, &s->uplo, &s->n, s->A, &lda, s->W, WORK, &lwork, &s->info);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    mem_usage_now(&s->u[2]);
+    s->time_solve = elapsed_seconds(t0, t1);
+    free(IWORK); free(WORK);
+}
+
+static PyObject *drv_call(PyObject *args, PyObject *kw, int use_d)
+{
+    static char *kwlist[] = { "a", "w", "jobz", "uplo", NULL };
+    PyObject *oa, *ow;
+    const char *sj = "V", *su = "U";
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "OO|ss", kwlist, &oa, &ow, &sj, &su)) return NULL;
+
+    drv_t s;
+    memset(&s, 0, sizeof(s));
+    s.use_d = use_d;
+    if (get_flag(sj, "NV", "jobz", &s.jobz) || get_flag(su, "UL", "uplo", &s.uplo)) return NULL;
+    Py_buffer va, vw;
+    if (get_matrix(oa, &va, &s.n) != 0) return NULL;
+    if (get_vector(ow, &vw, s.n) != 0) { PyBuffer_Release(&va); return NULL; }
+    s.A = (double*)va.buf;
+    s.W = (double*)vw.buf;
+
+    Py_BEGIN_ALLOW_THREADS
+    drv_run(&s);
+    Py_END_ALLOW_THREADS
+
+    PyBuffer_Release(&vw);
+    PyBuffer_Release(&va);
+    const char *name = use_d ? "DSYEVD" : "DSYEV";
+    if (s.info == -1000) return PyErr_NoMemory();
+    if (s.info == -1001) {
+        PyErr_Format(PyExc_ValueError, "%s: LWORK exceeds INT_MAX for n=%d (LP64 LAPACK)", name, s.n);
+        return NULL;
+    }
+    if (s.info != 0) {
+        PyErr_Format(PyExc_RuntimeError, "%s %s, info=%d", name,
+                     s.stage == 0 ? "workspace query failed" : "failed", s.info);
+        return NULL;
+    }
+
+    PyObject *r = new_result(use_d ? "dsyevd" : "dsyev", s.n, s.jobz, s.uplo);
+    PyObject *faults = PyDict_New();
+    if (!r || !faults ||
+        put_double(r, "alloc", s.time_alloc) || put_double(r, "solve", s.time_solve) ||
+        put_double(r, "total", s.time_solve) ||
+        put_faults(faults, "alloc", &s.u[0], &s.u[1]) || put_faults(faults, "solve", &s.u[1], &s.u[2]) ||
+        PyDict_SetItemString(r, "faults", faults)) {
+        Py_XDECREF(faults); Py_XDECREF(r);
+        return NULL;
+    }
+    Py_DECREF(faults);
+    return r;
+}
+
+static PyObject *py_syevd(PyObject *self, PyObject *args, PyObject *kw) { (void)self; return drv_call(args, kw, 1); }
+static PyObject *py_syev(PyObject *self, PyObject *args, PyObject *kw)  { (void)self; return drv_call(args, kw, 0); }
+
+/* --------- stedc: the staged path of DSTEDC/src/stedc_run.c --------- */
+typedef struct {
+    char uplo;
+    int n;
+    double *A, *W;              /* A -> Q -> eigenvectors; W <- D -> eigenvalues */
+    int info;                   /* -1000: out of memory, -1001: LWORK > INT_MAX */
+    const char *failed;         /* routine + phase of the failure */
+    double t[3];                /* dsytrd, dorgtr, dstedc */
+    mem_usage_t u[3][2];
+} stg_t;
+
+/* WORK of the queried size; NULL with *info set (-1001 / -1000) on failure. */
+static double *work_for(double wkopt, int *lwork, int *info)
+{
+    if (eig_lwork_int(wkopt, lwork) != 0) { *info = -1001; return NULL; }
+    double *w = (double*)malloc((size_t)*lwork * sizeof(double));
+    if (w) prefault_if(w, (size_t)*lwork * sizeof(double));
+    else   *info = -1000;
+    return w;
+}
+
+static void stg_run(stg_t *s)
+{
+    const int n = s->n, lda = n;
+    const char compz = 'V';
+    int lwork = -1, liwork = -1, iwkopt = 0;
+    double wkopt = 0.0, *WORK = NULL;
+    struct timespec t0, t1;
+    double *E   = (double*)malloc((size_t)(n > 1 ? n - 1 : 1) * sizeof(double));
+    double *TAU = (double*)malloc((size_t)(n > 1 ? n - 1 : 1) * sizeof(double));
+    if (!E || !TAU) { s->info = -1000; goto DONE; }
+    /* DSTEDC computes LWMIN = 1 + 3n + 2n*lg(n) + 4n^2 in int, which wraps past n ~ 23k:
+       floor its query in double, and refuse before DSYTRD rather than after it */
+    const double stedc_need = n > 1 ? 1.0 + 3.0 * n + 2.0 * n * ceil(log2((double)n)) + 4.0 * (double)n * n : 1.0;
+    if (eig_lwork_int(stedc_need, &lwork) != 0) { s->info = -1001; goto DONE; }
+    lwork = -1;
+
+    /* ---- 1) Reduce A -> T via DSYTRD ---- */
+    dsytrd_(&s->uplo, &n, s->A, &lda, s->W, E, TAU, &wkopt, &lwork, &s->info);
+    if (s->info != 0) { s->failed = "DSYTRD workspace query"; goto DONE; }
+    if (!(WORK = work_for(wkopt, &lwork, &s->info))) goto DONE;
+    mem_usage_now(&s->u[0][0]);
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    dsytrd_(&s->uplo, &n, s->A, &lda, s->W, E, TAU, WORK, &lwork, &s->info);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    mem_usage_now(&s->u[0][1]);
+    s->t[0] = elapsed_seconds(t0, t1);
+    free(WORK); WORK = NULL;
+    if (s->info != 0) { s->failed = "DSYTRD"; goto DONE; }
+
+    /* ---- 2) Form Q explicitly in-place using DORGTR ---- */
+    lwork = -1;
+    dorgtr_(&s->uplo, &n, s->A, &lda, TAU, &wkopt, &lwork, &s->info);
+    if (s->info != 0) { s->failed = "DORGTR workspace query"; goto DONE; }
+    if (!(WORK = work_for(wkopt, &lwork, &s->info))) goto DONE;
+    mem_usage_now(&s->u[1][0]);
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    dorgtr_(&s->uplo, &n, s->A, &lda, TAU, WORK, &lwork, &s->info);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    mem_usage_now(&s->u[1][1]);
+    s->t[1] = elapsed_seconds(t0, t1);
+    free(WORK); WORK = NULL;
+    if (s->info != 0) { s->failed = "DORGTR"; goto DONE; }
+
+    /* ---- 3) DSTEDC('V'): Z = Q * eigenvectors of T, in A ---- */
+    lwork = -1;
+    dstedc_(&compz, &n, s->W, E, s->A, &lda, &wkopt, &lwork, &iwkopt, &liwork, &s->info);
+    if (s->info != 0) { s->failed = "DSTEDC workspace query"; goto DONE; }
+    liwork = iwkopt > 0 ? iwkopt : 1;
+    if (wkopt < stedc_need) wkopt = stedc_need;
+    int *IWORK = (int*)malloc((size_t)liwork * sizeof(int));
+    if (!IWORK) { s->info = -1000; goto DONE; }
+    if (!(WORK = work_for(wkopt, &lwork, &s->info))) { free(IWORK); goto DONE; }
+    prefault_if(IWORK, (size_t)liwork * sizeof(int));
+    mem_usage_now(&s->u[2][0]);
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    dstedc_(&compz, &n, s->W, E, s->A, &lda, WORK, &lwork, IWORK, &liwork, &s->info);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    mem_usage_now(&s->u[2][1]);
+    s->t[2] = elapsed_seconds(t0, t1);
+    free(IWORK);
+    if (s->info != 0) s->failed = "DSTEDC";
+
+DONE:
+    free(WORK); free(TAU); free(E);
+}
+
+static PyObject *py_stedc(PyObject *self, PyObject *args, PyObject *kw)
+{
+    (void)self;
+    static char *kwlist[] = { "a", "w", "uplo", NULL };
+    static const char *STAGES[3] = { "dsytrd", "dorgtr", "dstedc" };
+    PyObject *oa, *ow;
+    const char *su = "U";
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "OO|s", kwlist, &oa, &ow, &su)) return NULL;
+
+    stg_t s;
+    memset(&s, 0, sizeof(s));
+    if (get_flag(su, "UL", "uplo", &s.uplo)) return NULL;
+    Py_buffer va, vw;
+    if (get_matrix(oa, &va, &s.n) != 0) return NULL;
+    if (get_vector(ow, &vw, s.n) != 0) { PyBuffer_Release(&va); return NULL; }
+    s.A = (double*)va.buf;
+    s.W = (double*)vw.buf;
+
+    Py_BEGIN_ALLOW_THREADS
+    stg_run(&s);
+    Py_END_ALLOW_THREADS
+
+    PyBuffer_Release(&vw);
+    PyBuffer_Release(&va);
+    if (s.info == -1000) return PyErr_NoMemory();
+    if (s.info == -1001) {
+        PyErr_Format(PyExc_ValueError, "stedc: LWORK exceeds INT_MAX for n=%d (LP64 LAPACK)", s.n);
+        return NULL;
+    }
+    if (s.info != 0) {
+        PyErr_Format(PyExc_RuntimeError, "%s failed, info=%d", s.failed, s.info);
+        return NULL;
+    }
+
+    PyObject *r = new_result("stedc", s.n, 'V', s.uplo);
+    PyObject *faults = PyDict_New();
+    int bad = !r || !faults;
+    for (int k = 0; k < 3 && !bad; ++k)
+        bad = put_double(r, STAGES[k], s.t[k]) || put_faults(faults, STAGES[k], &s.u[k][0], &s.u[k][1]);
+    if (bad || put_double(r, "total", s.t[0] + s.t[1] + s.t[2]) ||
+        PyDict_SetItemString(r, "faults", faults)) {
+        Py_XDECREF(faults); Py_XDECREF(r);
+        return NULL;
+    }
+    Py_DECREF(faults);
+    return r;
+}
+
+/* --------- wrapper registry --------- */
+static PyObject *py_wrap_timers(PyObject *self, PyObject *noargs)
+{
+    (void)self; (void)noargs;
+    PyObject *d = PyDict_New();
+    if (!d) return NULL;
+    const int m = __wrap_timer_count();
+    for (int i = 0; i < m; ++i) {
+        const char *name = NULL;
+        unsigned long long calls = 0;
+        double sec = 0.0;
+        if (!__wrap_timer_get(i, &name, &calls, &sec) || !name || calls == 0) continue;
+        PyObject *v = Py_BuildValue("(Kd)", calls, sec);
+        if (!v || PyDict_SetItemString(d, name, v) != 0) { Py_XDECREF(v); Py_DECREF(d); return NULL; }
+        Py_DECREF(v);
+    }
+    return d;
+}
+
+static PyObject *py_wrap_reset(PyObject *self, PyObject *noargs)
+{
+    (void)self; (void)noargs;
+    __stedc_timer_reset();
+    Py_RETURN_NONE;
+}
+
+/* --------- module --------- */
+static PyMethodDef PYEIG_METHODS[] = {
+    { "syevd", (PyCFunction)(void(*)(void))py_syevd, METH_VARARGS | METH_KEYWORDS,
+      "syevd(a, w, jobz='V', uplo='U') -> dict\n\nDSYEVD in place: a (Fortran n x n float64) "
+      "becomes the eigenvectors, w the eigenvalues. Returns stage timings." },
+    { "syev", (PyCFunction)(void(*)(void))py_syev, METH_VARARGS | METH_KEYWORDS,
+      "syev(a, w, jobz='V', uplo='U') -> dict\n\nDSYEV in place, as syevd()." },
+    { "stedc", (PyCFunction)(void(*)(void))py_stedc, METH_VARARGS | METH_KEYWORDS,
+      "stedc(a, w, uplo='U') -> dict\n\nDSYTRD -> DORGTR -> DSTEDC('V') in place; "
+      "times per stage." },
+    { "wrap_timers", py_wrap_timers, METH_NOARGS,
+      "wrap_timers() -> {routine: (calls, seconds)}\n\nThe wrapper registry (empty when "
+      "built with WRAP_TIMING=0)." },
+    { "wrap_reset", py_wrap_reset, METH_NOARGS, "wrap_reset()\n\nZero the wrapper registry." },
+    { NULL, NULL, 0, NULL }
+};
+
+static struct PyModuleDef PYEIG_MODULE = {
+    PyModuleDef_HEAD_INIT, "pyeig",
+    "Zero-copy bindings to the native LAPACK eigen paths (see pyeig.c).",
+    -1, PYEIG_METHODS, NULL, NULL, NULL, NULL
+};
+
+PyMODINIT_FUNC PyInit_pyeig(void)
+{
+    PyObject *m = PyModule_Create(&PYEIG_MODULE);
+    if (!m) return NULL;
+    if (PyModule_AddStringConstant(m, "backend", EIG_BACKEND) != 0) { Py_DECREF(m); return NULL; }
+    return m;
+}
@@ -0,0 +1,75 @@
+#!/usr/bin/env bash
+# build_run.sh — build the rank-one update benchmark and run it.
+#   ./build_run.sh <case_name> [n] [updates] [rho] [support]
+# support > 0 restricts z to the span of that many eigenvectors (heavy
+# deflation); 0 draws dense random z (no deflation, GEMM-bound).
+set -euo pipefail
+
+export OMP_NUM_THREADS=${OMP_NUM_THREADS:-1}
+export OPENBLAS_NUM_THREADS=${OPENBLAS_NUM_THREADS:-1}
+export ARMPL_NUM_THREADS=${ARMPL_NUM_THREADS:-1}
+
+TAG="${1:-}"
+[ -n "$TAG" ] || { echo "Usage: $0 <case_name> [n] [updates] [rho] [support]"; exit 1; }
+N="${2:-2000}"
+UPDATES="${3:-10}"
+RHO="${4:-1.0}"
+SUPPORT="${5:-0}"
+
+# ====== 1) Compiler setup ======
+CC="${CC:-gcc}"
+CFLAGS_BASE="-O3 -std=c11 -D_POSIX_C_SOURCE=200809L \
+  -mcpu=native -mtune=native \
+  -fno-math-errno -fno-trapping-math -ffp-contract=fast \
+  -I../../common/src"
+LIBS_FORTRAN="-lgfortran"
+LIBS_MATH="-lm"
+
+# ====== 2) Library presets ======
+CFLAGS_NETLIB="$CFLAGS_BASE -I../../LAPACK/build/include"
+LDFLAGS_NETLIB="../../LAPACK/build/lib/liblapack.a ../../LAPACK/build/lib/libblas.a $LIBS_FORTRAN $LIBS_MATH"
+
+CFLAGS_OB="$CFLAGS_BASE -I../../openblas/openblas_install/include"
+LDFLAGS_OB="../../openblas/openblas_install/lib/libopenblas.a $LIBS_FORTRAN $LIBS_MATH -lpthread -ldl"
+
+ARMPL_PREFIX="../../armpl/arm-performance-libraries_25.07_rpm/armpl_local/armpl_25.07_gcc"
+CFLAGS_AP="$CFLAGS_BASE -I$ARMPL_PREFIX/include"
+LDFLAGS_AP="$ARMPL_PREFIX/lib/libarmpl.a -lpthread -ldl $LIBS_FORTRAN $LIBS_MATH"
+
+# ====== 3) Sources ======
+SRCS=("../src/rank1_bench.c" "../../common/src/rank1_update.c")
+
+# ====== 4) Case selection ======
+case "$TAG" in
+  rank1-openblas) CFLAGS="$CFLAGS_OB";     LDFLAGS="$LDFLAGS_OB" ;;
+  rank1-netlib)   CFLAGS="$CFLAGS_NETLIB"; LDFLAGS="$LDFLAGS_NETLIB" ;;
+  rank1-armpl)    CFLAGS="$CFLAGS_AP";     LDFLAGS="$LDFLAGS_AP" ;;
+  *)
+      echo "[X] Unknown TAG: $TAG"
+      echo "    Available: rank1-openblas | rank1-netlib | rank1-armpl"
+      exit 1;;
+esac
+
+# ====== 5) Output & Build ======
+OUT_DIR="../output"
+OBJ_DIR="$OUT_DIR/obj"
+BIN_DIR="$OUT_DIR/bin"
+mkdir -p "$OBJ_DIR" "$BIN_DIR"
+
+OBJS=()
+for f in "${SRCS[@]}"; do
+  base="$(basename "$f" .c)"
+  obj="$OBJ_DIR/${base}.o"
+  echo "[BUILD] CC=$CC | SRC=$f"
+  $CC $CFLAGS -c "$f" -o "$obj"
+  OBJS+=("$obj")
+done
+
+BIN="$BIN_DIR/$TAG"
+echo "[LINK ] ${OBJS[*]} -> $BIN"
+$CC "${OBJS[@]}" $LDFLAGS -o "$BIN"
+
+# ====== 6) Run ======
+echo "[RUN  ] EXE=$BIN $N $UPDATES $RHO $SUPPORT"
+echo "[INFO ] OMP_NUM_THREADS=$OMP_NUM_THREADS OPENBLAS_NUM_THREADS=$OPENBLAS_NUM_THREADS ARMPL_NUM_THREADS=$ARMPL_NUM_THREADS"
+exec "$BIN" "$N" "$UPDATES" "$RHO" "$SUPPORT"
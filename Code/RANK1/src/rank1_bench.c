@@ -0,0 +1,253 @@
+// rank1_bench.c — rank-one eigen-update (common/src/rank1_update.c) vs a
+// full DSYEVD recompute of the modified matrix.
+//
+// Usage: rank1_bench [n] [updates] [rho] [support]
+//   - A starts as the KMS matrix (rho_kms = 0.95); one DSYEVD gives (D, V).
+//   - Each update draws a random unit z (support > 0: a random combination
+//     of `support` current eigenvectors, i.e. a low-rank-subspace change
+//     where all other poles deflate), alternates the sign of rho, applies
+//     A <- A + rho z z^T, then times
+//       update     eig_rank1_update(D, V, rho, z)        O(n^2) + one GEMM
+//       recompute  DSYEVD('V') on a copy of A            O(n^3)
+//   - Accuracy (untimed): eigenvalue gap to the recompute, residual
+//     ||A V - V D||_F / ||A||_F and orthogonality ||V^T V - I||_F, which
+//     show how the updated decomposition drifts over many updates.
+//   - Per-stage split of the update (project / deflate / secular / gemm /
+//     assemble) and the number of deflated poles are reported.
+// Results: stdout + ../output/rank1_time.txt
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <math.h>
+#include <sys/stat.h>
+
+#include "rank1_update.h"
+
+/* --------- Fortran LAPACK/BLAS symbols (vendor-agnostic) --------- */
+extern void dsyevd_(const char *JOBZ, const char *UPLO, const int *N,
+                    double *A, const int *LDA, double *W,
+                    double *WORK, const int *LWORK,
+                    int *IWORK, const int *LIWORK,
+                    int *INFO);
+extern void dgemm_(const char *TRANSA, const char *TRANSB,
+                   const int *M, const int *N, const int *K,
+                   const double *ALPHA, const double *A, const int *LDA,
+                   const double *B, const int *LDB,
+                   const double *BETA, double *C, const int *LDC);
+extern void dsymm_(const char *SIDE, const char *UPLO, const int *M, const int *N,
+                   const double *ALPHA, const double *A, const int *LDA,
+                   const double *B, const int *LDB,
+                   const double *BETA, double *C, const int *LDC);
+
+/* --------- Utilities --------- */
+static void ensure_dir(const char *path) {
+    if (mkdir(path, 0777) != 0 && errno != EEXIST) {
+        perror("mkdir");
+        exit(5);
+    }
+}
+static double elapsed_seconds(struct timespec a, struct timespec b) {
+    return (b.tv_sec - a.tv_sec) + (b.tv_nsec - a.tv_nsec) / 1e9;
+}
+
+/* Fill A (n x n, column-major) with a classic SPD KMS test matrix:
+   A_ij = rho^{|i-j|} + delta*(i==j), with |rho|<1, delta>=0. */
+static void fill_kms(double *A, int n, double rho, double delta)
+{
+    if (!(rho > -1.0 && rho < 1.0)) rho = 0.95;
+    if (delta < 0.0) delta = 0.0;
+
+    double arho = fabs(rho);
+    double *rp = (double*)malloc((size_t)n * sizeof(double));
+    if (!rp) { fprintf(stderr, "Allocation failed (rp)\n"); exit(6); }
+
+    rp[0] = 1.0;
+    for (int k = 1; k < n; ++k) rp[k] = rp[k-1] * arho;
+
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i <= j; ++i) {
+            double v = rp[j - i];
+            if (i == j) v += delta;
+            A[i + (size_t)j * n] = v;
+            A[j + (size_t)i * n] = v;
+        }
+    }
+    free(rp);
+}
+
+/* xorshift64* uniform in (0,1) -> Box–Muller normals */
+static unsigned long long G_RNG = 0x9E3779B97F4A7C15ull;
+static double urand(void) {
+    G_RNG ^= G_RNG >> 12; G_RNG ^= G_RNG << 25; G_RNG ^= G_RNG >> 27;
+    return ((G_RNG * 2685821657736338717ull) >> 11) * (1.0 / 9007199254740992.0) + 1e-300;
+}
+static void random_unit(double *z, int n) {
+    double s = 0.0;
+    for (int i = 0; i < n; ++i) {
+        z[i] = sqrt(-2.0 * log(urand())) * cos(6.283185307179586 * urand());
+        s += z[i] * z[i];
+    }
+    s = 1.0 / sqrt(s);
+    for (int i = 0; i < n; ++i) z[i] *= s;
+}
+
+/* DSYEVD('V') of A into (W, A); workspace query + timed call */
+static int syevd_v(int n, double *A, double *W, double *secs)
+{
+    const char jobz = 'V', uplo = 'U';
+    int info = 0, lwork = -1, liwork = -1, iwkopt = 0;
+    double wkopt = 0.0;
+    dsyevd_(&jobz, &uplo, &n, A, &n, W, &wkopt, &lwork, &iwkopt, &liwork, &info);
+    if (info != 0) return info;
+    lwork = (int)wkopt; liwork = iwkopt;
+    double *WORK  = (double*)malloc((size_t)lwork * sizeof(double));
+    int    *IWORK = (int*)malloc((size_t)liwork * sizeof(int));
+    if (!WORK || !IWORK) { free(IWORK); free(WORK); return -100; }
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    dsyevd_(&jobz, &uplo, &n, A, &n, W, WORK, &lwork, IWORK, &liwork, &info);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    free(IWORK); free(WORK);
+    if (secs) *secs = elapsed_seconds(t0, t1);
+    return info;
+}
+
+/* ||A V - V diag(D)||_F / ||A||_F and ||V^T V - I||_F (T is n x n scratch) */
+static void check(int n, const double *A, const double *D, const double *V, double *T,
+                  double *res, double *orth)
+{
+    const double one = 1.0, zero = 0.0;
+    dsymm_("L", "U", &n, &n, &one, A, &n, V, &n, &zero, T, &n);
+    double r = 0.0, a = 0.0;
+    for (int j = 0; j < n; ++j)
+        for (int i = 0; i < n; ++i) {
+            double x = T[i + (size_t)j * n] - V[i + (size_t)j * n] * D[j];
+            double y = A[i + (size_t)j * n];
+            r += x * x; a += y * y;
+        }
+    dgemm_("T", "N", &n, &n, &n, &one, V, &n, V, &n, &zero, T, &n);
+    double o = 0.0;
+    for (int j = 0; j < n; ++j)
+        for (int i = 0; i < n; ++i) {
+            double x = T[i + (size_t)j * n] - (i == j ? 1.0 : 0.0);
+            o += x * x;
+        }
+    *res = sqrt(r / a);
+    *orth = sqrt(o);
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char **argv)
+{
+    const int    n       = (argc > 1) ? atoi(argv[1]) : 2000;
+    const int    updates = (argc > 2) ? atoi(argv[2]) : 10;
+    const double rho     = (argc > 3) ? atof(argv[3]) : 1.0;
+    const int    support = (argc > 4) ? atoi(argv[4]) : 0;
+    if (n <= 0 || updates <= 0) { fprintf(stderr, "Usage: %s [n] [updates] [rho] [support]\n", argv[0]); return 1; }
+
+    const size_t nn = (size_t)n * n;
+    double *A  = (double*)malloc(nn * sizeof(double));   // current matrix
+    double *V  = (double*)malloc(nn * sizeof(double));   // updated eigenvectors
+    double *R  = (double*)malloc(nn * sizeof(double));   // recompute copy / check scratch
+    double *D  = (double*)malloc((size_t)n * sizeof(double));
+    double *Dr = (double*)malloc((size_t)n * sizeof(double));
+    double *z  = (double*)malloc((size_t)n * sizeof(double));
+    double *t_upd = (double*)malloc((size_t)updates * sizeof(double));
+    double *t_rec = (double*)malloc((size_t)updates * sizeof(double));
+    if (!A || !V || !R || !D || !Dr || !z || !t_upd || !t_rec) {
+        fprintf(stderr, "Allocation failed.\n");
+        return 1;
+    }
+
+    printf("Mode: rank-one update vs DSYEVD recompute (n=%d, updates=%d, |rho|=%g, z %s)\n",
+           n, updates, rho, support > 0 ? "in a few eigenvectors' span" : "dense random");
+    fill_kms(A, n, 0.95, 0.0);
+    memcpy(V, A, nn * sizeof(double));
+    double t_init = 0.0;
+    if (syevd_v(n, V, D, &t_init) != 0) { fprintf(stderr, "Initial DSYEVD failed\n"); return 2; }
+    printf("Initial DSYEVD took %.3f s\n", t_init);
+
+    rank1_ws_t ws = {0};
+    rank1_stats_t acc = {0};
+    double max_gap = 0.0, last_res = 0.0, last_orth = 0.0;
+
+    const char *outdir = "../output";
+    ensure_dir(outdir);
+    FILE *ft = fopen("../output/rank1_time.txt", "w");
+    if (ft) fprintf(ft, "# upd rho update_s recompute_s speedup k deflated max_eig_gap residual orth\n");
+
+    printf("%4s %6s %10s %11s %8s %6s %6s %11s %11s %11s\n",
+           "upd", "rho", "update[s]", "recomp[s]", "speedup", "K", "defl", "max|dl|", "residual", "orth");
+    for (int u = 0; u < updates; ++u) {
+        const double r = (u % 2) ? -rho : rho;
+        if (support > 0 && support < n) {                /* z = V(:, S) c, |S| = support */
+            double *c = Dr;                               /* Dr is free until the recompute */
+            random_unit(c, support);
+            memset(z, 0, (size_t)n * sizeof(double));
+            for (int s = 0; s < support; ++s) {
+                const double *v = V + (size_t)((s * (size_t)n) / support) * n;
+                for (int i = 0; i < n; ++i) z[i] += c[s] * v[i];
+            }
+        } else {
+            random_unit(z, n);
+        }
+        for (int j = 0; j < n; ++j)                       /* A <- A + r z z^T (full) */
+            for (int i = 0; i < n; ++i)
+                A[i + (size_t)j * n] += r * z[i] * z[j];
+
+        rank1_stats_t st;
+        struct timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        int info = eig_rank1_update(n, D, V, n, r, z, &ws, &st);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        if (info != 0) { fprintf(stderr, "eig_rank1_update failed, info=%d\n", info); return 3; }
+        t_upd[u] = elapsed_seconds(t0, t1);
+        acc.k += st.k; acc.deflated += st.deflated;
+        acc.t_project += st.t_project; acc.t_deflate += st.t_deflate;
+        acc.t_secular += st.t_secular; acc.t_gemm += st.t_gemm; acc.t_assemble += st.t_assemble;
+
+        memcpy(R, A, nn * sizeof(double));
+        if (syevd_v(n, R, Dr, &t_rec[u]) != 0) { fprintf(stderr, "DSYEVD recompute failed\n"); return 3; }
+
+        double gap = 0.0, scale = 0.0;
+        for (int i = 0; i < n; ++i) {
+            if (fabs(D[i] - Dr[i]) > gap) gap = fabs(D[i] - Dr[i]);
+            if (fabs(Dr[i]) > scale) scale = fabs(Dr[i]);
+        }
+        gap /= scale;
+        if (gap > max_gap) max_gap = gap;
+        check(n, A, D, V, R, &last_res, &last_orth);
+
+        printf("%4d %+6.2f %10.4f %11.4f %8.1f %6d %6d %11.3e %11.3e %11.3e\n",
+               u + 1, r, t_upd[u], t_rec[u], t_rec[u] / t_upd[u], st.k, st.deflated, gap, last_res, last_orth);
+        if (ft) fprintf(ft, "%d %+.3f %.6f %.6f %.2f %d %d %.3e %.3e %.3e\n",
+                        u + 1, r, t_upd[u], t_rec[u], t_rec[u] / t_upd[u], st.k, st.deflated, gap, last_res, last_orth);
+    }
+
+    qsort(t_upd, (size_t)updates, sizeof(double), cmp_double);
+    qsort(t_rec, (size_t)updates, sizeof(double), cmp_double);
+    const double mu = t_upd[updates / 2], mr = t_rec[updates / 2];
+    printf("---------------------------------------------\n");
+    printf("median update    %.4f s   (project %.4f  deflate %.4f  secular %.4f  gemm %.4f  assemble %.4f)\n",
+           mu, acc.t_project / updates, acc.t_deflate / updates, acc.t_secular / updates,
+           acc.t_gemm / updates, acc.t_assemble / updates);
+    printf("median recompute %.4f s   speedup %.1fx   avg K=%.1f deflated=%.1f\n",
+           mr, mr / mu, (double)acc.k / updates, (double)acc.deflated / updates);
+    printf("after %d updates: max eigenvalue gap %.3e, residual %.3e, orthogonality %.3e\n",
+           updates, max_gap, last_res, last_orth);
+    if (ft) {
+        fprintf(ft, "# median_update %.6f median_recompute %.6f speedup %.2f\n", mu, mr, mr / mu);
+        fclose(ft);
+    }
+
+    rank1_ws_free(&ws);
+    free(t_rec); free(t_upd); free(z); free(Dr); free(D); free(R); free(V); free(A);
+    return 0;
+}
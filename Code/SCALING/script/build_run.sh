@@ -0,0 +1,116 @@
+#!/usr/bin/env bash
+# build_run.sh — build the thread-scaling driver (scaling_run.c + DSYEVD timing
+# wrappers) and run it once with the current environment.
+#   ./build_run.sh <case_name> [routine] [n] [jobz]
+# Set BUILD_ONLY=1 to skip the run (used by scaling.sh).
+set -euo pipefail
+
+export OMP_NUM_THREADS=${OMP_NUM_THREADS:-1}
+export OPENBLAS_NUM_THREADS=${OPENBLAS_NUM_THREADS:-1}
+export ARMPL_NUM_THREADS=${ARMPL_NUM_THREADS:-1}
+
+TAG="${1:-}"
+[ -n "$TAG" ] || { echo "Usage: $0 <case_name> [routine] [n] [jobz]"; exit 1; }
+shift
+
+# ====== 1) Compiler setup ======
+CC_DEFAULT="${CC:-gcc}"
+CFLAGS_BASE="-O3 -std=c11 -D_POSIX_C_SOURCE=199309L \
+  -mcpu=native -mtune=native \
+  -fno-math-errno -fno-trapping-math -ffp-contract=fast \
+  -I../../common/src"
+LIBS_FORTRAN="-lgfortran"
+LIBS_MATH="-lm"
+
+# libnuma (mbind/move_pages) for NUMA_POLICY=interleave|local and placement
+# reports; WITH_NUMA=0 builds without it (all policies fall back to default)
+if [[ "${WITH_NUMA:-1}" == "1" ]]; then
+  CFLAGS_NUMA="-DHAVE_LIBNUMA"; LIBS_NUMA="-lnuma"
+else
+  CFLAGS_NUMA=""; LIBS_NUMA=""
+fi
+
+UNAME_S="$(uname -s || true)"
+if [[ "${UNAME_S}" == "Darwin" ]]; then
+  if [[ "${CC_DEFAULT}" != *"-fuse-ld="* ]]; then
+    CC_DEFAULT="${CC_DEFAULT} -fuse-ld=lld"
+  fi
+fi
+CC="${CC_DEFAULT}"
+
+# ====== 2) Library presets (threaded builds: no *_NUM_THREADS=1 baked in) ======
+# Netlib (static, single-threaded reference — useful as a flat baseline)
+CFLAGS_NETLIB="$CFLAGS_BASE -I../../LAPACK/build/include"
+LDFLAGS_NETLIB="../../LAPACK/build/lib/liblapack.a ../../LAPACK/build/lib/libblas.a $LIBS_FORTRAN $LIBS_MATH"
+
+# OpenBLAS (static)
+CFLAGS_OB="$CFLAGS_BASE -I../../openblas/openblas_install/include"
+LDFLAGS_OB="../../openblas/openblas_install/lib/libopenblas.a $LIBS_FORTRAN $LIBS_MATH -lpthread -ldl"
+
+# ArmPL (static, OpenMP runtime so the thread count is honoured)
+ARMPL_PREFIX="../../armpl/arm-performance-libraries_25.07_rpm/armpl_local/armpl_25.07_gcc"
+CFLAGS_AP="$CFLAGS_BASE -I$ARMPL_PREFIX/include"
+LDFLAGS_AP="$ARMPL_PREFIX/lib/libarmpl_mp.a -fopenmp -lgomp -lpthread -ldl $LIBS_FORTRAN $LIBS_MATH"
+
+# ====== 3) Sources ======
+SRC_MAIN="../src/scaling_run.c"
+SRC_WRAP_TIMERS="../../common/src/wrap_timers.c"
+SRC_WRAP_TREE="../../common/src/wrap_gen.c"
+SRC_NUMA="../../common/src/numa_alloc.c"
+
+# ====== 4) Symbols to --wrap (common/src/wrap_syms.def, as in DSYEVD/script/build_run.sh) ======
+WRAP_DEF="../../common/src/wrap_syms.def"
+WRAP_SYMS=($(grep -o '^WRAP_FN([A-Za-z_0-9]*' "$WRAP_DEF" | sed 's/^WRAP_FN(//'))
+WRAP_LDFLAGS=(); CFLAGS_WRAP=""
+# -u X pulls X out of the static archive even when only the wrapper calls it.
+if [[ "${WRAP_TIMING:-1}" == "1" ]]; then
+  for s in "${WRAP_SYMS[@]}"; do WRAP_LDFLAGS+=("-Wl,--wrap=${s}" "-Wl,-u,${s}"); done
+else
+  CFLAGS_WRAP="-DWRAP_TIMING_DISABLE"   # stubs only, calls go straight to the library
+fi
+
+# ====== 5) Case selection ======
+case "$TAG" in
+  scaling-openblas)
+      CFLAGS="$CFLAGS_OB"
+      LDFLAGS="$LDFLAGS_OB ${WRAP_LDFLAGS[*]}"
+      ;;
+  scaling-netlib)
+      CFLAGS="$CFLAGS_NETLIB"
+      LDFLAGS="$LDFLAGS_NETLIB ${WRAP_LDFLAGS[*]}"
+      ;;
+  scaling-armpl)
+      CFLAGS="$CFLAGS_AP"
+      LDFLAGS="$LDFLAGS_AP ${WRAP_LDFLAGS[*]}"
+      ;;
+  *)
+      echo "[X] Unknown TAG: $TAG"
+      echo "    Available: scaling-openblas | scaling-netlib | scaling-armpl"
+      exit 1;;
+esac
+SRCS=("$SRC_MAIN" "$SRC_WRAP_TIMERS" "$SRC_WRAP_TREE" "$SRC_NUMA")
+
+# ====== 6) Output & Build ======
+OUT_DIR="../output"
+OBJ_DIR="$OUT_DIR/obj"
+BIN_DIR="$OUT_DIR/bin"
+mkdir -p "$OBJ_DIR" "$BIN_DIR"
+
+OBJS=()
+for f in "${SRCS[@]}"; do
+  base="$(basename "$f" .c)"
+  obj="$OBJ_DIR/${base}.o"
+  echo "[BUILD] CC=$CC | SRC=$f"
+  $CC $CFLAGS $CFLAGS_WRAP $CFLAGS_NUMA -c "$f" -o "$obj"
+  OBJS+=("$obj")
+done
+
+BIN="$BIN_DIR/$TAG"
+echo "[LINK ] ${OBJS[*]} -> $BIN"
+$CC "${OBJS[@]}" $LDFLAGS $LIBS_NUMA -lpthread -o "$BIN"
+
+[[ "${BUILD_ONLY:-0}" == "1" ]] && exit 0
+
+echo "[RUN  ] EXE=$BIN $*"
+echo "[INFO ] OMP_NUM_THREADS=$OMP_NUM_THREADS OPENBLAS_NUM_THREADS=$OPENBLAS_NUM_THREADS ARMPL_NUM_THREADS=$ARMPL_NUM_THREADS"
+exec "$BIN" "$@"
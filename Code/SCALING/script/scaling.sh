@@ -0,0 +1,117 @@
+#!/usr/bin/env bash
+# scaling.sh — thread-scaling sweep for DSYEV / DSYEVD / DSTEDC / DSYTRD.
+#
+# Usage:
+#   ./scaling.sh <case_name> [n] [compact|scatter] [jobz] [routine ...]
+#
+# Examples:
+#   ./scaling.sh scaling-openblas                      # n=4000, compact, JOBZ=V, all routines
+#   ./scaling.sh scaling-openblas 8000 scatter V dsyevd dstedc
+#   THREADS="1 8 16 32" ./scaling.sh scaling-armpl 4000 compact N
+#
+# Pinning policy:
+#   compact  -> fill one socket/NUMA node core by core before touching the next
+#   scatter  -> round-robin consecutive threads across sockets/NUMA nodes
+#   (SMT siblings are only used once every physical core is taken.)
+#
+# Each run is restricted to its CPU list with taskset, and the list is also
+# exported as OMP_PLACES/GOMP_CPU_AFFINITY so OpenMP backends bind one thread
+# per CPU. Logs land in ../output/scaling/<case>_<policy>_<timestamp>/ and
+# ../src/scaling_report.py turns them into speedup / efficiency / per-stage
+# tables (report.txt, scaling.csv).
+#
+# NUMA_POLICY=default|interleave|firsttouch|local (and NUMA_NODE for 'local')
+# is passed through to the driver; each log records the resulting page
+# placement of A and the D&C workspace.
+
+set -euo pipefail
+
+TAG="${1:-}"
+[ -n "$TAG" ] || { echo "Usage: $0 <case_name> [n] [compact|scatter] [jobz] [routine ...]"; exit 1; }
+N="${2:-4000}"
+POLICY="${3:-compact}"
+JOBZ="${4:-V}"
+shift $(( $# < 4 ? $# : 4 ))
+ROUTINES=("$@")
+[ ${#ROUTINES[@]} -gt 0 ] || ROUTINES=(dsytrd dstedc dsyev dsyevd)
+
+case "$POLICY" in
+  compact|scatter) ;;
+  *) echo "[X] Unknown policy: $POLICY (compact|scatter)"; exit 1;;
+esac
+
+SCRIPT_DIR="$(cd -- "$(dirname -- "${BASH_SOURCE[0]}")" >/dev/null 2>&1 && pwd -P)"
+cd "$SCRIPT_DIR"
+
+# ====== 1) Build once ======
+BUILD_ONLY=1 ./build_run.sh "$TAG"
+BIN="../output/bin/$TAG"
+
+# ====== 2) CPU ordering for the chosen policy ======
+# Emits one logical CPU id per line, in the order threads should occupy them.
+cpu_order() {
+  local policy="$1"
+  if ! command -v lscpu >/dev/null 2>&1; then
+    seq 0 $(( $(nproc) - 1 ))
+    return
+  fi
+  # fields: smt_rank  index_within_node  node  cpu
+  local ranked
+  ranked="$(lscpu -p=CPU,CORE,SOCKET,NODE | grep -v '^#' \
+    | sort -t, -k4,4n -k3,3n -k2,2n -k1,1n \
+    | awk -F, '{ node = ($4 == "" ? $3 : $4); key = node ":" $3 ":" $2;
+                 r = smt[key]++; idx = pos[node ":" r]++;
+                 print r, idx, node, $1 }')"
+  if [[ "$policy" == "compact" ]]; then
+    sort -k1,1n -k3,3n -k2,2n <<<"$ranked" | awk '{ print $4 }'
+  else
+    sort -k1,1n -k2,2n -k3,3n <<<"$ranked" | awk '{ print $4 }'
+  fi
+}
+
+mapfile -t CPUS < <(cpu_order "$POLICY")
+NCPU=${#CPUS[@]}
+
+# ====== 3) Thread counts: 1, 2, 4, ... plus the full machine ======
+if [[ -n "${THREADS:-}" ]]; then
+  read -r -a TLIST <<<"$THREADS"
+else
+  TLIST=()
+  for (( t = 1; t <= NCPU; t *= 2 )); do TLIST+=("$t"); done
+  [[ "${TLIST[-1]}" -ne "$NCPU" ]] && TLIST+=("$NCPU")
+fi
+
+HAVE_TASKSET=1
+command -v taskset >/dev/null 2>&1 || { HAVE_TASKSET=0; echo "[WARN] taskset not found: runs are NOT pinned"; }
+
+TS="$(date +%Y%m%d_%H%M%S)"
+RUN_DIR="../output/scaling/${TAG}_${POLICY}_${TS}"
+mkdir -p "$RUN_DIR"
+{
+  echo "case=$TAG n=$N policy=$POLICY jobz=$JOBZ numa=${NUMA_POLICY:-default}"
+  echo "routines=${ROUTINES[*]}"
+  echo "threads=${TLIST[*]}"
+  echo "cpu_order=${CPUS[*]}"
+} > "$RUN_DIR/config.txt"
+
+# ====== 4) Sweep ======
+for r in "${ROUTINES[@]}"; do
+  for t in "${TLIST[@]}"; do
+    if (( t > NCPU )); then echo "[SKIP ] $r t=$t > $NCPU CPUs"; continue; fi
+    sel=("${CPUS[@]:0:t}")
+    list="$(IFS=,; echo "${sel[*]}")"
+    places="$(printf '{%s},' "${sel[@]}")"; places="${places%,}"
+
+    log="$RUN_DIR/${r}_t${t}.log"
+    echo "[RUN  ] $r n=$N jobz=$JOBZ threads=$t cpus=$list"
+    PIN=()
+    (( HAVE_TASKSET )) && PIN=(taskset -c "$list")
+    env OMP_NUM_THREADS="$t" OPENBLAS_NUM_THREADS="$t" ARMPL_NUM_THREADS="$t" \
+        OMP_PLACES="$places" OMP_PROC_BIND=close GOMP_CPU_AFFINITY="${sel[*]}" \
+        "${PIN[@]}" "$BIN" "$r" "$N" "$JOBZ" > "$log" 2>&1 \
+      || echo "[FAIL ] $r threads=$t (see $log)"
+  done
+done
+
+# ====== 5) Report ======
+python3 ../src/scaling_report.py "$RUN_DIR"
@@ -0,0 +1,132 @@
+# -*- coding: utf-8 -*-
+"""
+Summarize a thread-scaling sweep produced by ../script/scaling.sh.
+
+Reads <run_dir>/<routine>_t<threads>.log, each holding the driver's RESULT
+line (stdout) and the wrapper-timer summary (stderr), and writes:
+  - <run_dir>/report.txt : speedup / parallel efficiency per routine, plus
+                           per-stage speedup from the wrapper timers
+  - <run_dir>/scaling.csv: one row per (routine, threads, stage)
+
+Per stage, the report names the first stage whose parallel efficiency drops
+below EFF_THRESHOLD — that is the stage that stops scaling first.
+
+Usage: python3 scaling_report.py <run_dir> [eff_threshold]
+"""
+
+import os
+import re
+import sys
+
+EFF_THRESHOLD = 0.5     # efficiency below which a stage "stopped scaling"
+MIN_SHARE     = 0.01    # ignore stages below 1% of the 1-thread routine time
+
+RE_LOG    = re.compile(r"^(\w+)_t(\d+)\.log$")
+RE_RESULT = re.compile(r"^RESULT routine=(\w+) n=(\d+) jobz=(\w) threads=\S+ time=([0-9.eE+-]+)")
+RE_TIMER  = re.compile(r"^(\S+)\s+calls=\s*(\d+)\s+time=\s*([0-9.eE+-]+) s")
+
+
+def parse_log(path):
+    total, stages = None, {}
+    with open(path) as f:
+        for line in f:
+            m = RE_RESULT.match(line)
+            if m:
+                total = float(m.group(4))
+                continue
+            m = RE_TIMER.match(line)
+            if m:
+                stages[m.group(1)] = (int(m.group(2)), float(m.group(3)))
+    return total, stages
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__)
+        sys.exit(1)
+    run_dir = sys.argv[1]
+    thr = float(sys.argv[2]) if len(sys.argv) > 2 else EFF_THRESHOLD
+
+    runs = {}   # routine -> {threads: (total, stages)}
+    for name in sorted(os.listdir(run_dir)):
+        m = RE_LOG.match(name)
+        if not m:
+            continue
+        total, stages = parse_log(os.path.join(run_dir, name))
+        if total is None:
+            print(f"[WARN] no RESULT line in {name} (failed run?)")
+            continue
+        runs.setdefault(m.group(1), {})[int(m.group(2))] = (total, stages)
+
+    out, rows = [], []
+    cfg = os.path.join(run_dir, "config.txt")
+    if os.path.exists(cfg):
+        out += [l.rstrip() for l in open(cfg)] + [""]
+
+    for routine in sorted(runs):
+        by_t = runs[routine]
+        ts = sorted(by_t)
+        t_base = ts[0]
+        base_total, base_stages = by_t[t_base]
+
+        out.append(f"==== {routine} (baseline: {t_base} thread{'s' if t_base > 1 else ''}) ====")
+        out.append(f"{'threads':>7}  {'time[s]':>10}  {'speedup':>8}  {'efficiency':>10}")
+        for t in ts:
+            total = by_t[t][0]
+            sp = base_total / total if total > 0 else 0.0
+            eff = sp * t_base / t
+            out.append(f"{t:>7}  {total:>10.4f}  {sp:>8.2f}  {eff:>10.2%}")
+            rows.append((routine, t, "TOTAL", total, sp, eff))
+
+        # ---- per-stage scaling (wrapper timers) ----
+        stages = [s for s, (c, sec) in base_stages.items()
+                  if c and s not in (routine + "_", "TOTAL") and base_total > 0 and sec / base_total >= MIN_SHARE]
+        stages.sort(key=lambda s: -base_stages[s][1])
+        if stages:
+            out.append("")
+            out.append("per-stage speedup (share = stage time / routine time at baseline; stages nest):")
+            out.append(f"{'stage':<10} {'share':>7}  " + "  ".join(f"{'t=' + str(t):>7}" for t in ts))
+        first_stop = None   # (threads, -seconds, stage)
+        missing = []        # (stage, threads) without a timer sample
+        for s in stages:
+            b = base_stages[s][1]
+            cells = []
+            for t in ts:
+                c, sec = by_t[t][1].get(s, (0, 0.0))
+                if not c or sec <= 0:
+                    # no sample is not a speedup of 0: leave it out of the CSV and the verdict
+                    cells.append(f"{'n/a':>7}")
+                    missing.append((s, t))
+                    continue
+                sp = b / sec
+                eff = sp * t_base / t
+                cells.append(f"{sp:>7.2f}")
+                rows.append((routine, t, s, sec, sp, eff))
+                if t > t_base and eff < thr:
+                    cand = (t, -b, s)
+                    if first_stop is None or cand < first_stop:
+                        first_stop = cand
+            out.append(f"{s:<10} {b / base_total:>7.1%}  " + "  ".join(cells))
+        if missing:
+            out.append("[WARN] no timer sample for " +
+                       ", ".join(f"{s} at t={t}" for s, t in missing) + " (n/a above, not in CSV)")
+        if first_stop:
+            out.append(f"-> first stage to stop scaling: {first_stop[2]} "
+                       f"(efficiency < {thr:.0%} at {first_stop[0]} threads)")
+        elif stages:
+            out.append(f"-> all {'sampled ' if missing else ''}stages keep efficiency >= {thr:.0%}")
+        out.append("")
+
+    text = "\n".join(out)
+    print(text)
+    with open(os.path.join(run_dir, "report.txt"), "w") as f:
+        f.write(text + "\n")
+    with open(os.path.join(run_dir, "scaling.csv"), "w") as f:
+        f.write("routine,threads,stage,seconds,speedup,efficiency\n")
+        for r in rows:
+            f.write(f"{r[0]},{r[1]},{r[2]},{r[3]:.6f},{r[4]:.4f},{r[5]:.4f}\n")
+    print(f"Report written to: {os.path.join(run_dir, 'report.txt')}")
+
+
+if __name__ == "__main__":
+    main()
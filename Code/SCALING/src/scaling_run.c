@@ -0,0 +1,217 @@
+// scaling_run.c — One timed call of DSYEV / DSYEVD / DSTEDC / DSYTRD on a KMS
+// matrix, meant to be launched repeatedly by ../script/scaling.sh with a
+// different thread count and CPU set each time.
+//
+// Usage: scaling_run <dsyev|dsyevd|dstedc|dsytrd> [n] [jobz]
+//   - jobz applies to dsyev/dsyevd ('N' or 'V'); dstedc uses COMPZ='I' for
+//     'V' and 'N' otherwise; dsytrd ignores it.
+//   - The per-routine breakdown comes from the wrapper timers (stderr).
+//   - The last stdout line is a machine-readable RESULT record.
+//   - A and the D&C workspaces come from mem_alloc (common/src/numa_alloc.c, NUMA_POLICY env), and
+//     their per-node placement is printed next to the timing.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+
+#include "numa_alloc.h"
+
+/* --------- Fortran LAPACK symbols (vendor-agnostic) --------- */
+extern void dsyev_(const char *JOBZ, const char *UPLO, const int *N,
+                   double *A, const int *LDA, double *W,
+                   double *WORK, const int *LWORK, int *INFO);
+
+extern void dsyevd_(const char *JOBZ, const char *UPLO, const int *N,
+                    double *A, const int *LDA, double *W,
+                    double *WORK, const int *LWORK,
+                    int *IWORK, const int *LIWORK,
+                    int *INFO);
+
+extern void dsytrd_(const char *UPLO, const int *N,
+                    double *A, const int *LDA,
+                    double *D, double *E, double *TAU,
+                    double *WORK, const int *LWORK, int *INFO);
+
+extern void dstedc_(const char *COMPZ, const int *N,
+                    double *D, double *E,
+                    double *Z, const int *LDZ,
+                    double *WORK, const int *LWORK,
+                    int *IWORK, const int *LIWORK,
+                    int *INFO);
+
+/* Timer registry (common/src/wrap_timers.c) */
+extern void __stedc_timer_reset(void);
+
+/* --------- Utilities --------- */
+static double elapsed_seconds(struct timespec a, struct timespec b) {
+    return (b.tv_sec - a.tv_sec) + (b.tv_nsec - a.tv_nsec) / 1e9;
+}
+
+/* Fill A (n x n, column-major) with a classic SPD KMS test matrix:
+   A_ij = rho^{|i-j|} + delta*(i==j), with |rho|<1, delta>=0. */
+static void fill_kms(double *A, int n, double rho, double delta)
+{
+    if (!(rho > -1.0 && rho < 1.0)) rho = 0.95;
+    if (delta < 0.0) delta = 0.0;
+
+    double arho = fabs(rho);
+    double *rp = (double*)malloc((size_t)n * sizeof(double));
+    if (!rp) { fprintf(stderr, "Allocation failed (rp)\n"); exit(6); }
+
+    rp[0] = 1.0;
+    for (int k = 1; k < n; ++k) rp[k] = rp[k-1] * arho;
+
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i <= j; ++i) {
+            double v = rp[j - i];
+            if (i == j) v += delta;
+            A[i + (size_t)j * n] = v;
+            A[j + (size_t)i * n] = v;
+        }
+    }
+    free(rp);
+}
+
+static const char *env_or(const char *name, const char *dflt) {
+    const char *v = getenv(name);
+    return (v && *v) ? v : dflt;
+}
+
+/* DSYTRD on A (workspace query + timed call). D/E/TAU sized by caller. */
+static int run_sytrd(int n, double *A, double *D, double *E, double *TAU,
+                     double *secs)
+{
+    const char uplo = 'U';
+    int info = 0, lwork = -1;
+    double wkopt = 0.0;
+    dsytrd_(&uplo, &n, A, &n, D, E, TAU, &wkopt, &lwork, &info);
+    if (info != 0) return info;
+    lwork = (int)wkopt; if (lwork < 1) lwork = 1;
+    double *WORK = (double*)malloc((size_t)lwork * sizeof(double));
+    if (!WORK) return -100;
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    dsytrd_(&uplo, &n, A, &n, D, E, TAU, WORK, &lwork, &info);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    free(WORK);
+    if (secs) *secs = elapsed_seconds(t0, t1);
+    return info;
+}
+
+int main(int argc, char **argv)
+{
+    const char *routine = (argc > 1) ? argv[1] : "dsyevd";
+    const int   n       = (argc > 2) ? atoi(argv[2]) : 4000;
+    const char  jobz    = (argc > 3 && (argv[3][0] == 'V' || argv[3][0] == 'v')) ? 'V' : 'N';
+    const char  uplo    = 'U';
+    const double rho    = 0.95;
+    const double delta  = 0.0;
+
+    if (n <= 0) { fprintf(stderr, "Invalid n=%d\n", n); return 1; }
+
+    const char *threads = env_or("OPENBLAS_NUM_THREADS", env_or("OMP_NUM_THREADS", "1"));
+    const mem_policy_t mpol = mem_policy_from_env();
+    printf("Mode: %s (n=%d, JOBZ='%c', threads=%s, numa=%s)\n",
+           routine, n, jobz, threads, mem_policy_name(mpol));
+
+    const size_t bytes_A = (size_t)n * (size_t)n * sizeof(double);
+    double *A   = (double*)mem_alloc(bytes_A, mpol, 0);
+    double *W   = (double*)malloc((size_t)n * sizeof(double));
+    double *E   = (double*)malloc((size_t)n * sizeof(double));
+    double *TAU = (double*)malloc((size_t)n * sizeof(double));
+    if (!A || !W || !E || !TAU) {
+        fprintf(stderr, "Allocation failed.\n");
+        free(TAU); free(E); free(W); mem_free(A, bytes_A);
+        return 1;
+    }
+    fill_kms(A, n, rho, delta);
+
+    int info = 0;
+    double secs = 0.0;
+    double *WORK = NULL; size_t bytes_W = 0;   /* big workspace, kept for the placement report */
+    struct timespec t0, t1;
+
+    if (strcmp(routine, "dsyev") == 0) {
+        int lwork = -1; double wkopt = 0.0;
+        dsyev_(&jobz, &uplo, &n, A, &n, W, &wkopt, &lwork, &info);
+        if (info != 0) { fprintf(stderr, "DSYEV workspace query failed, info=%d\n", info); goto CLEANUP_ERR; }
+        lwork = (int)wkopt; if (lwork < 1) lwork = 1;
+        bytes_W = (size_t)lwork * sizeof(double);
+        WORK = (double*)mem_alloc(bytes_W, mpol, 0);
+        if (!WORK) { fprintf(stderr, "Allocation failed (WORK)\n"); goto CLEANUP_ERR; }
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        dsyev_(&jobz, &uplo, &n, A, &n, W, WORK, &lwork, &info);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        secs = elapsed_seconds(t0, t1);
+    }
+    else if (strcmp(routine, "dsyevd") == 0) {
+        int lwork = -1, liwork = -1, iwkopt = 0; double wkopt = 0.0;
+        dsyevd_(&jobz, &uplo, &n, A, &n, W, &wkopt, &lwork, &iwkopt, &liwork, &info);
+        if (info != 0) { fprintf(stderr, "DSYEVD workspace query failed, info=%d\n", info); goto CLEANUP_ERR; }
+        lwork  = (int)wkopt; if (lwork  < 1) lwork  = 1;
+        liwork = iwkopt;     if (liwork < 1) liwork = 1;
+        bytes_W = (size_t)lwork * sizeof(double);
+        WORK = (double*)mem_alloc(bytes_W, mpol, 0);
+        int *IWORK = (int*)malloc((size_t)liwork * sizeof(int));
+        if (!WORK || !IWORK) { fprintf(stderr, "Allocation failed (WORK/IWORK)\n"); free(IWORK); goto CLEANUP_ERR; }
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        dsyevd_(&jobz, &uplo, &n, A, &n, W, WORK, &lwork, IWORK, &liwork, &info);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        free(IWORK);
+        secs = elapsed_seconds(t0, t1);
+    }
+    else if (strcmp(routine, "dsytrd") == 0) {
+        info = run_sytrd(n, A, W, E, TAU, &secs);
+    }
+    else if (strcmp(routine, "dstedc") == 0) {
+        /* Untimed reduction to T, then a timed DSTEDC on (D,E). A is reused as Z. */
+        info = run_sytrd(n, A, W, E, TAU, NULL);
+        if (info != 0) { fprintf(stderr, "DSYTRD failed, info=%d\n", info); goto CLEANUP_ERR; }
+        __stedc_timer_reset();   /* keep the reduction out of the per-stage summary */
+
+        const char compz = (jobz == 'V') ? 'I' : 'N';
+        int ldz = (compz == 'I') ? n : 1;
+        int lwork = -1, liwork = -1, iwkopt = 0; double wkopt = 0.0;
+        dstedc_(&compz, &n, W, E, A, &ldz, &wkopt, &lwork, &iwkopt, &liwork, &info);
+        if (info != 0) { fprintf(stderr, "DSTEDC workspace query failed, info=%d\n", info); goto CLEANUP_ERR; }
+        lwork  = (int)wkopt; if (lwork  < 1) lwork  = 1;
+        liwork = iwkopt;     if (liwork < 1) liwork = 1;
+        bytes_W = (size_t)lwork * sizeof(double);
+        WORK = (double*)mem_alloc(bytes_W, mpol, 0);
+        int *IWORK = (int*)malloc((size_t)liwork * sizeof(int));
+        if (!WORK || !IWORK) { fprintf(stderr, "Allocation failed (WORK/IWORK)\n"); free(IWORK); goto CLEANUP_ERR; }
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        dstedc_(&compz, &n, W, E, A, &ldz, WORK, &lwork, IWORK, &liwork, &info);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        free(IWORK);
+        secs = elapsed_seconds(t0, t1);
+    }
+    else {
+        fprintf(stderr, "Unknown routine '%s' (dsyev|dsyevd|dstedc|dsytrd)\n", routine);
+        goto CLEANUP_ERR;
+    }
+
+    if (info != 0) { fprintf(stderr, "%s failed, info=%d\n", routine, info); goto CLEANUP_ERR; }
+
+    printf("%s took %.3f s\n", routine, secs);
+    mem_report_placement(stdout, "A", A, bytes_A);
+    if (WORK) mem_report_placement(stdout, "WORK", WORK, bytes_W);
+    printf("RESULT routine=%s n=%d jobz=%c threads=%s time=%.6f\n",
+           routine, n, jobz, threads, secs);
+    fflush(stdout);
+
+    mem_free(WORK, bytes_W);
+    free(TAU); free(E); free(W); mem_free(A, bytes_A);
+    return 0;
+
+CLEANUP_ERR:
+    mem_free(WORK, bytes_W);
+    free(TAU); free(E); free(W); mem_free(A, bytes_A);
+    return 2;
+}
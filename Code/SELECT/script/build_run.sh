@@ -0,0 +1,80 @@
+#!/usr/bin/env bash
+# build_run.sh — build the solver selector and run one of its commands.
+#   ./build_run.sh <case_name> [calibrate [n ...] | pick <n> <jobz> [nev] | solve <n> <jobz> [nev]]
+# Default: solve 4000 V with whatever table exists (none: the built-in
+#   crossovers). Calibration only runs when asked for (`calibrate`); it
+#   writes $EIG_TUNING (default ~/.cache/eig_tuning-<case_name>.txt).
+#   Re-run it per machine / thread count.
+set -euo pipefail
+
+export OMP_NUM_THREADS=${OMP_NUM_THREADS:-1}
+export OPENBLAS_NUM_THREADS=${OPENBLAS_NUM_THREADS:-1}
+export ARMPL_NUM_THREADS=${ARMPL_NUM_THREADS:-1}
+
+TAG="${1:-}"
+[ -n "$TAG" ] || { echo "Usage: $0 <case_name> [calibrate|pick|solve args...]"; exit 1; }
+shift
+
+# ====== 1) Compiler setup ======
+CC="${CC:-gcc}"
+CFLAGS_BASE="-O3 -std=c11 -D_POSIX_C_SOURCE=200809L \
+  -mcpu=native -mtune=native \
+  -fno-math-errno -fno-trapping-math -ffp-contract=fast \
+  -I../../common/src -DEIG_BACKEND=\"$TAG\""
+LIBS_FORTRAN="-lgfortran"
+LIBS_MATH="-lm"
+
+# ====== 2) Library presets ======
+CFLAGS_NETLIB="$CFLAGS_BASE -I../../LAPACK/build/include"
+LDFLAGS_NETLIB="../../LAPACK/build/lib/liblapack.a ../../LAPACK/build/lib/libblas.a $LIBS_FORTRAN $LIBS_MATH"
+
+CFLAGS_OB="$CFLAGS_BASE -I../../openblas/openblas_install/include"
+LDFLAGS_OB="../../openblas/openblas_install/lib/libopenblas.a $LIBS_FORTRAN $LIBS_MATH -lpthread -ldl"
+
+ARMPL_PREFIX="../../armpl/arm-performance-libraries_25.07_rpm/armpl_local/armpl_25.07_gcc"
+CFLAGS_AP="$CFLAGS_BASE -I$ARMPL_PREFIX/include"
+LDFLAGS_AP="$ARMPL_PREFIX/lib/libarmpl.a -lpthread -ldl $LIBS_FORTRAN $LIBS_MATH"
+
+# ====== 3) Sources ======
+SRCS=("../src/select_run.c" "../../common/src/eig_select.c" "../../common/src/mem_budget.c")
+
+# ====== 4) Case selection ======
+case "$TAG" in
+  select-openblas) CFLAGS="$CFLAGS_OB";     LDFLAGS="$LDFLAGS_OB" ;;
+  select-netlib)   CFLAGS="$CFLAGS_NETLIB"; LDFLAGS="$LDFLAGS_NETLIB" ;;
+  select-armpl)    CFLAGS="$CFLAGS_AP";     LDFLAGS="$LDFLAGS_AP" ;;
+  *)
+      echo "[X] Unknown TAG: $TAG"
+      echo "    Available: select-openblas | select-netlib | select-armpl"
+      exit 1;;
+esac
+
+# ====== 5) Output & Build ======
+OUT_DIR="../output"
+OBJ_DIR="$OUT_DIR/obj"
+BIN_DIR="$OUT_DIR/bin"
+mkdir -p "$OBJ_DIR" "$BIN_DIR"
+
+OBJS=()
+for f in "${SRCS[@]}"; do
+  base="$(basename "$f" .c)"
+  obj="$OBJ_DIR/${base}.o"
+  echo "[BUILD] CC=$CC | SRC=$f"
+  $CC $CFLAGS -c "$f" -o "$obj"
+  OBJS+=("$obj")
+done
+
+BIN="$BIN_DIR/$TAG"
+echo "[LINK ] ${OBJS[*]} -> $BIN"
+$CC "${OBJS[@]}" $LDFLAGS -o "$BIN"
+
+# ====== 6) Run ======
+echo "[INFO ] OMP_NUM_THREADS=$OMP_NUM_THREADS OPENBLAS_NUM_THREADS=$OPENBLAS_NUM_THREADS ARMPL_NUM_THREADS=$ARMPL_NUM_THREADS"
+if [[ $# -gt 0 ]]; then
+  echo "[RUN  ] EXE=$BIN $*"
+  exec "$BIN" "$@"
+fi
+TABLE="${EIG_TUNING:-${XDG_CACHE_HOME:-$HOME/.cache}/eig_tuning-$TAG.txt}"
+[[ -f "$TABLE" ]] || echo "[INFO ] no tuning table at $TABLE: default crossovers (calibrate with: $0 $TAG calibrate)"
+echo "[RUN  ] EXE=$BIN solve 4000 V"
+exec "$BIN" solve 4000 V
@@ -0,0 +1,226 @@
+// select_run.c — calibrate the solver tuning table, then let eig_select()
+// choose between DSYEV / DSYEVD / DSYEVR / DSYEVX / DSYEVD_2STAGE.
+//
+// Usage:
+//   select_run calibrate [n ...]            measure every path on KMS matrices
+//                                           (default n = 250 500 1000 2000) at
+//                                           the current thread count, merge the
+//                                           points into the tuning table
+//   select_run pick  <n> <jobz> [nev]       print the candidate table + choice
+//   select_run solve <n> <jobz> [nev]       choose, run on KMS, compare with
+//                                           the prediction
+//
+// Env: EIG_TUNING (table path, default per backend, see eig_select.h), EIG_CAL_REPS (median of,
+// default 3), EIG_CAL_FRAC (subset size for MRRR/bisection, default 0.1),
+// MEM_BUDGET (as in syevd.c), OPENBLAS_NUM_THREADS / OMP_NUM_THREADS.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+
+#include "eig_select.h"
+#include "mem_budget.h"
+
+#ifndef EIG_BACKEND
+#define EIG_BACKEND "unknown"     /* build_run.sh passes the case name */
+#endif
+
+/* --------- Utilities --------- */
+static double elapsed_seconds(struct timespec a, struct timespec b) {
+    return (b.tv_sec - a.tv_sec) + (b.tv_nsec - a.tv_nsec) / 1e9;
+}
+
+static int env_int(const char *name, int dflt) {
+    const char *v = getenv(name);
+    return (v && *v) ? atoi(v) : dflt;
+}
+
+static int env_threads(void) {
+    int t = env_int("OPENBLAS_NUM_THREADS", env_int("OMP_NUM_THREADS", 1));
+    return t > 0 ? t : 1;
+}
+
+/* Fill A (n x n, column-major) with a classic SPD KMS test matrix:
+   A_ij = rho^{|i-j|} + delta*(i==j), with |rho|<1, delta>=0. */
+static void fill_kms(double *A, int n, double rho, double delta)
+{
+    if (!(rho > -1.0 && rho < 1.0)) rho = 0.95;
+    if (delta < 0.0) delta = 0.0;
+
+    double arho = fabs(rho);
+    double *rp = (double*)malloc((size_t)n * sizeof(double));
+    if (!rp) { fprintf(stderr, "Allocation failed (rp)\n"); exit(6); }
+
+    rp[0] = 1.0;
+    for (int k = 1; k < n; ++k) rp[k] = rp[k-1] * arho;
+
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i <= j; ++i) {
+            double v = rp[j - i];
+            if (i == j) v += delta;
+            A[i + (size_t)j * n] = v;
+            A[j + (size_t)i * n] = v;
+        }
+    }
+    free(rp);
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/* One timed eig_run from a pristine copy of A0; Z == A for in-place paths. */
+static int time_path(eig_path_t p, char jobz, int n, int nev, const double *A0,
+                     double *A, double *W, double *Z, double *secs)
+{
+    const size_t nn = (size_t)n * n;
+    const int subset = (p == EIG_PATH_MRRR || p == EIG_PATH_BISECT);
+    int m = 0;
+    memcpy(A, A0, nn * sizeof(double));
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    int info = eig_run(p, jobz, 'U', n, A, n, nev, W, subset ? Z : A, n, &m);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    *secs = elapsed_seconds(t0, t1);
+    return info;
+}
+
+static int cmd_calibrate(int argc, char **argv)
+{
+    static const int DEFAULT_NS[] = { 250, 500, 1000, 2000 };
+    int nsz = argc > 0 ? argc : (int)(sizeof(DEFAULT_NS) / sizeof(DEFAULT_NS[0]));
+    int *ns = (int*)malloc((size_t)nsz * sizeof(int));
+    for (int i = 0; i < nsz; ++i) ns[i] = argc > 0 ? atoi(argv[i]) : DEFAULT_NS[i];
+
+    const int reps = env_int("EIG_CAL_REPS", 3) > 0 ? env_int("EIG_CAL_REPS", 3) : 1;
+    const char *fs = getenv("EIG_CAL_FRAC");
+    const double frac = (fs && *fs) ? atof(fs) : 0.1;
+    const int threads = env_threads();
+    const char *path = eig_tuning_path(EIG_BACKEND);
+
+    eig_tuning_t tab;
+    const int rc = eig_tuning_load(&tab, path, EIG_BACKEND, stderr);
+    if (rc < 0) { fprintf(stderr, "Cannot read %s\n", path); return 1; }
+    if (rc == 2) printf("Replacing %s: it belongs to another backend\n", path);
+    eig_tuning_stamp(&tab, EIG_BACKEND);
+    printf("Calibrating %s (backend=%s cpu=%s threads=%d reps=%d subset=%.2f)\n",
+           path, tab.backend, tab.cpu, threads, reps, frac);
+
+    double *samples = (double*)malloc((size_t)reps * sizeof(double));
+    for (int in = 0; in < nsz; ++in) {
+        const int n = ns[in];
+        if (n <= 0) continue;
+        const size_t nn = (size_t)n * n;
+        double *A0 = (double*)malloc(nn * sizeof(double));
+        double *A  = (double*)malloc(nn * sizeof(double));
+        double *Z  = (double*)malloc(nn * sizeof(double));
+        double *W  = (double*)malloc((size_t)n * sizeof(double));
+        if (!A0 || !A || !Z || !W) {
+            fprintf(stderr, "Allocation failed (n=%d)\n", n);
+            free(W); free(Z); free(A); free(A0);
+            continue;
+        }
+        fill_kms(A0, n, 0.95, 0.0);
+
+        for (int jz = 0; jz < 2; ++jz) {
+            const char jobz = jz ? 'V' : 'N';
+            for (int p = 0; p < EIG_PATH_COUNT; ++p) {
+                /* full spectrum for everything that supports it, plus one subset size */
+                for (int sub = 0; sub < 2; ++sub) {
+                    int nev = sub ? (int)lround(frac * n) : n;
+                    if (nev < 1) nev = 1;
+                    if (sub && (p != EIG_PATH_MRRR && p != EIG_PATH_BISECT)) continue;
+                    if (!eig_path_supports((eig_path_t)p, jobz, nev < n)) continue;
+
+                    int info = 0;
+                    for (int r = 0; r < reps && info == 0; ++r)
+                        info = time_path((eig_path_t)p, jobz, n, nev, A0, A, W, Z, &samples[r]);
+                    if (info != 0) {
+                        printf("  %-6s jobz=%c n=%5d nev=%5d  failed, info=%d\n",
+                               eig_path_name((eig_path_t)p), jobz, n, nev, info);
+                        continue;
+                    }
+                    qsort(samples, (size_t)reps, sizeof(double), cmp_double);
+                    eig_point_t pt = { (eig_path_t)p, jobz, threads, n, nev, samples[reps / 2] };
+                    eig_tuning_put(&tab, &pt);
+                    printf("  %-6s jobz=%c n=%5d nev=%5d  %10.4f s\n",
+                           eig_path_name((eig_path_t)p), jobz, n, nev, pt.seconds);
+                    fflush(stdout);
+                }
+            }
+        }
+        free(W); free(Z); free(A); free(A0);
+        /* save after every size so an interrupted calibration keeps its points */
+        if (eig_tuning_save(&tab, path) != 0) { free(samples); free(ns); eig_tuning_free(&tab); return 2; }
+    }
+    printf("Tuning table: %s (%d points)\n", path, tab.npts);
+    free(samples); free(ns);
+    eig_tuning_free(&tab);
+    return 0;
+}
+
+static int cmd_pick_or_solve(int solve, int argc, char **argv)
+{
+    if (argc < 2) { fprintf(stderr, "Usage: select_run %s <n> <jobz> [nev]\n", solve ? "solve" : "pick"); return 1; }
+    eig_request_t rq;
+    rq.n       = atoi(argv[0]);
+    rq.jobz    = (argv[1][0] == 'V' || argv[1][0] == 'v') ? 'V' : 'N';
+    rq.nev     = argc > 2 ? atoi(argv[2]) : 0;
+    rq.threads = env_threads();
+    rq.budget  = mem_budget_from_env();
+    if (rq.n <= 0) { fprintf(stderr, "Invalid n=%d\n", rq.n); return 1; }
+
+    const char *path = eig_tuning_path(EIG_BACKEND);
+    eig_tuning_t tab;
+    int rc = eig_tuning_load(&tab, path, EIG_BACKEND, stderr);
+    if (rc < 0) { fprintf(stderr, "Cannot read %s\n", path); return 1; }
+    if (rc == 1) printf("No tuning table at %s (run: select_run calibrate)\n", path);
+    if (rc == 2) printf("Tuning table %s is for another backend (run: select_run calibrate)\n", path);
+
+    const eig_path_t p = eig_select(&rq, &tab, stdout);
+    const double pred = eig_predict(&tab, p, &rq);
+    eig_tuning_free(&tab);
+    if (p == EIG_PATH_NONE) { fprintf(stderr, "No path fits the request\n"); return 3; }
+    if (!solve) return 0;
+
+    const int n = rq.n, nev = (rq.nev <= 0 || rq.nev > n) ? n : rq.nev;
+    const size_t nn = (size_t)n * n;
+    double *A0 = (double*)malloc(nn * sizeof(double));
+    double *A  = (double*)malloc(nn * sizeof(double));
+    double *W  = (double*)malloc((size_t)n * sizeof(double));
+    const int subset = (p == EIG_PATH_MRRR || p == EIG_PATH_BISECT);
+    double *Z  = (subset && rq.jobz == 'V') ? (double*)malloc((size_t)n * nev * sizeof(double)) : NULL;
+    if (!A0 || !A || !W || (subset && rq.jobz == 'V' && !Z)) {
+        fprintf(stderr, "Allocation failed.\n");
+        free(Z); free(W); free(A); free(A0);
+        return 1;
+    }
+    fill_kms(A0, n, 0.95, 0.0);
+
+    double secs = 0.0;
+    int info = time_path(p, rq.jobz, n, nev, A0, A, W, Z, &secs);
+    if (info != 0) { fprintf(stderr, "%s failed, info=%d\n", eig_path_routine(p), info); free(Z); free(W); free(A); free(A0); return 2; }
+
+    printf("%s took %.3f s", eig_path_routine(p), secs);
+    if (pred > 0.0) printf(" (predicted %.3f s, ratio %.2f)", pred, secs / pred);
+    printf("\nW[0]=%.12e W[%d]=%.12e\n", W[0], nev - 1, W[nev - 1]);
+    printf("RESULT path=%s n=%d jobz=%c nev=%d threads=%d time=%.6f pred=%.6f\n",
+           eig_path_name(p), n, rq.jobz, nev, rq.threads, secs, pred);
+
+    free(Z); free(W); free(A); free(A0);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *cmd = (argc > 1) ? argv[1] : "pick";
+    if (strcmp(cmd, "calibrate") == 0) return cmd_calibrate(argc - 2, argv + 2);
+    if (strcmp(cmd, "pick") == 0)      return cmd_pick_or_solve(0, argc - 2, argv + 2);
+    if (strcmp(cmd, "solve") == 0)     return cmd_pick_or_solve(1, argc - 2, argv + 2);
+    fprintf(stderr, "Usage: %s calibrate [n ...] | pick <n> <jobz> [nev] | solve <n> <jobz> [nev]\n", argv[0]);
+    return 1;
+}
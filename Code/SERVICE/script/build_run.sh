@@ -0,0 +1,115 @@
+#!/usr/bin/env bash
+# build_run.sh — build the persistent eigensolver service and drive it.
+#   ./build_run.sh <case_name> [n] [jobs] [depth]
+# Starts eig_server in the background (socket EIG_SOCKET, default
+# /tmp/eig_service.sock), then eig_client submits `jobs` n x n KMS matrices
+# in memfd buffers, `depth` in flight, checks the first one, asks for the
+# server's summary and shuts it down. SERVER_ONLY=1 just runs the server in
+# the foreground for other clients. See ../src/eig_server.c and
+# ../src/eig_client.c for the EIG_* settings. With EIG_WORKERS > 1 the
+# LAPACK/BLAS wrapper times are summed over the workers (WRAP_TIMING=0 drops
+# them).
+set -euo pipefail
+
+export OMP_NUM_THREADS=${OMP_NUM_THREADS:-1}
+export OPENBLAS_NUM_THREADS=${OPENBLAS_NUM_THREADS:-1}
+export ARMPL_NUM_THREADS=${ARMPL_NUM_THREADS:-1}
+
+TAG="${1:-}"
+[ -n "$TAG" ] || { echo "Usage: $0 <case_name> [n] [jobs] [depth]"; exit 1; }
+N="${2:-500}"
+JOBS="${3:-20}"
+DEPTH="${4:-1}"
+
+# ====== 1) Compiler setup ======
+CC="${CC:-gcc}"
+CFLAGS_BASE="-O3 -std=c11 -D_POSIX_C_SOURCE=199309L \
+  -mcpu=native -mtune=native \
+  -fno-math-errno -fno-trapping-math -ffp-contract=fast \
+  -I../../common/src -DEIG_BACKEND=\"$TAG\""
+LIBS_FORTRAN="-lgfortran"
+LIBS_MATH="-lm"
+
+# ====== 2) Library presets ======
+CFLAGS_NETLIB="$CFLAGS_BASE -I../../LAPACK/build/include"
+LDFLAGS_NETLIB="../../LAPACK/build/lib/liblapack.a ../../LAPACK/build/lib/libblas.a $LIBS_FORTRAN $LIBS_MATH"
+
+CFLAGS_OB="$CFLAGS_BASE -I../../openblas/openblas_install/include"
+LDFLAGS_OB="../../openblas/openblas_install/lib/libopenblas.a $LIBS_FORTRAN $LIBS_MATH -lpthread -ldl"
+
+ARMPL_PREFIX="../../armpl/arm-performance-libraries_25.07_rpm/armpl_local/armpl_25.07_gcc"
+CFLAGS_AP="$CFLAGS_BASE -I$ARMPL_PREFIX/include"
+LDFLAGS_AP="$ARMPL_PREFIX/lib/libarmpl.a -lpthread -ldl $LIBS_FORTRAN $LIBS_MATH"
+
+# ====== 3) Sources ======
+COMMON_SRCS=("../../common/src/eig_service.c"
+             "../../common/src/wrap_timers.c" "../../common/src/wrap_gen.c")
+SERVER_SRCS=("../src/eig_server.c" "../../common/src/mem_budget.c" "${COMMON_SRCS[@]}")
+CLIENT_SRCS=("../src/eig_client.c" "${COMMON_SRCS[@]}")
+
+# ====== 4) Symbols to --wrap: every WRAP_FN in common/src/wrap_syms.def ======
+WRAP_DEF="../../common/src/wrap_syms.def"
+WRAP_SYMS=($(grep -o '^WRAP_FN([A-Za-z_0-9]*' "$WRAP_DEF" | sed 's/^WRAP_FN(//'))
+WRAP_LDFLAGS=(); CFLAGS_WRAP=""
+# -u X pulls X out of the static archive even when only the wrapper calls it.
+if [[ "${WRAP_TIMING:-1}" == "1" ]]; then
+  for s in "${WRAP_SYMS[@]}"; do WRAP_LDFLAGS+=("-Wl,--wrap=${s}" "-Wl,-u,${s}"); done
+else
+  CFLAGS_WRAP="-DWRAP_TIMING_DISABLE"
+fi
+
+# ====== 5) Case selection ======
+case "$TAG" in
+  service-openblas)  CFLAGS="$CFLAGS_OB";     LDFLAGS="$LDFLAGS_OB ${WRAP_LDFLAGS[*]}" ;;
+  service-netlib)    CFLAGS="$CFLAGS_NETLIB"; LDFLAGS="$LDFLAGS_NETLIB ${WRAP_LDFLAGS[*]}" ;;
+  service-armpl)     CFLAGS="$CFLAGS_AP";     LDFLAGS="$LDFLAGS_AP ${WRAP_LDFLAGS[*]}" ;;
+  *)
+      echo "[X] Unknown TAG: $TAG"
+      echo "    Available: service-openblas | service-netlib | service-armpl"
+      exit 1;;
+esac
+
+# ====== 6) Output & Build ======
+OUT_DIR="../output"
+OBJ_DIR="$OUT_DIR/obj"
+BIN_DIR="$OUT_DIR/bin"
+mkdir -p "$OBJ_DIR" "$BIN_DIR"
+
+build() {   # build <binary> <sources...>
+  local bin="$BIN_DIR/$1"; shift
+  local objs=()
+  for f in "$@"; do
+    base="$(basename "$f" .c)"
+    obj="$OBJ_DIR/${base}.o"
+    echo "[BUILD] CC=$CC | SRC=$f"
+    $CC $CFLAGS $CFLAGS_WRAP -c "$f" -o "$obj"
+    objs+=("$obj")
+  done
+  echo "[LINK ] ${objs[*]} -> $bin"
+  $CC "${objs[@]}" $LDFLAGS -lpthread -o "$bin"
+}
+build "$TAG-server" "${SERVER_SRCS[@]}"
+build "$TAG-client" "${CLIENT_SRCS[@]}"
+SERVER="$BIN_DIR/$TAG-server"
+CLIENT="$BIN_DIR/$TAG-client"
+SOCK="${EIG_SOCKET:-/tmp/eig_service.sock}"
+export EIG_SOCKET="$SOCK"
+
+echo "[INFO ] OMP_NUM_THREADS=$OMP_NUM_THREADS OPENBLAS_NUM_THREADS=$OPENBLAS_NUM_THREADS ARMPL_NUM_THREADS=$ARMPL_NUM_THREADS"
+if [[ "${SERVER_ONLY:-0}" == "1" ]]; then
+  echo "[RUN  ] EXE=$SERVER (socket $SOCK)"
+  exec "$SERVER"
+fi
+
+echo "[RUN  ] EXE=$SERVER & (socket $SOCK)"
+rm -f "$SOCK"
+"$SERVER" &
+SERVER_PID=$!
+trap 'kill "$SERVER_PID" 2>/dev/null || true' EXIT
+for _ in $(seq 100); do [[ -S "$SOCK" ]] && break; sleep 0.1; done
+[[ -S "$SOCK" ]] || { echo "[X] server did not come up on $SOCK"; exit 1; }
+
+echo "[RUN  ] EXE=$CLIENT $N $JOBS $DEPTH"
+EIG_CLIENT_STATS=1 EIG_CLIENT_SHUTDOWN=1 "$CLIENT" "$N" "$JOBS" "$DEPTH"
+wait "$SERVER_PID"
+trap - EXIT
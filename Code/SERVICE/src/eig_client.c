@@ -0,0 +1,205 @@
+// eig_client.c — load generator and checker for eig_server: submits KMS
+// matrices (rho varies per job) in memfd buffers and reads the eigenpairs
+// back out of the same pages.
+//
+// Usage: eig_client [n] [jobs] [depth]           defaults 500, 20, 1
+//   depth  jobs in flight on the connection, one buffer each
+// Env:
+//   EIG_SOCKET           server socket (default /tmp/eig_service.sock)
+//   EIG_JOBZ             V (default) or N
+//   EIG_CHECK            1 (default): residual max_j ||A z_j - w_j z_j|| / ||A||_F
+//                        and orthogonality ||Z^T Z - I||_F of the first job
+//   EIG_CLIENT_STATS     1: ask the server to print its summary afterwards
+//   EIG_CLIENT_SHUTDOWN  1: stop the server afterwards
+// Reported per job: round trip (submit -> reply, fill excluded) and the
+// server's queue / setup / DSYEVD times; transport = round trip - server.
+// Results: stdout + ../output/client_time.txt
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "eig_service.h" /* ../../common/src: protocol, memfd buffers, SCM_RIGHTS */
+#include "now_sec.h"
+
+/* --------- Fortran BLAS symbols (vendor-agnostic) --------- */
+extern void dgemm_(const char *TRANSA, const char *TRANSB, const int *M, const int *N, const int *K,
+                   const double *ALPHA, const double *A, const int *LDA, const double *B, const int *LDB,
+                   const double *BETA, double *C, const int *LDC);
+
+/* --------- Utilities --------- */
+static void ensure_dir(const char *path) {
+    if (mkdir(path, 0777) != 0 && errno != EEXIST) {
+        perror("mkdir");
+        exit(5);
+    }
+}
+
+static int env_int(const char *name, int dflt) {
+    const char *v = getenv(name);
+    return (v && *v) ? atoi(v) : dflt;
+}
+
+static double job_rho(long job) { return 0.50 + 0.45 * (double)((job * 37) % 100) / 100.0; }
+
+/* KMS A_ij = rho^{|i-j|}, both triangles */
+static void fill_kms(double *A, int n, double rho)
+{
+    double *rp = A + (size_t)n * n;                       /* W area as scratch */
+    rp[0] = 1.0;
+    for (int k = 1; k < n; ++k) rp[k] = rp[k-1] * rho;
+    for (int j = 0; j < n; ++j)
+        for (int i = 0; i <= j; ++i) {
+            A[i + (size_t)j * n] = rp[j - i];
+            A[j + (size_t)i * n] = rp[j - i];
+        }
+}
+
+/* Residual and orthogonality of (W, Z) for A0. */
+static void check_pairs(const double *A0, const double *Z, const double *W, int n, double *res, double *orth)
+{
+    double *R = (double*)malloc((size_t)n * n * sizeof(double));
+    if (!R) { *res = *orth = -1.0; return; }
+    const char tn = 'N', tt = 'T';
+    const double one = 1.0, zero = 0.0;
+    double anrm = 0.0;
+    for (size_t i = 0; i < (size_t)n * n; ++i) anrm += A0[i] * A0[i];
+    anrm = sqrt(anrm);
+    dgemm_(&tn, &tn, &n, &n, &n, &one, A0, &n, Z, &n, &zero, R, &n);
+    *res = 0.0;
+    for (int j = 0; j < n; ++j) {
+        double s = 0.0;
+        for (int i = 0; i < n; ++i) {
+            const double r = R[i + (size_t)j * n] - W[j] * Z[i + (size_t)j * n];
+            s += r * r;
+        }
+        if (sqrt(s) > *res) *res = sqrt(s);
+    }
+    *res /= anrm;
+    dgemm_(&tt, &tn, &n, &n, &n, &one, Z, &n, Z, &n, &zero, R, &n);
+    *orth = 0.0;
+    for (int j = 0; j < n; ++j)
+        for (int i = 0; i < n; ++i) {
+            const double d = R[i + (size_t)j * n] - (i == j ? 1.0 : 0.0);
+            *orth += d * d;
+        }
+    *orth = sqrt(*orth);
+    free(R);
+}
+
+static int submit(int sock, uint32_t op, uint64_t id, int n, char jobz, int fd)
+{
+    eig_svc_req_t req;
+    memset(&req, 0, sizeof(req));
+    req.magic = EIG_SVC_MAGIC; req.op = op; req.id = id; req.n = n; req.jobz = jobz;
+    return eig_svc_send(sock, &req, sizeof(req), fd);
+}
+
+int main(int argc, char **argv)
+{
+    const int n     = (argc > 1) ? atoi(argv[1]) : 500;
+    const int jobs  = (argc > 2) ? atoi(argv[2]) : 20;
+    int       depth = (argc > 3) ? atoi(argv[3]) : 1;
+    if (n <= 0 || jobs <= 0) { fprintf(stderr, "Usage: %s [n] [jobs] [depth]\n", argv[0]); return 1; }
+    if (depth < 1) depth = 1;
+    if (depth > jobs) depth = jobs;
+    const char *jz = getenv("EIG_JOBZ");
+    const char jobz = (jz && (*jz == 'N' || *jz == 'n')) ? 'N' : 'V';
+    const int check = env_int("EIG_CHECK", 1) && jobz == 'V';
+
+    const int sock = eig_svc_connect(NULL);
+    if (sock < 0) return 2;
+
+    int     *fd   = (int*)malloc((size_t)depth * sizeof(int));
+    double **buf  = (double**)calloc((size_t)depth, sizeof(double*));
+    int     *free_slots = (int*)malloc((size_t)depth * sizeof(int));
+    int     *slot_of = (int*)malloc((size_t)jobs * sizeof(int));
+    double  *t_sub = (double*)calloc((size_t)jobs, sizeof(double));
+    eig_svc_rep_t *rep = (eig_svc_rep_t*)calloc((size_t)jobs, sizeof(eig_svc_rep_t));
+    double  *rtt  = (double*)calloc((size_t)jobs, sizeof(double));
+    double  *A0   = check ? (double*)malloc((size_t)n * n * sizeof(double)) : NULL;
+    if (!fd || !buf || !free_slots || !slot_of || !t_sub || !rep || !rtt || (check && !A0)) {
+        fprintf(stderr, "Allocation failed (client)\n"); return 6;
+    }
+    for (int b = 0; b < depth; ++b) {
+        fd[b] = eig_svc_buffer_create(n, &buf[b]);
+        if (fd[b] < 0) return 6;
+        memset(buf[b], 0, eig_svc_buffer_bytes(n));       /* fault the client side in once */
+        free_slots[b] = b;
+    }
+    int nfree = depth;
+
+    printf("[eig_client] n=%d jobs=%d depth=%d JOBZ=%c socket=%s\n",
+           n, jobs, depth, jobz, eig_svc_socket_path(NULL));
+    double res = -1.0, orth = -1.0, t_first = 0.0;
+    int next = 0, done = 0, failed = 0;
+    const double t0 = now_sec();
+    while (done < jobs) {
+        while (next < jobs && nfree > 0) {
+            const int b = free_slots[--nfree];
+            fill_kms(buf[b], n, job_rho(next));
+            if (check && next == 0) memcpy(A0, buf[b], (size_t)n * n * sizeof(double));
+            slot_of[next] = b;
+            t_sub[next] = now_sec();
+            if (submit(sock, EIG_SVC_SOLVE, (uint64_t)next, n, jobz, fd[b]) != 0) {
+                fprintf(stderr, "[eig_client] send failed: %s\n", strerror(errno)); return 3;
+            }
+            next++;
+        }
+        eig_svc_rep_t r;
+        if (eig_svc_recv(sock, &r, sizeof(r), NULL) != 0 || r.id >= (uint64_t)jobs) {
+            fprintf(stderr, "[eig_client] server closed the connection\n"); return 3;
+        }
+        const int id = (int)r.id, b = slot_of[id];
+        rtt[id] = now_sec() - t_sub[id];
+        rep[id] = r;
+        if (r.info != 0) failed++;
+        if (id == 0) {
+            t_first = rtt[0];
+            if (check && r.info == 0) check_pairs(A0, buf[b], buf[b] + (size_t)n * n, n, &res, &orth);
+        }
+        free_slots[nfree++] = b;
+        done++;
+    }
+    const double t_all = now_sec() - t0;
+
+    /* ---- Report ---- */
+    double s_rtt = 0.0, s_q = 0.0, s_set = 0.0, s_sol = 0.0, s_tr = 0.0, m_rtt = 0.0;
+    for (int j = 0; j < jobs; ++j) {
+        s_rtt += rtt[j]; s_q += rep[j].queue_s; s_set += rep[j].setup_s; s_sol += rep[j].solve_s;
+        s_tr += rtt[j] - rep[j].server_s;
+        if (rtt[j] > m_rtt) m_rtt = rtt[j];
+    }
+    printf("jobs %d in %.4f s: %.3f jobs/s, failed %d\n", jobs, t_all, jobs / t_all, failed);
+    printf("round trip  avg %.6f  max %.6f  first %.6f s\n", s_rtt / jobs, m_rtt, t_first);
+    printf("server      queue %.6f  setup %.6f  DSYEVD %.6f s (avg)\n", s_q / jobs, s_set / jobs, s_sol / jobs);
+    printf("transport   %.6f s (avg round trip - server)\n", s_tr / jobs);
+    if (check) printf("job 0       residual %.3e  orthogonality %.3e\n", res, orth);
+
+    ensure_dir("../output");
+    FILE *ft = fopen("../output/client_time.txt", "w");
+    if (ft) {
+        fprintf(ft, "# job n info rtt_s queue_s setup_s solve_s server_s\n");
+        for (int j = 0; j < jobs; ++j)
+            fprintf(ft, "%d %d %d %.6f %.6f %.6f %.6f %.6f\n", j, rep[j].n, rep[j].info, rtt[j],
+                    rep[j].queue_s, rep[j].setup_s, rep[j].solve_s, rep[j].server_s);
+        fprintf(ft, "# jobs/s %.6f avg_rtt %.6f max_rtt %.6f residual %.3e orthogonality %.3e\n",
+                jobs / t_all, s_rtt / jobs, m_rtt, res, orth);
+        fclose(ft);
+    }
+
+    eig_svc_rep_t r;
+    if (env_int("EIG_CLIENT_STATS", 0) && submit(sock, EIG_SVC_STATS, 0, 0, 0, -1) == 0)
+        eig_svc_recv(sock, &r, sizeof(r), NULL);
+    if (env_int("EIG_CLIENT_SHUTDOWN", 0) && submit(sock, EIG_SVC_SHUTDOWN, 0, 0, 0, -1) == 0)
+        eig_svc_recv(sock, &r, sizeof(r), NULL);
+
+    close(sock);
+    for (int b = 0; b < depth; ++b) eig_svc_buffer_free(fd[b], buf[b], n);
+    free(A0); free(rtt); free(rep); free(t_sub); free(slot_of); free(free_slots); free(buf); free(fd);
+    return failed ? 3 : 0;
+}
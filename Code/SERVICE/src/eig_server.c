@@ -0,0 +1,481 @@
+// eig_server.c — persistent local eigensolver service. One process pays the
+// start-up, backend initialisation and workspace faulting once; jobs then
+// come in over a Unix socket with the matrix in a client memfd
+// (common/src/eig_service.h) and are solved in place by DSYEVD: no copy of
+// A in either direction, no result files. A memfd not sealed against
+// shrinking (F_SEAL_SHRINK) is refused with info=-1: a client truncating it
+// under the solver's mapping would otherwise SIGBUS the whole service. So is
+// an n whose DSYEVD LWORK does not fit a 32-bit int (n > ~32k, JOBZ='V').
+//
+// Usage: eig_server
+// Env:
+//   EIG_SOCKET    socket path (default /tmp/eig_service.sock); the server
+//                 refuses to start while another one accepts there
+//   EIG_WORKERS   solver threads (default 1; more want single-threaded BLAS)
+//   EIG_QUEUE     pending jobs before connection readers block (default 64)
+//   EIG_WS_SIZES  warm workspaces kept per worker, LRU over (n, JOBZ)
+//                 (default 4)
+//   EIG_WARM      orders to warm up before accepting, e.g. "500,1000"
+//   EIG_LOG       1: one line per job on stdout
+// Per job the reply carries queue, workspace-setup, solve and in-server
+// times; the summary (on a STATS request and at shutdown, SIGINT/SIGTERM
+// or a SHUTDOWN request) goes to stdout + ../output/service_time.txt.
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include "eig_service.h" /* ../../common/src: protocol, memfd buffers, SCM_RIGHTS */
+#include "mem_budget.h"  /* eig_dsyevd_lwork / eig_lwork_int */
+#include "now_sec.h"
+
+#ifndef EIG_BACKEND
+#define EIG_BACKEND "unknown"     /* build_run.sh passes the case name */
+#endif
+
+/* --------- Fortran LAPACK symbols (vendor-agnostic) --------- */
+extern void dsyevd_(const char *JOBZ, const char *UPLO, const int *N,
+                    double *A, const int *LDA, double *W,
+                    double *WORK, const int *LWORK,
+                    int *IWORK, const int *LIWORK,
+                    int *INFO);
+
+/* --------- Utilities --------- */
+static void ensure_dir(const char *path) {
+    if (mkdir(path, 0777) != 0 && errno != EEXIST) {
+        perror("mkdir");
+        exit(5);
+    }
+}
+
+static int env_int(const char *name, int dflt) {
+    const char *v = getenv(name);
+    return (v && *v) ? atoi(v) : dflt;
+}
+
+/* --------- Connections --------- */
+
+typedef struct {
+    int             sock;
+    int             refs;        /* reader + jobs in flight */
+    pthread_mutex_t mu;          /* refs, and one reply at a time on sock */
+} conn_t;
+
+static void conn_put(conn_t *c)
+{
+    pthread_mutex_lock(&c->mu);
+    const int last = (--c->refs == 0);
+    pthread_mutex_unlock(&c->mu);
+    if (!last) return;
+    close(c->sock);
+    pthread_mutex_destroy(&c->mu);
+    free(c);
+}
+
+static void conn_reply(conn_t *c, const eig_svc_rep_t *rep)
+{
+    pthread_mutex_lock(&c->mu);
+    eig_svc_send(c->sock, rep, sizeof(*rep), -1);     /* a client gone away just loses it */
+    pthread_mutex_unlock(&c->mu);
+}
+
+/* --------- Job queue --------- */
+
+typedef struct { conn_t *c; eig_svc_req_t req; int fd; double t_recv; } job_t;
+
+static struct {
+    job_t          *buf;
+    int             cap, head, count, closed;
+    pthread_mutex_t mu;
+    pthread_cond_t  not_empty, not_full;
+} Q = { NULL, 0, 0, 0, 0, PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER };
+
+/* 0, or -1 once the service is shutting down */
+static int q_push(const job_t *j)
+{
+    pthread_mutex_lock(&Q.mu);
+    while (Q.count == Q.cap && !Q.closed) pthread_cond_wait(&Q.not_full, &Q.mu);
+    const int ok = !Q.closed;
+    if (ok) {
+        Q.buf[(Q.head + Q.count) % Q.cap] = *j;
+        Q.count++;
+        pthread_cond_signal(&Q.not_empty);
+    }
+    pthread_mutex_unlock(&Q.mu);
+    return ok ? 0 : -1;
+}
+
+/* 1 with a job, 0 once closed and drained */
+static int q_pop(job_t *j)
+{
+    pthread_mutex_lock(&Q.mu);
+    while (Q.count == 0 && !Q.closed) pthread_cond_wait(&Q.not_empty, &Q.mu);
+    const int got = Q.count > 0;
+    if (got) {
+        *j = Q.buf[Q.head];
+        Q.head = (Q.head + 1) % Q.cap;
+        Q.count--;
+        pthread_cond_signal(&Q.not_full);
+    }
+    pthread_mutex_unlock(&Q.mu);
+    return got;
+}
+
+static void q_close(void)
+{
+    pthread_mutex_lock(&Q.mu);
+    Q.closed = 1;
+    pthread_cond_broadcast(&Q.not_empty);
+    pthread_cond_broadcast(&Q.not_full);
+    pthread_mutex_unlock(&Q.mu);
+}
+
+/* --------- Metrics --------- */
+
+/* A latency series in O(1) memory for the life of the service: count, sum
+   and max exactly, percentiles from a log-spaced histogram (HIST_PER_DEC
+   buckets per decade from 1 us to 1000 s, so a percentile is the upper edge
+   of its bucket, within ~12%). */
+#define HIST_PER_DEC 20
+#define HIST_NB      (9 * HIST_PER_DEC + 2)              /* + <= 1 us, + > 1000 s */
+
+typedef struct { long n; double sum, max; long bucket[HIST_NB]; } series_t;
+
+static struct {
+    pthread_mutex_t mu;
+    long     jobs, failed, warm, cold;
+    series_t queue, setup, solve, server;
+    double   t_start;
+} M = { .mu = PTHREAD_MUTEX_INITIALIZER };
+
+static void series_add(series_t *s, double x)
+{
+    int b = 0;
+    if (x > 1e-6) {
+        b = 1 + (int)floor((log10(x) + 6.0) * HIST_PER_DEC);
+        if (b > HIST_NB - 1) b = HIST_NB - 1;
+    }
+    s->bucket[b]++;
+    s->n++;
+    s->sum += x;
+    if (x > s->max) s->max = x;
+}
+
+static double series_pct(const series_t *s, double p)
+{
+    const long target = (long)ceil(p * s->n);
+    long acc = 0;
+    for (int b = 0; b < HIST_NB; ++b) {
+        acc += s->bucket[b];
+        if (acc >= target) {
+            const double edge = pow(10.0, (double)b / HIST_PER_DEC - 6.0);
+            return edge < s->max ? edge : s->max;
+        }
+    }
+    return s->max;
+}
+
+static void series_line(FILE *f, const char *name, const series_t *s)
+{
+    if (s->n == 0) { fprintf(f, "%-7s (no jobs)\n", name); return; }
+    fprintf(f, "%-7s avg %.6f  p50 %.6f  p95 %.6f  max %.6f s\n", name,
+            s->sum / s->n, series_pct(s, 0.50), series_pct(s, 0.95), s->max);
+}
+
+static void metrics_report(FILE *f)
+{
+    pthread_mutex_lock(&M.mu);
+    fprintf(f, "Backend: %s  up %.3f s  jobs=%ld failed=%ld  workspace warm=%ld cold=%ld\n",
+            EIG_BACKEND, now_sec() - M.t_start, M.jobs, M.failed, M.warm, M.cold);
+    series_line(f, "QUEUE", &M.queue);
+    series_line(f, "SETUP", &M.setup);
+    series_line(f, "DSYEVD", &M.solve);
+    series_line(f, "SERVER", &M.server);
+    pthread_mutex_unlock(&M.mu);
+}
+
+static void metrics_dump(void)
+{
+    metrics_report(stdout);
+    fflush(stdout);
+    ensure_dir("../output");
+    FILE *ft = fopen("../output/service_time.txt", "w");
+    if (ft) { metrics_report(ft); fclose(ft); }
+}
+
+/* --------- Warm workspaces --------- */
+
+static int g_log = 0;
+
+typedef struct { int n; char jobz; int lwork, liwork; double *work; int *iwork; unsigned long used; } ws_entry_t;
+typedef struct { ws_entry_t *e; int cap; unsigned long tick; } ws_cache_t;
+
+/* Workspace for (n, jobz): a hit, or a query + allocation + first touch
+   into the least recently used entry. *setup_s gets the time of the miss. */
+static ws_entry_t *ws_get(ws_cache_t *wc, int n, char jobz, double *setup_s, int *hit)
+{
+    *setup_s = 0.0; *hit = 0;
+    ws_entry_t *lru = &wc->e[0];
+    for (int i = 0; i < wc->cap; ++i) {
+        ws_entry_t *e = &wc->e[i];
+        if (e->n == n && e->jobz == jobz) { e->used = ++wc->tick; *hit = 1; return e; }
+        if (e->used < lru->used) lru = e;
+    }
+    const double t0 = now_sec();
+    free(lru->work); free(lru->iwork);
+    memset(lru, 0, sizeof(*lru));
+    const char uplo = 'U';
+    const int q = -1;
+    int info = 0, iwkopt = 0;
+    double wkopt = 0.0, d = 0.0;
+    dsyevd_(&jobz, &uplo, &n, &d, &n, &d, &wkopt, &q, &iwkopt, &q, &info);
+    if (info != 0) return NULL;
+    wkopt = eig_dsyevd_lwork(jobz, n, wkopt);     /* n is the client's: LWMIN wraps past ~32k */
+    if (eig_lwork_int(wkopt, &lru->lwork) != 0) {
+        if (g_log) printf("[eig_server] n=%d: DSYEVD LWORK %.0f exceeds INT_MAX, refused\n", n, wkopt);
+        return NULL;
+    }
+    lru->liwork = iwkopt;
+    lru->work   = (double*)malloc((size_t)lru->lwork * sizeof(double));
+    lru->iwork  = (int*)malloc((size_t)lru->liwork * sizeof(int));
+    if (!lru->work || !lru->iwork) { free(lru->work); free(lru->iwork); memset(lru, 0, sizeof(*lru)); return NULL; }
+    memset(lru->work, 0, (size_t)lru->lwork * sizeof(double));     /* faulted now, not mid-solve */
+    memset(lru->iwork, 0, (size_t)lru->liwork * sizeof(int));
+    lru->n = n; lru->jobz = jobz; lru->used = ++wc->tick;
+    *setup_s = now_sec() - t0;
+    return lru;
+}
+
+/* --------- Solver workers --------- */
+
+static void *solver_worker(void *varg)
+{
+    ws_cache_t *wc = (ws_cache_t*)varg;
+    job_t j;
+    while (q_pop(&j)) {
+        const double t_pick = now_sec();
+        const int n = j.req.n;
+        eig_svc_rep_t rep;
+        memset(&rep, 0, sizeof(rep));
+        rep.id = j.req.id; rep.n = n; rep.info = -1;
+        rep.queue_s = t_pick - j.t_recv;
+
+        const size_t bytes = eig_svc_buffer_bytes(n);
+        struct stat sb;
+        double *A = NULL;
+        ws_entry_t *ws = NULL;
+        int warm = 0;
+        const int seals = fcntl(j.fd, F_GET_SEALS);
+        if (seals >= 0 && (seals & F_SEAL_SHRINK) && fstat(j.fd, &sb) == 0 && (size_t)sb.st_size >= bytes)
+            ws = ws_get(wc, n, j.req.jobz, &rep.setup_s, &warm);   /* refuses n > LP64 LWORK before mapping */
+        if (ws) {
+            void *p = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, j.fd, 0);
+            if (p != MAP_FAILED) A = (double*)p;
+        }
+        close(j.fd);
+        if (A) {
+            const char uplo = 'U';
+            const double t0 = now_sec();
+            dsyevd_(&j.req.jobz, &uplo, &n, A, &n, A + (size_t)n * n,
+                    ws->work, &ws->lwork, ws->iwork, &ws->liwork, &rep.info);
+            rep.solve_s = now_sec() - t0;
+            munmap(A, bytes);
+        }
+        rep.server_s = now_sec() - j.t_recv;
+
+        pthread_mutex_lock(&M.mu);                        /* before the reply: a STATS after it sees the job */
+        M.jobs++;
+        if (rep.info != 0) M.failed++;
+        if (warm) M.warm++; else M.cold++;
+        series_add(&M.queue, rep.queue_s);
+        series_add(&M.setup, rep.setup_s);
+        series_add(&M.solve, rep.solve_s);
+        series_add(&M.server, rep.server_s);
+        pthread_mutex_unlock(&M.mu);
+        conn_reply(j.c, &rep);
+        conn_put(j.c);
+        if (g_log)
+            printf("job %llu n=%d info=%d queue %.6f setup %.6f solve %.6f server %.6f s\n",
+                   (unsigned long long)rep.id, n, rep.info, rep.queue_s, rep.setup_s, rep.solve_s, rep.server_s);
+    }
+    return NULL;
+}
+
+/* --------- Accept loop --------- */
+
+static volatile sig_atomic_t g_stop = 0;
+static int g_listen = -1;
+
+static void request_stop(void)
+{
+    g_stop = 1;
+    shutdown(g_listen, SHUT_RDWR);                        /* wakes accept() */
+}
+
+static void on_signal(int sig) { (void)sig; request_stop(); }
+
+static void *conn_reader(void *varg)
+{
+    conn_t *c = (conn_t*)varg;
+    eig_svc_req_t req;
+    int fd = -1;
+    while (!g_stop && eig_svc_recv(c->sock, &req, sizeof(req), &fd) == 0) {
+        const double t_recv = now_sec();
+        eig_svc_rep_t rep;
+        memset(&rep, 0, sizeof(rep));
+        rep.id = req.id; rep.n = req.n; rep.info = -1;
+        if (req.magic != EIG_SVC_MAGIC) { if (fd >= 0) close(fd); break; }
+        if (req.op == EIG_SVC_SOLVE && fd >= 0 && req.n > 0 && (req.jobz == 'V' || req.jobz == 'N')) {
+            job_t j = { c, req, fd, t_recv };
+            pthread_mutex_lock(&c->mu); c->refs++; pthread_mutex_unlock(&c->mu);
+            if (q_push(&j) == 0) { fd = -1; continue; }
+            conn_put(c);                                  /* shutting down: refuse */
+        } else if (req.op == EIG_SVC_STATS) {
+            metrics_report(stdout);
+            fflush(stdout);
+            rep.info = 0;
+        } else if (req.op == EIG_SVC_SHUTDOWN) {
+            rep.info = 0;
+            conn_reply(c, &rep);
+            request_stop();
+            break;
+        }
+        if (fd >= 0) { close(fd); fd = -1; }
+        rep.server_s = now_sec() - t_recv;
+        conn_reply(c, &rep);
+    }
+    conn_put(c);
+    return NULL;
+}
+
+/* 1 when a server already accepts on `addr`; a refused connect or a missing
+   file is a stale socket (or none), safe to unlink. */
+static int socket_in_use(const struct sockaddr_un *addr)
+{
+    const int s = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (s < 0) return 0;
+    const int live = connect(s, (const struct sockaddr*)addr, sizeof(*addr)) == 0;
+    close(s);
+    return live;
+}
+
+int main(void)
+{
+    const char *path = eig_svc_socket_path(NULL);
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) { fprintf(stderr, "[eig_server] socket path too long\n"); return 1; }
+    strcpy(addr.sun_path, path);
+    if (socket_in_use(&addr)) {
+        fprintf(stderr, "[eig_server] %s: a server is already listening there (stop it or set EIG_SOCKET)\n", path);
+        return 1;
+    }
+    int nworkers = env_int("EIG_WORKERS", 1), nsizes = env_int("EIG_WS_SIZES", 4);
+    if (nworkers < 1) nworkers = 1;
+    if (nsizes < 1)   nsizes = 1;
+    Q.cap = env_int("EIG_QUEUE", 64);
+    if (Q.cap < 1) Q.cap = 1;
+    g_log = env_int("EIG_LOG", 0);
+    M.t_start = now_sec();
+
+    Q.buf = (job_t*)calloc((size_t)Q.cap, sizeof(job_t));
+    ws_cache_t *wc = (ws_cache_t*)calloc((size_t)nworkers, sizeof(ws_cache_t));
+    pthread_t  *tid = (pthread_t*)calloc((size_t)nworkers, sizeof(pthread_t));
+    if (!Q.buf || !wc || !tid) { fprintf(stderr, "Allocation failed (service)\n"); return 6; }
+    for (int w = 0; w < nworkers; ++w) {
+        wc[w].cap = nsizes;
+        wc[w].e = (ws_entry_t*)calloc((size_t)nsizes, sizeof(ws_entry_t));
+        if (!wc[w].e) { fprintf(stderr, "Allocation failed (workspace cache)\n"); return 6; }
+    }
+
+    /* Backend init (thread pool, dispatch) and the EIG_WARM workspaces, all
+       before the first job arrives. */
+    {
+        const double t0 = now_sec();
+        double a[4] = { 2.0, 1.0, 1.0, 2.0 }, w2[2], work[32], s;
+        int iwork[16], info = 0;
+        const int two = 2, lw = 32, liw = 16;
+        const char jv = 'V', up = 'U';
+        dsyevd_(&jv, &up, &two, a, &two, w2, work, &lw, iwork, &liw, &info);
+        int nwarm = 0;
+        const char *warm = getenv("EIG_WARM");
+        for (const char *p = warm; p && *p; ) {
+            const int n = atoi(p);
+            if (n > 0) {
+                int hit;
+                for (int w = 0; w < nworkers; ++w) ws_get(&wc[w], n, 'V', &s, &hit);
+                nwarm++;
+            }
+            while (*p && *p != ',') ++p;
+            if (*p == ',') ++p;
+        }
+        printf("[eig_server] backend %s ready in %.3f s (%d warm orders x %d workers)\n",
+               EIG_BACKEND, now_sec() - t0, nwarm, nworkers);
+    }
+
+    unlink(path);                                         /* stale socket of a killed server; live ones refused above */
+    g_listen = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (g_listen < 0 || bind(g_listen, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(g_listen, 64) != 0) {
+        fprintf(stderr, "[eig_server] %s: %s\n", path, strerror(errno));
+        return 1;
+    }
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;                            /* no SA_RESTART: accept() returns */
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    for (int w = 0; w < nworkers; ++w)
+        if (pthread_create(&tid[w], NULL, solver_worker, &wc[w]) != 0) {
+            fprintf(stderr, "[eig_server] pthread_create failed\n");
+            return 7;
+        }
+    printf("[eig_server] listening on %s (%d workers, queue %d, %d warm sizes/worker)\n",
+           path, nworkers, Q.cap, nsizes);
+    fflush(stdout);
+
+    while (!g_stop) {
+        const int s = accept4(g_listen, NULL, NULL, SOCK_CLOEXEC);
+        if (s < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (!g_stop) perror("accept");
+            break;
+        }
+        conn_t *c = (conn_t*)calloc(1, sizeof(conn_t));
+        pthread_t rt;
+        if (!c) { close(s); continue; }
+        c->sock = s; c->refs = 1;
+        pthread_mutex_init(&c->mu, NULL);
+        if (pthread_create(&rt, NULL, conn_reader, c) != 0) { conn_put(c); continue; }
+        pthread_detach(rt);
+    }
+
+    /* Drain: queued jobs still run and get their replies. */
+    q_close();
+    for (int w = 0; w < nworkers; ++w) pthread_join(tid[w], NULL);
+    close(g_listen);
+    unlink(path);
+    printf("[eig_server] shutting down\n");
+    metrics_dump();
+
+    for (int w = 0; w < nworkers; ++w) {
+        for (int i = 0; i < wc[w].cap; ++i) { free(wc[w].e[i].work); free(wc[w].e[i].iwork); }
+        free(wc[w].e);
+    }
+    free(tid); free(wc);
+    return 0;
+}
@@ -0,0 +1,217 @@
+// sparse_run.c — k extremal eigenpairs of a sparse symmetric matrix in CSR
+// form (common/src/csr.h) by LOBPCG (common/src/lobpcg.h) or thick-restart
+// Lanczos (common/src/lanczos.h) on the same operator. The dense drivers
+// stop near n = 30k (n^2 storage); here memory is O(nnz + n k).
+//
+// Usage: sparse_run [nx] [k] [LA|SA]
+//   Without MATRIX_INPUT the matrix is the 5-point Laplacian of an nx x nx
+//   grid (n = nx^2, default nx 300), whose eigenvalues are known in closed
+//   form and are compared; k default 10; SA (smallest, default) or LA.
+// Env:
+//   MATRIX_INPUT   coordinate Matrix Market file (.mtx); "symmetric" files
+//                  are mirrored, "general" ones must already be symmetric
+//   SPARSE_SOLVER  lobpcg (default) | lanczos
+//   SPARSE_TOL     residual tolerance relative to ||A|| (default 1e-8)
+//   SPARSE_MAXIT   LOBPCG iterations / Lanczos restarts (default 1000 / 500)
+//   SPMM_THREADS   SpMV/SpMM threads (default: online CPUs)
+//   SPARSE_BENCH   products per SpMV / SpMM throughput sample (default 20)
+// Outputs: ../output/sparse_time.txt (timings, throughput, checks),
+// ../output/sparse_eigenvalues.txt, ../output/sparse_history.txt (LOBPCG:
+// per iteration the converged count, active columns and max residual).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <math.h>
+#include <sys/stat.h>
+
+#include "csr.h"        /* ../../common/src: CSR input, threaded SpMM       */
+#include "lobpcg.h"     /* ../../common/src: LOBPCG, DSYEVD Rayleigh-Ritz    */
+#include "lanczos.h"    /* ../../common/src: thick-restart Lanczos           */
+
+#ifndef EIG_BACKEND
+#define EIG_BACKEND "unknown"     /* build_run.sh passes the case name */
+#endif
+
+/* --------- Utilities --------- */
+static void ensure_dir(const char *path) {
+    if (mkdir(path, 0777) != 0 && errno != EEXIST) {
+        perror("mkdir");
+        exit(5);
+    }
+}
+
+static double elapsed_seconds(struct timespec a, struct timespec b) {
+    return (b.tv_sec - a.tv_sec) + (b.tv_nsec - a.tv_nsec) / 1e9;
+}
+
+/* Convergence history: one line per LOBPCG iteration. */
+static void history_line(const lobpcg_iter_t *it, void *arg)
+{
+    FILE *f = (FILE*)arg;
+    double rmax = 0.0;
+    for (int j = 0; j < it->k; ++j) if (it->resid[j] > rmax) rmax = it->resid[j];
+    if (f) fprintf(f, "%5d %9.4f %4d %4d %4d %.3e %.15e\n",
+                   it->iter, it->seconds, it->nconv, it->nactive, it->np, rmax, it->theta[0]);
+}
+
+/* Seconds per product of `reps` k-column products Y = A X. */
+static double spmm_sample(const csr_t *A, int k, int reps, double *X, double *Y, double *pack)
+{
+    struct timespec t0, t1;
+    csr_spmm(A, k, X, A->n, Y, A->n, 0, pack);                   /* warm-up */
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int r = 0; r < reps; ++r) csr_spmm(A, k, X, A->n, Y, A->n, 0, pack);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    return elapsed_seconds(t0, t1) / reps;
+}
+
+int main(int argc, char **argv)
+{
+    const int nx = (argc > 1) ? atoi(argv[1]) : 300;
+    const int k  = (argc > 2) ? atoi(argv[2]) : 10;
+    const int which = (argc > 3 && (argv[3][0] == 'L' || argv[3][0] == 'l')) ? 1 : -1;
+    const char *in_env  = getenv("MATRIX_INPUT");
+    const char *sol_env = getenv("SPARSE_SOLVER");
+    const char *tol_env = getenv("SPARSE_TOL");
+    const char *it_env  = getenv("SPARSE_MAXIT");
+    const char *b_env   = getenv("SPARSE_BENCH");
+    const int use_lanczos = sol_env && strcmp(sol_env, "lanczos") == 0;
+    const double tol = tol_env ? atof(tol_env) : 1e-8;
+    const int maxit = it_env ? atoi(it_env) : (use_lanczos ? 500 : 1000);
+    const int reps = (b_env && atoi(b_env) > 0) ? atoi(b_env) : 20;
+
+    /* ---- Matrix ---- */
+    struct timespec t0, t1;
+    csr_t A;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    const int rc = (in_env && in_env[0]) ? csr_from_mtx(in_env, &A) : csr_laplacian_2d(nx, nx, &A);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (rc != 0) { fprintf(stderr, "Matrix setup failed (%d)\n", rc); return 1; }
+    const double time_setup = elapsed_seconds(t0, t1);
+    const int n = A.n;
+    if (k < 1 || 3 * k > n) { fprintf(stderr, "Need 1 <= k <= n/3 (n=%d)\n", n); return 1; }
+
+    struct_op_t *op = csr_op_create(&A, 0);
+    if (!op) { fprintf(stderr, "CSR operator setup failed\n"); return 1; }
+    const double anorm = op->norm_bound;
+
+    printf("Mode: sparse %s, %d %s eigenpairs | n=%d nnz=%lld (%s) | backend %s\n",
+           use_lanczos ? "Lanczos" : "LOBPCG", k, which > 0 ? "largest" : "smallest", n, A.nnz,
+           (in_env && in_env[0]) ? in_env : "2-D Laplacian", EIG_BACKEND);
+
+    double *W = (double*)malloc((size_t)k * sizeof(double));
+    double *X = (double*)malloc((size_t)n * (size_t)k * sizeof(double));
+    double *Y = (double*)malloc((size_t)n * (size_t)k * sizeof(double));
+    double *pack = (double*)malloc((size_t)n * CSR_PANEL * sizeof(double));
+    double *res = (double*)malloc((size_t)k * sizeof(double));
+    if (!W || !X || !Y || !pack || !res) { fprintf(stderr, "Allocation failed.\n"); return 1; }
+
+    /* ---- Throughput: one SpMV, one k-column SpMM ---- */
+    for (size_t i = 0; i < (size_t)n * k; ++i) X[i] = 1.0 / (1.0 + (double)(i % 97));
+    const double t_spmv = spmm_sample(&A, 1, reps, X, Y, pack);
+    const double t_spmm = spmm_sample(&A, k, reps, X, Y, pack);
+    const double fl1 = 2.0 * A.nnz, flk = 2.0 * A.nnz * k;
+    const double gb1 = csr_spmm_bytes(&A, 1), gbk = csr_spmm_bytes(&A, k);
+
+    /* ---- Solve ---- */
+    const char *outdir = "../output";
+    ensure_dir(outdir);
+    char path_time[256], path_w[256], path_h[256];
+    snprintf(path_time, sizeof(path_time), "%s/sparse_time.txt", outdir);
+    snprintf(path_w,    sizeof(path_w),    "%s/sparse_eigenvalues.txt", outdir);
+    snprintf(path_h,    sizeof(path_h),    "%s/sparse_history.txt", outdir);
+
+    int info, iters;
+    long cols;
+    double t_solve, t_apply, t_rr = 0.0, t_ortho;
+    size_t work_bytes;
+    if (use_lanczos) {
+        lanczos_stats_t st;
+        info = lanczos_extremal(op, k, which, 0, tol, maxit, W, X, n, &st);
+        iters = st.restarts; cols = st.matvecs;
+        t_solve = st.seconds; t_apply = st.apply_seconds; t_ortho = st.ortho_seconds;
+        work_bytes = st.bytes;
+    } else {
+        FILE *fh = fopen(path_h, "w");
+        if (fh) fprintf(fh, "# iter seconds nconv nactive np max_resid theta0\n");
+        lobpcg_stats_t st;
+        info = lobpcg_extremal(op, k, which, tol, maxit, W, X, n, history_line, fh, &st);
+        if (fh) fclose(fh);
+        iters = st.iters; cols = st.apply_cols;
+        t_solve = st.seconds; t_apply = st.apply_seconds; t_rr = st.rr_seconds; t_ortho = st.ortho_seconds;
+        work_bytes = st.bytes;
+    }
+    if (info < 0) { fprintf(stderr, "%s failed, info=%d\n", use_lanczos ? "lanczos_extremal" : "lobpcg_extremal", info); return 2; }
+    if (info > 0) printf("Warning: %d of %d pairs not converged after %d iterations\n", info, k, iters);
+
+    /* ---- Check: residuals through the operator, orthogonality, closed form ---- */
+    struct_op_apply_block(op, k, X, n, Y, n);
+    double res_max = 0.0, orth = 0.0;
+    for (int j = 0; j < k; ++j) {
+        const double *x = X + (size_t)j * n, *y = Y + (size_t)j * n;
+        double s = 0.0;
+        for (int i = 0; i < n; ++i) { const double d = y[i] - W[j] * x[i]; s += d * d; }
+        res[j] = sqrt(s) / anorm;
+        if (res[j] > res_max) res_max = res[j];
+        for (int l = 0; l <= j; ++l) {
+            const double *u = X + (size_t)l * n;
+            double g = 0.0;
+            for (int i = 0; i < n; ++i) g += u[i] * x[i];
+            if (fabs(g - (l == j ? 1.0 : 0.0)) > orth) orth = fabs(g - (l == j ? 1.0 : 0.0));
+        }
+    }
+    double dw = -1.0;
+    if (!(in_env && in_env[0])) {
+        double *Wref = (double*)malloc((size_t)k * sizeof(double));
+        if (Wref) {
+            csr_laplacian_2d_eig(nx, nx, k, which, Wref);
+            dw = 0.0;
+            for (int j = 0; j < k; ++j) if (fabs(W[j] - Wref[j]) / anorm > dw) dw = fabs(W[j] - Wref[j]) / anorm;
+        }
+        free(Wref);
+    }
+
+    /* ---- Report ---- */
+    const double mb = 1048576.0;
+    const double csr_mb = csr_spmm_bytes(&A, 1) / mb - 2.0 * n * sizeof(double) / mb;
+    printf("Matrix:  setup %.3f s, CSR %.1f MB (dense A: %.1f MB), ||A|| <= %.6f\n",
+           time_setup, csr_mb, (double)n * n * sizeof(double) / mb, anorm);
+    printf("SpMV     %.3f ms  %.2f GFLOP/s  %.2f GB/s\n", 1e3 * t_spmv, fl1 / t_spmv * 1e-9, gb1 / t_spmv * 1e-9);
+    printf("SpMM k=%-2d %.3f ms  %.2f GFLOP/s  %.2f GB/s  (%.2fx SpMV per column)\n",
+           k, 1e3 * t_spmm, flk / t_spmm * 1e-9, gbk / t_spmm * 1e-9, t_spmv * k / t_spmm);
+    printf("Solver:  %d iterations, %ld operator columns, %.1f MB work\n", iters, cols, work_bytes / mb);
+    printf("Apply    took %.3f s\n", t_apply);
+    if (!use_lanczos) printf("RR       took %.3f s (S^T A S + DSYEVD)\n", t_rr);
+    printf("Ortho    took %.3f s\n", t_ortho);
+    printf("Total    took %.3f s\n", time_setup + t_solve);
+    printf("Check: max ||Ax - lx||/||A|| = %.3e, max |X^T X - I| = %.3e", res_max, orth);
+    if (dw >= 0.0) printf(", max |l - l_exact|/||A|| = %.3e", dw);
+    printf("\n");
+    for (int j = 0; j < k && j < 10; ++j) printf("  l[%d] = %.15e\n", j, W[j]);
+
+    FILE *ft = fopen(path_time, "w");
+    if (ft) {
+        fprintf(ft, "n=%d nnz=%lld k=%d which=%s solver=%s tol=%.1e backend=%s\n", n, A.nnz, k,
+                which > 0 ? "LA" : "SA", use_lanczos ? "lanczos" : "lobpcg", tol, EIG_BACKEND);
+        fprintf(ft, "SPMV    %.6f s  %.3f GFLOP/s  %.3f GB/s\n", t_spmv, fl1 / t_spmv * 1e-9, gb1 / t_spmv * 1e-9);
+        fprintf(ft, "SPMM    %.6f s  %.3f GFLOP/s  %.3f GB/s\n", t_spmm, flk / t_spmm * 1e-9, gbk / t_spmm * 1e-9);
+        fprintf(ft, "SETUP   %.6f s\nAPPLY   %.6f s (%ld columns)\nRR      %.6f s\nORTHO   %.6f s\nTOTAL   %.6f s (%d iterations)\n",
+                time_setup, t_apply, cols, t_rr, t_ortho, time_setup + t_solve, iters);
+        fprintf(ft, "RESID   %.3e\nORTH    %.3e\n", res_max, orth);
+        if (dw >= 0.0) fprintf(ft, "DW      %.3e\n", dw);
+        fclose(ft);
+    }
+    FILE *fw = fopen(path_w, "w");
+    if (fw) {
+        for (int j = 0; j < k; ++j) fprintf(fw, "%.15e %.3e\n", W[j], res[j]);
+        fclose(fw);
+    }
+
+    free(res); free(pack); free(Y); free(X); free(W);
+    struct_op_free(op);
+    csr_free(&A);
+    return 0;
+}
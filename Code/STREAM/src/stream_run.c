@@ -0,0 +1,230 @@
+// stream_run.c — sliding-window covariance eigen updates (common/src/stream_eig.c)
+// on a synthetic factor-model stream, against a full DSYEVD per tick.
+//
+// Usage: stream_run [n] [window] [k] [ticks]
+//   n       features (matrix size)                      default 500
+//   window  observations in the sliding window          default 2000
+//   k       observations added and dropped per tick      default 4
+//   ticks   number of ticks                              default 200
+// Env:
+//   STREAM_TOL      drift bound that triggers a refresh  (default 1e-10)
+//   STREAM_REFRESH  also refresh every N ticks           (default 0 = bound only)
+//   STREAM_CHECK    compare with a full DSYEVD every N ticks (default 10)
+//   STREAM_RANK     factors in the data model            (default 8)
+//   STREAM_NOISE    idiosyncratic noise level            (default 0.1)
+//   STREAM_AUTO     0: always merge, even past the merge/refresh crossover
+//                   (default 1, see stream_eig.h)
+//
+// Data: x = F f + noise * e, F (n x rank) fixed, f and e standard normal,
+// with the factor loadings drifting slowly so the spectrum keeps moving.
+// Reported: per-tick latency (median / p95 / max, with and without
+// refreshes), refresh count, and the eigenvalue drift vs. the full recompute.
+// Results: stdout + ../output/stream_time.txt
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <math.h>
+#include <sys/stat.h>
+
+#include "stream_eig.h"
+
+/* --------- Fortran LAPACK/BLAS symbols (vendor-agnostic) --------- */
+extern void dsyevd_(const char *JOBZ, const char *UPLO, const int *N,
+                    double *A, const int *LDA, double *W,
+                    double *WORK, const int *LWORK,
+                    int *IWORK, const int *LIWORK,
+                    int *INFO);
+extern void dsyrk_(const char *UPLO, const char *TRANS, const int *N, const int *K,
+                   const double *ALPHA, const double *A, const int *LDA,
+                   const double *BETA, double *C, const int *LDC);
+
+/* --------- Utilities --------- */
+static void ensure_dir(const char *path) {
+    if (mkdir(path, 0777) != 0 && errno != EEXIST) {
+        perror("mkdir");
+        exit(5);
+    }
+}
+static double elapsed_seconds(struct timespec a, struct timespec b) {
+    return (b.tv_sec - a.tv_sec) + (b.tv_nsec - a.tv_nsec) / 1e9;
+}
+static double env_double(const char *name, double dflt) {
+    const char *v = getenv(name);
+    return (v && *v) ? atof(v) : dflt;
+}
+
+static unsigned long long G_RNG = 0x9E3779B97F4A7C15ull;
+static double urand(void) {
+    G_RNG ^= G_RNG >> 12; G_RNG ^= G_RNG << 25; G_RNG ^= G_RNG >> 27;
+    return ((G_RNG * 2685821657736338717ull) >> 11) * (1.0 / 9007199254740992.0) + 1e-300;
+}
+static double nrand(void) {
+    return sqrt(-2.0 * log(urand())) * cos(6.283185307179586 * urand());
+}
+
+/* one observation x (n) from the factor model; F drifts a little per draw */
+static void observe(double *x, int n, double *F, int rank, double noise)
+{
+    for (int i = 0; i < n; ++i) x[i] = noise * nrand();
+    for (int r = 0; r < rank; ++r) {
+        const double f = nrand();
+        double *col = F + (size_t)r * n;
+        for (int i = 0; i < n; ++i) x[i] += f * col[i];
+    }
+    const int i = (int)(urand() * n) % n, r = (int)(urand() * rank) % rank;
+    F[i + (size_t)r * n] += 1e-3 * nrand();
+}
+
+/* full DSYEVD('V') of the window matrix (upper triangle of S): the
+   from-scratch cost of what a tick maintains, and the drift reference */
+static int full_eigs(int n, const double *S, double *A, double *W, double *secs)
+{
+    const char jobz = 'V', uplo = 'U';
+    int info = 0, lwork = -1, liwork = -1, iwkopt = 0;
+    double wkopt = 0.0;
+    memcpy(A, S, (size_t)n * n * sizeof(double));
+    dsyevd_(&jobz, &uplo, &n, A, &n, W, &wkopt, &lwork, &iwkopt, &liwork, &info);
+    if (info != 0) return info;
+    lwork = (int)wkopt; liwork = iwkopt;
+    double *WORK = (double*)malloc((size_t)lwork * sizeof(double));
+    int   *IWORK = (int*)malloc((size_t)liwork * sizeof(int));
+    if (!WORK || !IWORK) { free(IWORK); free(WORK); return -100; }
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    dsyevd_(&jobz, &uplo, &n, A, &n, W, WORK, &lwork, IWORK, &liwork, &info);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    free(IWORK); free(WORK);
+    *secs = elapsed_seconds(t0, t1);
+    return info;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+static double pct(const double *sorted, int m, double p) {
+    if (m <= 0) return 0.0;
+    int i = (int)(p * (m - 1) + 0.5);
+    return sorted[i];
+}
+
+int main(int argc, char **argv)
+{
+    const int n      = (argc > 1) ? atoi(argv[1]) : 500;
+    const int window = (argc > 2) ? atoi(argv[2]) : 2000;
+    const int k      = (argc > 3) ? atoi(argv[3]) : 4;
+    const int ticks  = (argc > 4) ? atoi(argv[4]) : 200;
+    const double tol     = env_double("STREAM_TOL", 1e-10);
+    const int    refresh = (int)env_double("STREAM_REFRESH", 0);
+    const int    every   = (int)env_double("STREAM_CHECK", 10);
+    const int    rank    = (int)env_double("STREAM_RANK", 8) > 0 ? (int)env_double("STREAM_RANK", 8) : 1;
+    const double noise   = env_double("STREAM_NOISE", 0.1);
+    if (n <= 0 || window <= 0 || k <= 0 || k > window || ticks <= 0) {
+        fprintf(stderr, "Usage: %s [n] [window] [k<=window] [ticks]\n", argv[0]);
+        return 1;
+    }
+
+    printf("Mode: sliding-window eigen updates (n=%d, window=%d, k=%d, ticks=%d, tol=%.1e, refresh=%d)\n",
+           n, window, k, ticks, tol, refresh);
+
+    /* window ring buffer X (n x window), factor loadings F (n x rank) */
+    double *X  = (double*)malloc((size_t)n * window * sizeof(double));
+    double *F  = (double*)malloc((size_t)n * rank * sizeof(double));
+    double *S0 = (double*)calloc((size_t)n * n, sizeof(double));
+    double *A  = (double*)malloc((size_t)n * n * sizeof(double));
+    double *Wf = (double*)malloc((size_t)n * sizeof(double));
+    double *Xin  = (double*)malloc((size_t)n * k * sizeof(double));
+    double *Xout = (double*)malloc((size_t)n * k * sizeof(double));
+    double *lat  = (double*)malloc((size_t)ticks * sizeof(double));
+    double *lat_nr = (double*)malloc((size_t)ticks * sizeof(double));
+    if (!X || !F || !S0 || !A || !Wf || !Xin || !Xout || !lat || !lat_nr) {
+        fprintf(stderr, "Allocation failed.\n");
+        return 1;
+    }
+    for (size_t i = 0; i < (size_t)n * rank; ++i) F[i] = nrand() / sqrt((double)rank);
+    for (int j = 0; j < window; ++j) observe(X + (size_t)j * n, n, F, rank, noise);
+
+    /* initial window + one DSYEVD */
+    const double one = 1.0, zero = 0.0;
+    dsyrk_("U", "N", &n, &window, &one, X, &n, &zero, S0, &n);
+    stream_eig_t se;
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    int info = stream_eig_init(&se, n, S0, tol, refresh);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (info != 0) { fprintf(stderr, "stream_eig_init failed, info=%d\n", info); return 2; }
+    se.auto_refresh = (int)env_double("STREAM_AUTO", 1) != 0;
+    printf("Initial DSYEVD took %.3f s\n", elapsed_seconds(t0, t1));
+
+    const char *outdir = "../output";
+    ensure_dir(outdir);
+    FILE *ft = fopen("../output/stream_time.txt", "w");
+    if (ft) fprintf(ft, "# tick latency_s add_s drop_s check_s refresh_s deflated refreshed err_est full_s eig_drift\n");
+
+    int head = 0, nlat_nr = 0, nbypass = 0;
+    double max_drift = 0.0, full_sum = 0.0; int full_cnt = 0;
+    for (int t = 0; t < ticks; ++t) {
+        /* k new observations replace the k oldest in the ring */
+        for (int j = 0; j < k; ++j) {
+            double *slot = X + (size_t)((head + j) % window) * n;
+            memcpy(Xout + (size_t)j * n, slot, (size_t)n * sizeof(double));
+            observe(slot, n, F, rank, noise);
+            memcpy(Xin + (size_t)j * n, slot, (size_t)n * sizeof(double));
+        }
+        head = (head + k) % window;
+
+        stream_tick_t tk;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        info = stream_eig_tick(&se, k, Xin, n, k, Xout, n, &tk);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        if (info != 0) { fprintf(stderr, "tick %d failed, info=%d\n", t, info); return 3; }
+        lat[t] = elapsed_seconds(t0, t1);
+        if (!tk.refreshed) lat_nr[nlat_nr++] = lat[t];
+        nbypass += tk.bypassed;
+
+        double full_s = -1.0, drift = -1.0;
+        if (every > 0 && ((t + 1) % every == 0 || t == ticks - 1)) {
+            if (full_eigs(n, se.S, A, Wf, &full_s) != 0) { fprintf(stderr, "DSYEVD check failed\n"); return 3; }
+            double scale = fabs(Wf[n - 1]) > fabs(Wf[0]) ? fabs(Wf[n - 1]) : fabs(Wf[0]);
+            drift = 0.0;
+            for (int i = 0; i < n; ++i) if (fabs(se.D[i] - Wf[i]) > drift) drift = fabs(se.D[i] - Wf[i]);
+            drift /= scale;
+            if (drift > max_drift) max_drift = drift;
+            full_sum += full_s; full_cnt++;
+            printf("tick %5d  latency %8.4f s  (add %.4f drop %.4f check %.4f refresh %.4f)  "
+                   "defl %5d  err %.2e  | full DSYEVD %.4f s  drift %.2e%s\n",
+                   t + 1, lat[t], tk.t_add, tk.t_drop, tk.t_check, tk.t_refresh,
+                   tk.deflated, tk.err, full_s, drift, tk.bypassed ? "  [bypassed]" : tk.refreshed ? "  [refreshed]" : "");
+        }
+        if (ft) fprintf(ft, "%d %.6f %.6f %.6f %.6f %.6f %d %d %.3e %.6f %.3e\n",
+                        t + 1, lat[t], tk.t_add, tk.t_drop, tk.t_check, tk.t_refresh,
+                        tk.deflated, tk.refreshed, tk.err, full_s, drift);
+    }
+
+    qsort(lat, (size_t)ticks, sizeof(double), cmp_double);
+    qsort(lat_nr, (size_t)nlat_nr, sizeof(double), cmp_double);
+    const double full_avg = full_cnt ? full_sum / full_cnt : 0.0;
+    printf("---------------------------------------------\n");
+    printf("tick latency     median %.4f s  p95 %.4f s  max %.4f s\n",
+           pct(lat, ticks, 0.5), pct(lat, ticks, 0.95), lat[ticks - 1]);
+    printf("  w/o refresh    median %.4f s  p95 %.4f s  (%d ticks)\n",
+           pct(lat_nr, nlat_nr, 0.5), pct(lat_nr, nlat_nr, 0.95), nlat_nr);
+    printf("full DSYEVD('V') avg %.4f s  -> median tick speedup %.1fx\n",
+           full_avg, pct(lat, ticks, 0.5) > 0.0 ? full_avg / pct(lat, ticks, 0.5) : 0.0);
+    printf("refreshes %ld / %ld ticks (%d past the crossover: merge %.4f s, refresh %.4f s), "
+           "max eigenvalue drift %.3e (bound %.1e)\n",
+           se.refreshes - 1, se.ticks, nbypass, se.t_merge, se.t_full, max_drift, tol);
+    if (ft) {
+        fprintf(ft, "# median %.6f p95 %.6f max %.6f full_avg %.6f refreshes %ld max_drift %.3e\n",
+                pct(lat, ticks, 0.5), pct(lat, ticks, 0.95), lat[ticks - 1], full_avg,
+                se.refreshes - 1, max_drift);
+        fclose(ft);
+    }
+
+    stream_eig_free(&se);
+    free(lat_nr); free(lat); free(Xout); free(Xin); free(Wf); free(A); free(S0); free(F); free(X);
+    return 0;
+}
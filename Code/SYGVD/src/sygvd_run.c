@@ -0,0 +1,201 @@
+// sygvd_run.c — generalized symmetric-definite eigenproblems A_k x = lambda B x
+// for several A_k sharing one B, through common/src/gen_eig.h:
+// DPOTRF(B) once, then DSYGST -> DSYEVD -> DTRSM per A_k, each stage timed.
+//
+// Usage: sygvd_run [n] [count] [jobz]
+//   - B: MATRIX_INPUT_B=<file> (mat_io), else the SPD "mass matrix"
+//     tridiag(1/4, 1, 1/4) stored dense (spectrum in (1/2, 3/2)).
+//   - A_k: MATRIX_INPUT=<file> (count forced to 1), else KMS with
+//     rho_k = 0.95 - 0.05 k, k = 0 .. count-1 (default count 3).
+//   - the factor of B is computed once (or loaded from the stage cache,
+//     EIG_CACHE=1 enables) and reused for every A_k; the report shows the
+//     DPOTRF time a per-matrix DSYGVD would repeat.
+//   - GEN_CHECK=0 skips the check of the largest eigenpair of each A_k:
+//     ||A x - l B x|| / (|l| ||B x||) and x^T B x = 1 (keeps copies of A, B).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <math.h>
+#include <sys/stat.h>
+
+#include "gen_eig.h"    /* ../../common/src: DPOTRF / DSYGST / DSYEVD / DTRSM stages     */
+#include "mat_io.h"     /* ../../common/src: MATRIX_INPUT=<.mtx|.npy|raw> instead of KMS */
+#include "eig_cache.h"  /* ../../common/src: eig_cache_banner */
+
+#ifndef EIG_BACKEND
+#define EIG_BACKEND "unknown"     /* build_run.sh passes the case name */
+#endif
+
+/* --------- Utilities --------- */
+static void ensure_dir(const char *path) {
+    if (mkdir(path, 0777) != 0 && errno != EEXIST) {
+        perror("mkdir");
+        exit(5);
+    }
+}
+
+/* Fill A (n x n, column-major) with a classic SPD KMS test matrix:
+   A_ij = rho^{|i-j|} + delta*(i==j), with |rho|<1, delta>=0. */
+static void fill_kms(double *A, int n, double rho, double delta)
+{
+    if (!(rho > -1.0 && rho < 1.0)) rho = 0.95;
+    if (delta < 0.0) delta = 0.0;
+
+    double arho = fabs(rho);
+    double *rp = (double*)malloc((size_t)n * sizeof(double));
+    if (!rp) { fprintf(stderr, "Allocation failed (rp)\n"); exit(6); }
+
+    rp[0] = 1.0;
+    for (int k = 1; k < n; ++k) rp[k] = rp[k-1] * arho;
+
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i <= j; ++i) {
+            double v = rp[j - i];
+            if (i == j) v += delta;
+            A[i + (size_t)j * n] = v;
+            A[j + (size_t)i * n] = v;
+        }
+    }
+    free(rp);
+}
+
+static void fill_mass(double *B, int n)
+{
+    memset(B, 0, (size_t)n * (size_t)n * sizeof(double));
+    for (int i = 0; i < n; ++i) {
+        B[i + (size_t)i * n] = 1.0;
+        if (i + 1 < n) { B[i + 1 + (size_t)i * n] = 0.25; B[i + (size_t)(i + 1) * n] = 0.25; }
+    }
+}
+
+static int load(const char *path, int n, double *M)
+{
+    mat_header_t h;
+    if (mat_probe(path, &h) != 0 || h.n != n) return -1;
+    return mat_read(path, &h, M, n);
+}
+
+/* y = M x (M full n x n) */
+static void matvec(const double *M, int n, const double *x, double *y)
+{
+    for (int i = 0; i < n; ++i) y[i] = 0.0;
+    for (int k = 0; k < n; ++k) {
+        const double xk = x[k];
+        const double *col = M + (size_t)k * n;
+        for (int i = 0; i < n; ++i) y[i] += col[i] * xk;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int n = (argc > 1) ? atoi(argv[1]) : 2000;
+    int count = (argc > 2) ? atoi(argv[2]) : 3;
+    const char jobz = (argc > 3 && (argv[3][0] == 'N' || argv[3][0] == 'n')) ? 'N' : 'V';
+    const char uplo = 'U';
+    const char *in_a = getenv("MATRIX_INPUT");
+    const char *in_b = getenv("MATRIX_INPUT_B");
+    const char *chk = getenv("GEN_CHECK");
+    const int check = !(chk && chk[0] == '0') && jobz == 'V';
+
+    if (in_a) {
+        mat_header_t h;
+        if (mat_probe(in_a, &h) != 0) { fprintf(stderr, "Cannot read %s\n", in_a); return 1; }
+        n = h.n; count = 1;
+    }
+    if (n < 1 || count < 1) { fprintf(stderr, "Invalid n or count\n"); return 1; }
+    const size_t nn = (size_t)n * (size_t)n;
+
+    printf("Mode: A x = l B x, ITYPE=1, JOBZ='%c', UPLO='%c' | n=%d | %d matri%s A sharing one B | backend %s\n",
+           jobz, uplo, n, count, count == 1 ? "x" : "ces", EIG_BACKEND);
+
+    double *B  = (double*)malloc(nn * sizeof(double));
+    double *A  = (double*)malloc(nn * sizeof(double));
+    double *W  = (double*)malloc((size_t)n * sizeof(double));
+    double *A0 = check ? (double*)malloc(nn * sizeof(double)) : NULL;
+    double *x1 = check ? (double*)malloc((size_t)n * sizeof(double)) : NULL;
+    double *x2 = check ? (double*)malloc((size_t)n * sizeof(double)) : NULL;
+    if (!B || !A || !W || (check && (!A0 || !x1 || !x2))) { fprintf(stderr, "Allocation failed.\n"); return 1; }
+
+    if (in_b) {
+        if (load(in_b, n, B) != 0) { fprintf(stderr, "Failed to load %s (must be %d x %d)\n", in_b, n, n); return 1; }
+    } else {
+        fill_mass(B, n);
+    }
+
+    /* ---- 1) Factor B once ---- */
+    gen_eig_factor_t fac;
+    int info = gen_eig_factor(&fac, n, B, n, uplo, EIG_BACKEND);
+    if (info != 0) {
+        if (info > 0) fprintf(stderr, "DPOTRF failed, info=%d: B is not positive definite\n", info);
+        else          fprintf(stderr, "%s failed, info=%d\n", fac.stage, info);
+        return 2;
+    }
+    if (fac.from_cache) eig_cache_banner(stdout, "the DPOTRF factor of B");
+    printf("DPOTRF (B = U^T U) took %.3f s%s\n", fac.time_potrf, fac.from_cache ? " (cached factor)" : "");
+
+    const char *outdir = "../output";
+    ensure_dir(outdir);
+    char path_time[256], path_w[256];
+    snprintf(path_time, sizeof(path_time), "%s/sygvd_time.txt", outdir);
+    snprintf(path_w,    sizeof(path_w),    "%s/sygvd_eigenvalues.txt", outdir);
+    FILE *ft = fopen(path_time, "w");
+    if (ft && fac.from_cache) eig_cache_banner(ft, "the DPOTRF factor of B");
+    if (ft) fprintf(ft, "n=%d count=%d jobz=%c\nDPOTRF  %.6f s%s\n", n, count, jobz, fac.time_potrf,
+                    fac.from_cache ? " (cached)" : "");
+
+    double sum_solve = 0.0;
+    for (int k = 0; k < count; ++k) {
+        const double rho = 0.95 - 0.05 * k;
+        if (in_a) {
+            if (load(in_a, n, A) != 0) { fprintf(stderr, "Failed to load %s\n", in_a); return 1; }
+        } else {
+            fill_kms(A, n, rho > 0.05 ? rho : 0.05, 0.0);
+        }
+        if (check) memcpy(A0, A, nn * sizeof(double));
+
+        /* ---- 2-4) DSYGST -> DSYEVD -> DTRSM ---- */
+        gen_eig_times_t t;
+        info = gen_eig_solve(&fac, A, n, W, jobz, &t);
+        if (info != 0) { fprintf(stderr, "%s failed, info=%d\n", t.stage, info); return 2; }
+        sum_solve += t.total;
+        printf("A[%d]: DSYGST %.3f s | DSYEVD %.3f s | DTRSM %.3f s | total %.3f s | l in [%.6e, %.6e]\n",
+               k, t.sygst, t.syevd, t.trsm, t.total, W[0], W[n - 1]);
+        if (ft) fprintf(ft, "A[%d]    DSYGST %.6f s  DSYEVD %.6f s  DTRSM %.6f s  TOTAL %.6f s\n",
+                        k, t.sygst, t.syevd, t.trsm, t.total);
+
+        if (check) {
+            const double *x = A + (size_t)(n - 1) * n;
+            const double l = W[n - 1];
+            matvec(A0, n, x, x1);                       /* A x */
+            matvec(B, n, x, x2);                        /* B x */
+            double r2 = 0.0, bx2 = 0.0, xbx = 0.0;
+            for (int i = 0; i < n; ++i) {
+                const double r = x1[i] - l * x2[i];
+                r2 += r * r; bx2 += x2[i] * x2[i]; xbx += x[i] * x2[i];
+            }
+            const double res = sqrt(r2) / (fabs(l) * sqrt(bx2) > 0.0 ? fabs(l) * sqrt(bx2) : 1.0);
+            printf("       check (largest pair): residual %.3e, |x^T B x - 1| %.3e\n", res, fabs(xbx - 1.0));
+            if (ft) fprintf(ft, "A[%d]    RESID %.3e  BORTH %.3e\n", k, res, fabs(xbx - 1.0));
+        }
+    }
+
+    /* what a DSYGVD per matrix would pay on top: the factor for every A */
+    printf("Total  (%d solves) took %.3f s + DPOTRF once %.3f s (a DSYGVD per A repeats it: +%.3f s)\n",
+           count, sum_solve, fac.time_potrf, fac.time_potrf * (count - 1));
+    if (ft) {
+        fprintf(ft, "TOTAL   %.6f s (+ DPOTRF once)\n", sum_solve);
+        fclose(ft);
+    }
+    FILE *fw = fopen(path_w, "w");
+    if (fw) {
+        for (int i = 0; i < n; ++i) fprintf(fw, "%.12e\n", W[i]);
+        fclose(fw);
+    }
+
+    gen_eig_free(&fac);
+    free(x2); free(x1); free(A0); free(W); free(A); free(B);
+    return 0;
+}
@@ -0,0 +1,25 @@
+#!/usr/bin/env bash
+# build_run.sh — build the live timing viewer and attach it to a running
+# program that was started with WRAP_SHM=1 (DSYEVD/DSTEDC/SCALING builds or
+# the LD_PRELOAD library).
+#   ./build_run.sh [pid|list] [interval_s] [rows]
+# Example:
+#   (cd ../../DSYEVD/script && WRAP_SHM=1 WRAP_SIGNAL=1 ./build_run.sh syevd-profile-openblas) &
+#   ./build_run.sh                      # follows the newest segment
+#   kill -USR1 <pid>                    # summary on the program's stderr (needs WRAP_SIGNAL=1)
+set -euo pipefail
+
+# ====== 1) Compiler setup ======
+CC="${CC:-gcc}"
+CFLAGS="-O2 -std=c11 -D_POSIX_C_SOURCE=200809L -D_DEFAULT_SOURCE -I../../common/src"
+
+# ====== 2) Build ======
+OUT_DIR="../output"
+BIN_DIR="$OUT_DIR/bin"
+mkdir -p "$BIN_DIR"
+BIN="$BIN_DIR/wrap_top"
+echo "[BUILD] CC=$CC | SRC=../src/wrap_top.c" >&2
+$CC $CFLAGS ../src/wrap_top.c -o "$BIN"
+
+# ====== 3) Run ======
+exec "$BIN" "$@"
@@ -0,0 +1,223 @@
+// wrap_top.c — top-like live viewer for the timing registry of a running
+// program built with the wrappers (common/src/wrap_timers.c, WRAP_SHM=1).
+//
+// Usage: wrap_top [pid|list] [interval_s] [rows]
+//   - no pid: follow the newest <WRAP_SHM_DIR>/wrap_timers.* segment
+//   - list:   print all segments (pid, command, state, age) and exit
+//   - each refresh shows, per routine sorted by total time: calls, total
+//     time, share of elapsed wall time, and call rate and busy fraction
+//     over the last interval. Routines still in flight are listed with their
+//     running time, which shows progress inside one long call, e.g. DSTEQR.
+//   - the viewer exits when the program finishes (segment marked finished or
+//     removed). If the process died without cleaning up, the last snapshot
+//     is printed and tagged "[dead]". WRAP_TOP_CLEAN=1 then removes it.
+//   - WRAP_TOP_ONCE=1 prints one snapshot without clearing the screen
+//     (for logs/cron).
+// The segment is read-only here; copies are taken under the writer's
+// sequence lock (wrap_shm.h).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "wrap_shm.h"
+#include "now_sec.h"
+
+static const char *shm_dir(void){
+    const char *d = getenv("WRAP_SHM_DIR");
+    return (d && *d) ? d : "/dev/shm";
+}
+
+static int pid_alive(long pid){
+    return kill((pid_t)pid, 0) == 0 || errno == EPERM;
+}
+
+/* newest segment by mtime; returns pid or -1 */
+static long find_newest(void){
+    DIR *d = opendir(shm_dir());
+    if (!d) return -1;
+    long best = -1; time_t best_t = 0;
+    struct dirent *e;
+    const size_t plen = strlen(WRAP_SHM_PREFIX);
+    while ((e = readdir(d))){
+        if (strncmp(e->d_name, WRAP_SHM_PREFIX, plen) != 0) continue;
+        char path[512]; struct stat st;
+        snprintf(path, sizeof(path), "%s/%s", shm_dir(), e->d_name);
+        if (stat(path, &st) != 0) continue;
+        long pid = strtol(e->d_name + plen, NULL, 10);
+        if (pid > 0 && (best < 0 || st.st_mtime > best_t)){ best = pid; best_t = st.st_mtime; }
+    }
+    closedir(d);
+    return best;
+}
+
+static const wrap_shm_t *map_segment(long pid, char *path, size_t pathlen){
+    snprintf(path, pathlen, "%s/" WRAP_SHM_PREFIX "%ld", shm_dir(), pid);
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(wrap_shm_t)){ close(fd); return NULL; }
+    void *p = mmap(NULL, sizeof(wrap_shm_t), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    return p == MAP_FAILED ? NULL : (const wrap_shm_t*)p;
+}
+
+/* consistent copy under the sequence lock; 0 on success */
+static int snapshot(const wrap_shm_t *s, wrap_shm_t *out){
+    for (int tries = 0; tries < 1000; ++tries){
+        uint64_t a = __atomic_load_n(&s->seq, __ATOMIC_ACQUIRE);
+        if (a & 1){ usleep(50); continue; }
+        memcpy(out, s, sizeof(*out));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&s->seq, __ATOMIC_RELAXED) == a) return 0;
+    }
+    return -1;
+}
+
+static void list_segments(void){
+    DIR *d = opendir(shm_dir());
+    if (!d){ fprintf(stderr, "[X] cannot open %s\n", shm_dir()); return; }
+    const size_t plen = strlen(WRAP_SHM_PREFIX);
+    struct dirent *e;
+    const double tn = now_sec();
+    printf("%-8s %-16s %-8s %10s\n", "PID", "COMMAND", "STATE", "ELAPSED");
+    while ((e = readdir(d))){
+        if (strncmp(e->d_name, WRAP_SHM_PREFIX, plen) != 0) continue;
+        long pid = strtol(e->d_name + plen, NULL, 10);
+        char path[512];
+        const wrap_shm_t *s = map_segment(pid, path, sizeof(path));
+        if (!s) continue;
+        if (s->magic == WRAP_SHM_MAGIC){
+            const char *state = s->finished ? "done" : (pid_alive(pid) ? "running" : "dead");
+            const double t_end = pid_alive(pid) && !s->finished ? tn : s->t_update;
+            printf("%-8ld %-16s %-8s %9.1fs\n", pid, s->cmd, state, t_end - s->t_start);
+        }
+        munmap((void*)s, sizeof(wrap_shm_t));
+    }
+    closedir(d);
+}
+
+typedef struct { int idx; double seconds; } order_t;
+
+static int by_time_desc(const void *a, const void *b){
+    const double x = ((const order_t*)a)->seconds, y = ((const order_t*)b)->seconds;
+    return (x < y) - (x > y);
+}
+
+static void render(const wrap_shm_t *cur, const wrap_shm_t *prev, double dt_view,
+                   const char *state, int rows, int clear){
+    const double tn = now_sec();
+    const double t_end = strcmp(state, "running") == 0 ? tn : cur->t_update;
+    const double elapsed = t_end - cur->t_start;
+    const int n = (int)(cur->nslots < WRAP_SHM_SLOTS ? cur->nslots : WRAP_SHM_SLOTS);
+
+    if (clear) printf("\033[H\033[2J");
+    printf("wrap_top — pid %lld (%s) [%s]  elapsed %.1f s  last update %.1f s ago\n",
+           (long long)cur->pid, cur->cmd, state, elapsed, tn - cur->t_update);
+
+    printf("\nIN FLIGHT\n");
+    int any = 0;
+    for (int i = 0; i < n; ++i){
+        const wrap_shm_slot_t *s = &cur->slot[i];
+        if (s->depth <= 0) continue;
+        printf("  %-12s depth=%-3d running %10.3f s\n", s->name, s->depth, t_end - s->active_t0);
+        any = 1;
+    }
+    if (!any) printf("  (none)\n");
+
+    order_t *ord = (order_t*)malloc((size_t)(n > 0 ? n : 1) * sizeof(order_t));
+    if (!ord) return;
+    int m = 0;
+    for (int i = 0; i < n; ++i){
+        if (cur->slot[i].calls == 0) continue;
+        ord[m].idx = i; ord[m].seconds = cur->slot[i].seconds; ++m;
+    }
+    qsort(ord, (size_t)m, sizeof(order_t), by_time_desc);
+
+    printf("\n%-12s %10s %12s %7s %12s %7s\n", "ROUTINE", "CALLS", "TIME[s]", "%WALL", "CALLS/s", "BUSY%");
+    for (int k = 0; k < m && k < rows; ++k){
+        const wrap_shm_slot_t *s = &cur->slot[ord[k].idx];
+        double rate = 0.0, busy = 0.0;
+        if (prev && dt_view > 0.0){
+            const wrap_shm_slot_t *p = &prev->slot[ord[k].idx];
+            rate = (double)(s->calls - p->calls) / dt_view;
+            busy = 100.0 * (s->seconds - p->seconds) / dt_view;
+        }
+        printf("%-12s %10llu %12.3f %6.1f%% %12.1f %6.1f%%\n", s->name,
+               (unsigned long long)s->calls, s->seconds,
+               elapsed > 0.0 ? 100.0 * s->seconds / elapsed : 0.0, rate, busy);
+    }
+    if (m > rows) printf("  ... %d more\n", m - rows);
+    free(ord);
+    fflush(stdout);
+}
+
+int main(int argc, char **argv){
+    if (argc > 1 && strcmp(argv[1], "list") == 0){ list_segments(); return 0; }
+    long pid = (argc > 1) ? strtol(argv[1], NULL, 10) : find_newest();
+    double interval = (argc > 2) ? atof(argv[2]) : 1.0;
+    int rows = (argc > 3) ? atoi(argv[3]) : 25;
+    if (interval <= 0.0) interval = 1.0;
+    if (rows <= 0) rows = 25;
+    const char *once = getenv("WRAP_TOP_ONCE");
+    const int clear = !(once && once[0] == '1') && isatty(STDOUT_FILENO);
+
+    if (pid <= 0){
+        fprintf(stderr, "[X] no %s%s* segment (run the program with WRAP_SHM=1)\n",
+                shm_dir(), "/" WRAP_SHM_PREFIX);
+        return 1;
+    }
+    char path[512];
+    const wrap_shm_t *seg = map_segment(pid, path, sizeof(path));
+    if (!seg){ fprintf(stderr, "[X] cannot map %s\n", path); return 1; }
+
+    /* the writer publishes magic last; give a just-started program a moment */
+    for (int i = 0; i < 100 && __atomic_load_n(&seg->magic, __ATOMIC_ACQUIRE) != WRAP_SHM_MAGIC; ++i)
+        usleep(10000);
+    if (seg->magic != WRAP_SHM_MAGIC || seg->version != WRAP_SHM_VERSION){
+        fprintf(stderr, "[X] %s: not a wrap_timers segment (or other version)\n", path);
+        return 1;
+    }
+
+    wrap_shm_t *cur = (wrap_shm_t*)malloc(sizeof(wrap_shm_t));
+    wrap_shm_t *prev = (wrap_shm_t*)malloc(sizeof(wrap_shm_t));
+    if (!cur || !prev){ fprintf(stderr, "[X] OOM\n"); return 1; }
+    int have_prev = 0;
+    double t_prev = 0.0;
+
+    for (;;){
+        if (snapshot(seg, cur) != 0){ usleep(1000); continue; }
+        const double t = now_sec();
+        const char *state;
+        struct stat st;
+        if (cur->finished)             state = "done";
+        else if (pid_alive(pid))       state = "running";
+        else                           state = "dead";
+
+        render(cur, have_prev ? prev : NULL, t - t_prev, state, rows, clear);
+
+        if (strcmp(state, "running") != 0 || (once && once[0] == '1')){
+            if (strcmp(state, "dead") == 0){
+                const char *cl = getenv("WRAP_TOP_CLEAN");
+                if (cl && cl[0] == '1' && unlink(path) == 0) printf("[INFO ] removed %s\n", path);
+                else printf("[INFO ] stale segment kept: %s (WRAP_TOP_CLEAN=1 removes it)\n", path);
+            }
+            break;
+        }
+        if (stat(path, &st) != 0 && !pid_alive(pid)) break;   /* removed at exit */
+
+        wrap_shm_t *tmp = prev; prev = cur; cur = tmp;
+        have_prev = 1; t_prev = t;
+        usleep((useconds_t)(interval * 1e6));
+    }
+    free(cur); free(prev);
+    munmap((void*)seg, sizeof(wrap_shm_t));
+    return 0;
+}
@@ -0,0 +1,232 @@
+// band_eig.c — bandwidth detection, band storage and DSBEVD (see band_eig.h).
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "band_eig.h"
+#include "now_sec.h"
+#include "mem_budget.h"   /* eig_lwork_int */
+
+extern void dsbevd_(const char *JOBZ, const char *UPLO, const int *N, const int *KD,
+                    double *AB, const int *LDAB, double *W, double *Z, const int *LDZ,
+                    double *WORK, const int *LWORK, int *IWORK, const int *LIWORK, int *INFO);
+
+static int is_upper(char uplo) { return uplo == 'U' || uplo == 'u'; }
+
+/* ---------------- environment ---------------- */
+double band_tol_from_env(void)
+{
+    const char *v = getenv("BAND_TOL");
+    const double t = v ? atof(v) : 0.0;
+    return t > 0.0 ? t : 1e-15;
+}
+
+int band_route_auto(void)
+{
+    const char *v = getenv("BAND_ROUTE");
+    return v && strcmp(v, "auto") == 0;
+}
+
+int band_route_forced(void)
+{
+    const char *v = getenv("BAND_ROUTE");
+    if (!v || v[0] < '0' || v[0] > '9') return -1;
+    return atoi(v);
+}
+
+int band_route(int n, int kd_measured)
+{
+    const int kd = band_route_forced();
+    if (kd >= 0) return kd < n ? kd : (n > 0 ? n - 1 : 0);
+    if (!band_route_auto() || kd_measured < 0) return -1;
+    const char *r = getenv("BAND_RATIO");
+    const int ratio = (r && atoi(r) > 0) ? atoi(r) : 16;
+    return (kd_measured <= n / ratio) ? kd_measured : -1;
+}
+
+/* ---------------- detection ---------------- */
+/* smallest kd with sum_{d > kd} s[d] <= tol^2 * sum_d s[d]
+   (s[d]: squared Frobenius mass on diagonal offset d, both triangles) */
+static int width_from_mass(const double *s, int n, double tol)
+{
+    double total = 0.0;
+    for (int d = 0; d < n; ++d) total += s[d];
+    const double lim = tol * tol * total;
+    double tail = 0.0;
+    int kd = n - 1;
+    while (kd > 0 && tail + s[kd] <= lim) tail += s[kd--];
+    return kd;
+}
+
+/* sqrt(sum_{d > kd} s[d] / sum_d s[d]) */
+static double dropped_from_mass(const double *s, int n, int kd)
+{
+    double total = 0.0, tail = 0.0;
+    for (int d = 0; d < n; ++d) { total += s[d]; if (d > kd) tail += s[d]; }
+    return total > 0.0 ? sqrt(tail / total) : 0.0;
+}
+
+/* s[d] for dense A (referenced triangle); NULL on allocation failure */
+static double *mass_dense(int n, const double *A, int lda, char uplo)
+{
+    double *s = (double*)calloc((size_t)n, sizeof(double));
+    if (!s) return NULL;
+    const int up = is_upper(uplo);
+    for (int j = 0; j < n; ++j) {
+        const double *col = A + (size_t)j * lda;
+        const int i0 = up ? 0 : j, i1 = up ? j : n - 1;
+        for (int i = i0; i <= i1; ++i) {
+            const int d = up ? j - i : i - j;
+            s[d] += (d ? 2.0 : 1.0) * col[i] * col[i];
+        }
+    }
+    return s;
+}
+
+/* s[d] for KMS in closed form */
+static double *mass_kms(int n, double rho, double delta)
+{
+    if (!(rho > -1.0 && rho < 1.0)) rho = 0.95;
+    if (delta < 0.0) delta = 0.0;
+    double *s = (double*)malloc((size_t)n * sizeof(double));
+    if (!s) return NULL;
+    const double r2 = rho * rho;
+    double p = 1.0;                               /* rho^{2d} */
+    s[0] = n * (1.0 + delta) * (1.0 + delta);
+    for (int d = 1; d < n; ++d) { p *= r2; s[d] = 2.0 * (n - d) * p; }
+    return s;
+}
+
+int band_width(int n, const double *A, int lda, char uplo, double tol)
+{
+    if (n <= 1) return 0;
+    double *s = mass_dense(n, A, lda, uplo);
+    if (!s) return n - 1;
+    const int kd = width_from_mass(s, n, tol);
+    free(s);
+    return kd;
+}
+
+int band_width_kms(int n, double rho, double delta, double tol)
+{
+    if (n <= 1) return 0;
+    double *s = mass_kms(n, rho, delta);
+    if (!s) return n - 1;
+    const int kd = width_from_mass(s, n, tol);
+    free(s);
+    return kd;
+}
+
+double band_dropped(int n, const double *A, int lda, char uplo, int kd)
+{
+    if (kd >= n - 1) return 0.0;
+    double *s = mass_dense(n, A, lda, uplo);
+    if (!s) return -1.0;
+    const double r = dropped_from_mass(s, n, kd);
+    free(s);
+    return r;
+}
+
+double band_dropped_kms(int n, double rho, double delta, int kd)
+{
+    if (kd >= n - 1) return 0.0;
+    double *s = mass_kms(n, rho, delta);
+    if (!s) return -1.0;
+    const double r = dropped_from_mass(s, n, kd);
+    free(s);
+    return r;
+}
+
+void band_report_dropped(FILE *f, int kd, double dropped, double tol)
+{
+    if (dropped < 0.0) return;                    /* not measured (allocation failure) */
+    fprintf(f, "Band: KD=%d drops %.2e of ||A||_F outside the band\n", kd, dropped);
+    if (dropped > tol)
+        fprintf(stderr, "[band] warning: KD=%d drops %.2e of ||A||_F (> BAND_TOL=%.1e); "
+                        "eigenvalues may move by up to %.2e * ||A||_F\n", kd, dropped, tol, dropped);
+}
+
+/* ---------------- band storage ---------------- */
+void band_pack(int n, int kd, const double *A, int lda, char uplo, double *AB, int ldab)
+{
+    const int up = is_upper(uplo);
+    for (int j = 0; j < n; ++j) {
+        double *ab = AB + (size_t)j * ldab;
+        const double *col = A + (size_t)j * lda;
+        if (up) {
+            const int i0 = j - kd > 0 ? j - kd : 0;
+            for (int i = i0; i <= j; ++i) ab[kd + i - j] = col[i];
+        } else {
+            const int i1 = j + kd < n - 1 ? j + kd : n - 1;
+            for (int i = j; i <= i1; ++i) ab[i - j] = col[i];
+        }
+    }
+}
+
+void band_fill_kms(int n, int kd, double rho, double delta, char uplo, double *AB, int ldab)
+{
+    if (!(rho > -1.0 && rho < 1.0)) rho = 0.95;
+    if (delta < 0.0) delta = 0.0;
+    const double arho = fabs(rho);
+    const int up = is_upper(uplo);
+    memset(AB, 0, (size_t)ldab * (size_t)n * sizeof(double));
+    for (int j = 0; j < n; ++j) {
+        double *ab = AB + (size_t)j * ldab;
+        double v = 1.0;
+        for (int d = 0; d <= kd && (up ? j - d >= 0 : j + d < n); ++d) {
+            ab[up ? kd - d : d] = v + (d == 0 ? delta : 0.0);
+            v *= arho;
+        }
+    }
+}
+
+/* ---------------- DSBEVD ---------------- */
+int band_eig_solve_ab(char jobz, char uplo, int n, int kd, double *AB, int ldab, double *W,
+                      double *Z, int ldz, band_eig_times_t *t)
+{
+    memset(t, 0, sizeof(*t));
+    t->kd = kd;
+    int info = 0, lwork = -1, liwork = -1, iwkopt = 0;
+    double wkopt = 0.0;
+    dsbevd_(&jobz, &uplo, &n, &kd, AB, &ldab, W, Z, &ldz, &wkopt, &lwork, &iwkopt, &liwork, &info);
+    if (info != 0) return info;
+    /* DSBEVD computes LWMIN = 1 + 5n + 2n^2 (JOBZ='V') in int: floor the query in double */
+    if ((jobz == 'V' || jobz == 'v') && wkopt < 1.0 + 5.0 * n + 2.0 * (double)n * n)
+        wkopt = 1.0 + 5.0 * n + 2.0 * (double)n * n;
+    if (eig_lwork_int(wkopt, &lwork) != 0) return -101;
+    liwork = iwkopt > 0 ? iwkopt : 1;
+    double *WORK = (double*)malloc((size_t)lwork * sizeof(double));
+    int *IWORK = (int*)malloc((size_t)liwork * sizeof(int));
+    if (!WORK || !IWORK) { free(IWORK); free(WORK); return -100; }
+    t->lwork = lwork; t->liwork = liwork;
+    t->bytes = (size_t)ldab * (size_t)n * sizeof(double)
+             + (size_t)lwork * sizeof(double) + (size_t)liwork * sizeof(int);
+
+    const double t0 = now_sec();
+    dsbevd_(&jobz, &uplo, &n, &kd, AB, &ldab, W, Z, &ldz, WORK, &lwork, IWORK, &liwork, &info);
+    t->solve = now_sec() - t0;
+
+    free(IWORK); free(WORK);
+    return info;
+}
+
+int band_eig_solve(char jobz, char uplo, int n, int kd, double *A, int lda, double *W,
+                   band_eig_times_t *t)
+{
+    const int ldab = kd + 1;
+    const int ldz = (jobz == 'V' || jobz == 'v') ? lda : 1;
+    double *AB = (double*)malloc((size_t)ldab * (size_t)n * sizeof(double));
+    if (!AB) { memset(t, 0, sizeof(*t)); return -100; }
+
+    const double t0 = now_sec();
+    band_pack(n, kd, A, lda, uplo, AB, ldab);
+    const double pack = now_sec() - t0;
+
+    const int info = band_eig_solve_ab(jobz, uplo, n, kd, AB, ldab, W, A, ldz, t);
+    t->pack = pack;
+    free(AB);
+    return info;
+}
@@ -0,0 +1,78 @@
+// band_eig.h — numerically banded symmetric matrices: bandwidth detection,
+// LAPACK band storage and the DSBEVD path (DSBTRD band -> tridiagonal,
+// then DSTEDC / DSTERF), which skips the dense O(n^3) DSYTRD.
+//
+// Bandwidth: the smallest kd such that dropping every entry with |i-j| > kd
+// changes A by at most BAND_TOL in relative Frobenius norm,
+//     ||A - band_kd(A)||_F <= tol * ||A||_F,
+// so (Weyl) every eigenvalue moves by at most tol * ||A||_F. One O(n^2)
+// pass over the referenced triangle; KMS has a closed form (O(n)).
+//
+// Routing (BAND_ROUTE):
+//   off    (default) always dense
+//   auto   measure kd, take the band path when kd <= n / BAND_RATIO
+//          (default 16: DSBTRD's Givens sweeps cost ~6 n^2 kd flops but run
+//          far below DSYTRD's 4/3 n^3 BLAS rate)
+//   <kd>   force the band path with this half-bandwidth; entries outside
+//          are dropped, and a warning goes to stderr when their Frobenius
+//          mass exceeds BAND_TOL (band_dropped / band_report_dropped)
+// Band-storage input (mat_io.h: a (kd+1, n) .npy) is already AB and goes
+// straight to band_eig_solve_ab; nothing is dropped.
+// Band storage (UPLO='U'): AB(kd + i - j, j) = A(i, j), max(0, j-kd) <= i <= j;
+// (UPLO='L'): AB(i - j, j) = A(i, j), j <= i <= min(n-1, j+kd); ldab >= kd+1.
+// JOBZ='N' costs O(n^2 kd); JOBZ='V' still accumulates the rotations into
+// an n x n Q, which is O(n^3) but without the dense reduction.
+
+#ifndef BAND_EIG_H
+#define BAND_EIG_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+typedef struct {
+    int    kd;              /* half-bandwidth used                       */
+    double pack;            /* seconds: dense -> band storage            */
+    double solve;           /* seconds: DSBEVD                           */
+    int    lwork, liwork;   /* DSBEVD workspace                          */
+    size_t bytes;           /* AB + WORK + IWORK                         */
+} band_eig_times_t;
+
+double band_tol_from_env(void);      /* BAND_TOL, default 1e-15                */
+
+/* Half-bandwidth for the band path, or -1 for dense. kd_measured is the
+   detector result (-1 when not measured); BAND_ROUTE=<kd> overrides it. */
+int  band_route(int n, int kd_measured);
+int  band_route_forced(void);        /* BAND_ROUTE=<kd>: kd, else -1           */
+int  band_route_auto(void);          /* 1 if BAND_ROUTE=auto                   */
+
+/* Numerical half-bandwidth of dense A (referenced triangle `uplo`). */
+int  band_width(int n, const double *A, int lda, char uplo, double tol);
+
+/* Same for KMS: A_ij = rho^|i-j| + delta*(i==j), without forming A. */
+int  band_width_kms(int n, double rho, double delta, double tol);
+
+/* Relative Frobenius mass ||A - band_kd(A)||_F / ||A||_F outside the band,
+   for dense A (triangle `uplo`) and for KMS in closed form. */
+double band_dropped(int n, const double *A, int lda, char uplo, int kd);
+double band_dropped_kms(int n, double rho, double delta, int kd);
+
+/* "Band: KD=.. drops .. of ||A||_F" on f; a warning on stderr when dropped > tol. */
+void band_report_dropped(FILE *f, int kd, double dropped, double tol);
+
+/* Dense (triangle `uplo`) -> band storage, and KMS straight into band storage. */
+void band_pack(int n, int kd, const double *A, int lda, char uplo, double *AB, int ldab);
+void band_fill_kms(int n, int kd, double rho, double delta, char uplo, double *AB, int ldab);
+
+/* DSBEVD on the band part of dense A: W gets the eigenvalues; for JOBZ='V'
+   A is overwritten with the eigenvectors (ldz = lda). Workspace is allocated
+   outside the timed call. Returns as band_eig_solve_ab (below). */
+int  band_eig_solve(char jobz, char uplo, int n, int kd, double *A, int lda, double *W,
+                    band_eig_times_t *t);
+
+/* DSBEVD on band storage AB (ldab >= kd+1, overwritten): eigenvectors into
+   Z (ldz >= n) for JOBZ='V'. t->pack stays 0; t->bytes counts AB. Returns
+   DSBEVD's INFO, -100 on allocation failure, -101 when LWORK > INT_MAX. */
+int  band_eig_solve_ab(char jobz, char uplo, int n, int kd, double *AB, int ldab, double *W,
+                       double *Z, int ldz, band_eig_times_t *t);
+
+#endif /* BAND_EIG_H */
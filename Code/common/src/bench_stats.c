@@ -0,0 +1,250 @@
+// bench_stats.c — repeated-timing statistics + history (see bench_stats.h).
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <sched.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include "bench_stats.h"
+
+/* ---------------- statistics ---------------- */
+
+static int cmp_double(const void *a, const void *b)
+{
+    const double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/* quantile of sorted v[0..n), linear interpolation between order statistics */
+static double quantile_sorted(const double *v, int n, double p)
+{
+    if (n <= 0) return 0.0;
+    const double h = (n - 1) * p;
+    const int lo = (int)floor(h);
+    const int hi = lo + 1 < n ? lo + 1 : n - 1;
+    return v[lo] + (h - lo) * (v[hi] - v[lo]);
+}
+
+static uint64_t xorshift64(uint64_t *s)
+{
+    uint64_t x = *s;
+    x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+    return *s = x;
+}
+
+void bench_summarize(const double *x, int n, int boot, double ci_level, bench_summary_t *s)
+{
+    memset(s, 0, sizeof(*s));
+    s->n = n;
+    s->ci_level = (ci_level > 0.0 && ci_level < 1.0) ? ci_level : 0.95;
+    if (n <= 0) return;
+
+    double *v = (double*)malloc((size_t)n * sizeof(double));
+    if (!v) return;
+    memcpy(v, x, (size_t)n * sizeof(double));
+    qsort(v, (size_t)n, sizeof(double), cmp_double);
+
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i) sum += v[i];
+    s->mean   = sum / n;
+    s->min    = v[0];
+    s->max    = v[n - 1];
+    s->median = quantile_sorted(v, n, 0.5);
+    s->q1     = quantile_sorted(v, n, 0.25);
+    s->q3     = quantile_sorted(v, n, 0.75);
+    s->iqr    = s->q3 - s->q1;
+
+    /* percentile bootstrap of the median */
+    if (boot <= 0) boot = 2000;
+    double *med = (double*)malloc((size_t)boot * sizeof(double));
+    double *r   = (double*)malloc((size_t)n * sizeof(double));
+    if (med && r && n > 1) {
+        uint64_t seed = 0x9E3779B97F4A7C15ULL;
+        for (int b = 0; b < boot; ++b) {
+            for (int i = 0; i < n; ++i) r[i] = v[xorshift64(&seed) % (uint64_t)n];
+            qsort(r, (size_t)n, sizeof(double), cmp_double);
+            med[b] = quantile_sorted(r, n, 0.5);
+        }
+        qsort(med, (size_t)boot, sizeof(double), cmp_double);
+        const double a = 0.5 * (1.0 - s->ci_level);
+        s->ci_lo = quantile_sorted(med, boot, a);
+        s->ci_hi = quantile_sorted(med, boot, 1.0 - a);
+    } else {
+        s->ci_lo = s->ci_hi = s->median;
+    }
+    free(r); free(med); free(v);
+}
+
+/* ---------------- CPU clock ---------------- */
+
+static double read_khz(int cpu)
+{
+    char path[128];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_cur_freq", cpu);
+    FILE *f = fopen(path, "r");
+    if (!f) return 0.0;
+    double khz = 0.0;
+    if (fscanf(f, "%lf", &khz) != 1) khz = 0.0;
+    fclose(f);
+    return khz;
+}
+
+/* /proc/cpuinfo fallback (VMs and kernels without cpufreq) */
+static double cpuinfo_mhz(const cpu_set_t *mask)
+{
+    FILE *f = fopen("/proc/cpuinfo", "r");
+    if (!f) return 0.0;
+    char line[256];
+    int cpu = -1, cnt = 0;
+    double sum = 0.0;
+    while (fgets(line, sizeof(line), f)) {
+        if (strncmp(line, "processor", 9) == 0) cpu = atoi(strchr(line, ':') ? strchr(line, ':') + 1 : "0");
+        else if (strncmp(line, "cpu MHz", 7) == 0 && cpu >= 0 && cpu < CPU_SETSIZE && CPU_ISSET(cpu, mask)) {
+            const char *c = strchr(line, ':');
+            if (c) { sum += atof(c + 1); cnt++; }
+        }
+    }
+    fclose(f);
+    return cnt ? sum / cnt : 0.0;
+}
+
+double bench_cpu_mhz(void)
+{
+    cpu_set_t mask; CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(mask), &mask) != 0) return 0.0;
+    double sum = 0.0; int cnt = 0;
+    for (int c = 0; c < CPU_SETSIZE; ++c) {
+        if (!CPU_ISSET(c, &mask)) continue;
+        const double khz = read_khz(c);
+        if (khz > 0.0) { sum += khz / 1000.0; cnt++; }
+    }
+    return cnt ? sum / cnt : cpuinfo_mhz(&mask);
+}
+
+void bench_cpu_governor(char *gov, size_t len)
+{
+    snprintf(gov, len, "?");
+    cpu_set_t mask; CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(mask), &mask) != 0) return;
+    for (int c = 0; c < CPU_SETSIZE; ++c) {
+        if (!CPU_ISSET(c, &mask)) continue;
+        char path[128];
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_governor", c);
+        FILE *f = fopen(path, "r");
+        if (!f) return;
+        if (fgets(gov, (int)len, f)) gov[strcspn(gov, "\n")] = '\0';
+        fclose(f);
+        return;
+    }
+}
+
+int bench_is_noisy(const bench_summary_t *s, double mhz_min, double mhz_max,
+                   double noise_rel, char *why, size_t why_len)
+{
+    if (why && why_len) why[0] = '\0';
+    if (noise_rel <= 0.0) noise_rel = 0.05;
+    int noisy = 0;
+    size_t off = 0;
+    if (s->median > 0.0 && s->iqr / s->median > noise_rel) {
+        noisy = 1;
+        if (why) off += (size_t)snprintf(why + off, why_len - off, "IQR %.1f%% of median",
+                                         100.0 * s->iqr / s->median);
+    }
+    if (mhz_min > 0.0 && (mhz_max - mhz_min) / mhz_min > 0.05) {
+        noisy = 1;
+        if (why && off < why_len)
+            snprintf(why + off, why_len - off, "%sCPU clock %.0f..%.0f MHz", off ? ", " : "", mhz_min, mhz_max);
+    }
+    return noisy;
+}
+
+/* ---------------- history ---------------- */
+
+#define HIST_FIELDS 18
+
+static int split_tabs(char *line, char **f, int maxf)
+{
+    int k = 0;
+    line[strcspn(line, "\n")] = '\0';
+    for (char *p = line; k < maxf; ) {
+        f[k++] = p;
+        char *t = strchr(p, '\t');
+        if (!t) break;
+        *t = '\0'; p = t + 1;
+    }
+    return k;
+}
+
+int bench_history_compare(const char *path, const bench_record_t *r, double noise_rel, FILE *out)
+{
+    FILE *f = fopen(path, "r");
+    if (!f) { if (out) fprintf(out, "History: %s (new)\n", path); return 0; }
+    if (noise_rel <= 0.0) noise_rel = 0.05;
+
+    char line[1024], same[1024] = "", best[1024] = "";
+    double best_med = 0.0;
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#') continue;
+        char buf[1024];
+        memcpy(buf, line, sizeof(buf));
+        char *fl[HIST_FIELDS];
+        if (split_tabs(buf, fl, HIST_FIELDS) < HIST_FIELDS) continue;
+        if (strcmp(fl[1], r->host) || strcmp(fl[4], r->routine) || atoi(fl[5]) != r->n ||
+            fl[6][0] != r->jobz || atoi(fl[7]) != r->threads) continue;
+        if (strcmp(fl[2], r->backend) == 0) {
+            memcpy(same, line, sizeof(same));                 /* latest wins */
+        } else if (!best[0] || atof(fl[9]) < best_med) {
+            memcpy(best, line, sizeof(best)); best_med = atof(fl[9]);
+        }
+    }
+    fclose(f);
+
+    int regression = 0;
+    if (same[0]) {
+        char *fl[HIST_FIELDS];
+        split_tabs(same, fl, HIST_FIELDS);
+        const double med = atof(fl[9]), lo = atof(fl[13]), hi = atof(fl[14]);
+        const double rel = med > 0.0 ? (r->s.median - med) / med : 0.0;
+        const char *verdict = "no significant change";
+        if (r->s.ci_lo > hi && rel > noise_rel)       { verdict = "REGRESSION"; regression = 1; }
+        else if (r->s.ci_hi < lo && -rel > noise_rel) verdict = "improvement";
+        if (out) fprintf(out, "History: vs %s rev %s (%s): median %.6f -> %.6f s (%+.1f%%), CI [%.6f, %.6f] -> [%.6f, %.6f]: %s%s\n",
+                         fl[2], fl[3], fl[0], med, r->s.median, 100.0 * rel, lo, hi,
+                         r->s.ci_lo, r->s.ci_hi, verdict, atoi(fl[17]) ? " (previous run was noisy)" : "");
+    } else if (out) {
+        fprintf(out, "History: no earlier %s result for this host/routine/n/jobz/threads\n", r->backend);
+    }
+    if (best[0] && out) {
+        char *fl[HIST_FIELDS];
+        split_tabs(best, fl, HIST_FIELDS);
+        fprintf(out, "History: best other backend %s rev %s: median %.6f s (this run %.2fx)\n",
+                fl[2], fl[3], atof(fl[9]), atof(fl[9]) > 0.0 ? r->s.median / atof(fl[9]) : 0.0);
+    }
+    return regression;
+}
+
+int bench_history_append(const char *path, const bench_record_t *r)
+{
+    FILE *probe = fopen(path, "r");
+    const int is_new = (probe == NULL);
+    if (probe) fclose(probe);
+    FILE *f = fopen(path, "a");
+    if (!f) return -1;
+    if (is_new)
+        fprintf(f, "# time\thost\tbackend\trev\troutine\tn\tjobz\tthreads\treps\tmedian\tmin\tq1\tq3"
+                   "\tci_lo\tci_hi\tmhz_min\tmhz_max\tnoisy\n");
+    char ts[32];
+    time_t now = time(NULL);
+    struct tm tmv;
+    strftime(ts, sizeof(ts), "%Y-%m-%dT%H:%M:%S", localtime_r(&now, &tmv));
+    fprintf(f, "%s\t%s\t%s\t%s\t%s\t%d\t%c\t%d\t%d\t%.9f\t%.9f\t%.9f\t%.9f\t%.9f\t%.9f\t%.0f\t%.0f\t%d\n",
+            ts, r->host, r->backend, r->rev, r->routine, r->n, r->jobz, r->threads, r->s.n,
+            r->s.median, r->s.min, r->s.q1, r->s.q3, r->s.ci_lo, r->s.ci_hi,
+            r->mhz_min, r->mhz_max, r->noisy);
+    return fclose(f) == 0 ? 0 : -1;
+}
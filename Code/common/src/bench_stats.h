@@ -0,0 +1,66 @@
+// bench_stats.h — robust statistics for repeated timings, CPU-frequency
+// stability checks and a regression history (used by Code/BENCH).
+//
+// Statistics over N samples (seconds):
+//   median, min, max, quartiles (linear interpolation, Q1/Q3 -> IQR), mean,
+//   and a percentile-bootstrap confidence interval for the median
+//   (B resamples, fixed seed, so the same samples give the same interval).
+//
+// Noise: a result is flagged when
+//   - IQR / median exceeds `noise_rel` (default 0.05, BENCH_NOISE), or
+//   - the mean CPU clock of the CPUs we may run on (cpufreq
+//     scaling_cur_freq, else /proc/cpuinfo "cpu MHz") differs by more than
+//     5% across the samples: turbo, thermal or power-capping steps, or
+//     an 'ondemand'/'powersave' governor ramping between runs.
+//
+// History: one tab-separated line per result, appended to a plain-text file
+//   <time> <host> <backend> <rev> <routine> <n> <jobz> <threads> <reps>
+//   <median> <min> <q1> <q3> <ci_lo> <ci_hi> <mhz_min> <mhz_max> <noisy>
+// bench_history_compare() finds the previous result with the same host,
+// routine, n, jobz and threads. For the same backend it reports a
+// regression when the confidence intervals do not overlap and the median
+// moved by more than `noise_rel`; it also lists the best other backend.
+
+#ifndef BENCH_STATS_H
+#define BENCH_STATS_H
+
+#include <stdio.h>
+
+typedef struct {
+    int    n;
+    double median, min, max, mean, q1, q3, iqr;
+    double ci_lo, ci_hi;      /* bootstrap CI of the median */
+    double ci_level;          /* e.g. 0.95 */
+} bench_summary_t;
+
+/* Summary of x[0..n) (x is not modified). `boot` resamples (<= 0: 2000). */
+void bench_summarize(const double *x, int n, int boot, double ci_level, bench_summary_t *s);
+
+/* Mean current clock in MHz over the CPUs in our affinity mask (0 when
+   unavailable), and the scaling governor of the first such CPU ("?" if
+   unknown) into gov[len]. */
+double bench_cpu_mhz(void);
+void   bench_cpu_governor(char *gov, size_t len);
+
+typedef struct {
+    const char *host, *backend, *rev, *routine;
+    int    n;
+    char   jobz;
+    int    threads;
+    bench_summary_t s;
+    double mhz_min, mhz_max;
+    int    noisy;
+} bench_record_t;
+
+/* Noise verdict for a summary + clock range; `why` gets a short reason. */
+int  bench_is_noisy(const bench_summary_t *s, double mhz_min, double mhz_max,
+                    double noise_rel, char *why, size_t why_len);
+
+/* Compare against earlier lines of `path` (if any) and print the verdict to
+   `out`. Returns 1 for a regression against the same backend, else 0. */
+int  bench_history_compare(const char *path, const bench_record_t *r, double noise_rel, FILE *out);
+
+/* Append `r` to `path` (header written when the file is new). 0 on success. */
+int  bench_history_append(const char *path, const bench_record_t *r);
+
+#endif /* BENCH_STATS_H */
@@ -0,0 +1,293 @@
+// csr.c — CSR input, 2-D Laplacian generator and threaded SpMV / SpMM (see csr.h).
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "csr.h"
+#include "mat_io.h"
+
+typedef struct { int c; double v; } entry_t;
+
+static int by_col(const void *a, const void *b)
+{
+    const entry_t *x = (const entry_t*)a, *y = (const entry_t*)b;
+    return (x->c > y->c) - (x->c < y->c);
+}
+
+static int alloc_csr(csr_t *A, int n, long long nnz)
+{
+    memset(A, 0, sizeof(*A));
+    A->n = n; A->nnz = nnz;
+    A->rowptr = (long long*)calloc((size_t)n + 1, sizeof(long long));
+    A->col = (int*)malloc((size_t)(nnz > 0 ? nnz : 1) * sizeof(int));
+    A->val = (double*)malloc((size_t)(nnz > 0 ? nnz : 1) * sizeof(double));
+    if (!A->rowptr || !A->col || !A->val) { csr_free(A); return -1; }
+    return 0;
+}
+
+int csr_from_mtx(const char *path, csr_t *A)
+{
+    mat_header_t h;
+    memset(A, 0, sizeof(*A));
+    if (mat_probe(path, &h) != 0) return -1;
+    const long long cap = mat_coo_capacity(&h);
+    if (cap < 0) { fprintf(stderr, "[csr] %s: need a coordinate Matrix Market file\n", path); return -2; }
+    int *ri = (int*)malloc((size_t)(cap > 0 ? cap : 1) * sizeof(int));
+    int *ci = (int*)malloc((size_t)(cap > 0 ? cap : 1) * sizeof(int));
+    double *v = (double*)malloc((size_t)(cap > 0 ? cap : 1) * sizeof(double));
+    long long m = (ri && ci && v) ? mat_read_coo(path, &h, ri, ci, v) : -3;
+    if (m < 0 || alloc_csr(A, h.n, m) != 0) { free(v); free(ci); free(ri); return m < 0 ? (int)m : -3; }
+
+    /* bucket by row, then sort each row by column and sum duplicates */
+    for (long long e = 0; e < m; ++e) A->rowptr[ri[e] + 1]++;
+    for (int i = 0; i < h.n; ++i) A->rowptr[i + 1] += A->rowptr[i];
+    long long *fill = (long long*)malloc((size_t)h.n * sizeof(long long));
+    entry_t *row = (entry_t*)malloc((size_t)h.n * sizeof(entry_t));
+    if (!fill || !row) { free(row); free(fill); free(v); free(ci); free(ri); csr_free(A); return -3; }
+    memcpy(fill, A->rowptr, (size_t)h.n * sizeof(long long));
+    for (long long e = 0; e < m; ++e) {
+        const long long p = fill[ri[e]]++;
+        A->col[p] = ci[e]; A->val[p] = v[e];
+    }
+    long long out = 0;
+    for (int i = 0; i < h.n; ++i) {
+        const long long b = A->rowptr[i], len = A->rowptr[i + 1] - b;
+        for (long long q = 0; q < len; ++q) { row[q].c = A->col[b + q]; row[q].v = A->val[b + q]; }
+        qsort(row, (size_t)len, sizeof(entry_t), by_col);
+        A->rowptr[i] = out;
+        for (long long q = 0; q < len; ++q) {
+            if (q > 0 && row[q].c == row[q - 1].c) { A->val[out - 1] += row[q].v; continue; }
+            A->col[out] = row[q].c; A->val[out] = row[q].v; ++out;
+        }
+    }
+    A->rowptr[h.n] = out;
+    A->nnz = out;
+    free(row); free(fill); free(v); free(ci); free(ri);
+    return 0;
+}
+
+int csr_laplacian_2d(int nx, int ny, csr_t *A)
+{
+    if (nx < 1 || ny < 1 || (long long)nx * ny > 0x7fffffffLL) return -1;
+    const int n = nx * ny;
+    if (alloc_csr(A, n, 5LL * n) != 0) return -3;
+    long long p = 0;
+    for (int j = 0; j < ny; ++j)
+        for (int i = 0; i < nx; ++i) {
+            const int r = i + nx * j;
+            A->rowptr[r] = p;
+            if (j > 0)      { A->col[p] = r - nx; A->val[p++] = -1.0; }
+            if (i > 0)      { A->col[p] = r - 1;  A->val[p++] = -1.0; }
+            A->col[p] = r; A->val[p++] = 4.0;
+            if (i < nx - 1) { A->col[p] = r + 1;  A->val[p++] = -1.0; }
+            if (j < ny - 1) { A->col[p] = r + nx; A->val[p++] = -1.0; }
+        }
+    A->rowptr[n] = p;
+    A->nnz = p;
+    return 0;
+}
+
+static int by_value(const void *a, const void *b)
+{
+    const double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+void csr_laplacian_2d_eig(int nx, int ny, int k, int which, double *W)
+{
+    const size_t n = (size_t)nx * (size_t)ny;
+    double *all = (double*)malloc(n * sizeof(double));
+    if (!all) { for (int i = 0; i < k; ++i) W[i] = NAN; return; }
+    for (int j = 0; j < ny; ++j)
+        for (int i = 0; i < nx; ++i)
+            all[i + (size_t)nx * j] = 4.0 - 2.0 * cos((i + 1) * M_PI / (nx + 1)) - 2.0 * cos((j + 1) * M_PI / (ny + 1));
+    qsort(all, n, sizeof(double), by_value);
+    for (int i = 0; i < k; ++i) W[i] = which > 0 ? all[n - 1 - i] : all[i];
+    free(all);
+}
+
+void csr_free(csr_t *A)
+{
+    if (!A) return;
+    free(A->val); free(A->col); free(A->rowptr);
+    memset(A, 0, sizeof(*A));
+}
+
+/* --------- Threaded SpMV / SpMM --------- */
+
+typedef struct {
+    const csr_t  *A;
+    int           k, ldx, ldy;
+    const double *X;
+    double       *Y;
+    double       *pack;          /* n x CSR_PANEL, row-major */
+    const int    *r0;            /* row range of thread t: [r0[t], r0[t+1]) */
+    pthread_barrier_t bar;
+} spmm_job_t;
+
+typedef struct { spmm_job_t *job; int t; } spmm_arg_t;
+
+static void *spmm_worker(void *arg)
+{
+    const spmm_arg_t *a = (const spmm_arg_t*)arg;
+    spmm_job_t *J = a->job;
+    const csr_t *A = J->A;
+    const long long *rp = A->rowptr;
+    const int *col = A->col;
+    const double *val = A->val;
+    const int lo = J->r0[a->t], hi = J->r0[a->t + 1];
+
+    /* a tail narrower than half a panel gathers less from X column by
+       column: one SpMV each, straight from X (no pack, no barrier) */
+    const int kp = (J->k % CSR_PANEL < CSR_PANEL / 2) ? J->k - J->k % CSR_PANEL : J->k;
+    for (int c = kp; c < J->k; ++c) {
+        const double *x = J->X + (size_t)c * J->ldx;
+        double *y = J->Y + (size_t)c * J->ldy;
+        for (int i = lo; i < hi; ++i) {
+            double s = 0.0;
+            for (long long e = rp[i]; e < rp[i + 1]; ++e) s += val[e] * x[col[e]];
+            y[i] = s;
+        }
+    }
+
+    double *pk = J->pack;
+    for (int c0 = 0; c0 < kp; c0 += CSR_PANEL) {
+        const int w = (kp - c0 < CSR_PANEL) ? kp - c0 : CSR_PANEL;
+        for (int i = lo; i < hi; ++i) {               /* row stride w: a narrow tail panel */
+            double *d = pk + (size_t)i * w;              /* does not stream padding          */
+            for (int c = 0; c < w; ++c) d[c] = J->X[i + (size_t)(c0 + c) * J->ldx];
+        }
+        pthread_barrier_wait(&J->bar);                   /* the panel of X is complete */
+        for (int i = lo; i < hi; ++i) {
+            double acc[CSR_PANEL] = {0};
+            if (w == CSR_PANEL) {                        /* fixed width: unrolled, vectorized */
+                for (long long e = rp[i]; e < rp[i + 1]; ++e) {
+                    const double v = val[e];
+                    const double *xp = pk + (size_t)col[e] * CSR_PANEL;
+                    for (int c = 0; c < CSR_PANEL; ++c) acc[c] += v * xp[c];
+                }
+            } else {
+                for (long long e = rp[i]; e < rp[i + 1]; ++e) {
+                    const double v = val[e];
+                    const double *xp = pk + (size_t)col[e] * w;
+                    for (int c = 0; c < w; ++c) acc[c] += v * xp[c];
+                }
+            }
+            for (int c = 0; c < w; ++c) J->Y[i + (size_t)(c0 + c) * J->ldy] = acc[c];
+        }
+        pthread_barrier_wait(&J->bar);                   /* nobody reads the panel any more */
+    }
+    return NULL;
+}
+
+static int spmm_threads(int nthreads, int n)
+{
+    if (nthreads <= 0) {
+        const char *v = getenv("SPMM_THREADS");
+        nthreads = (v && atoi(v) > 0) ? atoi(v) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (nthreads < 1) nthreads = 1;
+    if (nthreads > n) nthreads = n;
+    return nthreads;
+}
+
+void csr_spmm(const csr_t *A, int k, const double *X, int ldx, double *Y, int ldy,
+              int nthreads, double *pack)
+{
+    if (k < 1 || A->n < 1) return;
+    const int T = spmm_threads(nthreads, A->n);
+    int *r0 = (int*)malloc((size_t)(T + 1) * sizeof(int));
+    spmm_arg_t *args = (spmm_arg_t*)malloc((size_t)T * sizeof(spmm_arg_t));
+    pthread_t *tid = (pthread_t*)malloc((size_t)T * sizeof(pthread_t));
+    double *own = (k > 1 && !pack) ? (double*)malloc((size_t)A->n * CSR_PANEL * sizeof(double)) : NULL;
+    if (!r0 || !args || !tid || (k > 1 && !pack && !own)) { fprintf(stderr, "[csr] SpMM: OOM\n"); abort(); }
+
+    /* equal-nonzero row ranges */
+    r0[0] = 0; r0[T] = A->n;
+    for (int t = 1; t < T; ++t) {
+        const long long target = A->nnz * t / T;
+        int lo = r0[t - 1], hi = A->n;
+        while (lo < hi) { const int mid = lo + (hi - lo) / 2; if (A->rowptr[mid] < target) lo = mid + 1; else hi = mid; }
+        r0[t] = lo;
+    }
+    spmm_job_t J;
+    J.A = A; J.k = k; J.ldx = ldx; J.ldy = ldy; J.X = X; J.Y = Y;
+    J.pack = pack ? pack : own;
+    J.r0 = r0;
+    pthread_barrier_init(&J.bar, NULL, (unsigned)T);
+    for (int t = 0; t < T; ++t) { args[t].job = &J; args[t].t = t; }
+    for (int t = 1; t < T; ++t)
+        if (pthread_create(&tid[t], NULL, spmm_worker, &args[t]) != 0) {
+            /* the barrier counts T threads: running short would hang it */
+            fprintf(stderr, "[csr] pthread_create failed (thread %d of %d)\n", t, T);
+            abort();
+        }
+    spmm_worker(&args[0]);                       /* the caller is thread 0 */
+    for (int t = 1; t < T; ++t) pthread_join(tid[t], NULL);
+    pthread_barrier_destroy(&J.bar);
+    free(own); free(tid); free(args); free(r0);
+}
+
+double csr_spmm_bytes(const csr_t *A, int k)
+{
+    const double mat = (double)A->nnz * (sizeof(double) + sizeof(int)) + (double)(A->n + 1) * sizeof(long long);
+    const int kp = (k % CSR_PANEL < CSR_PANEL / 2) ? k - k % CSR_PANEL : k;   /* as spmm_worker */
+    const double per = (double)A->n * sizeof(double);
+    return mat * ((kp + CSR_PANEL - 1) / CSR_PANEL + (k - kp))
+         + per * (4.0 * kp + 2.0 * (k - kp));     /* panels: X read, pack write + read, Y write */
+}
+
+/* --------- Operator view --------- */
+
+typedef struct { const csr_t *A; int nthreads; double *pack; } csr_ctx_t;
+
+static void csr_apply(struct_op_t *op, const double *x, double *y)
+{
+    const csr_ctx_t *c = (const csr_ctx_t*)op->ctx;
+    csr_spmm(c->A, 1, x, c->A->n, y, c->A->n, c->nthreads, NULL);
+}
+
+static void csr_apply_block(struct_op_t *op, int k, const double *X, int ldx, double *Y, int ldy)
+{
+    csr_ctx_t *c = (csr_ctx_t*)op->ctx;
+    if (k > 1 && !c->pack) c->pack = (double*)malloc((size_t)c->A->n * CSR_PANEL * sizeof(double));
+    csr_spmm(c->A, k, X, ldx, Y, ldy, c->nthreads, c->pack);
+}
+
+static void csr_destroy(struct_op_t *op)
+{
+    csr_ctx_t *c = (csr_ctx_t*)op->ctx;
+    if (c) free(c->pack);
+    free(c);
+}
+
+struct_op_t *csr_op_create(const csr_t *A, int nthreads)
+{
+    if (!A || A->n < 1) return NULL;
+    struct_op_t *op = (struct_op_t*)calloc(1, sizeof(struct_op_t));
+    csr_ctx_t *c = (csr_ctx_t*)malloc(sizeof(csr_ctx_t));
+    if (!op || !c) { free(c); free(op); return NULL; }
+    c->A = A;
+    c->nthreads = nthreads;
+    c->pack = NULL;                              /* n x CSR_PANEL, on the first block product */
+    double nb = 0.0;
+    for (int i = 0; i < A->n; ++i) {
+        double s = 0.0;
+        for (long long e = A->rowptr[i]; e < A->rowptr[i + 1]; ++e) s += fabs(A->val[e]);
+        if (s > nb) nb = s;
+    }
+    op->n = A->n;
+    op->kind = "csr";
+    op->norm_bound = nb;
+    op->bytes = (size_t)A->nnz * (sizeof(double) + sizeof(int)) + ((size_t)A->n + 1) * sizeof(long long);
+    op->apply = csr_apply;
+    op->apply_block = csr_apply_block;
+    op->destroy = csr_destroy;
+    op->ctx = c;
+    return op;
+}
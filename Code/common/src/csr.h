@@ -0,0 +1,54 @@
+// csr.h — symmetric sparse matrices in CSR form and a threaded SpMV / SpMM
+// for the iterative eigensolvers (struct_op.h: csr_op_create).
+//
+// Input: a coordinate Matrix Market file (mat_io.h mat_read_coo; symmetric
+// files are mirrored, duplicates summed), or the 5-point graph Laplacian of
+// an nx x ny grid (Dirichlet: eigenvalues 4 - 2cos(i pi/(nx+1)) -
+// 2cos(j pi/(ny+1)), closed form in csr_laplacian_2d_eig).
+//
+// Kernel: Y = A X for k columns (column-major). Rows are split into one
+// contiguous range per thread with equal nonzeros. For k > 1 the columns go
+// in panels of CSR_PANEL: each thread first copies its rows of the panel of
+// X into a shared row-major buffer (barrier), so every nonzero then reads
+// one contiguous run of CSR_PANEL doubles instead of CSR_PANEL cache lines,
+// and the row/col/val stream is read once per panel instead of once per
+// column. A tail of fewer than CSR_PANEL/2 columns (and k = 1) runs as plain
+// SpMVs: a narrow panel gathers no better than a column. Threads: `nthreads` > 0, else SPMM_THREADS, else the online CPUs;
+// the caller is thread 0, the others are started per call (the pthread
+// pattern of inv_iter.c).
+
+#ifndef CSR_H
+#define CSR_H
+
+#include "struct_op.h"
+
+#define CSR_PANEL 8
+
+typedef struct {
+    int        n;
+    long long  nnz;
+    long long *rowptr;       /* n + 1                                   */
+    int       *col;          /* nnz, ascending within a row              */
+    double    *val;          /* nnz                                      */
+} csr_t;
+
+int  csr_from_mtx(const char *path, csr_t *A);             /* 0 or < 0 */
+int  csr_laplacian_2d(int nx, int ny, csr_t *A);
+void csr_laplacian_2d_eig(int nx, int ny, int k, int which, double *W);   /* k extremal, as lanczos_extremal orders them */
+void csr_free(csr_t *A);
+
+/* Y = A X (k columns); threads as above. pack: n x CSR_PANEL doubles of
+   panel buffer for k > 1, or NULL to allocate one per call. Aborts when a
+   thread cannot be started (the panel barrier counts them all). */
+void csr_spmm(const csr_t *A, int k, const double *X, int ldx, double *Y, int ldy,
+              int nthreads, double *pack);
+
+/* Bytes a k-column product streams: the matrix once per panel, X packed
+   and read, Y written (the throughput model of the drivers' GB/s). */
+double csr_spmm_bytes(const csr_t *A, int k);
+
+/* Operator view (A is borrowed, must outlive the operator); norm_bound is
+   the max absolute row sum. */
+struct_op_t *csr_op_create(const csr_t *A, int nthreads);
+
+#endif /* CSR_H */
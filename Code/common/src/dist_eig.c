@@ -0,0 +1,364 @@
+// dist_eig.c — native MPI reduction, MRRR and back-transform (see dist_eig.h).
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "dist_eig.h"
+#include "now_sec.h"
+
+extern void dlarfg_(const int *N, double *ALPHA, double *X, const int *INCX, double *TAU);
+extern void dlarft_(const char *DIRECT, const char *STOREV, const int *N, const int *K,
+                    const double *V, const int *LDV, const double *TAU, double *T, const int *LDT);
+extern void dsterf_(const int *N, double *D, double *E, int *INFO);
+extern void dstemr_(const char *JOBZ, const char *RANGE, const int *N, double *D, double *E,
+                    const double *VL, const double *VU, const int *IL, const int *IU,
+                    int *M, double *W, double *Z, const int *LDZ, const int *NZC,
+                    int *ISUPPZ, int *TRYRAC, double *WORK, const int *LWORK,
+                    int *IWORK, const int *LIWORK, int *INFO);
+extern void dgemv_(const char *TRANS, const int *M, const int *N, const double *ALPHA,
+                   const double *A, const int *LDA, const double *X, const int *INCX,
+                   const double *BETA, double *Y, const int *INCY);
+extern void dger_(const int *M, const int *N, const double *ALPHA, const double *X, const int *INCX,
+                  const double *Y, const int *INCY, double *A, const int *LDA);
+extern void dgemm_(const char *TRANSA, const char *TRANSB, const int *M, const int *N, const int *K,
+                   const double *ALPHA, const double *A, const int *LDA, const double *B, const int *LDB,
+                   const double *BETA, double *C, const int *LDC);
+extern void dtrmm_(const char *SIDE, const char *UPLO, const char *TRANSA, const char *DIAG,
+                   const int *M, const int *N, const double *ALPHA, const double *A, const int *LDA,
+                   double *B, const int *LDB);
+
+/* in-place sum over c, timed into the stats */
+static void allreduce(MPI_Comm c, double *buf, int count, dist_eig_stats_t *st)
+{
+    const double t0 = now_sec();
+    MPI_Allreduce(MPI_IN_PLACE, buf, count, MPI_DOUBLE, MPI_SUM, c);
+    st->t_comm += now_sec() - t0;
+    st->n_comm++;
+    st->bytes_comm += (double)count * sizeof(double);
+}
+
+/* one verdict for the grid: any allocation failure (< 0) first, else the
+   largest INFO */
+static int agree(const dist_grid_t *g, int err)
+{
+    int lo = err, hi = err;
+    MPI_Allreduce(MPI_IN_PLACE, &lo, 1, MPI_INT, MPI_MIN, g->comm);
+    MPI_Allreduce(MPI_IN_PLACE, &hi, 1, MPI_INT, MPI_MAX, g->comm);
+    return lo < 0 ? lo : hi;
+}
+
+/* --------- Grid and layout --------- */
+
+int dist_grid_init(MPI_Comm comm, int nprow, int npcol, dist_grid_t *g)
+{
+    memset(g, 0, sizeof(*g));
+    g->comm = comm;
+    MPI_Comm_rank(comm, &g->rank);
+    MPI_Comm_size(comm, &g->size);
+    if (nprow <= 0) {
+        nprow = (int)sqrt((double)g->size);
+        while (nprow > 1 && g->size % nprow != 0) --nprow;
+        npcol = g->size / nprow;
+    }
+    if (nprow < 1 || npcol < 1 || nprow * npcol != g->size) return -1;
+    g->nprow = nprow; g->npcol = npcol;
+    g->myrow = g->rank / npcol;
+    g->mycol = g->rank % npcol;
+    MPI_Comm_split(comm, g->myrow, g->mycol, &g->row_comm);
+    MPI_Comm_split(comm, g->mycol, g->myrow, &g->col_comm);
+    return 0;
+}
+
+void dist_grid_free(dist_grid_t *g)
+{
+    if (g->row_comm != MPI_COMM_NULL) MPI_Comm_free(&g->row_comm);
+    if (g->col_comm != MPI_COMM_NULL) MPI_Comm_free(&g->col_comm);
+}
+
+int dist_numroc(int n, int nb, int p, int P)
+{
+    const int nblocks = n / nb, extra = nblocks % P;
+    int num = (nblocks / P) * nb;
+    if (p < extra) num += nb;
+    else if (p == extra) num += n % nb;
+    return num;
+}
+
+int dist_l2g(int l, int nb, int p, int P) { return ((l / nb) * P + p) * nb + l % nb; }
+int dist_g2l(int g, int nb, int P)        { return (g / (nb * P)) * nb + g % nb; }
+static int owner(int g, int nb, int P)    { return (g / nb) % P; }
+
+int dist_mat_alloc(const dist_grid_t *g, int n, int nb, dist_mat_t *A)
+{
+    memset(A, 0, sizeof(*A));
+    A->n = n; A->nb = nb;
+    A->mloc = dist_numroc(n, nb, g->myrow, g->nprow);
+    A->nloc = dist_numroc(n, nb, g->mycol, g->npcol);
+    A->lld = A->mloc > 1 ? A->mloc : 1;
+    A->a = (double*)calloc((size_t)A->lld * (size_t)(A->nloc > 0 ? A->nloc : 1), sizeof(double));
+    return A->a ? 0 : -1;
+}
+
+void dist_mat_free(dist_mat_t *A)
+{
+    free(A->a);
+    memset(A, 0, sizeof(*A));
+}
+
+/* --------- sytd2: A = Q T Q^T --------- */
+
+static int reduce(const dist_grid_t *g, dist_mat_t *A, double *D, double *E, double *tau,
+                  dist_eig_stats_t *st)
+{
+    const int n = A->n, nb = A->nb, lld = A->lld, one = 1;
+    const int Pr = g->nprow, Pc = g->npcol, pr = g->myrow, pc = g->mycol;
+    double *x  = (double*)malloc((size_t)n * sizeof(double));
+    double *p  = (double*)malloc((size_t)n * sizeof(double));
+    double *vr = (double*)malloc((size_t)(A->mloc + 1) * sizeof(double));
+    double *wr = (double*)malloc((size_t)(A->mloc + 1) * sizeof(double));
+    double *yl = (double*)malloc((size_t)(A->mloc + 1) * sizeof(double));
+    double *vc = (double*)malloc((size_t)(A->nloc + 1) * sizeof(double));
+    double *wc = (double*)malloc((size_t)(A->nloc + 1) * sizeof(double));
+    if (agree(g, (!x || !p || !vr || !wr || !yl || !vc || !wc) ? -1 : 0) != 0) {
+        free(wc); free(vc); free(yl); free(wr); free(vr); free(p); free(x);
+        return -1;
+    }
+    const double mone = -1.0, dzero = 0.0, done = 1.0;
+
+    for (int k = 0; k < n - 1; ++k) {
+        const int m = n - k - 1;
+        const int lrk = dist_numroc(k, nb, pr, Pr);          /* first local row >= k     */
+        const int lr0 = dist_numroc(k + 1, nb, pr, Pr);      /* first local row >= k + 1 */
+        const int lc0 = dist_numroc(k + 1, nb, pc, Pc);
+        const int mr = A->mloc - lr0, mc = A->nloc - lc0;
+        const int mine = (pc == owner(k, nb, Pc));
+        const int lck = mine ? dist_g2l(k, nb, Pc) : 0;
+
+        /* column k, rows k..n-1, on every rank: x[0] = A(k,k), x[1..m] below */
+        memset(x, 0, (size_t)(m + 1) * sizeof(double));
+        if (mine)
+            for (int li = lrk; li < A->mloc; ++li)
+                x[dist_l2g(li, nb, pr, Pr) - k] = A->a[li + (size_t)lck * lld];
+        allreduce(g->comm, x, m + 1, st);
+        D[k] = x[0];
+        double alpha = x[1], t = 0.0;
+        dlarfg_(&m, &alpha, x + 2, &one, &t);
+        E[k] = alpha;
+        tau[k] = t;
+        double *v = x + 1;
+        v[0] = 1.0;
+        if (mine)                                      /* reflector into column k */
+            for (int li = lr0; li < A->mloc; ++li)
+                A->a[li + (size_t)lck * lld] = v[dist_l2g(li, nb, pr, Pr) - (k + 1)];
+        st->n_reduce++;
+        if (t == 0.0) continue;
+
+        /* p = tau A22 v: local DGEMV, rows summed over the grid */
+        for (int j = 0; j < mc; ++j) vc[j] = v[dist_l2g(lc0 + j, nb, pc, Pc) - (k + 1)];
+        for (int i = 0; i < mr; ++i) vr[i] = v[dist_l2g(lr0 + i, nb, pr, Pr) - (k + 1)];
+        memset(p, 0, (size_t)m * sizeof(double));
+        if (mr > 0 && mc > 0) {
+            dgemv_("N", &mr, &mc, &done, A->a + lr0 + (size_t)lc0 * lld, &lld, vc, &one, &dzero, yl, &one);
+            for (int i = 0; i < mr; ++i) p[dist_l2g(lr0 + i, nb, pr, Pr) - (k + 1)] = yl[i];
+        }
+        allreduce(g->comm, p, m, st);
+
+        /* w = p - (tau/2)(p^T v) v; A22 -= v w^T + w v^T */
+        double dot = 0.0;
+        for (int i = 0; i < m; ++i) { p[i] *= t; dot += p[i] * v[i]; }
+        const double a2 = -0.5 * t * dot;
+        for (int i = 0; i < m; ++i) p[i] += a2 * v[i];
+        if (mr > 0 && mc > 0) {
+            for (int j = 0; j < mc; ++j) wc[j] = p[dist_l2g(lc0 + j, nb, pc, Pc) - (k + 1)];
+            for (int i = 0; i < mr; ++i) wr[i] = p[dist_l2g(lr0 + i, nb, pr, Pr) - (k + 1)];
+            double *a22 = A->a + lr0 + (size_t)lc0 * lld;
+            dger_(&mr, &mc, &mone, vr, &one, wc, &one, a22, &lld);
+            dger_(&mr, &mc, &mone, wr, &one, vc, &one, a22, &lld);
+        }
+    }
+
+    /* last diagonal entry */
+    x[0] = 0.0;
+    if (pr == owner(n - 1, nb, Pr) && pc == owner(n - 1, nb, Pc))
+        x[0] = A->a[dist_g2l(n - 1, nb, Pr) + (size_t)dist_g2l(n - 1, nb, Pc) * lld];
+    allreduce(g->comm, x, 1, st);
+    D[n - 1] = x[0];
+    E[n - 1] = 0.0;
+
+    free(wc); free(vc); free(yl); free(wr); free(vr); free(p); free(x);
+    return 0;
+}
+
+/* --------- stemr: local columns of Z_T --------- */
+
+/* The nb-wide column blocks of a process column are dealt over its process
+   rows (block b to row b mod nprow); each rank runs DSTEMR on its blocks
+   for all n rows, then one MPI_Alltoallv on the column communicator hands
+   every rank its rows of every block. */
+static int tridiag_vectors(const dist_grid_t *g, const double *D, const double *E,
+                           dist_mat_t *Z, dist_eig_stats_t *st)
+{
+    const int n = Z->n, nb = Z->nb, Pr = g->nprow, pr = g->myrow;
+    const int nblk = (Z->nloc + nb - 1) / nb;     /* the same on the whole process column */
+    int *cnt = (int*)calloc(5 * (size_t)Pr, sizeof(int));
+    if (agree(g, cnt ? 0 : -1) != 0) return -1;
+    int *cols = cnt + 4 * Pr;                     /* columns computed by each process row */
+    for (int q = 0; q < Pr; ++q) {
+        cols[q] = 0;
+        for (int b = q; b < nblk; b += Pr) cols[q] += (Z->nloc - b * nb < nb) ? Z->nloc - b * nb : nb;
+    }
+    const int lwork = 18 * n, liwork = 10 * n;
+    double *Dc = (double*)malloc((size_t)n * sizeof(double));
+    double *Ec = (double*)malloc((size_t)n * sizeof(double));
+    double *wb = (double*)malloc((size_t)n * sizeof(double));      /* DSTEMR: W(N) even for a subset */
+    double *Zt = (double*)malloc((size_t)n * (cols[pr] > 0 ? cols[pr] : 1) * sizeof(double));
+    double *sb = (double*)malloc((size_t)n * (cols[pr] > 0 ? cols[pr] : 1) * sizeof(double));
+    double *rb = (double*)malloc((size_t)Z->lld * (Z->nloc > 0 ? Z->nloc : 1) * sizeof(double));
+    int *isuppz = (int*)malloc(2 * (size_t)nb * sizeof(int));
+    double *work = (double*)malloc((size_t)lwork * sizeof(double));
+    int *iwork = (int*)malloc((size_t)liwork * sizeof(int));
+    int info = 0;
+    if (!Dc || !Ec || !wb || !Zt || !sb || !rb || !isuppz || !work || !iwork) info = -1;
+
+    int off = 0;
+    for (int b = pr; info == 0 && b < nblk; b += Pr) {
+        const int lj = b * nb;
+        const int g0 = dist_l2g(lj, nb, g->mycol, g->npcol);
+        const int bw = (Z->nloc - lj < nb) ? Z->nloc - lj : nb;
+        const int il = g0 + 1, iu = g0 + bw;
+        const double vl = 0.0, vu = 0.0;
+        int mfound = 0, tryrac = 1;
+        memcpy(Dc, D, (size_t)n * sizeof(double));
+        memcpy(Ec, E, (size_t)n * sizeof(double));
+        dstemr_("V", "I", &n, Dc, Ec, &vl, &vu, &il, &iu, &mfound, wb, Zt + (size_t)off * n, &n, &bw,
+                isuppz, &tryrac, work, &lwork, iwork, &liwork, &info);
+        if (info == 0 && mfound != bw) info = n + 1;
+        off += bw;
+        st->n_tridiag++;
+    }
+    info = agree(g, info);
+
+    if (info == 0) {
+        int *sc = cnt, *sd = cnt + Pr, *rc = cnt + 2 * Pr, *rd = cnt + 3 * Pr;
+        int spos = 0, rpos = 0;
+        for (int q = 0; q < Pr; ++q) {
+            const int mq = dist_numroc(n, nb, q, Pr);
+            sc[q] = mq * cols[pr];      sd[q] = spos; spos += sc[q];
+            rc[q] = Z->mloc * cols[q];  rd[q] = rpos; rpos += rc[q];
+            double *s = sb + sd[q];
+            for (int c = 0; c < cols[pr]; ++c)
+                for (int lq = 0; lq < mq; ++lq) *s++ = Zt[dist_l2g(lq, nb, q, Pr) + (size_t)c * n];
+        }
+        const double t0 = now_sec();
+        MPI_Alltoallv(sb, sc, sd, MPI_DOUBLE, rb, rc, rd, MPI_DOUBLE, g->col_comm);
+        st->t_comm += now_sec() - t0;
+        st->n_comm++;
+        st->bytes_comm += (double)(spos - sc[pr]) * sizeof(double);
+        for (int q = 0; q < Pr; ++q) {
+            const double *r = rb + rd[q];
+            for (int b = q; b < nblk; b += Pr) {
+                const int bw = (Z->nloc - b * nb < nb) ? Z->nloc - b * nb : nb;
+                for (int c = 0; c < bw; ++c)
+                    for (int li = 0; li < Z->mloc; ++li) Z->a[li + (size_t)(b * nb + c) * Z->lld] = *r++;
+            }
+        }
+    }
+    free(cnt); free(iwork); free(work); free(isuppz); free(rb); free(sb); free(Zt); free(wb); free(Ec); free(Dc);
+    return info;
+}
+
+/* --------- ormtr: Z = Q Z_T, panels of nb reflectors, last first --------- */
+
+static int back_transform(const dist_grid_t *g, const dist_mat_t *A, const double *tau,
+                          dist_mat_t *Z, dist_eig_stats_t *st)
+{
+    const int n = A->n, nb = A->nb, lld = A->lld;
+    const int Pr = g->nprow, Pc = g->npcol, pr = g->myrow, pc = g->mycol;
+    const int nloc = Z->nloc, nl1 = nloc > 0 ? nloc : 1;
+    double *V  = (double*)malloc((size_t)n * nb * sizeof(double));
+    double *Vr = (double*)malloc((size_t)(Z->mloc > 0 ? Z->mloc : 1) * nb * sizeof(double));
+    double *T  = (double*)malloc((size_t)nb * nb * sizeof(double));
+    double *M  = (double*)malloc((size_t)nb * nl1 * sizeof(double));
+    if (agree(g, (!V || !Vr || !T || !M) ? -1 : 0) != 0 || n < 2) {
+        free(M); free(T); free(Vr); free(V);
+        return n < 2 ? 0 : -1;
+    }
+    const double done = 1.0, mone = -1.0, dzero = 0.0;
+    for (int k0 = ((n - 2) / nb) * nb; k0 >= 0; k0 -= nb) {
+        const int k1 = (k0 + nb < n - 1) ? k0 + nb : n - 1;
+        const int b = k1 - k0, h = n - 1 - k0;
+
+        /* panel V (rows k0+1..n-1) on every rank; one process column holds it */
+        memset(V, 0, (size_t)h * b * sizeof(double));
+        if (pc == owner(k0, nb, Pc))
+            for (int c = 0; c < b; ++c) {
+                const int k = k0 + c, lck = dist_g2l(k, nb, Pc);
+                for (int li = dist_numroc(k + 1, nb, pr, Pr); li < A->mloc; ++li)
+                    V[(dist_l2g(li, nb, pr, Pr) - (k0 + 1)) + (size_t)c * h] = A->a[li + (size_t)lck * lld];
+            }
+        allreduce(g->comm, V, h * b, st);
+        dlarft_("F", "C", &h, &b, V, &h, tau + k0, T, &nb);
+
+        /* Z(k0+1:, :) -= V T (V^T Z(k0+1:, :)) */
+        const int lr = dist_numroc(k0 + 1, nb, pr, Pr), mr = Z->mloc - lr;
+        for (int c = 0; c < b; ++c)
+            for (int i = 0; i < mr; ++i)
+                Vr[i + (size_t)c * mr] = V[(dist_l2g(lr + i, nb, pr, Pr) - (k0 + 1)) + (size_t)c * h];
+        if (nloc > 0) {
+            if (mr > 0) dgemm_("T", "N", &b, &nloc, &mr, &done, Vr, &mr, Z->a + lr, &Z->lld, &dzero, M, &b);
+            else memset(M, 0, (size_t)b * nloc * sizeof(double));
+        }
+        allreduce(g->col_comm, M, b * nloc, st);
+        if (nloc > 0 && mr > 0) {
+            dtrmm_("L", "U", "N", "N", &b, &nloc, &done, T, &nb, M, &b);
+            dgemm_("N", "N", &mr, &nloc, &b, &mone, Vr, &mr, M, &b, &done, Z->a + lr, &Z->lld);
+        }
+        st->n_backtr++;
+    }
+    free(M); free(T); free(Vr); free(V);
+    return 0;
+}
+
+/* --------- Driver --------- */
+
+int dist_syevd(const dist_grid_t *g, dist_mat_t *A, double *W, dist_mat_t *Z,
+               dist_eig_stats_t *st)
+{
+    memset(st, 0, sizeof(*st));
+    const int n = A->n;
+    double *D   = (double*)malloc((size_t)n * sizeof(double));
+    double *E   = (double*)malloc((size_t)n * sizeof(double));
+    double *tau = (double*)calloc((size_t)n, sizeof(double));
+    int err = agree(g, (!D || !E || !tau) ? -1 : 0);
+
+    double t0 = now_sec();
+    if (err == 0) err = reduce(g, A, D, E, tau, st);
+    st->t_reduce = now_sec() - t0;
+
+    t0 = now_sec();
+    if (err == 0) {
+        double *Ew = (double*)malloc((size_t)n * sizeof(double));
+        int info = 0;
+        if (!Ew) err = -1;
+        else {
+            memcpy(W, D, (size_t)n * sizeof(double));
+            memcpy(Ew, E, (size_t)n * sizeof(double));
+            dsterf_(&n, W, Ew, &info);                  /* all eigenvalues, every rank */
+            if (info != 0) err = info;
+        }
+        free(Ew);
+    }
+    err = agree(g, err);
+    if (err == 0) err = tridiag_vectors(g, D, E, Z, st);      /* agreed inside */
+    st->t_tridiag = now_sec() - t0;
+
+    t0 = now_sec();
+    if (err == 0) err = back_transform(g, A, tau, Z, st);
+    st->t_backtr = now_sec() - t0;
+
+    free(tau); free(E); free(D);
+    return err;
+}
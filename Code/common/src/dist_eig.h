@@ -0,0 +1,75 @@
+// dist_eig.h — distributed-memory symmetric eigensolver over MPI: A in the
+// 2-D block-cyclic layout of ScaLAPACK (nb x nb blocks dealt round-robin
+// over an nprow x npcol process grid, row-major rank order like BLACS "R"),
+// so no rank ever holds more than ~n^2/P + O(n nb) doubles.
+//
+// Stages (native; the MPI driver switches to PDSYTRD / PDSTEDC / PDORMTR
+// when built with HAVE_SCALAPACK):
+//   sytd2  A = Q T Q^T, unblocked Householder reduction (the PDSYTD2
+//          scheme): per column, the reflector is summed to every rank
+//          (MPI_Allreduce, O(n)), A22 v is a local DGEMV plus one O(n)
+//          allreduce, the rank-2 update two local DGERs. Reflectors stay in
+//          the distributed lower triangle, D / E end up on every rank.
+//   stemr  eigenvectors of T for the columns each rank owns: every nb-wide
+//          block of global columns is one DSTEMR RANGE='I' call (MRRR,
+//          O(n nb) work, no communication); each process row computes the
+//          same blocks for its process column and keeps its own rows.
+//          MRRR rather than D&C: a divide & conquer merge cannot produce a
+//          subset of columns, and the distributed merge is PDLAED*-sized.
+//   ormtr  Z = Q Z_T, blocked: reflectors in panels of nb (one process
+//          column each), panel V summed to every rank, T from DLARFT, then
+//          Z -= V (T (V^T Z)) with the V^T Z product summed over each process
+//          column (MPI_Allreduce on the column communicator).
+// Communication volume per rank is O(n^2) doubles (two n-vectors per
+// column in sytd2, one n x nb panel per block in ormtr), independent of P:
+// memory scales with P, the reduction's communication does not (PDSYTRD's
+// blocked PDLATRD would cut it by ~nb).
+
+#ifndef DIST_EIG_H
+#define DIST_EIG_H
+
+#include <mpi.h>
+
+typedef struct {
+    MPI_Comm comm, row_comm, col_comm;  /* all, same process row, same process column */
+    int      rank, size;
+    int      nprow, npcol, myrow, mycol;
+} dist_grid_t;
+
+typedef struct {
+    int     n, nb;              /* global order, block size                     */
+    int     mloc, nloc, lld;    /* local rows, local columns, leading dimension */
+    double *a;                  /* mloc x nloc, column-major                    */
+} dist_mat_t;
+
+typedef struct {
+    double t_reduce, t_tridiag, t_backtr;   /* stage wall time (comm included)  */
+    double t_comm;                          /* of which in MPI collectives      */
+    long   n_reduce, n_tridiag, n_backtr;   /* columns / DSTEMR blocks / panels */
+    long   n_comm;
+    double bytes_comm;                      /* payload this rank sent           */
+} dist_eig_stats_t;
+
+/* nprow x npcol grid over comm (nprow * npcol must equal the size; nprow <=
+   0 picks the most square factorization with nprow <= npcol). 0 or -1. */
+int  dist_grid_init(MPI_Comm comm, int nprow, int npcol, dist_grid_t *g);
+void dist_grid_free(dist_grid_t *g);
+
+/* ScaLAPACK's NUMROC / INDXL2G / INDXG2L, 0-based: entries of an n-long
+   dimension on process coordinate p of P, and the index maps. */
+int dist_numroc(int n, int nb, int p, int P);
+int dist_l2g(int l, int nb, int p, int P);
+int dist_g2l(int g, int nb, int P);
+
+/* Local part of an n x n matrix on g; a is zeroed. 0 or -1. */
+int  dist_mat_alloc(const dist_grid_t *g, int n, int nb, dist_mat_t *A);
+void dist_mat_free(dist_mat_t *A);
+
+/* All eigenpairs of the symmetric A (full storage, both triangles): W[n]
+   ascending on every rank, Z distributed like A. A is overwritten with the
+   reflectors. Returns 0, -1 on allocation failure, or a DSTEMR INFO > 0
+   (any rank's, agreed over the grid). */
+int dist_syevd(const dist_grid_t *g, dist_mat_t *A, double *W, dist_mat_t *Z,
+               dist_eig_stats_t *st);
+
+#endif /* DIST_EIG_H */
@@ -0,0 +1,261 @@
+// eig_cache.c — content-addressed stage cache (see eig_cache.h).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "eig_cache.h"
+
+/* LAPACK version: part of every key so an upgraded library misses */
+extern void ilaver_(int *VERS_MAJOR, int *VERS_MINOR, int *VERS_PATCH);
+
+#define EIG_CACHE_MAGIC "EIGCACH1"
+
+typedef struct {
+    char     magic[8];
+    uint64_t key;
+    char     stage[16];
+    uint32_t nfields;
+    uint32_t pad;
+} cache_hdr_t;
+
+typedef struct {
+    char     name[8];
+    uint64_t count;
+    uint64_t sum;        /* eig_cache_hash of the data */
+} cache_rec_t;
+
+int eig_cache_enabled(void)
+{
+    const char *v = getenv("EIG_CACHE");
+    return v && (v[0] == '1' || strcmp(v, "on") == 0);
+}
+
+void eig_cache_banner(FILE *f, const char *what)
+{
+    if (!f) return;
+    fprintf(f, "########################################################################\n"
+               "## CACHED RESULT: %s loaded from %s (EIG_CACHE=1).\n"
+               "## The timings below are cache reads, NOT solver runs.\n"
+               "########################################################################\n",
+            what, eig_cache_dir());
+}
+
+int eig_cache_vectors(void)
+{
+    const char *v = getenv("EIG_CACHE_VECTORS");
+    if (!v || !*v) return 1;
+    if (strcmp(v, "all") == 0) return 2;
+    return v[0] == '0' ? 0 : 1;
+}
+
+static int mkdir_p(char *path)
+{
+    for (char *p = path + 1; *p; ++p) {
+        if (*p != '/') continue;
+        *p = '\0';
+        int rc = mkdir(path, 0777);
+        *p = '/';
+        if (rc != 0 && errno != EEXIST) return -1;
+    }
+    return (mkdir(path, 0777) != 0 && errno != EEXIST) ? -1 : 0;
+}
+
+const char *eig_cache_dir(void)
+{
+    static char dir[1024];
+    if (dir[0]) return dir;
+    const char *d = getenv("EIG_CACHE_DIR");
+    const char *xdg = getenv("XDG_CACHE_HOME");
+    const char *home = getenv("HOME");
+    if (d && *d)          snprintf(dir, sizeof(dir), "%s", d);
+    else if (xdg && *xdg) snprintf(dir, sizeof(dir), "%s/eig_cache", xdg);
+    else                  snprintf(dir, sizeof(dir), "%s/.cache/eig_cache", home ? home : ".");
+    return dir;
+}
+
+/* ---------------- hashing ---------------- */
+
+static inline uint64_t mix64(uint64_t h)
+{
+    h ^= h >> 33; h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33; h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+static inline uint64_t lane(uint64_t h, uint64_t v)
+{
+    h ^= v * 0x9E3779B97F4A7C15ull;
+    h = (h << 31) | (h >> 33);
+    return h * 0x87c37b91114253d5ull;
+}
+
+uint64_t eig_cache_hash(uint64_t seed, const void *p, size_t len)
+{
+    const unsigned char *b = (const unsigned char*)p;
+    uint64_t h0 = seed ^ 0x243F6A8885A308D3ull, h1 = seed ^ 0x13198A2E03707344ull;
+    uint64_t h2 = seed ^ 0xA4093822299F31D0ull, h3 = seed ^ 0x082EFA98EC4E6C89ull;
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        uint64_t v[4];
+        memcpy(v, b + i, 32);
+        h0 = lane(h0, v[0]); h1 = lane(h1, v[1]);
+        h2 = lane(h2, v[2]); h3 = lane(h3, v[3]);
+    }
+    for (; i + 8 <= len; i += 8) {
+        uint64_t v; memcpy(&v, b + i, 8);
+        h0 = lane(h0, v);
+    }
+    if (i < len) {
+        uint64_t v = 0; memcpy(&v, b + i, len - i);
+        h1 = lane(h1, v);
+    }
+    return mix64(h0 ^ mix64(h1) ^ mix64(h2 + 1) ^ mix64(h3 + 2) ^ (uint64_t)len);
+}
+
+static uint64_t key_env(uint64_t h, char uplo, const char *backend)
+{
+    int vmaj = 0, vmin = 0, vpat = 0;
+    ilaver_(&vmaj, &vmin, &vpat);
+    const int ver[3] = { vmaj, vmin, vpat };
+    h = eig_cache_hash(h, &uplo, 1);
+    h = eig_cache_hash(h, ver, sizeof(ver));
+    if (backend) h = eig_cache_hash(h, backend, strlen(backend));
+    return h;
+}
+
+uint64_t eig_cache_key_kms(int n, char uplo, double rho, double delta, const char *backend)
+{
+    /* same clamping as fill_kms, so equivalent parameters share an entry */
+    if (!(rho > -1.0 && rho < 1.0)) rho = 0.95;
+    if (delta < 0.0) delta = 0.0;
+    const double p[2] = { rho < 0.0 ? -rho : rho, delta };
+    uint64_t h = eig_cache_hash(0x4B4D53ull /* "KMS" */, &n, sizeof(n));
+    h = eig_cache_hash(h, p, sizeof(p));
+    return key_env(h, uplo, backend);
+}
+
+uint64_t eig_cache_key_matrix(int n, const double *A, int lda, char uplo, const char *backend)
+{
+    /* only the referenced triangle, column by column */
+    uint64_t h = eig_cache_hash(0x4D4154ull /* "MAT" */, &n, sizeof(n));
+    const int up = (uplo == 'U' || uplo == 'u');
+    for (int j = 0; j < n; ++j) {
+        const double *col = A + (size_t)j * lda;
+        h = up ? eig_cache_hash(h, col, (size_t)(j + 1) * sizeof(double))
+               : eig_cache_hash(h, col + j, (size_t)(n - j) * sizeof(double));
+    }
+    return key_env(h, uplo, backend);
+}
+
+uint64_t eig_cache_key_band(int n, int kd, const double *AB, int ldab, char uplo, const char *backend)
+{
+    /* the kd+1 stored rows of each column */
+    const int dims[2] = { n, kd };
+    uint64_t h = eig_cache_hash(0x42414E44ull /* "BAND" */, dims, sizeof(dims));
+    for (int j = 0; j < n; ++j)
+        h = eig_cache_hash(h, AB + (size_t)j * ldab, (size_t)(kd + 1) * sizeof(double));
+    return key_env(h, uplo, backend);
+}
+
+uint64_t eig_cache_key_stage(uint64_t input_key, const char *stage, char opt)
+{
+    uint64_t h = eig_cache_hash(input_key, stage, strlen(stage));
+    return eig_cache_hash(h, &opt, 1);
+}
+
+/* ---------------- entries ---------------- */
+
+static void entry_path(char *buf, size_t len, const char *stage, uint64_t key)
+{
+    snprintf(buf, len, "%s/%s-%016llx.bin", eig_cache_dir(), stage, (unsigned long long)key);
+}
+
+int eig_cache_load(const char *stage, uint64_t key, eig_cache_field_t *f, int nf)
+{
+    for (int i = 0; i < nf; ++i) f[i].found = 0;
+    if (!eig_cache_enabled()) return -1;
+
+    char path[1200];
+    entry_path(path, sizeof(path), stage, key);
+    FILE *fp = fopen(path, "rb");
+    if (!fp) return -1;
+
+    cache_hdr_t hdr;
+    int loaded = 0;
+    if (fread(&hdr, sizeof(hdr), 1, fp) != 1 || memcmp(hdr.magic, EIG_CACHE_MAGIC, 8) != 0 ||
+        hdr.key != key || strncmp(hdr.stage, stage, sizeof(hdr.stage)) != 0)
+        goto MISS;
+
+    for (uint32_t r = 0; r < hdr.nfields; ++r) {
+        cache_rec_t rec;
+        if (fread(&rec, sizeof(rec), 1, fp) != 1) goto MISS;
+        eig_cache_field_t *dst = NULL;
+        for (int i = 0; i < nf; ++i)
+            if (f[i].data && !f[i].found && f[i].count == rec.count &&
+                strncmp(f[i].name, rec.name, sizeof(rec.name)) == 0) { dst = &f[i]; break; }
+        if (!dst) {
+            if (fseek(fp, (long)(rec.count * sizeof(double)), SEEK_CUR) != 0) goto MISS;
+            continue;
+        }
+        if (fread(dst->data, sizeof(double), rec.count, fp) != rec.count ||
+            eig_cache_hash(0, dst->data, rec.count * sizeof(double)) != rec.sum)
+            goto CORRUPT;
+        dst->found = 1;
+        loaded++;
+    }
+    fclose(fp);
+    return loaded;
+
+MISS:
+    for (int i = 0; i < nf; ++i) f[i].found = 0;
+    fclose(fp);
+    return -1;
+
+CORRUPT:    /* a destination was (partly) overwritten: drop the entry, tell the caller */
+    for (int i = 0; i < nf; ++i) f[i].found = 0;
+    fclose(fp);
+    fprintf(stderr, "[eig_cache] %s: checksum mismatch, entry removed\n", path);
+    remove(path);
+    return -2;
+}
+
+int eig_cache_store(const char *stage, uint64_t key, const eig_cache_field_t *f, int nf)
+{
+    if (!eig_cache_enabled()) return -1;
+    char dir[1024];
+    snprintf(dir, sizeof(dir), "%s", eig_cache_dir());
+    if (mkdir_p(dir) != 0) return -1;
+
+    char path[1200], tmp[1300];
+    entry_path(path, sizeof(path), stage, key);
+    snprintf(tmp, sizeof(tmp), "%s.%ld.tmp", path, (long)getpid());
+    FILE *fp = fopen(tmp, "wb");
+    if (!fp) return -1;
+
+    cache_hdr_t hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, EIG_CACHE_MAGIC, 8);
+    hdr.key = key;
+    strncpy(hdr.stage, stage, sizeof(hdr.stage) - 1);
+    for (int i = 0; i < nf; ++i) if (f[i].data) hdr.nfields++;
+    int ok = fwrite(&hdr, sizeof(hdr), 1, fp) == 1;
+
+    for (int i = 0; i < nf && ok; ++i) {
+        if (!f[i].data) continue;
+        cache_rec_t rec;
+        memset(&rec, 0, sizeof(rec));
+        strncpy(rec.name, f[i].name, sizeof(rec.name) - 1);
+        rec.count = f[i].count;
+        rec.sum = eig_cache_hash(0, f[i].data, f[i].count * sizeof(double));
+        ok = fwrite(&rec, sizeof(rec), 1, fp) == 1 &&
+             fwrite(f[i].data, sizeof(double), f[i].count, fp) == f[i].count;
+    }
+    if (fclose(fp) != 0) ok = 0;
+    if (!ok || rename(tmp, path) != 0) { remove(tmp); return -1; }
+    return 0;
+}
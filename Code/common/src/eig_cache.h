@@ -0,0 +1,70 @@
+// eig_cache.h — content-addressed on-disk cache for reduction / eigen stages.
+//
+// A stage result (D, E, TAU, eigenvalues, optionally Q or eigenvectors) is
+// stored under a 64-bit key derived from
+//   - the input: generator parameters (KMS n, rho, delta) or a fast hash of
+//     the referenced triangle of A,
+//   - UPLO, the backend name (EIG_BACKEND, the build case) and the LAPACK
+//     version reported by ILAVER,
+//   - the stage name and its options (e.g. JOBZ), via eig_cache_key_stage().
+// One file per (stage, key): <dir>/<stage>-<key:016x>.bin, written to a
+// temporary name and renamed, so concurrent runs never see partial entries.
+// Each array carries its own checksum; a mismatch is treated as a miss.
+//
+// Off by default: a hit replaces the solve, so the profiling drivers would
+// report a file read as the solver time. Every driver prints
+// eig_cache_banner() when a reported stage came from the cache.
+//
+// Env:
+//   EIG_CACHE=1|on           enable lookups and stores (default off)
+//   EIG_CACHE_DIR=<dir>      cache directory (default $XDG_CACHE_HOME/eig_cache,
+//                            else ~/.cache/eig_cache)
+//   EIG_CACHE_VECTORS=0|1|all  n x n arrays to store: none, final eigenvectors
+//                            (default), or also the reduction's Q. They
+//                            dominate the disk footprint (8 n^2 bytes each).
+//
+// The cache never changes numerical results of a run that misses; a hit
+// returns the bytes a previous run with the same key produced.
+
+#ifndef EIG_CACHE_H
+#define EIG_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+typedef struct {
+    const char *name;     /* up to 7 chars, e.g. "D", "E", "TAU", "W", "Z" */
+    double     *data;     /* load: destination; store: source (NULL: skip) */
+    size_t      count;    /* number of doubles                             */
+    int         found;    /* set by eig_cache_load                         */
+} eig_cache_field_t;
+
+int         eig_cache_enabled(void);          /* EIG_CACHE=1|on */
+int         eig_cache_vectors(void);          /* 0, 1 (eigenvectors) or 2 (+ Q) */
+const char *eig_cache_dir(void);
+
+/* Loud notice on `f` that `what` was loaded from the cache instead of
+   computed, so the timings that follow are not solver times. */
+void        eig_cache_banner(FILE *f, const char *what);
+
+/* Non-cryptographic 64-bit hash (4 independent multiply-xorshift lanes). */
+uint64_t eig_cache_hash(uint64_t seed, const void *p, size_t len);
+
+/* Input keys. backend may be NULL. */
+uint64_t eig_cache_key_kms(int n, char uplo, double rho, double delta, const char *backend);
+uint64_t eig_cache_key_matrix(int n, const double *A, int lda, char uplo, const char *backend);
+uint64_t eig_cache_key_band(int n, int kd, const double *AB, int ldab, char uplo, const char *backend);
+/* Stage key: input key + stage name + one option character (JOBZ/COMPZ). */
+uint64_t eig_cache_key_stage(uint64_t input_key, const char *stage, char opt);
+
+/* Fill the fields found in the entry (name and count must match).
+   Returns the number of fields loaded, -1 on a miss, or -2 when an array
+   failed its checksum after being read: the destination buffers are then
+   clobbered and must be rebuilt by the caller (the entry is removed). */
+int eig_cache_load(const char *stage, uint64_t key, eig_cache_field_t *f, int nf);
+
+/* Write the fields with non-NULL data. Returns 0, or -1 (caller carries on). */
+int eig_cache_store(const char *stage, uint64_t key, const eig_cache_field_t *f, int nf);
+
+#endif /* EIG_CACHE_H */
@@ -0,0 +1,452 @@
+// eig_select.c — measured-crossover solver selection (see eig_select.h).
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "eig_select.h"
+#include "mem_budget.h"   /* eig_dsyevd_lwork / eig_lwork_int: LP64 LWORK checks */
+
+/* --------- Fortran LAPACK symbols (vendor-agnostic) --------- */
+extern void dsyev_(const char *JOBZ, const char *UPLO, const int *N,
+                   double *A, const int *LDA, double *W,
+                   double *WORK, const int *LWORK, int *INFO);
+extern void dsyevd_(const char *JOBZ, const char *UPLO, const int *N,
+                    double *A, const int *LDA, double *W,
+                    double *WORK, const int *LWORK,
+                    int *IWORK, const int *LIWORK, int *INFO);
+extern void dsyevd_2stage_(const char *JOBZ, const char *UPLO, const int *N,
+                           double *A, const int *LDA, double *W,
+                           double *WORK, const int *LWORK,
+                           int *IWORK, const int *LIWORK, int *INFO);
+extern void dsyevr_(const char *JOBZ, const char *RANGE, const char *UPLO, const int *N,
+                    double *A, const int *LDA, const double *VL, const double *VU,
+                    const int *IL, const int *IU, const double *ABSTOL,
+                    int *M, double *W, double *Z, const int *LDZ, int *ISUPPZ,
+                    double *WORK, const int *LWORK, int *IWORK, const int *LIWORK,
+                    int *INFO);
+extern void dsyevx_(const char *JOBZ, const char *RANGE, const char *UPLO, const int *N,
+                    double *A, const int *LDA, const double *VL, const double *VU,
+                    const int *IL, const int *IU, const double *ABSTOL,
+                    int *M, double *W, double *Z, const int *LDZ,
+                    double *WORK, const int *LWORK, int *IWORK, int *IFAIL,
+                    int *INFO);
+
+static const char *NAMES[EIG_PATH_COUNT]    = { "qr", "dc", "mrrr", "bisect", "2stage" };
+static const char *ROUTINES[EIG_PATH_COUNT] = { "DSYEV", "DSYEVD", "DSYEVR", "DSYEVX", "DSYEVD_2STAGE" };
+
+const char *eig_path_name(eig_path_t p)    { return (p >= 0 && p < EIG_PATH_COUNT) ? NAMES[p] : "none"; }
+const char *eig_path_routine(eig_path_t p) { return (p >= 0 && p < EIG_PATH_COUNT) ? ROUTINES[p] : "-"; }
+
+eig_path_t eig_path_from_string(const char *s)
+{
+    if (!s) return EIG_PATH_NONE;
+    for (int p = 0; p < EIG_PATH_COUNT; ++p)
+        if (strcmp(s, NAMES[p]) == 0) return (eig_path_t)p;
+    return EIG_PATH_NONE;
+}
+
+int eig_path_supports(eig_path_t p, char jobz, int partial)
+{
+    switch (p) {
+        case EIG_PATH_QR:
+        case EIG_PATH_DC:     return 1;                 /* full spectrum, caller keeps nev */
+        case EIG_PATH_MRRR:   return 1;
+        case EIG_PATH_BISECT: return partial;           /* only worth it for subsets */
+        case EIG_PATH_2STAGE: return jobz == 'N';       /* LAPACK: JOBZ='V' not implemented */
+        default:              return 0;
+    }
+}
+
+static int subset_path(eig_path_t p) { return p == EIG_PATH_MRRR || p == EIG_PATH_BISECT; }
+
+static int req_nev(const eig_request_t *rq) { return (rq->nev <= 0 || rq->nev > rq->n) ? rq->n : rq->nev; }
+
+static int env_threads(void)
+{
+    const char *v = getenv("OPENBLAS_NUM_THREADS");
+    if (!v || !*v) v = getenv("OMP_NUM_THREADS");
+    int t = (v && *v) ? atoi(v) : 1;
+    return t > 0 ? t : 1;
+}
+
+/* ---------------- tuning table ---------------- */
+
+const char *eig_tuning_path(const char *backend)
+{
+    static char buf[4096];
+    const char *p = getenv("EIG_TUNING");
+    if (p && *p) return p;
+    if (!backend || !*backend) backend = "unknown";
+    const char *xdg = getenv("XDG_CACHE_HOME");
+    if (xdg && *xdg) { snprintf(buf, sizeof(buf), "%s/eig_tuning-%s.txt", xdg, backend); return buf; }
+    const char *home = getenv("HOME");
+    snprintf(buf, sizeof(buf), "%s/.cache/eig_tuning-%s.txt", (home && *home) ? home : ".", backend);
+    return buf;
+}
+
+void eig_tuning_stamp(eig_tuning_t *t, const char *backend)
+{
+    if (gethostname(t->host, sizeof(t->host)) != 0) strcpy(t->host, "?");
+    t->host[sizeof(t->host)-1] = '\0';
+    strcpy(t->cpu, "?");
+    FILE *f = fopen("/proc/cpuinfo", "r");
+    if (f) {
+        char line[512];
+        while (fgets(line, sizeof(line), f)) {
+            /* x86: "model name", Arm: "CPU part" */
+            if (strncmp(line, "model name", 10) == 0 || strncmp(line, "CPU part", 8) == 0) {
+                char *c = strchr(line, ':');
+                if (!c) continue;
+                c += 1 + strspn(c + 1, " \t");
+                c[strcspn(c, "\n")] = '\0';
+                for (char *q = c; *q; ++q) if (*q == ' ') *q = '_';
+                snprintf(t->cpu, sizeof(t->cpu), "%s", c);
+                break;
+            }
+        }
+        fclose(f);
+    }
+    snprintf(t->backend, sizeof(t->backend), "%s", backend ? backend : "?");
+}
+
+void eig_tuning_put(eig_tuning_t *t, const eig_point_t *p)
+{
+    for (int i = 0; i < t->npts; ++i) {
+        eig_point_t *q = &t->pts[i];
+        if (q->path == p->path && q->jobz == p->jobz && q->threads == p->threads &&
+            q->n == p->n && q->nev == p->nev) { *q = *p; return; }
+    }
+    if (t->npts == t->cap) {
+        int ncap = t->cap ? 2 * t->cap : 64;
+        eig_point_t *np = (eig_point_t*)realloc(t->pts, (size_t)ncap * sizeof(*np));
+        if (!np) { fprintf(stderr, "[select] OOM\n"); abort(); }
+        t->pts = np; t->cap = ncap;
+    }
+    t->pts[t->npts++] = *p;
+}
+
+void eig_tuning_free(eig_tuning_t *t)
+{
+    free(t->pts);
+    t->pts = NULL; t->npts = t->cap = 0;
+}
+
+int eig_tuning_load(eig_tuning_t *t, const char *path, const char *backend_now, FILE *log)
+{
+    memset(t, 0, sizeof(*t));
+    FILE *f = fopen(path, "r");
+    if (!f) return (errno == ENOENT) ? 1 : -1;
+
+    char line[512], host[64] = "", cpu[128] = "", backend[64] = "";
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#') {
+            sscanf(line, "# host=%63s cpu=%127s backend=%63s", host, cpu, backend);
+            continue;
+        }
+        char name[16], jobz;
+        eig_point_t p;
+        if (sscanf(line, "%15s %c %d %d %d %lf", name, &jobz, &p.threads, &p.n, &p.nev, &p.seconds) != 6)
+            continue;
+        p.path = eig_path_from_string(name);
+        p.jobz = jobz;
+        if (p.path != EIG_PATH_NONE && p.n > 0 && p.seconds > 0.0) eig_tuning_put(t, &p);
+    }
+    fclose(f);
+
+    /* timings of another BLAS/LAPACK say nothing about this one */
+    if (backend_now && backend[0] && strcmp(backend, backend_now) != 0) {
+        if (log) fprintf(log, "[select] %s was calibrated with backend=%s, this is backend=%s: "
+                              "ignoring its %d points\n", path, backend, backend_now, t->npts);
+        eig_tuning_free(t);
+        eig_tuning_stamp(t, backend_now);
+        return 2;
+    }
+    eig_tuning_stamp(t, backend_now ? backend_now : backend);
+    if (log && cpu[0] && (strcmp(cpu, t->cpu) != 0 || strcmp(host, t->host) != 0))
+        fprintf(log, "[select] %s was calibrated on host=%s cpu=%s (this is host=%s cpu=%s); "
+                     "re-run calibrate for this machine\n", path, host, cpu, t->host, t->cpu);
+    return 0;
+}
+
+/* mkdir for the last directory component only (e.g. ~/.cache) */
+static void ensure_parent_dir(const char *path)
+{
+    char dir[4096];
+    snprintf(dir, sizeof(dir), "%s", path);
+    char *slash = strrchr(dir, '/');
+    if (!slash || slash == dir) return;
+    *slash = '\0';
+    if (mkdir(dir, 0777) != 0 && errno != EEXIST) perror("mkdir");
+}
+
+int eig_tuning_save(const eig_tuning_t *t, const char *path)
+{
+    char tmp[4200];
+    snprintf(tmp, sizeof(tmp), "%s.tmp%ld", path, (long)getpid());
+    ensure_parent_dir(path);
+    FILE *f = fopen(tmp, "w");
+    if (!f) { perror("[select] fopen tuning table"); return -1; }
+    fprintf(f, "# eig_tuning v1\n");
+    fprintf(f, "# host=%s cpu=%s backend=%s\n", t->host, t->cpu, t->backend);
+    fprintf(f, "# path jobz threads n nev seconds\n");
+    for (int i = 0; i < t->npts; ++i) {
+        const eig_point_t *p = &t->pts[i];
+        fprintf(f, "%-6s %c %3d %6d %6d %.6e\n", eig_path_name(p->path), p->jobz,
+                p->threads, p->n, p->nev, p->seconds);
+    }
+    if (fclose(f) != 0 || rename(tmp, path) != 0) { perror("[select] write tuning table"); remove(tmp); return -1; }
+    return 0;
+}
+
+/* ---------------- prediction ---------------- */
+
+#define MAX_SAMPLES 256
+
+/* log-log piecewise-linear time(n) through the samples (sorted by n);
+   n^3 scaling from the nearest point outside the measured range */
+static double interp_loglog(const int *ns, const double *ts, int k, int n)
+{
+    if (k == 0) return -1.0;
+    if (n <= ns[0])   return ts[0]   * pow((double)n / ns[0], 3.0);
+    if (n >= ns[k-1]) return ts[k-1] * pow((double)n / ns[k-1], 3.0);
+    for (int i = 1; i < k; ++i) {
+        if (n <= ns[i]) {
+            double x = (log((double)n) - log((double)ns[i-1])) / (log((double)ns[i]) - log((double)ns[i-1]));
+            return exp(log(ts[i-1]) + x * (log(ts[i]) - log(ts[i-1])));
+        }
+    }
+    return ts[k-1];
+}
+
+/* samples of (path, jobz, threads) whose nev/n is within 1e-3 of `frac` */
+static double predict_at_fraction(const eig_tuning_t *t, eig_path_t p, char jobz,
+                                  int threads, double frac, int n)
+{
+    int ns[MAX_SAMPLES]; double ts[MAX_SAMPLES]; int k = 0;
+    for (int i = 0; i < t->npts && k < MAX_SAMPLES; ++i) {
+        const eig_point_t *q = &t->pts[i];
+        if (q->path != p || q->jobz != jobz || q->threads != threads) continue;
+        if (fabs((double)q->nev / q->n - frac) > 1e-3) continue;
+        /* insertion by n */
+        int j = k++;
+        while (j > 0 && ns[j-1] > q->n) { ns[j] = ns[j-1]; ts[j] = ts[j-1]; --j; }
+        ns[j] = q->n; ts[j] = q->seconds;
+    }
+    return interp_loglog(ns, ts, k, n);
+}
+
+double eig_predict(const eig_tuning_t *t, eig_path_t p, const eig_request_t *rq)
+{
+    if (!t || t->npts == 0) return -1.0;
+    const int nev = req_nev(rq);
+    if (!eig_path_supports(p, rq->jobz, nev < rq->n)) return -1.0;
+    const int want_threads = rq->threads > 0 ? rq->threads : env_threads();
+
+    /* nearest measured thread count (in ratio) */
+    int threads = -1; double best = 1e300;
+    for (int i = 0; i < t->npts; ++i) {
+        const eig_point_t *q = &t->pts[i];
+        if (q->path != p || q->jobz != rq->jobz) continue;
+        double d = fabs(log((double)q->threads / want_threads));
+        if (d < best) { best = d; threads = q->threads; }
+    }
+    if (threads < 0) return -1.0;
+
+    if (!subset_path(p)) return predict_at_fraction(t, p, rq->jobz, threads, 1.0, rq->n);
+
+    /* subset paths: bracket nev/n between measured fractions, linear in between */
+    const double f = (double)nev / rq->n;
+    double flo = -1.0, fhi = 2.0;
+    for (int i = 0; i < t->npts; ++i) {
+        const eig_point_t *q = &t->pts[i];
+        if (q->path != p || q->jobz != rq->jobz || q->threads != threads) continue;
+        double qf = (double)q->nev / q->n;
+        if (qf <= f + 1e-3 && qf > flo) flo = qf;
+        if (qf >= f - 1e-3 && qf < fhi) fhi = qf;
+    }
+    if (flo < 0.0 && fhi > 1.5) return -1.0;
+    if (flo < 0.0) flo = fhi;
+    if (fhi > 1.5) fhi = flo;
+    double tlo = predict_at_fraction(t, p, rq->jobz, threads, flo, rq->n);
+    double thi = predict_at_fraction(t, p, rq->jobz, threads, fhi, rq->n);
+    if (fhi - flo < 1e-9) return tlo;
+    return tlo + (thi - tlo) * (f - flo) / (fhi - flo);
+}
+
+size_t eig_path_bytes(eig_path_t p, const eig_request_t *rq)
+{
+    const int n = rq->n, nev = req_nev(rq);
+    const int lda = n > 1 ? n : 1;
+    const char jobz = rq->jobz, uplo = 'U';
+    const int vec = (jobz == 'V');
+    int info = 0, lq = -1, liq = -1, iwq = 0, m = 0, il = 1, iu = nev > 0 ? nev : 1, isz = 0;
+    double wq = 0.0, dummy = 0.0, vl = 0.0, vu = 0.0, abstol = 0.0;
+    const char range = (nev < n) ? 'I' : 'A';
+
+    size_t bytes = ((size_t)n * n + (size_t)n) * sizeof(double);        /* A + W */
+    switch (p) {
+    case EIG_PATH_QR:
+        dsyev_(&jobz, &uplo, &n, &dummy, &lda, &dummy, &wq, &lq, &info);
+        break;
+    case EIG_PATH_DC:
+        dsyevd_(&jobz, &uplo, &n, &dummy, &lda, &dummy, &wq, &lq, &iwq, &liq, &info);
+        break;
+    case EIG_PATH_2STAGE:
+        dsyevd_2stage_(&jobz, &uplo, &n, &dummy, &lda, &dummy, &wq, &lq, &iwq, &liq, &info);
+        break;
+    case EIG_PATH_MRRR:
+        dsyevr_(&jobz, &range, &uplo, &n, &dummy, &lda, &vl, &vu, &il, &iu, &abstol,
+                &m, &dummy, &dummy, &lda, &isz, &wq, &lq, &iwq, &liq, &info);
+        bytes += (vec ? (size_t)n * nev * sizeof(double) : 0) + 2 * (size_t)nev * sizeof(int);
+        break;
+    case EIG_PATH_BISECT:
+        dsyevx_(&jobz, &range, &uplo, &n, &dummy, &lda, &vl, &vu, &il, &iu, &abstol,
+                &m, &dummy, &dummy, &lda, &wq, &lq, &isz, &isz, &info);
+        iwq = 6 * n;                                                   /* IWORK 5n + IFAIL n */
+        bytes += vec ? (size_t)n * nev * sizeof(double) : 0;
+        break;
+    default:
+        return (size_t)-1;
+    }
+    if (info != 0) return (size_t)-1;
+    if (p == EIG_PATH_DC) wq = eig_dsyevd_lwork(jobz, n, wq);
+    int lw = 0;
+    if (eig_lwork_int(wq, &lw) != 0) return (size_t)-1;              /* LP64 LWORK cannot express it */
+    return bytes + (size_t)lw * sizeof(double) + (size_t)iwq * sizeof(int);
+}
+
+eig_path_t eig_select(const eig_request_t *rq, const eig_tuning_t *t, FILE *log)
+{
+    const int nev = req_nev(rq), partial = nev < rq->n;
+    double pred[EIG_PATH_COUNT];
+    size_t bytes[EIG_PATH_COUNT];
+    int ok[EIG_PATH_COUNT];
+
+    eig_path_t pick = EIG_PATH_NONE;
+    for (int p = 0; p < EIG_PATH_COUNT; ++p) {
+        ok[p] = eig_path_supports((eig_path_t)p, rq->jobz, partial);
+        pred[p] = ok[p] ? eig_predict(t, (eig_path_t)p, rq) : -1.0;
+        bytes[p] = ok[p] ? eig_path_bytes((eig_path_t)p, rq) : (size_t)-1;
+        if (ok[p] && bytes[p] == (size_t)-1) ok[p] = 0;
+        if (ok[p] && rq->budget && bytes[p] > rq->budget) ok[p] = 0;
+        if (ok[p] && pred[p] >= 0.0 && (pick == EIG_PATH_NONE || pred[p] < pred[pick])) pick = (eig_path_t)p;
+    }
+
+    /* no measurements: measured crossovers from the thesis table */
+    const char *why = "tuning table";
+    if (pick == EIG_PATH_NONE) {
+        static const eig_path_t subset_order[] = { EIG_PATH_MRRR, EIG_PATH_BISECT, EIG_PATH_DC, EIG_PATH_QR };
+        static const eig_path_t full_order[]   = { EIG_PATH_DC, EIG_PATH_MRRR, EIG_PATH_QR };
+        const int use_subset = partial && rq->jobz == 'V' && 10 * nev <= rq->n;
+        const eig_path_t *order = use_subset ? subset_order : full_order;
+        const int norder = use_subset ? 4 : 3;
+        for (int i = 0; i < norder && pick == EIG_PATH_NONE; ++i)
+            if (ok[order[i]]) pick = order[i];
+        why = "default crossovers (no tuning data)";
+    }
+
+    if (log) {
+        fprintf(log, "[select] n=%d jobz=%c nev=%d threads=%d budget=", rq->n, rq->jobz, nev,
+                rq->threads > 0 ? rq->threads : env_threads());
+        if (rq->budget) fprintf(log, "%.1f MB\n", rq->budget / 1048576.0); else fprintf(log, "unlimited\n");
+        for (int p = 0; p < EIG_PATH_COUNT; ++p) {
+            fprintf(log, "[select]   %-6s %-14s ", eig_path_name((eig_path_t)p), eig_path_routine((eig_path_t)p));
+            if (!eig_path_supports((eig_path_t)p, rq->jobz, partial)) { fprintf(log, "n/a for this job\n"); continue; }
+            if (pred[p] >= 0.0) fprintf(log, "pred=%10.4f s ", pred[p]); else fprintf(log, "pred=         ? ");
+            if (bytes[p] != (size_t)-1) fprintf(log, "mem=%9.1f MB", bytes[p] / 1048576.0);
+            else                        fprintf(log, "mem=        ?   ");
+            fprintf(log, "%s%s\n", ok[p] ? "" : bytes[p] == (size_t)-1 ? "  (LWORK > INT_MAX or query failed)" :
+                    "  (over budget)", p == pick ? "  <- selected" : "");
+        }
+        fprintf(log, "[select] -> %s (%s)\n", eig_path_routine(pick), why);
+    }
+    return pick;
+}
+
+/* ---------------- execution ---------------- */
+
+int eig_run(eig_path_t p, char jobz, char uplo, int n, double *A, int lda, int nev,
+            double *W, double *Z, int ldz, int *m)
+{
+    const int k = (nev <= 0 || nev > n) ? n : nev;
+    const char range = (k < n) ? 'I' : 'A';
+    const double vl = 0.0, vu = 0.0, abstol = 0.0;
+    const int il = 1, iu = k > 0 ? k : 1;
+    const int zld = (jobz == 'V') ? ldz : 1;
+    int info = 0, lwork = -1, liwork = -1, iwq = 0;
+    double wq = 0.0, dummy = 0.0;
+    *m = 0;
+
+    /* workspace query */
+    switch (p) {
+    case EIG_PATH_QR:     dsyev_(&jobz, &uplo, &n, A, &lda, W, &wq, &lwork, &info); break;
+    case EIG_PATH_DC:     dsyevd_(&jobz, &uplo, &n, A, &lda, W, &wq, &lwork, &iwq, &liwork, &info); break;
+    case EIG_PATH_2STAGE: dsyevd_2stage_(&jobz, &uplo, &n, A, &lda, W, &wq, &lwork, &iwq, &liwork, &info); break;
+    case EIG_PATH_MRRR: {
+        int isz = 0;
+        dsyevr_(&jobz, &range, &uplo, &n, A, &lda, &vl, &vu, &il, &iu, &abstol,
+                m, W, Z ? Z : &dummy, &zld, &isz, &wq, &lwork, &iwq, &liwork, &info);
+        break;
+    }
+    case EIG_PATH_BISECT: {
+        int isz = 0;
+        dsyevx_(&jobz, &range, &uplo, &n, A, &lda, &vl, &vu, &il, &iu, &abstol,
+                m, W, Z ? Z : &dummy, &zld, &wq, &lwork, &isz, &isz, &info);
+        iwq = 5 * n;
+        break;
+    }
+    default: return -1;
+    }
+    if (info != 0) return info;
+
+    if (p == EIG_PATH_DC) wq = eig_dsyevd_lwork(jobz, n, wq);
+    if (eig_lwork_int(wq, &lwork) != 0) {
+        fprintf(stderr, "[select] %s n=%d: LWORK %.0f exceeds INT_MAX\n", eig_path_routine(p), n, wq);
+        return -101;
+    }
+    liwork = iwq;     if (liwork < 1) liwork = 1;
+    double *WORK  = (double*)malloc((size_t)lwork * sizeof(double));
+    int    *IWORK = (int*)malloc((size_t)liwork * sizeof(int));
+    int    *AUX   = (int*)malloc(2 * (size_t)(n > 0 ? n : 1) * sizeof(int));   /* ISUPPZ / IFAIL */
+    if (!WORK || !IWORK || !AUX) { free(AUX); free(IWORK); free(WORK); return -100; }
+
+    switch (p) {
+    case EIG_PATH_QR:
+        dsyev_(&jobz, &uplo, &n, A, &lda, W, WORK, &lwork, &info);
+        *m = n;
+        break;
+    case EIG_PATH_DC:
+        dsyevd_(&jobz, &uplo, &n, A, &lda, W, WORK, &lwork, IWORK, &liwork, &info);
+        *m = n;
+        break;
+    case EIG_PATH_2STAGE:
+        dsyevd_2stage_(&jobz, &uplo, &n, A, &lda, W, WORK, &lwork, IWORK, &liwork, &info);
+        *m = n;
+        break;
+    case EIG_PATH_MRRR:
+        dsyevr_(&jobz, &range, &uplo, &n, A, &lda, &vl, &vu, &il, &iu, &abstol,
+                m, W, Z ? Z : &dummy, &zld, AUX, WORK, &lwork, IWORK, &liwork, &info);
+        break;
+    case EIG_PATH_BISECT:
+        dsyevx_(&jobz, &range, &uplo, &n, A, &lda, &vl, &vu, &il, &iu, &abstol,
+                m, W, Z ? Z : &dummy, &zld, WORK, &lwork, IWORK, AUX, &info);
+        break;
+    default: break;
+    }
+    free(AUX); free(IWORK); free(WORK);
+
+    /* full-spectrum paths: keep the first k pairs; vectors are in A */
+    if (info == 0 && (p == EIG_PATH_QR || p == EIG_PATH_DC || p == EIG_PATH_2STAGE)) {
+        *m = k;
+        if (jobz == 'V' && Z && Z != A)
+            for (int j = 0; j < k; ++j)
+                memcpy(Z + (size_t)j * ldz, A + (size_t)j * lda, (size_t)n * sizeof(double));
+    }
+    return info;
+}
@@ -0,0 +1,102 @@
+// eig_select.h — pick a dense symmetric eigensolver from measured timings.
+//
+// Paths (all LAPACK, column-major, smallest `nev` eigenpairs when nev < n):
+//   qr      DSYEV          full spectrum, implicit QL/QR
+//   dc      DSYEVD         full spectrum, divide & conquer
+//   mrrr    DSYEVR         RANGE='I' subset or full, relatively robust reps.
+//   bisect  DSYEVX         RANGE='I' subset, bisection + inverse iteration
+//   2stage  DSYEVD_2STAGE  full spectrum, band reduction first (JOBZ='N' only)
+//
+// The tuning table is a plain-text file of measured points
+//   <path> <jobz> <threads> <n> <nev> <seconds>
+// written by `select_run calibrate` (Code/SELECT) on the target machine and
+// merged on every calibration, so it persists between runs. Location:
+// $EIG_TUNING, else $XDG_CACHE_HOME/eig_tuning-<backend>.txt, else
+// ~/.cache/eig_tuning-<backend>.txt, so each BLAS/LAPACK build keeps its own
+// table. A table stamped with another backend is not used.
+//
+// eig_select() predicts each path's time for the request by log-log
+// interpolation in n (nearest measured thread count, linear in nev/n for the
+// subset paths), drops paths whose workspace exceeds the memory budget and
+// returns the fastest. Without table data it falls back to the crossovers
+// in Thesis/chapter1/output/result_table.txt: D&C for full spectra, MRRR
+// for small subsets with vectors.
+
+#ifndef EIG_SELECT_H
+#define EIG_SELECT_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+typedef enum {
+    EIG_PATH_QR = 0,
+    EIG_PATH_DC,
+    EIG_PATH_MRRR,
+    EIG_PATH_BISECT,
+    EIG_PATH_2STAGE,
+    EIG_PATH_COUNT,
+    EIG_PATH_NONE = -1
+} eig_path_t;
+
+typedef struct {
+    int    n;
+    char   jobz;      /* 'N' or 'V' */
+    int    nev;       /* smallest nev eigenpairs; <= 0 or >= n means all */
+    int    threads;   /* BLAS threads the solve will use; 0 = from environment */
+    size_t budget;    /* bytes the solve may hold (A + W + Z + workspace); 0 = unlimited */
+} eig_request_t;
+
+typedef struct {
+    eig_path_t path;
+    char   jobz;
+    int    threads;
+    int    n;
+    int    nev;
+    double seconds;
+} eig_point_t;
+
+typedef struct {
+    eig_point_t *pts;
+    int    npts, cap;
+    char   host[64];
+    char   cpu[128];
+    char   backend[64];
+} eig_tuning_t;
+
+const char *eig_path_name(eig_path_t p);        /* "qr", "dc", ...      */
+const char *eig_path_routine(eig_path_t p);     /* "DSYEV", "DSYEVD", ... */
+eig_path_t  eig_path_from_string(const char *s);
+
+/* 1 if `p` can serve (jobz, nev < n) at all. */
+int  eig_path_supports(eig_path_t p, char jobz, int partial);
+
+/* Tuning table. load: 0 ok, 1 no file (empty table), 2 the file was
+   calibrated with another backend than `backend` (empty table, stamped
+   with `backend`), <0 error. The header records host/CPU/backend; a
+   host/CPU mismatch is only reported on `log`. */
+const char *eig_tuning_path(const char *backend);
+int  eig_tuning_load(eig_tuning_t *t, const char *path, const char *backend, FILE *log);
+int  eig_tuning_save(const eig_tuning_t *t, const char *path);
+void eig_tuning_put(eig_tuning_t *t, const eig_point_t *p);   /* insert or replace */
+void eig_tuning_free(eig_tuning_t *t);
+void eig_tuning_stamp(eig_tuning_t *t, const char *backend); /* fill host/cpu/backend */
+
+/* Predicted seconds for `p`, < 0 when the table has nothing for it. */
+double eig_predict(const eig_tuning_t *t, eig_path_t p, const eig_request_t *rq);
+
+/* Bytes `p` needs for the request (LAPACK workspace queries); (size_t)-1
+   when the query fails or LWORK would exceed INT_MAX. */
+size_t eig_path_bytes(eig_path_t p, const eig_request_t *rq);
+
+/* The selector. The candidate table (time, bytes, verdict) goes to `log`. */
+eig_path_t eig_select(const eig_request_t *rq, const eig_tuning_t *t, FILE *log);
+
+/* Run `p` on A (overwritten). W needs n entries; the nev (or n) eigenvectors
+   land in Z (n x m, ldz >= n) for JOBZ='V'. The full-spectrum paths compute
+   in A; pass Z == A to skip the copy (eig_path_bytes assumes that).
+   Returns LAPACK INFO, -100 on allocation failure or -101 when the
+   workspace exceeds a 32-bit LWORK; *m is the number of eigenpairs delivered. */
+int  eig_run(eig_path_t p, char jobz, char uplo, int n, double *A, int lda, int nev,
+             double *W, double *Z, int ldz, int *m);
+
+#endif /* EIG_SELECT_H */
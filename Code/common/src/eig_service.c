@@ -0,0 +1,117 @@
+// eig_service.c — memfd buffers and descriptor passing for the eigensolver
+// service (see eig_service.h).
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "eig_service.h"
+
+size_t eig_svc_buffer_bytes(int n)
+{
+    return ((size_t)n * n + (size_t)n) * sizeof(double);
+}
+
+int eig_svc_buffer_create(int n, double **A)
+{
+    *A = NULL;
+    if (n <= 0) return -1;
+    const size_t bytes = eig_svc_buffer_bytes(n);
+    int fd = memfd_create("eig_job", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0) { perror("memfd_create"); return -1; }
+    if (ftruncate(fd, (off_t)bytes) != 0) { perror("ftruncate"); close(fd); return -1; }
+    /* the server maps these pages: a shrink would SIGBUS it mid-solve */
+    if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_SEAL) != 0) { perror("F_ADD_SEALS"); close(fd); return -1; }
+    void *p = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) { perror("mmap"); close(fd); return -1; }
+    *A = (double*)p;
+    return fd;
+}
+
+void eig_svc_buffer_free(int fd, double *A, int n)
+{
+    if (A) munmap(A, eig_svc_buffer_bytes(n));
+    if (fd >= 0) close(fd);
+}
+
+const char *eig_svc_socket_path(const char *path)
+{
+    if (path && *path) return path;
+    const char *env = getenv("EIG_SOCKET");
+    return (env && *env) ? env : EIG_SVC_SOCKET;
+}
+
+int eig_svc_connect(const char *path)
+{
+    path = eig_svc_socket_path(path);
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) { fprintf(stderr, "[eig_svc] socket path too long\n"); return -1; }
+    strcpy(addr.sun_path, path);
+    int s = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (s < 0) { perror("socket"); return -1; }
+    if (connect(s, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        fprintf(stderr, "[eig_svc] connect %s: %s\n", path, strerror(errno));
+        close(s);
+        return -1;
+    }
+    return s;
+}
+
+int eig_svc_send(int sock, const void *buf, size_t len, int fd)
+{
+    const char *p = (const char*)buf;
+    while (len > 0) {
+        struct iovec iov = { (void*)p, len };
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = &iov; msg.msg_iovlen = 1;
+        union { struct cmsghdr h; char buf[CMSG_SPACE(sizeof(int))]; } ctl;
+        if (fd >= 0) {                                   /* only with the first byte */
+            memset(&ctl, 0, sizeof(ctl));
+            msg.msg_control = ctl.buf; msg.msg_controllen = sizeof(ctl.buf);
+            struct cmsghdr *c = CMSG_FIRSTHDR(&msg);
+            c->cmsg_level = SOL_SOCKET; c->cmsg_type = SCM_RIGHTS;
+            c->cmsg_len = CMSG_LEN(sizeof(int));
+            memcpy(CMSG_DATA(c), &fd, sizeof(int));
+        }
+        ssize_t k = sendmsg(sock, &msg, MSG_NOSIGNAL);
+        if (k < 0 && errno == EINTR) continue;
+        if (k <= 0) return -1;
+        p += k; len -= (size_t)k; fd = -1;
+    }
+    return 0;
+}
+
+int eig_svc_recv(int sock, void *buf, size_t len, int *fd)
+{
+    char *p = (char*)buf;
+    if (fd) *fd = -1;
+    while (len > 0) {
+        struct iovec iov = { p, len };
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = &iov; msg.msg_iovlen = 1;
+        union { struct cmsghdr h; char buf[CMSG_SPACE(sizeof(int))]; } ctl;
+        msg.msg_control = ctl.buf; msg.msg_controllen = sizeof(ctl.buf);
+        ssize_t k = recvmsg(sock, &msg, MSG_CMSG_CLOEXEC);
+        if (k < 0 && errno == EINTR) continue;
+        if (k <= 0) return -1;
+        for (struct cmsghdr *c = CMSG_FIRSTHDR(&msg); c; c = CMSG_NXTHDR(&msg, c))
+            if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SCM_RIGHTS) {
+                int got;
+                memcpy(&got, CMSG_DATA(c), sizeof(int));
+                if (fd && *fd < 0) *fd = got; else close(got);  /* unexpected: don't leak */
+            }
+        p += k; len -= (size_t)k;
+    }
+    return 0;
+}
@@ -0,0 +1,63 @@
+// eig_service.h — wire protocol of the persistent eigensolver service
+// (SERVICE/src/eig_server.c): jobs go over a Unix stream socket, the matrix
+// does not. The client puts A in a memfd (eig_svc_buffer_create), sends a
+// fixed-size request with the descriptor attached (SCM_RIGHTS), the server
+// maps the same pages and runs DSYEVD on them in place: eigenvectors
+// overwrite A, eigenvalues land in the W area behind it. The reply carries
+// the job's timings only.
+//
+// Buffer layout (eig_svc_buffer_bytes(n)): A n x n column-major, lda = n,
+// then W[n]. Both sides map it MAP_SHARED; the client must not touch the
+// buffer between sending a job and receiving its reply. The memfd must be
+// sealed against shrinking (F_SEAL_SHRINK, as eig_svc_buffer_create does):
+// the server rejects other descriptors, since a client truncating the file
+// under the solver's mapping would kill the server with SIGBUS.
+
+#ifndef EIG_SERVICE_H
+#define EIG_SERVICE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define EIG_SVC_MAGIC   0x31474945u          /* "EIG1" */
+#define EIG_SVC_SOCKET  "/tmp/eig_service.sock"
+
+enum { EIG_SVC_SOLVE = 1, EIG_SVC_STATS = 2, EIG_SVC_SHUTDOWN = 3 };
+
+typedef struct {
+    uint32_t magic, op;
+    uint64_t id;                 /* echoed in the reply                          */
+    int32_t  n;
+    char     jobz;               /* 'V': vectors into A, 'N': eigenvalues only   */
+    char     pad[3];
+} eig_svc_req_t;
+
+typedef struct {
+    uint64_t id;
+    int32_t  info;               /* DSYEVD INFO, or -1: bad request / buffer     */
+    int32_t  n;
+    double   queue_s;            /* received -> picked up by a solver worker     */
+    double   setup_s;            /* workspace allocation (0 when warm)            */
+    double   solve_s;            /* DSYEVD                                        */
+    double   server_s;           /* received -> reply sent                        */
+} eig_svc_rep_t;
+
+/* Bytes of the shared buffer for order n. */
+size_t eig_svc_buffer_bytes(int n);
+
+/* memfd of eig_svc_buffer_bytes(n), sealed against shrinking, mapped
+   read/write into *A (W = A + n*n). Returns the descriptor or -1. */
+int  eig_svc_buffer_create(int n, double **A);
+void eig_svc_buffer_free(int fd, double *A, int n);
+
+/* Connected socket to path (NULL: EIG_SOCKET or EIG_SVC_SOCKET), or -1. */
+int  eig_svc_connect(const char *path);
+const char *eig_svc_socket_path(const char *path);
+
+/* Full-length send / receive of len bytes; fd >= 0 rides along as
+   SCM_RIGHTS on send, *fd receives it (or -1) on recv. 0, or -1 on error
+   or EOF. */
+int  eig_svc_send(int sock, const void *buf, size_t len, int fd);
+int  eig_svc_recv(int sock, void *buf, size_t len, int *fd);
+
+#endif /* EIG_SERVICE_H */
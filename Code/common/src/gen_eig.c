@@ -0,0 +1,101 @@
+// gen_eig.c — A x = lambda B x via DPOTRF / DSYGST / DSYEVD / DTRSM (see gen_eig.h).
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gen_eig.h"
+#include "now_sec.h"
+#include "eig_cache.h"
+
+extern void dpotrf_(const char *UPLO, const int *N, double *A, const int *LDA, int *INFO);
+extern void dsygst_(const int *ITYPE, const char *UPLO, const int *N, double *A, const int *LDA,
+                    const double *B, const int *LDB, int *INFO);
+extern void dsyevd_(const char *JOBZ, const char *UPLO, const int *N,
+                    double *A, const int *LDA, double *W,
+                    double *WORK, const int *LWORK,
+                    int *IWORK, const int *LIWORK,
+                    int *INFO);
+extern void dtrsm_(const char *SIDE, const char *UPLO, const char *TRANSA, const char *DIAG,
+                   const int *M, const int *N, const double *ALPHA, const double *A, const int *LDA,
+                   double *B, const int *LDB);
+
+int gen_eig_factor(gen_eig_factor_t *f, int n, const double *B, int ldb, char uplo, const char *backend)
+{
+    memset(f, 0, sizeof(*f));
+    f->n = n; f->ldu = n; f->uplo = uplo;
+    const size_t nn = (size_t)n * (size_t)n;
+    f->U = (double*)malloc(nn * sizeof(double));
+    if (!f->U) { f->stage = "malloc"; return -1; }
+
+    const int use_cache = eig_cache_enabled() && eig_cache_vectors() > 0;
+    uint64_t key = 0;
+    if (use_cache) {
+        key = eig_cache_key_stage(eig_cache_key_matrix(n, B, ldb, uplo, backend), "potrf", uplo);
+        eig_cache_field_t fu[1] = { { "U", f->U, nn, 0 } };
+        if (eig_cache_load("potrf", key, fu, 1) >= 0 && fu[0].found) { f->from_cache = 1; return 0; }
+    }
+
+    for (int j = 0; j < n; ++j)
+        memcpy(f->U + (size_t)j * n, B + (size_t)j * ldb, (size_t)n * sizeof(double));
+    int info = 0;
+    const double t0 = now_sec();
+    dpotrf_(&uplo, &n, f->U, &f->ldu, &info);
+    f->time_potrf = now_sec() - t0;
+    if (info != 0) { f->stage = "DPOTRF"; return info; }
+
+    if (use_cache) {
+        const eig_cache_field_t fu[1] = { { "U", f->U, nn, 0 } };
+        eig_cache_store("potrf", key, fu, 1);
+    }
+    return 0;
+}
+
+int gen_eig_solve(const gen_eig_factor_t *f, double *A, int lda, double *W, char jobz, gen_eig_times_t *t)
+{
+    memset(t, 0, sizeof(*t));
+    const int n = f->n, itype = 1;
+    int info = 0;
+
+    /* ---- 2) C = U^-T A U^-1 in place ---- */
+    double t0 = now_sec();
+    dsygst_(&itype, &f->uplo, &n, A, &lda, f->U, &f->ldu, &info);
+    t->sygst = now_sec() - t0;
+    if (info != 0) { t->stage = "DSYGST"; return info; }
+
+    /* ---- 3) D&C on C (workspace outside the clock) ---- */
+    int lwork = -1, liwork = -1, iwkopt = 0;
+    double wkopt = 0.0;
+    dsyevd_(&jobz, &f->uplo, &n, A, &lda, W, &wkopt, &lwork, &iwkopt, &liwork, &info);
+    if (info != 0) { t->stage = "DSYEVD"; return info; }
+    lwork  = (int)wkopt > 0 ? (int)wkopt : 1;
+    liwork = iwkopt > 0 ? iwkopt : 1;
+    double *WORK = (double*)malloc((size_t)lwork * sizeof(double));
+    int *IWORK = (int*)malloc((size_t)liwork * sizeof(int));
+    if (!WORK || !IWORK) { free(IWORK); free(WORK); t->stage = "malloc"; return -1; }
+    t->lwork = lwork; t->liwork = liwork;
+    t0 = now_sec();
+    dsyevd_(&jobz, &f->uplo, &n, A, &lda, W, WORK, &lwork, IWORK, &liwork, &info);
+    t->syevd = now_sec() - t0;
+    free(IWORK); free(WORK);
+    if (info != 0) { t->stage = "DSYEVD"; return info; }
+
+    /* ---- 4) X = U^-1 Y  (L^-T Y) ---- */
+    if (jobz == 'V' || jobz == 'v') {
+        const char side = 'L', diag = 'N';
+        const char trans = (f->uplo == 'U' || f->uplo == 'u') ? 'N' : 'T';
+        const double one = 1.0;
+        t0 = now_sec();
+        dtrsm_(&side, &f->uplo, &trans, &diag, &n, &n, &one, f->U, &f->ldu, A, &lda);
+        t->trsm = now_sec() - t0;
+    }
+    t->total = t->sygst + t->syevd + t->trsm;
+    return 0;
+}
+
+void gen_eig_free(gen_eig_factor_t *f)
+{
+    free(f->U);
+    f->U = NULL;
+}
@@ -0,0 +1,45 @@
+// gen_eig.h — generalized symmetric-definite eigenproblem A x = lambda B x
+// (ITYPE 1, as DSYGVD) as four separately timed stages:
+//   1. DPOTRF   B = U^T U (UPLO='U') or L L^T (UPLO='L')
+//   2. DSYGST   C = U^-T A U^-1 (L^-1 A L^-T), blocked: DTRSM / DSYMM / DSYR2K
+//   3. DSYEVD   C = Y diag(W) Y^T, divide & conquer
+//   4. DTRSM    X = U^-1 Y (L^-T Y), JOBZ='V' only; B-orthonormal X
+// Stage 1 lives in a gen_eig_factor_t that is built once and reused for any
+// number of A matrices with the same B (stages 2-4 only read it).
+// gen_eig_factor() looks the factor up in / stores it to the stage cache
+// (eig_cache.h, stage "potrf", keyed by B's bytes) when EIG_CACHE=1, so
+// the factorization is also shared across runs.
+// Errors: functions return 0, or the failing routine's INFO (t->stage /
+// f->stage name the routine); a positive DPOTRF INFO means B is not
+// positive definite. Per-call wrapper timings (wrap_syms.def) come on top
+// when the program is linked with the wrappers.
+
+#ifndef GEN_EIG_H
+#define GEN_EIG_H
+
+typedef struct {
+    int     n, ldu;
+    char    uplo;
+    double *U;              /* n x n factor (the other triangle is untouched) */
+    double  time_potrf;     /* seconds in DPOTRF, 0 on a cache hit            */
+    int     from_cache;     /* 1: loaded from the stage cache                  */
+    const char *stage;      /* failing routine on error                        */
+} gen_eig_factor_t;
+
+typedef struct {
+    double sygst, syevd, trsm, total;   /* seconds; total excludes the factor */
+    int    lwork, liwork;               /* DSYEVD workspace used              */
+    const char *stage;                  /* failing routine on error           */
+} gen_eig_times_t;
+
+/* Copy B (n x n, column-major, referenced triangle `uplo`) and factor it.
+   `backend` goes into the cache key (may be NULL). */
+int  gen_eig_factor(gen_eig_factor_t *f, int n, const double *B, int ldb, char uplo, const char *backend);
+
+/* Solve for one A (overwritten: eigenvectors X for JOBZ='V'); W gets the
+   eigenvalues in ascending order. */
+int  gen_eig_solve(const gen_eig_factor_t *f, double *A, int lda, double *W, char jobz, gen_eig_times_t *t);
+
+void gen_eig_free(gen_eig_factor_t *f);
+
+#endif /* GEN_EIG_H */
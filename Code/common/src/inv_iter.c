@@ -0,0 +1,151 @@
+// inv_iter.c — cluster-parallel inverse iteration on top of DSTEIN (see inv_iter.h).
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "inv_iter.h"
+#include "now_sec.h"
+
+extern void dstein_(const int *N, const double *D, const double *E, const int *M,
+                    const double *W, const int *IBLOCK, const int *ISPLIT,
+                    double *Z, const int *LDZ, double *WORK, int *IWORK,
+                    int *IFAIL, int *INFO);
+
+typedef struct { int j0, m; } cluster_t;      /* W[j0 .. j0+m-1] */
+
+typedef struct {
+    int n, ldz;
+    const double *D, *E, *W;
+    const int *iblock, *isplit;
+    double *Z;
+    const cluster_t *cl;
+    int ncl, maxm;
+    int next;                                  /* next cluster to hand out */
+    int nfail;
+    pthread_mutex_t lock;
+} pool_t;
+
+typedef struct { pool_t *p; double busy; } worker_t;
+
+static void *worker(void *arg)
+{
+    worker_t *w = (worker_t*)arg;
+    pool_t *p = w->p;
+    double *WORK = (double*)malloc(5 * (size_t)p->n * sizeof(double));
+    int *IWORK = (int*)malloc((size_t)p->n * sizeof(int));
+    int *IFAIL = (int*)malloc((size_t)p->maxm * sizeof(int));
+    int nfail = 0;
+    for (;;) {
+        pthread_mutex_lock(&p->lock);
+        const int k = p->next++;
+        pthread_mutex_unlock(&p->lock);
+        if (k >= p->ncl) break;
+        const cluster_t *c = &p->cl[k];
+        if (!WORK || !IWORK || !IFAIL) { nfail += c->m; continue; }
+        int info = 0;
+        const double t0 = now_sec();
+        dstein_(&p->n, p->D, p->E, &c->m, p->W + c->j0, p->iblock + c->j0, p->isplit,
+                p->Z + (size_t)c->j0 * p->ldz, &p->ldz, WORK, IWORK, IFAIL, &info);
+        w->busy += now_sec() - t0;
+        if (info != 0) nfail += info > 0 ? info : c->m;
+    }
+    pthread_mutex_lock(&p->lock);
+    p->nfail += nfail;
+    pthread_mutex_unlock(&p->lock);
+    free(IFAIL); free(IWORK); free(WORK);
+    return NULL;
+}
+
+static int by_size_desc(const void *a, const void *b)
+{
+    const cluster_t *x = (const cluster_t*)a, *y = (const cluster_t*)b;
+    return (y->m > x->m) - (y->m < x->m);
+}
+
+/* DSTEIN's grouping: same block and gap <= 1e-3 * ||T_block||_1 */
+static int make_clusters(const double *D, const double *E, int m, const double *W,
+                         const int *iblock, const int *isplit, cluster_t *cl)
+{
+    int ncl = 0, blk = -1;
+    double ortol = 0.0;
+    for (int j = 0; j < m; ++j) {
+        if (iblock[j] != blk) {                  /* new block: its 1-norm */
+            blk = iblock[j];
+            const int b1 = (blk == 1) ? 0 : isplit[blk - 2], bn = isplit[blk - 1] - 1;
+            double nrm = fabs(D[b1]) + (bn > b1 ? fabs(E[b1]) : 0.0);
+            if (bn > b1) nrm = fmax(nrm, fabs(D[bn]) + fabs(E[bn - 1]));
+            for (int i = b1 + 1; i < bn; ++i) nrm = fmax(nrm, fabs(D[i]) + fabs(E[i - 1]) + fabs(E[i]));
+            ortol = 1e-3 * nrm;
+            cl[ncl].j0 = j; cl[ncl].m = 1; ++ncl;
+        } else if (fabs(W[j] - W[j - 1]) > ortol) {
+            cl[ncl].j0 = j; cl[ncl].m = 1; ++ncl;
+        } else {
+            cl[ncl - 1].m++;
+        }
+    }
+    return ncl;
+}
+
+int inv_iter_vectors(int n, const double *D, const double *E, int m, const double *W,
+                     const int *iblock, const int *isplit, double *Z, int ldz,
+                     int nthreads, inv_iter_stats_t *st)
+{
+    memset(st, 0, sizeof(*st));
+    if (n < 1 || m < 1 || m > n || ldz < n) return -1;
+
+    /* DSTERF-style input: one block, all values in it */
+    int *ib_own = NULL, is_own[1] = { n };
+    if (!iblock) {
+        ib_own = (int*)malloc((size_t)m * sizeof(int));
+        if (!ib_own) return -1;
+        for (int j = 0; j < m; ++j) ib_own[j] = 1;
+        iblock = ib_own; isplit = is_own;
+    }
+
+    cluster_t *cl = (cluster_t*)malloc((size_t)m * sizeof(cluster_t));
+    if (!cl) { free(ib_own); return -1; }
+    const int ncl = make_clusters(D, E, m, W, iblock, isplit, cl);
+    qsort(cl, (size_t)ncl, sizeof(cluster_t), by_size_desc);     /* largest first */
+
+    if (nthreads <= 0) {
+        const char *v = getenv("INVIT_THREADS");
+        nthreads = (v && atoi(v) > 0) ? atoi(v) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (nthreads < 1) nthreads = 1;
+    if (nthreads > ncl) nthreads = ncl;
+
+    pool_t p = { n, ldz, D, E, W, iblock, isplit, Z, cl, ncl, cl[0].m, 0, 0,
+                 PTHREAD_MUTEX_INITIALIZER };
+    worker_t *ws = (worker_t*)calloc((size_t)nthreads, sizeof(worker_t));
+    pthread_t *tids = (pthread_t*)calloc((size_t)nthreads, sizeof(pthread_t));
+    if (!ws || !tids) { free(tids); free(ws); free(cl); free(ib_own); return -1; }
+
+    const double t0 = now_sec();
+    int started = 0;
+    for (int t = 0; t < nthreads; ++t) {
+        ws[t].p = &p;
+        if (t > 0 && pthread_create(&tids[t], NULL, worker, &ws[t]) != 0) break;
+        started = t + 1;
+    }
+    worker(&ws[0]);                                  /* the caller is thread 0 */
+    for (int t = 1; t < started; ++t) pthread_join(tids[t], NULL);
+    st->seconds = now_sec() - t0;
+
+    st->nclusters = ncl;
+    st->largest = cl[0].m;
+    st->nthreads = started;
+    st->nfail = p.nfail;
+    st->busy_min = ws[0].busy;
+    for (int t = 0; t < started; ++t) {
+        if (ws[t].busy > st->busy_max) st->busy_max = ws[t].busy;
+        if (ws[t].busy < st->busy_min) st->busy_min = ws[t].busy;
+    }
+    pthread_mutex_destroy(&p.lock);
+    free(tids); free(ws); free(cl); free(ib_own);
+    return p.nfail;
+}
@@ -0,0 +1,43 @@
+// inv_iter.h — parallel inverse iteration: eigenvectors of a symmetric
+// tridiagonal T for given eigenvalues (from DSTEBZ bisection or DSTERF).
+//
+// The eigenvalues are split the way DSTEIN groups them: within a block of
+// T, consecutive values closer than 1e-3 ||T_block||_1 form a cluster whose
+// vectors are reorthogonalized against each other; distinct clusters never
+// are. Every cluster therefore is an independent task: a pool of pthreads
+// takes clusters largest first and runs DSTEIN on each, writing the vectors
+// straight into their columns of Z. The vectors equal serial DSTEIN's up to
+// the random starting vectors (both converge to the same normalized,
+// sign-fixed eigenvectors).
+//
+// Threads: `nthreads` > 0, else INVIT_THREADS, else the online CPUs; never
+// more than the number of clusters. Keep the BLAS single-threaded (the
+// driver scripts export OPENBLAS_NUM_THREADS=1): DSTEIN is level-1 only.
+// The pool is timed here (inv_iter_stats_t): per-thread busy time says more
+// than the wrapper registry, which sums the threads' DCOPY / DSCAL calls
+// (atomic adds per call, no lock; WRAP_MASK=-dcopy_,-dscal_ skips them).
+// Returns 0, -1 on bad arguments / allocation failure, or the number of
+// vectors that failed to converge (DSTEIN INFO > 0 summed over tasks).
+
+#ifndef INV_ITER_H
+#define INV_ITER_H
+
+typedef struct {
+    int    nclusters;      /* tasks                                          */
+    int    largest;        /* vectors in the largest cluster                 */
+    int    nthreads;       /* threads used                                   */
+    int    nfail;          /* vectors that did not converge                  */
+    double seconds;        /* wall time, pool start to join                  */
+    double busy_max;       /* max / min seconds a thread spent in DSTEIN     */
+    double busy_min;
+} inv_iter_stats_t;
+
+/* Eigenvectors of T = tridiag(E, D, E) (E: n-1 entries) for the m values W.
+   iblock / isplit as returned by DSTEBZ with ORDER='B' (values grouped by
+   block, ascending within a block); iblock == NULL means T is one unreduced
+   block and W is ascending (e.g. DSTERF output). Z is n x m, ldz >= n. */
+int inv_iter_vectors(int n, const double *D, const double *E, int m, const double *W,
+                     const int *iblock, const int *isplit, double *Z, int ldz,
+                     int nthreads, inv_iter_stats_t *st);
+
+#endif /* INV_ITER_H */
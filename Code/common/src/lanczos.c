@@ -0,0 +1,196 @@
+// lanczos.c — thick-restart Lanczos on a struct_op_t (see lanczos.h).
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#include "lanczos.h"
+#include "now_sec.h"
+
+extern void dgemv_(const char *TRANS, const int *M, const int *N, const double *ALPHA,
+                   const double *A, const int *LDA, const double *X, const int *INCX,
+                   const double *BETA, double *Y, const int *INCY);
+extern void dgemm_(const char *TRANSA, const char *TRANSB, const int *M, const int *N, const int *K,
+                   const double *ALPHA, const double *A, const int *LDA, const double *B, const int *LDB,
+                   const double *BETA, double *C, const int *LDC);
+extern void dsyev_(const char *JOBZ, const char *UPLO, const int *N, double *A, const int *LDA,
+                   double *W, double *WORK, const int *LWORK, int *INFO);
+
+#define LANCZOS_ROW_BLOCK 4096      /* rows per DGEMM in the in-place restart */
+
+static double norm2(int n, const double *x)
+{
+    double s = 0.0;
+    for (int i = 0; i < n; ++i) s += x[i] * x[i];
+    return sqrt(s);
+}
+
+static void random_vector(int n, double *x, unsigned long long *s)
+{
+    for (int i = 0; i < n; ++i) {
+        *s = *s * 6364136223846793005ull + 1442695040888963407ull;
+        x[i] = (double)(*s >> 11) / 4503599627370496.0 - 1.0;       /* 2^52: [-1, 1) */
+    }
+}
+
+/* h += V^T w, w -= V (V^T w): one classical Gram-Schmidt pass, repeated
+   while it removes more than 1/sqrt(2) of w's norm (DGKS), at most twice.
+   Returns ||w||. */
+static double cgs(int n, int m, const double *V, double *w, double *h, double *t)
+{
+    const char tr = 'T', nt = 'N';
+    const int one = 1;
+    const double p1 = 1.0, m1 = -1.0, z0 = 0.0;
+    double before = norm2(n, w), after = before;
+    for (int pass = 0; pass < 2; ++pass) {
+        dgemv_(&tr, &n, &m, &p1, V, &n, w, &one, &z0, t, &one);
+        dgemv_(&nt, &n, &m, &m1, V, &n, t, &one, &p1, w, &one);
+        for (int i = 0; i < m; ++i) h[i] += t[i];
+        after = norm2(n, w);
+        if (after > 0.7071 * before) break;
+        before = after;
+    }
+    return after;
+}
+
+/* V[:, 0:keep] = V[:, 0:ncv] * Y (ncv x keep), in place by row blocks */
+static void rotate_basis(int n, int ncv, int keep, double *V, const double *Y, double *tmp)
+{
+    const char nt = 'N';
+    const double p1 = 1.0, z0 = 0.0;
+    for (int r0 = 0; r0 < n; r0 += LANCZOS_ROW_BLOCK) {
+        const int rows = (n - r0 < LANCZOS_ROW_BLOCK) ? n - r0 : LANCZOS_ROW_BLOCK;
+        dgemm_(&nt, &nt, &rows, &keep, &ncv, &p1, V + r0, &n, Y, &ncv, &z0, tmp, &rows);
+        for (int c = 0; c < keep; ++c)
+            memcpy(V + r0 + (size_t)c * n, tmp + (size_t)c * rows, (size_t)rows * sizeof(double));
+    }
+}
+
+int lanczos_extremal(struct_op_t *op, int k, int which, int ncv, double tol, int maxit,
+                     double *W, double *V, int ldv, lanczos_stats_t *st)
+{
+    memset(st, 0, sizeof(*st));
+    const int n = op ? op->n : 0;
+    if (n < 3 || k < 1 || k > n - 2 || !W || !V || ldv < n) return -1;
+    if (ncv <= 0) ncv = (3 * k > k + 60) ? 3 * k : k + 60;
+    if (ncv > n) ncv = n;
+    if (ncv < k + 2) return -1;
+    if (tol <= 0.0) tol = 1e-10;
+    if (maxit <= 0) maxit = 500;
+
+    const int keep_max = k + (ncv - k) / 2;
+    double *Vb  = (double*)malloc((size_t)n * (size_t)(ncv + 1) * sizeof(double));
+    double *tmp = (double*)malloc((size_t)LANCZOS_ROW_BLOCK * (size_t)keep_max * sizeof(double));
+    double *H   = (double*)calloc((size_t)ncv * ncv, sizeof(double));
+    double *S   = (double*)malloc((size_t)ncv * ncv * sizeof(double));
+    double *Y   = (double*)malloc((size_t)ncv * keep_max * sizeof(double));
+    double *th  = (double*)malloc((size_t)ncv * sizeof(double));
+    double *h   = (double*)malloc((size_t)(ncv + 1) * sizeof(double));
+    double *t   = (double*)malloc((size_t)(ncv + 1) * sizeof(double));
+    const char jobz = 'V', uplo = 'U';
+    int lwork = -1, info = 0;
+    double wkopt = 0.0;
+    dsyev_(&jobz, &uplo, &ncv, S, &ncv, th, &wkopt, &lwork, &info);
+    lwork = (int)wkopt > 0 ? (int)wkopt : 3 * ncv;
+    double *work = (double*)malloc((size_t)lwork * sizeof(double));
+    int ret = -1;
+    if (!Vb || !tmp || !H || !S || !Y || !th || !h || !t || !work) goto DONE;
+    st->bytes = ((size_t)n * (ncv + 1) + (size_t)LANCZOS_ROW_BLOCK * keep_max
+                 + 3 * (size_t)ncv * ncv + (size_t)lwork) * sizeof(double);
+
+    const double t_start = now_sec();
+    unsigned long long seed = 0x2545f4914f6cdd1dull;
+    random_vector(n, Vb, &seed);
+    double nrm = norm2(n, Vb);
+    for (int i = 0; i < n; ++i) Vb[i] /= nrm;
+
+    double beta = 0.0;
+    int l = 0;
+    for (int it = 0; ; ++it) {
+        /* ---- extend the basis from column l to ncv ---- */
+        for (int j = l; j < ncv; ++j) {
+            double *vj = Vb + (size_t)j * n, *w = Vb + (size_t)(j + 1) * n;
+            double t0 = now_sec();
+            struct_op_apply(op, vj, w);
+            st->apply_seconds += now_sec() - t0;
+            st->matvecs++;
+
+            /* three-term step first (not on the arrow column after a
+               restart), so that CGS only removes rounding-level components */
+            t0 = now_sec();
+            memset(h, 0, (size_t)(j + 1) * sizeof(double));
+            if (j > l || l == 0) {
+                double a = 0.0;
+                for (int i = 0; i < n; ++i) a += vj[i] * w[i];
+                const double *vp = j > 0 ? vj - n : NULL;
+                const double b = j > 0 ? beta : 0.0;
+                for (int i = 0; i < n; ++i) w[i] -= a * vj[i] + (vp ? b * vp[i] : 0.0);
+                h[j] = a;
+                if (j > 0) h[j - 1] = b;
+            }
+            beta = cgs(n, j + 1, Vb, w, h, t);
+            for (int i = 0; i <= j; ++i) H[i + (size_t)j * ncv] = h[i];
+            const double scale = op->norm_bound > 0.0 ? op->norm_bound : fabs(h[j]) + beta;
+            if (beta <= DBL_EPSILON * scale) {          /* invariant subspace: continue with a fresh direction */
+                random_vector(n, w, &seed);
+                memset(h, 0, (size_t)(j + 1) * sizeof(double));
+                cgs(n, j + 1, Vb, w, h, t);              /* H column already stored */
+                cgs(n, j + 1, Vb, w, h, t);
+                nrm = norm2(n, w);
+                for (int i = 0; i < n; ++i) w[i] /= nrm;
+                beta = 0.0;
+            } else {
+                for (int i = 0; i < n; ++i) w[i] /= beta;
+            }
+            st->ortho_seconds += now_sec() - t0;
+        }
+
+        /* ---- Ritz pairs of H, wanted end first ---- */
+        memcpy(S, H, (size_t)ncv * ncv * sizeof(double));
+        dsyev_(&jobz, &uplo, &ncv, S, &ncv, th, work, &lwork, &info);
+        if (info != 0) goto DONE;
+        const double anorm = fmax(fabs(th[0]), fabs(th[ncv - 1]));
+        int nconv = 0;
+        double rmax = 0.0;
+        for (int i = 0; i < k; ++i) {
+            const int c = which > 0 ? ncv - 1 - i : i;
+            const double r = fabs(beta * S[(ncv - 1) + (size_t)c * ncv]);
+            if (r <= tol * anorm) ++nconv;
+            if (anorm > 0.0 && r / anorm > rmax) rmax = r / anorm;
+        }
+        st->nconv = nconv;
+        st->max_resid = rmax;
+        const int done = (nconv >= k) || (it >= maxit);
+        const int keep = done ? k : keep_max;
+        for (int i = 0; i < keep; ++i) {
+            const int c = which > 0 ? ncv - 1 - i : i;
+            memcpy(Y + (size_t)i * ncv, S + (size_t)c * ncv, (size_t)ncv * sizeof(double));
+        }
+
+        /* ---- thick restart: V[:, 0:keep] = Ritz vectors, then the residual ---- */
+        const double t0 = now_sec();
+        rotate_basis(n, ncv, keep, Vb, Y, tmp);
+        st->ortho_seconds += now_sec() - t0;
+        if (done) {
+            for (int i = 0; i < k; ++i) {
+                W[i] = th[which > 0 ? ncv - 1 - i : i];
+                memcpy(V + (size_t)i * ldv, Vb + (size_t)i * n, (size_t)n * sizeof(double));
+            }
+            ret = k - nconv;
+            break;
+        }
+        memcpy(Vb + (size_t)keep * n, Vb + (size_t)ncv * n, (size_t)n * sizeof(double));
+        memset(H, 0, (size_t)ncv * ncv * sizeof(double));
+        for (int i = 0; i < keep; ++i) H[i + (size_t)i * ncv] = th[which > 0 ? ncv - 1 - i : i];
+        l = keep;
+        st->restarts++;
+    }
+    st->seconds = now_sec() - t_start;
+
+DONE:
+    free(work); free(t); free(h); free(th); free(Y); free(S); free(H); free(tmp); free(Vb);
+    return ret;
+}
@@ -0,0 +1,49 @@
+// lanczos.h — thick-restart Lanczos for k extremal eigenpairs of a
+// matrix-free symmetric operator (struct_op.h).
+//
+// Basis V (n x (ncv+1)), fully reorthogonalized: every new vector A v_j
+// loses its three-term components (alpha_j v_j, beta_{j-1} v_{j-1}), then
+// one classical Gram-Schmidt pass against the whole basis (DGEMV 'T' / 'N'),
+// a second only when the first removed more than 1/sqrt(2) of the norm
+// (DGKS). All coefficients together form column j of H = V^T A V. After
+// ncv steps H is solved with DSYEV; the `keep` Ritz pairs nearest the
+// wanted end (k plus half of the rest) become the first columns of V
+// (row-blocked DGEMM, in place), the residual vector follows them and the
+// iteration resumes from there (Wu & Simon's thick restart: H is diagonal
+// plus one arrow row, which the next column's Gram-Schmidt coefficients
+// fill in).
+//
+// A Ritz pair (theta, y) counts as converged when |beta y_last| <=
+// tol * max|theta|, the residual norm ||A y - theta y|| of exact arithmetic.
+// Memory: (ncv + 1) n doubles of basis, nb * keep for the restart, O(ncv^2).
+// The basis size matters more than for well-separated spectra: extremal
+// eigenvalues of large Toeplitz matrices with smooth symbols (KMS) are
+// spaced ~||A|| / n^2, and a short basis restarted often stalls (n = 1e5,
+// k = 10, tol 1e-6: 10.7k products at ncv = 30, 3.6k at ncv = 60).
+//
+// Returns 0 (k pairs converged), the number still unconverged after
+// maxit restarts (W, V hold the best approximations), or -1 on bad
+// arguments / allocation failure.
+
+#ifndef LANCZOS_H
+#define LANCZOS_H
+
+#include "struct_op.h"
+
+typedef struct {
+    int    matvecs, restarts, nconv;
+    double seconds;            /* total wall time                            */
+    double apply_seconds;      /* in the operator                            */
+    double ortho_seconds;      /* Gram-Schmidt (DGEMV) and restarts (DGEMM)  */
+    double max_resid;          /* max |beta y_last| / max|theta| of the k     */
+    size_t bytes;              /* basis + work                                */
+} lanczos_stats_t;
+
+/* k pairs at the top (which > 0) or bottom (which < 0) of the spectrum:
+   W[k] ordered from the wanted end inward, V n x k (ldv >= n). ncv <= 0
+   picks max(3k, k + 60), capped at n; tol <= 0 picks 1e-10; maxit <= 0
+   picks 500 restarts. */
+int lanczos_extremal(struct_op_t *op, int k, int which, int ncv, double tol, int maxit,
+                     double *W, double *V, int ldv, lanczos_stats_t *st);
+
+#endif /* LANCZOS_H */
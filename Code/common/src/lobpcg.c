@@ -0,0 +1,210 @@
+// lobpcg.c — block LOBPCG with DSYEVD Rayleigh-Ritz (see lobpcg.h).
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "lobpcg.h"
+#include "now_sec.h"
+
+extern void dgemm_(const char *TRANSA, const char *TRANSB, const int *M, const int *N, const int *K,
+                   const double *ALPHA, const double *A, const int *LDA, const double *B, const int *LDB,
+                   const double *BETA, double *C, const int *LDC);
+extern void dpotrf_(const char *UPLO, const int *N, double *A, const int *LDA, int *INFO);
+extern void dtrsm_(const char *SIDE, const char *UPLO, const char *TRANSA, const char *DIAG,
+                   const int *M, const int *N, const double *ALPHA, const double *A, const int *LDA,
+                   double *B, const int *LDB);
+extern void dsyevd_(const char *JOBZ, const char *UPLO, const int *N,
+                    double *A, const int *LDA, double *W,
+                    double *WORK, const int *LWORK,
+                    int *IWORK, const int *LIWORK,
+                    int *INFO);
+
+/* C (m x n) = op(A)^T-or-not B, thin wrapper to keep the call sites short */
+static void gemm(char ta, int m, int n, int k, double alpha, const double *A, int lda,
+                 const double *B, int ldb, double beta, double *C, int ldc)
+{
+    const char tb = 'N';
+    dgemm_(&ta, &tb, &m, &n, &k, &alpha, A, &lda, B, &ldb, &beta, C, &ldc);
+}
+
+/* V -= Q (Q^T V) and, when given, AV -= AQ (Q^T V); twice. c: nq x nv work */
+static void project_out(int n, const double *Q, const double *AQ, int nq,
+                        double *V, double *AV, int nv, double *c)
+{
+    if (nq == 0 || nv == 0) return;
+    for (int pass = 0; pass < 2; ++pass) {
+        gemm('T', nq, nv, n, 1.0, Q, n, V, n, 0.0, c, nq);
+        gemm('N', n, nv, nq, -1.0, Q, n, c, nq, 1.0, V, n);
+        if (AV) gemm('N', n, nv, nq, -1.0, AQ, n, c, nq, 1.0, AV, n);
+    }
+}
+
+/* V = V R^-1 with V^T V = R^T R (and AV = AV R^-1), twice. Returns the
+   DPOTRF INFO of the first failing pass (V not numerically full rank). */
+static int chol_qr(int n, double *V, double *AV, int nv, double *G)
+{
+    const char side = 'R', uplo = 'U', tr = 'N', diag = 'N';
+    const double one = 1.0;
+    for (int pass = 0; pass < 2; ++pass) {
+        int info = 0;
+        gemm('T', nv, nv, n, 1.0, V, n, V, n, 0.0, G, nv);
+        dpotrf_(&uplo, &nv, G, &nv, &info);
+        if (info != 0) return info;
+        dtrsm_(&side, &uplo, &tr, &diag, &n, &nv, &one, G, &nv, V, &n);
+        if (AV) dtrsm_(&side, &uplo, &tr, &diag, &n, &nv, &one, G, &nv, AV, &n);
+    }
+    return 0;
+}
+
+static void random_block(int n, int k, double *X)
+{
+    unsigned long long s = 0x2545f4914f6cdd1dull;
+    for (size_t i = 0; i < (size_t)n * k; ++i) {
+        s = s * 6364136223846793005ull + 1442695040888963407ull;
+        X[i] = (double)(s >> 11) / 4503599627370496.0 - 1.0;        /* 2^52: [-1, 1) */
+    }
+}
+
+int lobpcg_extremal(struct_op_t *op, int k, int which, double tol, int maxit,
+                    double *W, double *X, int ldx,
+                    lobpcg_monitor_t monitor, void *arg, lobpcg_stats_t *st)
+{
+    memset(st, 0, sizeof(*st));
+    const int n = op ? op->n : 0;
+    if (k < 1 || 3 * k > n || !W || !X || ldx < n) return -1;
+    if (tol <= 0.0) tol = 1e-8;
+    if (maxit <= 0) maxit = 1000;
+
+    const int mmax = 3 * k;
+    const size_t nk = (size_t)n * k;
+    double *S   = (double*)malloc(nk * 3 * sizeof(double));   /* [X W P]         */
+    double *AS  = (double*)malloc(nk * 3 * sizeof(double));   /* [AX AW AP]      */
+    double *Pb  = (double*)malloc(nk * sizeof(double));       /* P, AP carried   */
+    double *APb = (double*)malloc(nk * sizeof(double));
+    double *T1  = (double*)malloc(nk * sizeof(double));       /* new X, AX       */
+    double *T2  = (double*)malloc(nk * sizeof(double));
+    double *G   = (double*)malloc((size_t)mmax * mmax * sizeof(double));
+    double *c   = (double*)malloc((size_t)mmax * mmax * sizeof(double));
+    double *th  = (double*)malloc((size_t)mmax * sizeof(double));
+    double *C   = (double*)malloc((size_t)mmax * k * sizeof(double));
+    double *res = (double*)malloc((size_t)k * sizeof(double));
+    double *tk  = (double*)malloc((size_t)k * sizeof(double));
+    const char jobz = 'V', uplo = 'U';
+    int lwork = -1, liwork = -1, iwkopt = 0, info = 0;
+    double wkopt = 0.0;
+    dsyevd_(&jobz, &uplo, &mmax, G, &mmax, th, &wkopt, &lwork, &iwkopt, &liwork, &info);
+    lwork = (int)wkopt > 0 ? (int)wkopt : 1;
+    liwork = iwkopt > 0 ? iwkopt : 1;
+    double *work = (double*)malloc((size_t)lwork * sizeof(double));
+    int *iwork = (int*)malloc((size_t)liwork * sizeof(int));
+    int ret = -1;
+    if (!S || !AS || !Pb || !APb || !T1 || !T2 || !G || !c || !th || !C || !res || !tk || !work || !iwork)
+        goto DONE;
+    st->bytes = (10 * nk + 3 * (size_t)mmax * mmax + (size_t)lwork) * sizeof(double);
+
+    const double t_start = now_sec();
+    double t0;
+#define APPLY(V, AV, nv) do {                                              \
+        t0 = now_sec();                                                    \
+        struct_op_apply_block(op, (nv), (V), n, (AV), n);                  \
+        st->apply_seconds += now_sec() - t0;                               \
+        st->apply_calls++; st->apply_cols += (nv);                         \
+    } while (0)
+
+    random_block(n, k, S);
+    if (chol_qr(n, S, NULL, k, G) != 0) goto DONE;
+    APPLY(S, AS, k);
+
+    int na = 0, np = 0;                          /* columns of W, P in S */
+    for (int it = 0; ; ++it) {
+        /* ---- Rayleigh-Ritz on S = [X W P] (orthonormal) ---- */
+        const int m = k + na + np;
+        t0 = now_sec();
+        gemm('T', m, m, n, 1.0, S, n, AS, n, 0.0, G, m);
+        for (int j = 0; j < m; ++j)
+            for (int i = 0; i < j; ++i) G[i + (size_t)j * m] = 0.5 * (G[i + (size_t)j * m] + G[j + (size_t)i * m]);
+        dsyevd_(&jobz, &uplo, &m, G, &m, th, work, &lwork, iwork, &liwork, &info);
+        st->rr_seconds += now_sec() - t0;
+        if (info != 0) { fprintf(stderr, "[lobpcg] DSYEVD failed, info=%d\n", info); goto DONE; }
+        for (int j = 0; j < k; ++j) {
+            const int src = which > 0 ? m - 1 - j : j;
+            memcpy(C + (size_t)j * m, G + (size_t)src * m, (size_t)m * sizeof(double));
+            tk[j] = th[src];
+        }
+
+        /* ---- X = S C, AX = AS C; P = [W P] C_{WP}, AP likewise ---- */
+        t0 = now_sec();
+        gemm('N', n, k, m, 1.0, S, n, C, m, 0.0, T1, n);
+        gemm('N', n, k, m, 1.0, AS, n, C, m, 0.0, T2, n);
+        if (m > k) {
+            gemm('N', n, k, m - k, 1.0, S + nk, n, C + k, m, 0.0, Pb, n);
+            gemm('N', n, k, m - k, 1.0, AS + nk, n, C + k, m, 0.0, APb, n);
+        }
+        memcpy(S, T1, nk * sizeof(double));
+        memcpy(AS, T2, nk * sizeof(double));
+        np = (m > k) ? k : 0;
+
+        /* ---- residuals, convergence, active columns into the W slot ---- */
+        double anorm = op->norm_bound;
+        if (anorm <= 0.0) anorm = fmax(fabs(th[0]), fabs(th[m - 1]));
+        int nconv = 0;
+        na = 0;
+        st->max_resid = 0.0;
+        for (int j = 0; j < k; ++j) {
+            const double *x = S + (size_t)j * n, *ax = AS + (size_t)j * n;
+            double *r = S + nk + (size_t)na * n;
+            double s = 0.0;
+            for (int i = 0; i < n; ++i) { r[i] = ax[i] - tk[j] * x[i]; s += r[i] * r[i]; }
+            res[j] = sqrt(s) / anorm;
+            if (res[j] > st->max_resid) st->max_resid = res[j];
+            if (res[j] <= tol) ++nconv; else ++na;       /* keep r_j only when active */
+        }
+        st->ortho_seconds += now_sec() - t0;
+        st->iters = it;
+        st->nconv = nconv;
+        if (monitor) {
+            lobpcg_iter_t rec = { it, nconv, na, np, k, tk, res, now_sec() - t_start };
+            monitor(&rec, arg);
+        }
+        if (nconv == k || it >= maxit) { ret = k - nconv; break; }
+
+        /* ---- W: off X, orthonormal, then A W ---- */
+        t0 = now_sec();
+        double *Wb = S + nk, *AW = AS + nk;
+        project_out(n, S, NULL, k, Wb, NULL, na, c);
+        if (chol_qr(n, Wb, NULL, na, G) != 0) {
+            fprintf(stderr, "[lobpcg] residual block lost rank at iteration %d\n", it);
+            ret = k - nconv;
+            break;
+        }
+        st->ortho_seconds += now_sec() - t0;
+        APPLY(Wb, AW, na);
+
+        /* ---- P: off X and W, orthonormal (AP carried along) or dropped ---- */
+        t0 = now_sec();
+        if (np > 0) {
+            project_out(n, S, AS, k + na, Pb, APb, np, c);
+            if (chol_qr(n, Pb, APb, np, G) != 0) np = 0;
+            else {
+                memcpy(S + nk + (size_t)na * n, Pb, (size_t)np * n * sizeof(double));
+                memcpy(AS + nk + (size_t)na * n, APb, (size_t)np * n * sizeof(double));
+            }
+        }
+        st->ortho_seconds += now_sec() - t0;
+    }
+#undef APPLY
+
+    for (int j = 0; j < k; ++j) {
+        W[j] = tk[j];
+        memcpy(X + (size_t)j * ldx, S + (size_t)j * n, (size_t)n * sizeof(double));
+    }
+    st->seconds = now_sec() - t_start;
+
+DONE:
+    free(iwork); free(work); free(tk); free(res); free(C); free(th); free(c); free(G);
+    free(T2); free(T1); free(APb); free(Pb); free(AS); free(S);
+    return ret;
+}
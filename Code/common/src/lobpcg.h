@@ -0,0 +1,56 @@
+// lobpcg.h — LOBPCG (Knyazev) for k extremal eigenpairs of a symmetric
+// operator (struct_op.h; block products through struct_op_apply_block, so
+// a CSR operator runs one SpMM per block instead of k SpMVs).
+//
+// Per iteration, with the block X (n x k) of current Ritz vectors:
+//   R = A X - X Theta; columns with ||r_j|| <= tol ||A|| are converged and
+//   drop out of the new directions (soft locking), the rest form W;
+//   W is projected off X and orthonormalized (Cholesky QR, twice); AW = A W;
+//   the previous update P (and AP, carried along) is projected off X and W
+//   and orthonormalized the same way, or dropped when its Gram matrix is not
+//   numerically positive definite;
+//   S = [X W P] is then orthonormal, G = S^T (A S) (m x m, m <= 3k) goes to
+//   DSYEVD (the divide & conquer of the dense drivers), the k Ritz vectors
+//   at the wanted end give X = S C, A X = (A S) C and P = [W P] C_{W,P}.
+// Only X, W, P and their images are stored: ~10 n k doubles. No
+// preconditioner (T = I): convergence follows the spectral gaps, as for
+// Lanczos, but per block product instead of per vector.
+//
+// ||A|| is op->norm_bound when known, else the largest |Ritz value|.
+// Returns 0 (all k converged), the number still unconverged after maxit
+// iterations (W, X hold the best approximations), or -1 on bad arguments /
+// allocation failure / a failed DSYEVD.
+
+#ifndef LOBPCG_H
+#define LOBPCG_H
+
+#include "struct_op.h"
+
+typedef struct {
+    int           iter, nconv, nactive, np;   /* np: columns of P this iteration */
+    int           k;
+    const double *theta, *resid;              /* k Ritz values, ||r|| / ||A||     */
+    double        seconds;                    /* since the start                 */
+} lobpcg_iter_t;
+
+typedef void (*lobpcg_monitor_t)(const lobpcg_iter_t *it, void *arg);
+
+typedef struct {
+    int    iters, nconv;
+    long   apply_calls, apply_cols;  /* block products, columns through the operator */
+    double seconds;
+    double apply_seconds;            /* in the operator (SpMM)                        */
+    double rr_seconds;               /* S^T A S (DGEMM) + DSYEVD                      */
+    double ortho_seconds;            /* projections, Cholesky QR, basis updates       */
+    double max_resid;
+    size_t bytes;
+} lobpcg_stats_t;
+
+/* k pairs at the top (which > 0) or bottom (which < 0): W[k] from the
+   wanted end inward, X n x k (ldx >= n). tol <= 0 picks 1e-8, maxit <= 0
+   picks 1000. monitor (may be NULL) is called once per iteration. */
+int lobpcg_extremal(struct_op_t *op, int k, int which, double tol, int maxit,
+                    double *W, double *X, int ldx,
+                    lobpcg_monitor_t monitor, void *arg, lobpcg_stats_t *st);
+
+#endif /* LOBPCG_H */
@@ -0,0 +1,386 @@
+// mat_io.c — Matrix Market / .npy / raw readers (see mat_io.h).
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <errno.h>
+#include <math.h>
+#include <limits.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "mat_io.h"
+
+#define TBLK 64   /* block size for the C-order transpose copy */
+
+const char *mat_format_name(mat_format_t f)
+{
+    switch (f) {
+    case MAT_FMT_MTX: return "mtx";
+    case MAT_FMT_NPY: return "npy";
+    default:          return "raw";
+    }
+}
+
+static int host_little_endian(void) {
+    const uint16_t one = 1;
+    return *(const unsigned char*)&one == 1;
+}
+
+/* read-only mapping of the whole file */
+static const unsigned char *map_file(const char *path, size_t *bytes)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) { fprintf(stderr, "[mat_io] open %s: %s\n", path, strerror(errno)); return NULL; }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) { close(fd); return NULL; }
+    void *p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) { perror("[mat_io] mmap"); return NULL; }
+    madvise(p, (size_t)st.st_size, MADV_SEQUENTIAL);
+    *bytes = (size_t)st.st_size;
+    return (const unsigned char*)p;
+}
+
+/* ---------------- Matrix Market ---------------- */
+typedef struct { const char *p, *end; } scan_t;
+
+static void skip_line(scan_t *s) {
+    while (s->p < s->end && *s->p != '\n') s->p++;
+    if (s->p < s->end) s->p++;
+}
+
+/* next whitespace-separated token as double; 0 on success */
+static int scan_double(scan_t *s, double *v)
+{
+    while (s->p < s->end && isspace((unsigned char)*s->p)) s->p++;
+    if (s->p >= s->end) return -1;
+    char tok[64]; int k = 0;
+    while (s->p < s->end && !isspace((unsigned char)*s->p) && k < 63) tok[k++] = *s->p++;
+    tok[k] = '\0';
+    char *e; *v = strtod(tok, &e);
+    return (e == tok) ? -2 : 0;
+}
+
+static int scan_long(scan_t *s, long long *v)
+{
+    double d;
+    if (scan_double(s, &d) != 0) return -1;
+    *v = (long long)d;
+    return 0;
+}
+
+/* parse banner + comments + size line; leaves s at the first entry */
+static int mtx_header(const char *buf, size_t len, mat_header_t *h, scan_t *s)
+{
+    s->p = buf; s->end = buf + len;
+    char line[256]; size_t k = 0;
+    while (s->p + k < s->end && s->p[k] != '\n' && k < sizeof(line) - 1) { line[k] = s->p[k]; ++k; }
+    line[k] = '\0';
+    skip_line(s);
+
+    char obj[32], fmt[32], field[32], sym[32];
+    if (sscanf(line, "%%%%MatrixMarket %31s %31s %31s %31s", obj, fmt, field, sym) != 4 ||
+        strcasecmp(obj, "matrix") != 0) {
+        fprintf(stderr, "[mat_io] bad Matrix Market banner\n");
+        return -1;
+    }
+    if (strcasecmp(field, "complex") == 0 || strcasecmp(sym, "hermitian") == 0 ||
+        strcasecmp(sym, "skew-symmetric") == 0) {
+        fprintf(stderr, "[mat_io] unsupported Matrix Market type: %s %s\n", field, sym);
+        return -2;
+    }
+    h->mtx_coordinate = (strcasecmp(fmt, "coordinate") == 0);
+    h->mtx_symmetric  = (strcasecmp(sym, "symmetric") == 0);
+    h->mtx_pattern    = (strcasecmp(field, "pattern") == 0);
+
+    while (s->p < s->end && *s->p == '%') skip_line(s);
+    long long m = 0, n = 0, nnz = 0;
+    if (scan_long(s, &m) || scan_long(s, &n) || (h->mtx_coordinate && scan_long(s, &nnz))) {
+        fprintf(stderr, "[mat_io] bad Matrix Market size line\n");
+        return -3;
+    }
+    if (m != n || n <= 0) { fprintf(stderr, "[mat_io] matrix is %lld x %lld, need square\n", m, n); return -4; }
+    h->n = (int)n;
+    h->mtx_nnz = nnz;
+    return 0;
+}
+
+static int mtx_read(const char *buf, size_t len, const mat_header_t *h, double *A, int lda)
+{
+    mat_header_t tmp = *h;
+    scan_t s;
+    if (mtx_header(buf, len, &tmp, &s) != 0) return -1;
+    const int n = h->n;
+
+    if (h->mtx_coordinate) {
+        for (int j = 0; j < n; ++j) memset(&A[(size_t)j * lda], 0, (size_t)n * sizeof(double));
+        for (long long e = 0; e < h->mtx_nnz; ++e) {
+            long long i, j; double v = 1.0;
+            if (scan_long(&s, &i) || scan_long(&s, &j) || (!h->mtx_pattern && scan_double(&s, &v))) {
+                fprintf(stderr, "[mat_io] truncated entry %lld of %lld\n", e, h->mtx_nnz);
+                return -2;
+            }
+            if (i < 1 || j < 1 || i > n || j > n) { fprintf(stderr, "[mat_io] index out of range\n"); return -3; }
+            A[(i - 1) + (size_t)(j - 1) * lda] = v;
+            if (h->mtx_symmetric) A[(j - 1) + (size_t)(i - 1) * lda] = v;
+        }
+    } else {
+        for (int j = 0; j < n; ++j) {
+            for (int i = h->mtx_symmetric ? j : 0; i < n; ++i) {
+                double v;
+                if (scan_double(&s, &v)) { fprintf(stderr, "[mat_io] truncated array data\n"); return -2; }
+                A[i + (size_t)j * lda] = v;
+                if (h->mtx_symmetric) A[j + (size_t)i * lda] = v;
+            }
+        }
+    }
+    return 0;
+}
+
+static long long mtx_read_coo(const char *buf, size_t len, const mat_header_t *h,
+                              int *ri, int *ci, double *v)
+{
+    mat_header_t tmp = *h;
+    scan_t s;
+    if (mtx_header(buf, len, &tmp, &s) != 0) return -1;
+    const int n = h->n;
+    long long m = 0;
+    for (long long e = 0; e < h->mtx_nnz; ++e) {
+        long long i, j; double x = 1.0;
+        if (scan_long(&s, &i) || scan_long(&s, &j) || (!h->mtx_pattern && scan_double(&s, &x))) {
+            fprintf(stderr, "[mat_io] truncated entry %lld of %lld\n", e, h->mtx_nnz);
+            return -2;
+        }
+        if (i < 1 || j < 1 || i > n || j > n) { fprintf(stderr, "[mat_io] index out of range\n"); return -3; }
+        ri[m] = (int)(i - 1); ci[m] = (int)(j - 1); v[m] = x; ++m;
+        if (h->mtx_symmetric && i != j) { ri[m] = (int)(j - 1); ci[m] = (int)(i - 1); v[m] = x; ++m; }
+    }
+    return m;
+}
+
+/* ---------------- NumPy .npy ---------------- */
+/* Value token of `key` in the header dict: first non-blank after the
+   colon that follows the key, or NULL when the key or colon is missing. */
+static const char *npy_value(const char *dict, const char *key)
+{
+    const char *p = strstr(dict, key);
+    if (!p) return NULL;
+    p += strlen(key);
+    while (*p == ' ') ++p;
+    if (*p++ != ':') return NULL;
+    while (*p == ' ') ++p;
+    return p;
+}
+
+static int npy_header(const unsigned char *buf, size_t len, mat_header_t *h)
+{
+    if (len < 10 || memcmp(buf, "\x93NUMPY", 6) != 0) return -1;
+    int major = buf[6];
+    size_t hlen, hstart;
+    if (major == 1) { hlen = buf[8] | (buf[9] << 8); hstart = 10; }
+    else {
+        if (len < 12) return -1;
+        hlen = buf[8] | (buf[9] << 8) | ((size_t)buf[10] << 16) | ((size_t)buf[11] << 24);
+        hstart = 12;
+    }
+    if (hstart + hlen > len) return -2;
+
+    char *dict = (char*)malloc(hlen + 1);
+    if (!dict) return -3;
+    memcpy(dict, buf + hstart, hlen); dict[hlen] = '\0';
+
+    int rc = 0;
+    const char *d = npy_value(dict, "'descr'");
+    const char *f = npy_value(dict, "'fortran_order'");
+    const char *s = npy_value(dict, "'shape'");
+    char descr[8] = {0};
+    long r = 0, c = 0;
+    int fortran = -1;
+    if (f && strncmp(f, "True", 4) == 0)  fortran = 1;
+    if (f && strncmp(f, "False", 5) == 0) fortran = 0;
+    if (!d || !s || fortran < 0 ||
+        sscanf(d, "'%7[^']'", descr) != 1 ||
+        sscanf(s, "(%ld ,%ld", &r, &c) != 2) {
+        fprintf(stderr, "[mat_io] cannot parse .npy header: %s\n", dict);
+        rc = -4;
+    } else if (strcmp(descr + 1, "f8") != 0 && strcmp(descr + 1, "f4") != 0) {
+        fprintf(stderr, "[mat_io] unsupported .npy dtype %s (need f8/f4)\n", descr);
+        rc = -5;
+    } else if (r > c || r <= 0 || c > INT_MAX) {
+        fprintf(stderr, "[mat_io] .npy shape (%ld, %ld), need (n, n) or band storage (kd+1, n)\n", r, c);
+        rc = -6;
+    } else {
+        h->n = (int)c;
+        h->band_rows = r < c ? (int)r : 0;
+        h->elem_bytes = descr[2] - '0';
+        h->fortran_order = fortran;
+        int le = host_little_endian();
+        h->byteswap = (descr[0] == '<' && !le) || (descr[0] == '>' && le);
+        h->data_offset = hstart + hlen;
+        if (h->data_offset + (size_t)r * (size_t)c * h->elem_bytes > len) {
+            fprintf(stderr, "[mat_io] .npy payload truncated\n");
+            rc = -7;
+        }
+    }
+    free(dict);
+    return rc;
+}
+
+static double load_elem(const unsigned char *p, int elem, int swap)
+{
+    unsigned char b[8];
+    if (swap) for (int k = 0; k < elem; ++k) b[k] = p[elem - 1 - k];
+    else      memcpy(b, p, (size_t)elem);
+    if (elem == 8) { double d; memcpy(&d, b, 8); return d; }
+    float f; memcpy(&f, b, 4); return (double)f;
+}
+
+/* raw / npy payload (m x n, m = n or the band rows) -> A (lda), transposing
+   C order block by block */
+static void dense_read(const unsigned char *data, const mat_header_t *h, int m, double *A, int lda)
+{
+    const int n = h->n, eb = h->elem_bytes;
+    const int fast = (eb == 8 && !h->byteswap);
+
+    if (h->fortran_order) {
+        for (int j = 0; j < n; ++j) {
+            const unsigned char *col = data + (size_t)j * m * eb;
+            if (fast) memcpy(&A[(size_t)j * lda], col, (size_t)m * sizeof(double));
+            else for (int i = 0; i < m; ++i) A[i + (size_t)j * lda] = load_elem(col + (size_t)i * eb, eb, h->byteswap);
+        }
+        return;
+    }
+    /* C order: element (i,j) sits at row-major offset i*n + j */
+    for (int ib = 0; ib < m; ib += TBLK) {
+        int ie = (ib + TBLK < m) ? ib + TBLK : m;
+        for (int jb = 0; jb < n; jb += TBLK) {
+            int je = (jb + TBLK < n) ? jb + TBLK : n;
+            for (int i = ib; i < ie; ++i) {
+                const unsigned char *row = data + ((size_t)i * n) * eb;
+                for (int j = jb; j < je; ++j) {
+                    A[i + (size_t)j * lda] = fast
+                        ? ((const double*)row)[j]
+                        : load_elem(row + (size_t)j * eb, eb, h->byteswap);
+                }
+            }
+        }
+    }
+}
+
+/* ---------------- public API ---------------- */
+int mat_probe(const char *path, mat_header_t *h)
+{
+    memset(h, 0, sizeof(*h));
+    size_t len = 0;
+    const unsigned char *buf = map_file(path, &len);
+    if (!buf) return -1;
+    h->file_bytes = len;
+
+    int rc = 0;
+    if (len >= 6 && memcmp(buf, "\x93NUMPY", 6) == 0) {
+        h->format = MAT_FMT_NPY;
+        rc = npy_header(buf, len, h);
+    } else if (len >= 14 && strncmp((const char*)buf, "%%MatrixMarket", 14) == 0) {
+        h->format = MAT_FMT_MTX;
+        scan_t s;
+        rc = mtx_header((const char*)buf, len, h, &s);
+    } else {
+        h->format = MAT_FMT_RAW;
+        h->elem_bytes = 8;
+        h->fortran_order = 1;
+        double nn = sqrt((double)(len / 8));
+        h->n = (int)llround(nn);
+        if (len % 8 != 0 || (size_t)h->n * (size_t)h->n * 8 != len) {
+            fprintf(stderr, "[mat_io] %s: %zu bytes is not n*n doubles\n", path, len);
+            rc = -2;
+        }
+    }
+    munmap((void*)buf, len);
+    return rc;
+}
+
+int mat_can_map(const mat_header_t *h, int lda)
+{
+    if (h->format == MAT_FMT_MTX || h->band_rows) return 0;
+    if (lda != h->n || h->elem_bytes != 8 || h->byteswap) return 0;
+    return (h->data_offset % sizeof(double)) == 0;
+}
+
+int mat_map(const char *path, const mat_header_t *h, mat_mapping_t *m)
+{
+    memset(m, 0, sizeof(*m));
+    if (!mat_can_map(h, h->n)) return -1;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) { fprintf(stderr, "[mat_io] open %s: %s\n", path, strerror(errno)); return -2; }
+    /* private + writable: LAPACK may overwrite A; dirty pages never reach the file */
+    void *p = mmap(NULL, h->file_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) { perror("[mat_io] mmap"); return -3; }
+    m->base = p;
+    m->bytes = h->file_bytes;
+    m->a = (double*)((char*)p + h->data_offset);
+    m->transposed = !h->fortran_order;
+    return 0;
+}
+
+void mat_unmap(mat_mapping_t *m)
+{
+    if (m && m->base) munmap(m->base, m->bytes);
+    if (m) memset(m, 0, sizeof(*m));
+}
+
+int mat_read(const char *path, const mat_header_t *h, double *A, int lda)
+{
+    if (h->band_rows) { fprintf(stderr, "[mat_io] %s: band storage, not a dense matrix\n", path); return -1; }
+    if (lda < h->n) return -1;
+    size_t len = 0;
+    const unsigned char *buf = map_file(path, &len);
+    if (!buf) return -2;
+    int rc = 0;
+    if (h->format == MAT_FMT_MTX) rc = mtx_read((const char*)buf, len, h, A, lda);
+    else dense_read(buf + h->data_offset, h, h->n, A, lda);
+    munmap((void*)buf, len);
+    return rc;
+}
+
+int mat_read_band(const char *path, const mat_header_t *h, double *AB, int ldab)
+{
+    if (!h->band_rows) { fprintf(stderr, "[mat_io] %s: not band storage\n", path); return -1; }
+    if (ldab < h->band_rows) return -1;
+    size_t len = 0;
+    const unsigned char *buf = map_file(path, &len);
+    if (!buf) return -2;
+    dense_read(buf + h->data_offset, h, h->band_rows, AB, ldab);
+    munmap((void*)buf, len);
+    return 0;
+}
+
+long long mat_coo_capacity(const mat_header_t *h)
+{
+    if (h->format != MAT_FMT_MTX || !h->mtx_coordinate) return -1;
+    return h->mtx_symmetric ? 2 * h->mtx_nnz : h->mtx_nnz;
+}
+
+long long mat_read_coo(const char *path, const mat_header_t *h, int *ri, int *ci, double *v)
+{
+    if (mat_coo_capacity(h) < 0) { fprintf(stderr, "[mat_io] %s: not a coordinate Matrix Market file\n", path); return -1; }
+    size_t len = 0;
+    const unsigned char *buf = map_file(path, &len);
+    if (!buf) return -2;
+    const long long m = mtx_read_coo((const char*)buf, len, h, ri, ci, v);
+    munmap((void*)buf, len);
+    return m;
+}
+
+char mat_uplo(const mat_mapping_t *m, char uplo)
+{
+    if (!m || !m->transposed) return uplo;
+    return (uplo == 'U' || uplo == 'u') ? 'L' : 'U';
+}
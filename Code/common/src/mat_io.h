@@ -0,0 +1,80 @@
+// mat_io.h — dense symmetric matrix input: Matrix Market, NumPy .npy, raw binary.
+//
+// Formats (detected from the file contents, raw as the fallback):
+//   .mtx  Matrix Market "matrix coordinate|array real|integer|pattern
+//         symmetric|general" (symmetric entries are mirrored)
+//   .npy  NumPy v1/v2/v3, dtype <f8 >f8 <f4 >f4, C or Fortran order, shape (n, n);
+//         shape (kd+1, n) with kd+1 < n is LAPACK band storage (band_rows),
+//         upper form AB(kd+i-j, j) = A(i, j) as scipy.linalg.eig_banded's
+//         default, and is read with mat_read_band only
+//   raw   n*n column-major doubles, no header (n = sqrt(size/8))
+//
+// Two ways to get the data:
+//   mat_read : copy into a caller buffer with any leading dimension lda >= n
+//              (C order is transposed on the way in, f4 widened, bytes swapped)
+//   mat_map  : zero-copy private mapping of the file when the bytes already
+//              are native float64 with lda == n (raw, or .npy <f8). C-order
+//              .npy maps as A^T; since A is symmetric only the referenced
+//              triangle differs, so call mat_uplo() to flip UPLO.
+// The mapping is copy-on-write: the solver may overwrite A, the file is untouched.
+//   mat_read_band: band-storage .npy into a caller AB (ldab >= kd+1), same
+//              conversions as mat_read, never n x n
+//   mat_read_coo : the entries of a coordinate .mtx as triplets, without the
+//              n x n array (sparse input, csr.h); symmetric files mirrored
+
+#ifndef MAT_IO_H
+#define MAT_IO_H
+
+#include <stddef.h>
+
+typedef enum { MAT_FMT_RAW = 0, MAT_FMT_MTX, MAT_FMT_NPY } mat_format_t;
+
+typedef struct {
+    mat_format_t format;
+    int    n;
+    size_t file_bytes;
+    size_t data_offset;    /* raw/npy: first byte of the payload            */
+    int    elem_bytes;     /* raw/npy: 8 (f8) or 4 (f4)                     */
+    int    byteswap;       /* npy: payload endianness differs from host     */
+    int    fortran_order;  /* raw: 1; npy: from header                      */
+    int    band_rows;      /* npy (kd+1, n) band storage: kd+1; else 0      */
+    int    mtx_coordinate; /* mtx: 1 coordinate, 0 array                    */
+    int    mtx_symmetric;  /* mtx: 1 symmetric, 0 general                  */
+    int    mtx_pattern;    /* mtx: 1 pattern (all values 1.0)               */
+    long long mtx_nnz;     /* mtx coordinate: number of stored entries      */
+} mat_header_t;
+
+typedef struct {
+    double *a;             /* column-major, leading dimension n             */
+    int     transposed;    /* 1: storage holds A^T (C-order .npy)           */
+    void   *base;          /* mapping base / length for munmap              */
+    size_t  bytes;
+} mat_mapping_t;
+
+/* Inspect `path` and fill `h`. Returns 0 on success. */
+int  mat_probe(const char *path, mat_header_t *h);
+
+/* 1 if mat_map() can serve this file zero-copy for leading dimension lda. */
+int  mat_can_map(const mat_header_t *h, int lda);
+
+/* Zero-copy map (see above). Returns 0 on success. */
+int  mat_map(const char *path, const mat_header_t *h, mat_mapping_t *m);
+void mat_unmap(mat_mapping_t *m);
+
+/* Copy the full symmetric matrix into A (column-major, lda >= n). */
+int  mat_read(const char *path, const mat_header_t *h, double *A, int lda);
+
+/* Band-storage .npy only: the (kd+1) x n payload into AB (ldab >= kd+1). */
+int  mat_read_band(const char *path, const mat_header_t *h, double *AB, int ldab);
+
+/* Coordinate .mtx only: 0-based triplets into ri / ci / v, room for
+   mat_coo_capacity(h) entries. Returns the number stored, < 0 on error. */
+long long mat_coo_capacity(const mat_header_t *h);
+long long mat_read_coo(const char *path, const mat_header_t *h, int *ri, int *ci, double *v);
+
+/* UPLO to pass to LAPACK for this storage ('U'<->'L' when transposed). */
+char mat_uplo(const mat_mapping_t *m, char uplo);
+
+const char *mat_format_name(mat_format_t f);
+
+#endif /* MAT_IO_H */
@@ -0,0 +1,242 @@
+// mem_budget.c — RSS accounting + budget-aware method selection (see mem_budget.h).
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+#include "mem_budget.h"
+
+/* --------- Fortran LAPACK symbols (workspace queries only) --------- */
+extern void dsyevd_(const char *JOBZ, const char *UPLO, const int *N,
+                    double *A, const int *LDA, double *W,
+                    double *WORK, const int *LWORK,
+                    int *IWORK, const int *LIWORK, int *INFO);
+extern void dsyevr_(const char *JOBZ, const char *RANGE, const char *UPLO, const int *N,
+                    double *A, const int *LDA, const double *VL, const double *VU,
+                    const int *IL, const int *IU, const double *ABSTOL,
+                    int *M, double *W, double *Z, const int *LDZ, int *ISUPPZ,
+                    double *WORK, const int *LWORK, int *IWORK, const int *LIWORK,
+                    int *INFO);
+extern void dsyev_(const char *JOBZ, const char *UPLO, const int *N,
+                   double *A, const int *LDA, double *W,
+                   double *WORK, const int *LWORK, int *INFO);
+
+/* ---------------- accounting ---------------- */
+
+/* "VmHWM:   123456 kB" style field from /proc/self/status */
+static long status_field_kb(const char *key)
+{
+    FILE *f = fopen("/proc/self/status", "r");
+    if (!f) return -1;
+    char line[256];
+    size_t klen = strlen(key);
+    long v = -1;
+    while (fgets(line, sizeof(line), f)) {
+        if (strncmp(line, key, klen) == 0 && line[klen] == ':') {
+            v = strtol(line + klen + 1, NULL, 10);
+            break;
+        }
+    }
+    fclose(f);
+    return v;
+}
+
+long mem_rss_kb(void)
+{
+    FILE *f = fopen("/proc/self/statm", "r");
+    if (!f) return 0;
+    long size = 0, resident = 0;
+    int ok = fscanf(f, "%ld %ld", &size, &resident);
+    fclose(f);
+    if (ok != 2) return 0;
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+long mem_peak_rss_kb(void)
+{
+    long hwm = status_field_kb("VmHWM");       /* honours mem_reset_peak() */
+    if (hwm >= 0) return hwm;
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) == 0) return ru.ru_maxrss;   /* KiB on Linux */
+    return 0;
+}
+
+int mem_reset_peak(void)
+{
+    FILE *f = fopen("/proc/self/clear_refs", "w");
+    if (!f) return -1;
+    int rc = (fputs("5", f) >= 0) ? 0 : -1;    /* 5: reset VmHWM to VmRSS */
+    if (fclose(f) != 0) rc = -1;
+    return rc;
+}
+
+void mem_usage_now(mem_usage_t *u)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    u->wall = t.tv_sec + t.tv_nsec * 1e-9;
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) != 0) memset(&ru, 0, sizeof(ru));
+    u->minflt = ru.ru_minflt;
+    u->majflt = ru.ru_majflt;
+    u->nvcsw  = ru.ru_nvcsw;
+    u->nivcsw = ru.ru_nivcsw;
+}
+
+void mem_usage_report(FILE *out, const char *label, const mem_usage_t *a, const mem_usage_t *b)
+{
+    if (!out) return;
+    const long minflt = b->minflt - a->minflt;
+    /* one minor fault maps one base page (or a whole THP); a lower bound */
+    const double mb = (double)minflt * (double)sysconf(_SC_PAGESIZE) / 1048576.0;
+    fprintf(out, "[fault] %-8s: minflt=%-9ld majflt=%-6ld vcsw=%-7ld ivcsw=%-7ld (%.3f s, >= %.1f MB faulted in)\n",
+            label, minflt, b->majflt - a->majflt, b->nvcsw - a->nvcsw, b->nivcsw - a->nivcsw,
+            b->wall - a->wall, mb);
+}
+
+size_t mem_parse_bytes(const char *s)
+{
+    if (!s || !*s) return 0;
+    char *end = NULL;
+    double v = strtod(s, &end);
+    if (end == s || v <= 0.0) return 0;
+    while (*end && isspace((unsigned char)*end)) ++end;
+    switch (toupper((unsigned char)*end)) {
+        case 'T': v *= 1024.0;  /* fall through */
+        case 'G': v *= 1024.0;  /* fall through */
+        case 'M': v *= 1024.0;  /* fall through */
+        case 'K': v *= 1024.0;  break;
+        case '\0': break;
+        default: return 0;
+    }
+    return (size_t)v;
+}
+
+size_t mem_budget_from_env(void)
+{
+    return mem_parse_bytes(getenv("MEM_BUDGET"));
+}
+
+/* ---------------- planning ---------------- */
+
+const char *eig_method_name(eig_method_t m)
+{
+    switch (m) {
+        case EIG_METHOD_DC:   return "dc";
+        case EIG_METHOD_MRRR: return "mrrr";
+        case EIG_METHOD_QR:   return "qr";
+        case EIG_METHOD_OOC:  return "ooc";
+        default:              return "?";
+    }
+}
+
+const char *eig_method_routine(eig_method_t m)
+{
+    switch (m) {
+        case EIG_METHOD_DC:   return "DSYEVD";
+        case EIG_METHOD_MRRR: return "DSYEVR";
+        case EIG_METHOD_QR:   return "DSYEV";
+        case EIG_METHOD_OOC:  return "OOC";
+        default:              return "?";
+    }
+}
+
+double eig_dsyevd_lwork(char jobz, int n, double queried)
+{
+    if (jobz == 'V' || jobz == 'v') {
+        const double need = 1.0 + 6.0 * n + 2.0 * (double)n * n;
+        if (queried < need) queried = need;
+    }
+    return queried;
+}
+
+int eig_lwork_int(double w, int *lwork)
+{
+    if (w > (double)INT_MAX) return -1;
+    *lwork = w < 1.0 ? 1 : (int)w;
+    return 0;
+}
+
+int eig_footprint(eig_method_t m, char jobz, char uplo, int n, eig_footprint_t *f)
+{
+    const size_t nn = (size_t)n * (size_t)n;
+    const int lda = n > 1 ? n : 1;
+    int info = 0, lq = -1, liq = -1, iwq = 0;
+    double wq = 0.0, dummy = 0.0;
+
+    f->method = m;
+    f->lwork = f->liwork = 0;
+    f->bytes = (nn + (size_t)n) * sizeof(double);          /* A + W */
+
+    switch (m) {
+    case EIG_METHOD_DC:
+        dsyevd_(&jobz, &uplo, &n, &dummy, &lda, &dummy, &wq, &lq, &iwq, &liq, &info);
+        wq = eig_dsyevd_lwork(jobz, n, wq);
+        f->liwork = iwq;
+        break;
+    case EIG_METHOD_MRRR: {
+        const char range = 'A';
+        const double vl = 0.0, vu = 0.0, abstol = 0.0;
+        const int il = 1, iu = n;
+        int mfound = 0, isuppz = 0;
+        dsyevr_(&jobz, &range, &uplo, &n, &dummy, &lda, &vl, &vu, &il, &iu, &abstol,
+                &mfound, &dummy, &dummy, &lda, &isuppz, &wq, &lq, &iwq, &liq, &info);
+        f->liwork = iwq;
+        if (jobz == 'V' || jobz == 'v') f->bytes += nn * sizeof(double);   /* Z */
+        f->bytes += 2 * (size_t)n * sizeof(int);                          /* ISUPPZ */
+        break;
+    }
+    case EIG_METHOD_QR:
+        dsyev_(&jobz, &uplo, &n, &dummy, &lda, &dummy, &wq, &lq, &info);
+        break;
+    default:
+        return -1;
+    }
+    if (eig_lwork_int(wq, &f->lwork) != 0) {   /* LP64 LWORK overflows: method unusable */
+        f->lwork = INT_MAX;
+        f->bytes = (size_t)-1;
+        return info != 0 ? info : -1;
+    }
+    f->bytes += (size_t)f->lwork * sizeof(double) + (size_t)f->liwork * sizeof(int);
+    return info;
+}
+
+eig_method_t eig_plan_for_budget(char jobz, char uplo, int n, size_t budget,
+                                 eig_footprint_t fp[EIG_METHOD_OOC], FILE *log)
+{
+    eig_footprint_t local[EIG_METHOD_OOC];
+    if (!fp) fp = local;
+
+    eig_method_t pick = EIG_METHOD_OOC;
+    for (int m = EIG_METHOD_DC; m < EIG_METHOD_OOC; ++m) {
+        if (eig_footprint((eig_method_t)m, jobz, uplo, n, &fp[m]) != 0) fp[m].bytes = (size_t)-1;
+        if (pick == EIG_METHOD_OOC && fp[m].bytes != (size_t)-1 &&
+            (budget == 0 || fp[m].bytes <= budget)) pick = (eig_method_t)m;
+    }
+
+    if (log) {
+        fprintf(log, "[mem] n=%d JOBZ='%c' budget=%s", n, jobz, budget ? "" : "unlimited");
+        if (budget) fprintf(log, "%.1f MB", budget / 1048576.0);
+        fprintf(log, "\n");
+        for (int m = EIG_METHOD_DC; m < EIG_METHOD_OOC; ++m) {
+            if (fp[m].bytes == (size_t)-1) {
+                fprintf(log, "[mem]   %-6s unusable: LWORK > INT_MAX or query failed\n",
+                        eig_method_routine((eig_method_t)m));
+                continue;
+            }
+            fprintf(log, "[mem]   %-6s LWORK=%-11d LIWORK=%-9d total=%10.1f MB%s\n",
+                    eig_method_routine((eig_method_t)m), fp[m].lwork, fp[m].liwork,
+                    fp[m].bytes / 1048576.0, (eig_method_t)m == pick ? "  <- selected" : "");
+        }
+        if (pick == EIG_METHOD_OOC)
+            fprintf(log, "[mem]   nothing fits in core (A alone is %.1f MB): use Code/OOC\n",
+                    (double)n * n * sizeof(double) / 1048576.0);
+    }
+    return pick;
+}
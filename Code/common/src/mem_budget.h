@@ -0,0 +1,91 @@
+// mem_budget.h — memory accounting and budget-aware eigensolver selection.
+//
+// Accounting: current / peak resident set of this process (Linux /proc,
+// getrusage elsewhere), and a way to restart the peak between stages.
+// Per-stage page faults and context switches: take a mem_usage_t before and
+// after a stage and print the difference; minor faults there are first-touch
+// allocation cost, not compute (see MEM_PREFAULT in numa_alloc.h).
+//
+// Budget: MEM_BUDGET=<bytes>[K|M|G|T] caps what the driver may hold resident.
+// eig_plan_for_budget() asks LAPACK for the workspace of each dense method
+// and picks the first that fits, in order of speed:
+//   DC    DSYEVD   A + (1+6n+2n^2) WORK + (3+5n) IWORK       (JOBZ='V')
+//   MRRR  DSYEVR   A + Z + 26n WORK + 10n IWORK + 2n ISUPPZ
+//   QR    DSYEV    A + (3n-1 .. n*(nb+2)) WORK
+//   OOC   A itself does not fit: use Code/OOC (file-backed, panelled)
+
+#ifndef MEM_BUDGET_H
+#define MEM_BUDGET_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+/* Resident set now / high-water mark, in KiB (0 when unavailable). */
+long   mem_rss_kb(void);
+long   mem_peak_rss_kb(void);
+
+/* Reset the high-water mark to the current RSS (Linux clear_refs).
+   Returns 0 on success; on failure mem_peak_rss_kb() stays monotonic. */
+int    mem_reset_peak(void);
+
+/* getrusage(RUSAGE_SELF) counters (all threads) + wall clock. */
+typedef struct {
+    double wall;         /* CLOCK_MONOTONIC seconds */
+    long   minflt;       /* page faults served without I/O (first touch, COW) */
+    long   majflt;       /* page faults that needed I/O */
+    long   nvcsw;        /* voluntary context switches (blocking) */
+    long   nivcsw;       /* involuntary context switches (preemption) */
+} mem_usage_t;
+
+void mem_usage_now(mem_usage_t *u);
+
+/* One line for the stage [a, b]:
+     [fault] <label>: minflt=.. majflt=.. vcsw=.. ivcsw=..  (<s> s, <MB> MB faulted in)
+   `out` may be stdout or a results file. */
+void mem_usage_report(FILE *out, const char *label, const mem_usage_t *a, const mem_usage_t *b);
+
+/* "123456", "512M", "1.5G", "2g" -> bytes; 0 for NULL/empty/invalid. */
+size_t mem_parse_bytes(const char *s);
+
+/* $MEM_BUDGET in bytes, 0 = unlimited. */
+size_t mem_budget_from_env(void);
+
+typedef enum {
+    EIG_METHOD_DC = 0,   /* DSYEVD (divide & conquer) */
+    EIG_METHOD_MRRR,     /* DSYEVR (relatively robust representations) */
+    EIG_METHOD_QR,       /* DSYEV  (implicit QL/QR) */
+    EIG_METHOD_OOC,      /* out-of-core driver */
+    EIG_METHOD_COUNT
+} eig_method_t;
+
+typedef struct {
+    eig_method_t method;
+    int    lwork;        /* from the LAPACK workspace query */
+    int    liwork;       /* 0 where the routine has no IWORK */
+    size_t bytes;        /* A + W + Z + workspace the driver will hold */
+} eig_footprint_t;
+
+const char *eig_method_name(eig_method_t m);      /* "dc", "mrrr", ... */
+const char *eig_method_routine(eig_method_t m);   /* "DSYEVD", ...     */
+
+/* DSYEVD's LWORK from a workspace query `queried`. LAPACK computes the
+   JOBZ='V' minimum 1+6n+2n^2 in int, which wraps past n ~ 32k and
+   under-reports; the result is raised to that minimum, in double. */
+double eig_dsyevd_lwork(char jobz, int n, double queried);
+
+/* `w` as an LP64 LWORK: *lwork = max(1, w) and 0, or -1 when w exceeds
+   INT_MAX (no 32-bit LWORK can express it; *lwork untouched). */
+int  eig_lwork_int(double w, int *lwork);
+
+/* Workspace query for one in-core method. Returns LAPACK INFO (0 = ok), or
+   -1 when the workspace exceeds INT_MAX (LP64 LWORK): bytes is then
+   (size_t)-1 so the planner never picks the method. */
+int  eig_footprint(eig_method_t m, char jobz, char uplo, int n, eig_footprint_t *f);
+
+/* Pick the fastest method whose footprint fits `budget` bytes (0 = no limit
+   -> DC). `fp` (may be NULL) receives the DC/MRRR/QR footprints; the table
+   and the decision are printed to `log` when non-NULL. */
+eig_method_t eig_plan_for_budget(char jobz, char uplo, int n, size_t budget,
+                                 eig_footprint_t fp[EIG_METHOD_OOC], FILE *log);
+
+#endif /* MEM_BUDGET_H */
@@ -0,0 +1,139 @@
+// mmap_matrix.c — file-backed column-major matrices (see mmap_matrix.h).
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "mmap_matrix.h"
+
+static size_t page_bytes(void) {
+    long p = sysconf(_SC_PAGESIZE);
+    return (p > 0) ? (size_t)p : 4096u;
+}
+
+static int map_fd(mmap_matrix_t *m, int fd, int rows, int cols, int writable)
+{
+    m->rows  = rows;
+    m->cols  = cols;
+    m->bytes = (size_t)rows * (size_t)cols * sizeof(double);
+    m->fd    = fd;
+    m->keep  = writable;
+    m->a     = NULL;
+    if (m->bytes == 0) return 0;
+
+    void *p = mmap(NULL, m->bytes, writable ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                   MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) { perror("[mmap] mmap"); close(fd); m->fd = -1; return -1; }
+    m->a = (double*)p;
+    return 0;
+}
+
+int mmap_matrix_open(mmap_matrix_t *m, const char *path, int rows, int cols, int writable)
+{
+    int fd = open(path, writable ? O_RDWR : O_RDONLY);
+    if (fd < 0) { fprintf(stderr, "[mmap] open %s: %s\n", path, strerror(errno)); return -1; }
+
+    struct stat st;
+    size_t want = (size_t)rows * (size_t)cols * sizeof(double);
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size != want) {
+        fprintf(stderr, "[mmap] %s: size %lld bytes, expected %zu (%d x %d doubles)\n",
+                path, (long long)st.st_size, want, rows, cols);
+        close(fd);
+        return -2;
+    }
+    return map_fd(m, fd, rows, cols, writable);
+}
+
+int mmap_matrix_create(mmap_matrix_t *m, const char *path, int rows, int cols)
+{
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) { fprintf(stderr, "[mmap] create %s: %s\n", path, strerror(errno)); return -1; }
+    if (ftruncate(fd, (off_t)((size_t)rows * (size_t)cols * sizeof(double))) != 0) {
+        fprintf(stderr, "[mmap] ftruncate %s: %s\n", path, strerror(errno));
+        close(fd);
+        return -2;
+    }
+    return map_fd(m, fd, rows, cols, 1);
+}
+
+int mmap_matrix_scratch(mmap_matrix_t *m, const char *dir, int rows, int cols)
+{
+    if (!dir) dir = getenv("OOC_SCRATCH");
+    if (!dir) dir = getenv("TMPDIR");
+    if (!dir) dir = "/tmp";
+
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/ooc_scratch_XXXXXX", dir);
+    int fd = mkstemp(path);
+    if (fd < 0) { fprintf(stderr, "[mmap] mkstemp %s: %s\n", path, strerror(errno)); return -1; }
+    unlink(path);   /* space is reclaimed when the mapping is closed */
+    if (ftruncate(fd, (off_t)((size_t)rows * (size_t)cols * sizeof(double))) != 0) {
+        fprintf(stderr, "[mmap] ftruncate scratch: %s\n", strerror(errno));
+        close(fd);
+        return -2;
+    }
+    if (map_fd(m, fd, rows, cols, 1) != 0) return -1;
+    m->keep = 0;    /* unlinked: nothing to write back on close */
+    return 0;
+}
+
+void mmap_matrix_close(mmap_matrix_t *m)
+{
+    if (!m) return;
+    if (m->a) {
+        if (m->keep) msync(m->a, m->bytes, MS_SYNC);
+        munmap(m->a, m->bytes);
+    }
+    if (m->fd >= 0) close(m->fd);
+    m->a = NULL; m->fd = -1; m->bytes = 0;
+}
+
+/* page-aligned byte range covering columns [j0, j1) */
+static int col_range(const mmap_matrix_t *m, int j0, int j1, char **start, size_t *len)
+{
+    if (!m->a || j0 >= j1) return -1;
+    if (j0 < 0) j0 = 0;
+    if (j1 > m->cols) j1 = m->cols;
+    size_t pg = page_bytes();
+    size_t b0 = (size_t)j0 * (size_t)m->rows * sizeof(double);
+    size_t b1 = (size_t)j1 * (size_t)m->rows * sizeof(double);
+    b0 -= b0 % pg;
+    *start = (char*)m->a + b0;
+    *len   = b1 - b0;
+    return 0;
+}
+
+void mmap_matrix_prefetch(const mmap_matrix_t *m, int j0, int j1)
+{
+    char *p; size_t len;
+    if (col_range(m, j0, j1, &p, &len) == 0)
+        madvise(p, len, MADV_WILLNEED);
+}
+
+void mmap_matrix_release(const mmap_matrix_t *m, int j0, int j1)
+{
+    char *p; size_t len;
+    if (col_range(m, j0, j1, &p, &len) != 0) return;
+    msync(p, len, MS_SYNC);
+    madvise(p, len, MADV_DONTNEED);
+    posix_fadvise(m->fd, (off_t)(p - (char*)m->a), (off_t)len, POSIX_FADV_DONTNEED);
+}
+
+void io_counters(unsigned long long *read_bytes, unsigned long long *write_bytes)
+{
+    *read_bytes = *write_bytes = 0;
+    FILE *f = fopen("/proc/self/io", "r");
+    if (!f) return;
+    char key[64]; unsigned long long v;
+    while (fscanf(f, "%63[^:]: %llu\n", key, &v) == 2) {
+        if (strcmp(key, "read_bytes") == 0)  *read_bytes  = v;
+        if (strcmp(key, "write_bytes") == 0) *write_bytes = v;
+    }
+    fclose(f);
+}
@@ -0,0 +1,48 @@
+// mmap_matrix.h — file-backed (memory-mapped) column-major matrices.
+//
+// A mapped matrix lives in a file instead of anonymous memory, so the kernel
+// can write finished columns back and drop them under memory pressure; the
+// process footprint is bounded by the columns currently being worked on.
+// Files are raw column-major doubles, no header (rows*cols*8 bytes).
+
+#ifndef MMAP_MATRIX_H
+#define MMAP_MATRIX_H
+
+#include <stddef.h>
+
+typedef struct {
+    double *a;       /* mapping (column-major, leading dimension = rows) */
+    size_t  bytes;   /* mapped length                                   */
+    int     rows;
+    int     cols;
+    int     fd;      /* -1 once closed                                  */
+    int     keep;    /* 1: writable and the file outlives the process   */
+} mmap_matrix_t;
+
+/* Map an existing file of exactly rows*cols doubles.
+   writable=0 maps read-only; writable=1 maps MAP_SHARED read/write, so
+   stores go straight back to the file. Returns 0 on success. */
+int  mmap_matrix_open(mmap_matrix_t *m, const char *path, int rows, int cols, int writable);
+
+/* Create (or truncate) `path` to rows*cols doubles and map it read/write. */
+int  mmap_matrix_create(mmap_matrix_t *m, const char *path, int rows, int cols);
+
+/* Unlinked temporary file under `dir` (NULL: $OOC_SCRATCH, then $TMPDIR,
+   then /tmp), mapped read/write; the space is returned when closed. */
+int  mmap_matrix_scratch(mmap_matrix_t *m, const char *dir, int rows, int cols);
+
+/* unmap + close; mappings whose file is kept (open writable / create) are
+   msync'ed first, read-only and scratch mappings are not. */
+void mmap_matrix_close(mmap_matrix_t *m);
+
+/* Hint that columns [j0, j1) are about to be used. */
+void mmap_matrix_prefetch(const mmap_matrix_t *m, int j0, int j1);
+
+/* Write columns [j0, j1) back to the file and drop them from memory. */
+void mmap_matrix_release(const mmap_matrix_t *m, int j0, int j1);
+
+/* Process I/O counters from /proc/self/io (bytes actually hitting storage);
+   both are 0 where unavailable. */
+void io_counters(unsigned long long *read_bytes, unsigned long long *write_bytes);
+
+#endif /* MMAP_MATRIX_H */
@@ -0,0 +1,17 @@
+// now_sec.h — monotonic wall clock in seconds, shared by the common/src
+// solvers, their stage timers and the drivers. Header-only (static inline):
+// callers must see clock_gettime, i.e. build with
+// _POSIX_C_SOURCE >= 199309L or _GNU_SOURCE as the driver scripts do.
+
+#ifndef NOW_SEC_H
+#define NOW_SEC_H
+
+#include <time.h>
+
+static inline double now_sec(void)
+{
+    struct timespec t; clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+#endif /* NOW_SEC_H */
@@ -0,0 +1,263 @@
+// numa_alloc.c — NUMA-aware allocator (see numa_alloc.h for the policies).
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/mman.h>
+
+#include "numa_alloc.h"
+
+#ifdef HAVE_LIBNUMA
+#  include <numa.h>
+#  include <numaif.h>
+#endif
+
+#define NUMA_MAX_NODES      64
+#define NUMA_REPORT_SAMPLES 65536   /* pages queried by mem_report_placement */
+
+static size_t page_bytes(void) {
+    long p = sysconf(_SC_PAGESIZE);
+    return (p > 0) ? (size_t)p : 4096u;
+}
+
+mem_policy_t mem_policy_from_string(const char *s)
+{
+    if (!s) return MEM_POLICY_DEFAULT;
+    if (strcmp(s, "interleave") == 0) return MEM_POLICY_INTERLEAVE;
+    if (strcmp(s, "firsttouch") == 0) return MEM_POLICY_FIRSTTOUCH;
+    if (strcmp(s, "local") == 0)      return MEM_POLICY_LOCAL;
+    if (strcmp(s, "default") != 0)
+        fprintf(stderr, "[numa] unknown policy '%s', using default\n", s);
+    return MEM_POLICY_DEFAULT;
+}
+
+const char *mem_policy_name(mem_policy_t p)
+{
+    switch (p) {
+    case MEM_POLICY_INTERLEAVE: return "interleave";
+    case MEM_POLICY_FIRSTTOUCH: return "firsttouch";
+    case MEM_POLICY_LOCAL:      return "local";
+    default:                    return "default";
+    }
+}
+
+mem_policy_t mem_policy_from_env(void)
+{
+    return mem_policy_from_string(getenv("NUMA_POLICY"));
+}
+
+/* BLAS thread count as the drivers see it (OpenBLAS > OpenMP > ArmPL > 1). */
+static int env_threads(void)
+{
+    const char *names[] = { "OPENBLAS_NUM_THREADS", "OMP_NUM_THREADS", "ARMPL_NUM_THREADS" };
+    for (int i = 0; i < 3; ++i) {
+        const char *v = getenv(names[i]);
+        if (v && atoi(v) > 0) return atoi(v);
+    }
+    return 1;
+}
+
+/* ---------------- prefault / lock ---------------- */
+mem_prefault_t mem_prefault_from_env(void)
+{
+    const char *v = getenv("MEM_PREFAULT");
+    if (!v || !*v || strcmp(v, "0") == 0 || strcmp(v, "off") == 0) return MEM_PREFAULT_OFF;
+    if (strcmp(v, "populate") == 0) return MEM_PREFAULT_POPULATE;
+    if (strcmp(v, "touch") != 0 && strcmp(v, "1") != 0)
+        fprintf(stderr, "[mem] unknown MEM_PREFAULT '%s', using touch\n", v);
+    return MEM_PREFAULT_TOUCH;
+}
+
+int mem_lock_from_env(void)
+{
+    const char *v = getenv("MEM_LOCK");
+    return v && v[0] == '1';
+}
+
+const char *mem_prefault_name(mem_prefault_t m)
+{
+    switch (m) {
+    case MEM_PREFAULT_TOUCH:    return "touch";
+    case MEM_PREFAULT_POPULATE: return "populate";
+    default:                    return "off";
+    }
+}
+
+int mem_prefault(void *ptr, size_t bytes, int lock)
+{
+    if (!ptr || bytes == 0) return 0;
+    const size_t pg = page_bytes();
+    char *lo = (char*)((uintptr_t)ptr & ~(uintptr_t)(pg - 1));
+    char *hi = (char*)ptr + bytes;
+    int populated = 0;
+#ifdef MADV_POPULATE_WRITE
+    populated = (madvise(lo, (size_t)(hi - lo), MADV_POPULATE_WRITE) == 0);
+#endif
+    if (!populated) {
+        /* rewrite one byte per page with its own value: a write fault on
+           anonymous memory (no shared zero page) and contents unchanged */
+        for (volatile char *q = (volatile char*)ptr; (char*)q < hi;
+             q = (volatile char*)((uintptr_t)(q + pg) & ~(uintptr_t)(pg - 1)))
+            *q = *q;
+    }
+    if (lock && mlock(lo, (size_t)(hi - lo)) != 0) {
+        static int warned = 0;
+        if (!warned++) perror("[mem] mlock (raise ulimit -l / RLIMIT_MEMLOCK)");
+        return -1;
+    }
+    return 0;
+}
+
+/* ---------------- first-touch workers ---------------- */
+typedef struct {
+    char  *base;
+    size_t len;
+    int    cpu;     /* -1: do not pin */
+} touch_job_t;
+
+static void *touch_worker(void *arg)
+{
+    touch_job_t *job = (touch_job_t*)arg;
+    if (job->cpu >= 0) {
+        cpu_set_t set; CPU_ZERO(&set); CPU_SET(job->cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+    /* zero-fill = what the solver would see from calloc, and it faults the
+       pages in on this thread's node */
+    memset(job->base, 0, job->len);
+    return NULL;
+}
+
+/* Split [ptr, ptr+bytes) into `nt` page-aligned contiguous blocks — the same
+   contiguous column blocks a column-partitioned BLAS hands its threads — and
+   touch block t from a thread pinned to the t-th CPU of our affinity mask. */
+static void first_touch(char *ptr, size_t bytes, int nt)
+{
+    size_t pg = page_bytes();
+    size_t npages = (bytes + pg - 1) / pg;
+    if (nt < 1) nt = 1;
+    if ((size_t)nt > npages) nt = (int)npages;
+
+    cpu_set_t mask; CPU_ZERO(&mask);
+    int cpus[CPU_SETSIZE], ncpu = 0;
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+        for (int c = 0; c < CPU_SETSIZE; ++c)
+            if (CPU_ISSET(c, &mask)) cpus[ncpu++] = c;
+    }
+
+    touch_job_t *jobs = (touch_job_t*)calloc((size_t)nt, sizeof(touch_job_t));
+    pthread_t   *tids = (pthread_t*)  calloc((size_t)nt, sizeof(pthread_t));
+    if (!jobs || !tids) { memset(ptr, 0, bytes); free(tids); free(jobs); return; }
+
+    for (int t = 0; t < nt; ++t) {
+        size_t p0 = npages * (size_t)t / (size_t)nt;
+        size_t p1 = npages * (size_t)(t + 1) / (size_t)nt;
+        size_t b0 = p0 * pg, b1 = p1 * pg;
+        if (b1 > bytes) b1 = bytes;
+        jobs[t].base = ptr + b0;
+        jobs[t].len  = (b1 > b0) ? b1 - b0 : 0;
+        jobs[t].cpu  = ncpu ? cpus[t % ncpu] : -1;
+    }
+    int started = 0;
+    for (int t = 1; t < nt; ++t) {
+        if (pthread_create(&tids[t], NULL, touch_worker, &jobs[t]) != 0) break;
+        started = t;
+    }
+    /* block 0 on a pinned helper too, so the caller's own affinity is untouched */
+    pthread_t t0;
+    if (pthread_create(&t0, NULL, touch_worker, &jobs[0]) == 0) pthread_join(t0, NULL);
+    else memset(jobs[0].base, 0, jobs[0].len);
+    for (int t = 1; t <= started; ++t) pthread_join(tids[t], NULL);
+    for (int t = started + 1; t < nt; ++t) memset(jobs[t].base, 0, jobs[t].len);
+
+    free(tids); free(jobs);
+}
+
+void *mem_alloc(size_t bytes, mem_policy_t p, int nthreads)
+{
+    if (bytes == 0) bytes = 1;
+    const mem_prefault_t pf = mem_prefault_from_env();
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS, populated = 0;
+#ifdef MAP_POPULATE
+    /* only where no mbind has to come first: populating places the pages */
+    if (pf == MEM_PREFAULT_POPULATE && p == MEM_POLICY_DEFAULT) { flags |= MAP_POPULATE; populated = 1; }
+#endif
+    void *ptr = mmap(NULL, bytes, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (ptr == MAP_FAILED) return NULL;
+
+#ifdef HAVE_LIBNUMA
+    if (numa_available() >= 0 && numa_num_configured_nodes() > 1) {
+        int nnodes = numa_num_configured_nodes();
+        unsigned long mask[NUMA_MAX_NODES / (8 * sizeof(unsigned long)) + 1];
+        memset(mask, 0, sizeof(mask));
+        long rc = 0;
+
+        if (p == MEM_POLICY_INTERLEAVE) {
+            for (int nd = 0; nd < nnodes && nd < NUMA_MAX_NODES; ++nd)
+                mask[nd / (8 * sizeof(unsigned long))] |= 1ul << (nd % (8 * sizeof(unsigned long)));
+            rc = mbind(ptr, bytes, MPOL_INTERLEAVE, mask, NUMA_MAX_NODES, 0);
+        } else if (p == MEM_POLICY_LOCAL) {
+            const char *env = getenv("NUMA_NODE");
+            int nd = (env && *env) ? atoi(env) : numa_node_of_cpu(sched_getcpu());
+            if (nd < 0 || nd >= nnodes) nd = 0;
+            mask[nd / (8 * sizeof(unsigned long))] |= 1ul << (nd % (8 * sizeof(unsigned long)));
+            rc = mbind(ptr, bytes, MPOL_BIND, mask, NUMA_MAX_NODES, 0);
+        }
+        if (rc != 0) perror("[numa] mbind");
+    }
+#endif
+
+    if (p == MEM_POLICY_FIRSTTOUCH)
+        first_touch((char*)ptr, bytes, nthreads > 0 ? nthreads : env_threads());
+    else if (pf != MEM_PREFAULT_OFF && !populated)
+        mem_prefault(ptr, bytes, 0);
+    if (mem_lock_from_env()) mem_prefault(ptr, bytes, 1);
+    return ptr;
+}
+
+void mem_free(void *ptr, size_t bytes)
+{
+    if (!ptr) return;
+    if (bytes == 0) bytes = 1;
+    munmap(ptr, bytes);
+}
+
+void mem_report_placement(FILE *out, const char *label, const void *ptr, size_t bytes)
+{
+    if (!out || !ptr) return;
+    double mb = (double)bytes / (1024.0 * 1024.0);
+#ifdef HAVE_LIBNUMA
+    size_t pg = page_bytes();
+    size_t npages = (bytes + pg - 1) / pg;
+    size_t stride = (npages > NUMA_REPORT_SAMPLES) ? npages / NUMA_REPORT_SAMPLES : 1;
+    size_t ns = (npages + stride - 1) / stride;
+
+    void **pages  = (void**)malloc(ns * sizeof(void*));
+    int   *status = (int*)  malloc(ns * sizeof(int));
+    if (!pages || !status) { free(status); free(pages); return; }
+    for (size_t k = 0; k < ns; ++k) pages[k] = (char*)ptr + k * stride * pg;
+
+    unsigned long count[NUMA_MAX_NODES] = {0}, absent = 0;
+    if (move_pages(0, ns, pages, NULL, status, 0) == 0) {
+        for (size_t k = 0; k < ns; ++k) {
+            if (status[k] >= 0 && status[k] < NUMA_MAX_NODES) count[status[k]]++;
+            else absent++;
+        }
+        fprintf(out, "[numa] %-6s: %9.1f MB ", label, mb);
+        for (int nd = 0; nd < NUMA_MAX_NODES; ++nd)
+            if (count[nd]) fprintf(out, " node%d=%5.1f%%", nd, 100.0 * count[nd] / ns);
+        if (absent) fprintf(out, " unmapped=%5.1f%%", 100.0 * absent / ns);
+        fprintf(out, "  (pages sampled=%zu)\n", ns);
+    } else {
+        fprintf(out, "[numa] %-6s: %9.1f MB  placement query failed\n", label, mb);
+    }
+    free(status); free(pages);
+#else
+    fprintf(out, "[numa] %-6s: %9.1f MB  placement unavailable (built without HAVE_LIBNUMA)\n", label, mb);
+#endif
+}
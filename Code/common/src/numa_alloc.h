@@ -0,0 +1,74 @@
+// numa_alloc.h — NUMA-aware allocator for matrices and LAPACK workspaces.
+//
+// Policies (select with NUMA_POLICY=default|interleave|firsttouch|local):
+//   default    : plain anonymous pages, placed wherever they are first written
+//   interleave : pages round-robin over all NUMA nodes (mbind MPOL_INTERLEAVE)
+//   firsttouch : pages pre-touched in parallel, split into the same contiguous
+//                column blocks the BLAS threads work on, one pinned thread per
+//                block on the CPUs of the process affinity mask
+//   local      : all pages bound to one node (NUMA_NODE=<id>, or the node of
+//                the calling CPU) — one batch job per socket
+//
+// Build with -DHAVE_LIBNUMA ... -lnuma for mbind/move_pages; without it every
+// policy falls back to 'default' and placement is reported as unavailable.
+//
+// Prefaulting (keeps first-touch page faults out of timed regions):
+//   MEM_PREFAULT=0        off (default): pages fault in during the solve
+//   MEM_PREFAULT=touch    mem_alloc faults every page in after placement
+//                         (MADV_POPULATE_WRITE, else one write per page)
+//   MEM_PREFAULT=populate as touch, but default-policy mappings are created
+//                         with MAP_POPULATE (kernel fills them in mmap)
+//   MEM_LOCK=1            also mlock the allocation (needs RLIMIT_MEMLOCK /
+//                         CAP_IPC_LOCK; a failure is reported once and ignored)
+// Drivers call mem_prefault() on buffers not from mem_alloc (malloc'd
+// vectors, file mappings) before starting the clock.
+
+#ifndef NUMA_ALLOC_H
+#define NUMA_ALLOC_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+typedef enum {
+    MEM_POLICY_DEFAULT = 0,
+    MEM_POLICY_INTERLEAVE,
+    MEM_POLICY_FIRSTTOUCH,
+    MEM_POLICY_LOCAL
+} mem_policy_t;
+
+/* Parse "default|interleave|firsttouch|local"; NULL/unknown -> default. */
+mem_policy_t mem_policy_from_string(const char *s);
+const char   *mem_policy_name(mem_policy_t p);
+
+/* Policy from $NUMA_POLICY (default when unset). */
+mem_policy_t mem_policy_from_env(void);
+
+typedef enum {
+    MEM_PREFAULT_OFF = 0,
+    MEM_PREFAULT_TOUCH,
+    MEM_PREFAULT_POPULATE
+} mem_prefault_t;
+
+/* $MEM_PREFAULT ("0"/unset, "touch" or "1", "populate") and $MEM_LOCK. */
+mem_prefault_t mem_prefault_from_env(void);
+int            mem_lock_from_env(void);
+const char    *mem_prefault_name(mem_prefault_t m);
+
+/* Fault in every page of [ptr, ptr+bytes) for writing, keeping the contents
+   (private file mappings are copied here rather than inside the solve), and
+   mlock it when `lock` is set. Returns 0, or -1 when locking failed. */
+int mem_prefault(void *ptr, size_t bytes, int lock);
+
+/* Page-aligned allocation under policy `p`. `nthreads` is the BLAS thread
+   count used to partition first-touch (<=0: take it from the environment).
+   Prefaulted/locked per $MEM_PREFAULT / $MEM_LOCK (see above).
+   Returns NULL on failure. Release with mem_free(ptr, bytes). */
+void *mem_alloc(size_t bytes, mem_policy_t p, int nthreads);
+void  mem_free(void *ptr, size_t bytes);
+
+/* Print the per-node page distribution of [ptr, ptr+bytes) as one line:
+     [numa] <label>: <MB> MB  node0=..%  node1=..%  (pages sampled=...)
+   `out` may be stdout or a results file. */
+void mem_report_placement(FILE *out, const char *label, const void *ptr, size_t bytes);
+
+#endif /* NUMA_ALLOC_H */
@@ -0,0 +1,196 @@
+// rank1_update.c — rank-one eigendecomposition update (see rank1_update.h).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "rank1_update.h"
+#include "now_sec.h"
+
+/* --------- Fortran LAPACK/BLAS symbols (vendor-agnostic) --------- */
+extern void dgemv_(const char *TRANS, const int *M, const int *N,
+                   const double *ALPHA, const double *A, const int *LDA,
+                   const double *X, const int *INCX,
+                   const double *BETA, double *Y, const int *INCY);
+extern void dgemm_(const char *TRANSA, const char *TRANSB,
+                   const int *M, const int *N, const int *K,
+                   const double *ALPHA, const double *A, const int *LDA,
+                   const double *B, const int *LDB,
+                   const double *BETA, double *C, const int *LDC);
+extern void drot_(const int *N, double *X, const int *INCX, double *Y, const int *INCY,
+                  const double *C, const double *S);
+extern void dlaed9_(const int *K, const int *KSTART, const int *KSTOP, const int *N,
+                    double *D, double *Q, const int *LDQ, const double *RHO,
+                    double *DLAMDA, double *W, double *S, const int *LDS, int *INFO);
+extern double dlamch_(const char *CMACH);
+
+static int ws_reserve(rank1_ws_t *ws, size_t nd, size_t ni)
+{
+    if (ws->buf_len < nd) {
+        double *p = (double*)realloc(ws->buf, nd * sizeof(double));
+        if (!p) return -1;
+        ws->buf = p; ws->buf_len = nd;
+    }
+    if (ws->ibuf_len < ni) {
+        int *p = (int*)realloc(ws->ibuf, ni * sizeof(int));
+        if (!p) return -1;
+        ws->ibuf = p; ws->ibuf_len = ni;
+    }
+    return 0;
+}
+
+void rank1_ws_free(rank1_ws_t *ws)
+{
+    if (!ws) return;
+    free(ws->buf); free(ws->ibuf);
+    ws->buf = NULL; ws->ibuf = NULL; ws->buf_len = ws->ibuf_len = 0;
+}
+
+int eig_rank1_update(int n, double *D, double *V, int ldv, double rho, const double *z,
+                     rank1_ws_t *ws, rank1_stats_t *st)
+{
+    rank1_stats_t st_local;
+    rank1_ws_t ws_local = {0};
+    if (!st) st = &st_local;
+    memset(st, 0, sizeof(*st));
+    if (n < 0 || ldv < (n > 1 ? n : 1) || !D || !V || !z) return -1;
+    st->k = 0; st->deflated = n;
+    if (n == 0 || rho == 0.0) return 0;
+    if (!ws) ws = &ws_local;
+
+    const size_t nn = (size_t)n * (size_t)n;
+    /* w dw zw dl zk lam | Q/C (n x K) | S (K x K) | B (n x n) */
+    if (ws_reserve(ws, 6 * (size_t)n + 3 * nn, 4 * (size_t)n) != 0) { rank1_ws_free(&ws_local); return -2; }
+    double *w   = ws->buf;
+    double *dw  = w  + n;
+    double *zw  = dw + n;
+    double *dl  = zw + n;
+    double *zk  = dl + n;
+    double *lam = zk + n;
+    double *Q   = lam + n;
+    double *S   = Q + nn;
+    double *B   = S + nn;
+    int *nondefl = ws->ibuf;          /* working positions kept in the secular problem */
+    int *defl    = nondefl + n;       /* working positions deflated                    */
+    int *final   = defl + n;          /* merged order: >=0 nondefl index, <0 ~defl idx */
+
+    const int one = 1;
+    const double d_one = 1.0, d_zero = 0.0;
+    const double sgn = (rho < 0.0) ? -1.0 : 1.0;   /* rho < 0: eigen-update of -A */
+    double t0 = now_sec();
+
+    /* ---- 1) w = V^T z ---- */
+    dgemv_("T", &n, &n, &d_one, V, &ldv, z, &one, &d_zero, w, &one);
+    double t1 = now_sec();
+    st->t_project = t1 - t0;
+
+    /* Working order: poles sgn*D ascending. D is ascending, so for rho < 0
+       the working position i maps to column n-1-i. */
+    #define COL(i) ((sgn > 0.0) ? (i) : (n - 1 - (i)))
+    double wnorm2 = 0.0;
+    for (int i = 0; i < n; ++i) {
+        dw[i] = sgn * D[COL(i)];
+        zw[i] = w[COL(i)];
+        wnorm2 += zw[i] * zw[i];
+    }
+    if (wnorm2 == 0.0) { st->t_deflate = now_sec() - t1; rank1_ws_free(&ws_local); return 0; }
+
+    /* ---- 2) deflation (DLAED2): normalise z, rho_eff = |rho| * ||w||^2 ---- */
+    const double wnorm = sqrt(wnorm2);
+    const double rho_eff = fabs(rho) * wnorm2;
+    double dmax = 0.0, zmax = 0.0;
+    for (int i = 0; i < n; ++i) {
+        zw[i] /= wnorm;
+        if (fabs(dw[i]) > dmax) dmax = fabs(dw[i]);
+        if (fabs(zw[i]) > zmax) zmax = fabs(zw[i]);
+    }
+    const double eps = dlamch_("E");
+    const double tol = 8.0 * eps * (dmax > zmax ? dmax : zmax);
+
+    int k = 0, nd = 0, pj = -1;
+    for (int j = 0; j < n; ++j) {
+        if (rho_eff * fabs(zw[j]) <= tol) { defl[nd++] = j; continue; }
+        if (pj < 0) { pj = j; continue; }
+        /* nearly equal poles: rotate z_pj into z_j */
+        double s = zw[pj], c = zw[j];
+        const double tau = hypot(c, s);
+        const double t = dw[j] - dw[pj];
+        c /= tau; s = -s / tau;
+        if (fabs(t * c * s) <= tol) {
+            zw[j] = tau; zw[pj] = 0.0;
+            drot_(&n, V + (size_t)COL(pj) * ldv, &one, V + (size_t)COL(j) * ldv, &one, &c, &s);
+            const double dp = dw[pj] * c * c + dw[j] * s * s;
+            dw[j]  = dw[pj] * s * s + dw[j] * c * c;
+            dw[pj] = dp;
+            defl[nd++] = pj;
+            pj = j;
+        } else {
+            nondefl[k++] = pj;
+            pj = j;
+        }
+    }
+    if (pj >= 0) nondefl[k++] = pj;
+    st->k = k; st->deflated = nd;
+
+    /* gather: B = [V(:,nondefl) | V(:,defl)] in working order */
+    for (int i = 0; i < k; ++i) {
+        dl[i] = dw[nondefl[i]];
+        zk[i] = zw[nondefl[i]];
+        memcpy(B + (size_t)i * n, V + (size_t)COL(nondefl[i]) * ldv, (size_t)n * sizeof(double));
+    }
+    for (int i = 0; i < nd; ++i)
+        memcpy(B + (size_t)(k + i) * n, V + (size_t)COL(defl[i]) * ldv, (size_t)n * sizeof(double));
+    double t2 = now_sec();
+    st->t_deflate = t2 - t1;
+
+    /* ---- 3) secular equation + eigenvectors of diag(dl) + rho_eff zk zk^T ---- */
+    int info = 0;
+    if (k > 0) {
+        const int kk = k;
+        dlaed9_(&kk, &one, &kk, &kk, lam, Q, &kk, &rho_eff, dl, zk, S, &kk, &info);
+    }
+    double t3 = now_sec();
+    st->t_secular = t3 - t2;
+    if (info != 0) { rank1_ws_free(&ws_local); return info; }
+
+    /* ---- 4) C = B(:,1:k) * S  (C reuses Q, n x k) ---- */
+    double *C = Q;
+    if (k > 0)
+        dgemm_("N", "N", &n, &k, &k, &d_one, B, &n, S, &k, &d_zero, C, &n);
+    double t4 = now_sec();
+    st->t_gemm = t4 - t3;
+
+    /* ---- 5) merge new roots (ascending) with deflated poles (nearly sorted) ---- */
+    for (int i = 1; i < nd; ++i) {     /* insertion sort by dw; B's deflated columns follow defl[] */
+        const int pos = defl[i];
+        const double v = dw[pos];
+        if (dw[defl[i - 1]] <= v) continue;
+        memcpy(w, B + (size_t)(k + i) * n, (size_t)n * sizeof(double));   /* w is free now */
+        int j = i - 1;
+        while (j >= 0 && dw[defl[j]] > v) {
+            defl[j + 1] = defl[j];
+            memcpy(B + (size_t)(k + j + 1) * n, B + (size_t)(k + j) * n, (size_t)n * sizeof(double));
+            --j;
+        }
+        defl[j + 1] = pos;
+        memcpy(B + (size_t)(k + j + 1) * n, w, (size_t)n * sizeof(double));
+    }
+    int a = 0, b = 0;
+    for (int m = 0; m < n; ++m) {
+        if (b >= nd || (a < k && lam[a] <= dw[defl[b]])) final[m] = a++;
+        else                                               final[m] = ~(b++);
+    }
+    for (int m = 0; m < n; ++m) {
+        const int dst = (sgn > 0.0) ? m : n - 1 - m;   /* back to ascending real order */
+        const int f = final[m];
+        const double *src = (f >= 0) ? C + (size_t)f * n : B + (size_t)(k + ~f) * n;
+        D[dst] = sgn * ((f >= 0) ? lam[f] : dw[defl[~f]]);
+        memcpy(V + (size_t)dst * ldv, src, (size_t)n * sizeof(double));
+    }
+    #undef COL
+    st->t_assemble = now_sec() - t4;
+
+    rank1_ws_free(&ws_local);
+    return 0;
+}
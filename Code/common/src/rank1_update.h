@@ -0,0 +1,44 @@
+// rank1_update.h — update an eigendecomposition after a rank-one change.
+//
+// Given A = V diag(D) V^T (D ascending, V orthonormal n x n), compute the
+// eigendecomposition of A + rho z z^T in O(n^2) + one GEMM instead of a new
+// O(n^3) DSYEVD. This is the merge step of LAPACK's divide & conquer
+// (Bunch–Nielsen–Sorensen, as in DLAED1/DLAED2/DLAED3) for an arbitrary z:
+//   1) w = V^T z                                           (DGEMV)
+//   2) deflation: rho*|w_i| <= tol keeps (d_i, v_i); nearly equal poles
+//      are merged with a Givens rotation of their columns (DLAED2 rules)
+//   3) secular equation for the K surviving poles and the Gu–Eisenstat
+//      eigenvectors of diag(d) + rho w w^T                      (DLAED9/DLAED4)
+//   4) V_K <- V_K S                                           (one DGEMM)
+// rho < 0 is handled by solving the negated problem.
+
+#ifndef RANK1_UPDATE_H
+#define RANK1_UPDATE_H
+
+#include <stddef.h>
+
+/* Reusable buffers; zero-initialise, grown on demand, rank1_ws_free() at the end. */
+typedef struct {
+    double *buf;   size_t buf_len;    /* doubles */
+    int    *ibuf;  size_t ibuf_len;   /* ints    */
+} rank1_ws_t;
+
+typedef struct {
+    int    k;              /* non-deflated poles (size of the secular problem) */
+    int    deflated;       /* n - k                                            */
+    double t_project;      /* seconds: w = V^T z                               */
+    double t_deflate;      /* seconds: deflation + rotations                   */
+    double t_secular;      /* seconds: DLAED9 (roots + vectors of the K x K)   */
+    double t_gemm;         /* seconds: V_K S                                   */
+    double t_assemble;     /* seconds: sort + column placement                 */
+} rank1_stats_t;
+
+/* A + rho z z^T. On return D (ascending) and V hold the new decomposition.
+   ws / st may be NULL. Returns 0, >0 secular-equation failure (DLAED9 INFO),
+   <0 bad argument / allocation failure. */
+int  eig_rank1_update(int n, double *D, double *V, int ldv, double rho, const double *z,
+                      rank1_ws_t *ws, rank1_stats_t *st);
+
+void rank1_ws_free(rank1_ws_t *ws);
+
+#endif /* RANK1_UPDATE_H */
@@ -0,0 +1,211 @@
+// stage_pipe.c — pinned stage workers over bounded FIFO queues (see stage_pipe.h).
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <pthread.h>
+
+#include "stage_pipe.h"
+#include "now_sec.h"
+
+/* --------- Bounded queue --------- */
+
+typedef struct { void *slot; long job; int failed; double t_fed; } item_t;
+
+typedef struct {
+    item_t         *buf;
+    int             cap, head, count, closed;
+    pthread_mutex_t mu;
+    pthread_cond_t  not_empty, not_full;
+} queue_t;
+
+static int q_init(queue_t *q, int cap)
+{
+    memset(q, 0, sizeof(*q));
+    q->buf = (item_t*)malloc((size_t)cap * sizeof(item_t));
+    if (!q->buf) return -1;
+    q->cap = cap;
+    pthread_mutex_init(&q->mu, NULL);
+    pthread_cond_init(&q->not_empty, NULL);
+    pthread_cond_init(&q->not_full, NULL);
+    return 0;
+}
+
+static void q_destroy(queue_t *q)
+{
+    if (!q->buf) return;
+    pthread_cond_destroy(&q->not_full);
+    pthread_cond_destroy(&q->not_empty);
+    pthread_mutex_destroy(&q->mu);
+    free(q->buf);
+}
+
+/* 1 with an item, 0 once the queue is closed and drained */
+static int q_pop(queue_t *q, item_t *out, double *waited)
+{
+    const double t0 = now_sec();
+    pthread_mutex_lock(&q->mu);
+    while (q->count == 0 && !q->closed) pthread_cond_wait(&q->not_empty, &q->mu);
+    const int got = q->count > 0;
+    if (got) {
+        *out = q->buf[q->head];
+        q->head = (q->head + 1) % q->cap;
+        q->count--;
+        pthread_cond_signal(&q->not_full);
+    }
+    pthread_mutex_unlock(&q->mu);
+    *waited += now_sec() - t0;
+    return got;
+}
+
+static void q_push(queue_t *q, item_t it, double *waited)
+{
+    const double t0 = now_sec();
+    pthread_mutex_lock(&q->mu);
+    while (q->count == q->cap) pthread_cond_wait(&q->not_full, &q->mu);
+    q->buf[(q->head + q->count) % q->cap] = it;
+    q->count++;
+    pthread_cond_signal(&q->not_empty);
+    pthread_mutex_unlock(&q->mu);
+    *waited += now_sec() - t0;
+}
+
+static void q_close(queue_t *q)
+{
+    pthread_mutex_lock(&q->mu);
+    q->closed = 1;
+    pthread_cond_broadcast(&q->not_empty);
+    pthread_mutex_unlock(&q->mu);
+}
+
+/* --------- Workers --------- */
+
+typedef struct {
+    const stage_pipe_stage_t *stages;
+    int                 nstages;
+    void               *arg;
+    queue_t            *q;          /* q[s]: input of stage s            */
+    queue_t             free_q;     /* slots back from the last stage    */
+    int                *live;       /* running workers per stage         */
+    stage_pipe_stats_t *st;
+    double              lat_sum, lat_max;
+    long                failed;
+    pthread_mutex_t     mu;         /* live, st, latency                 */
+} pipe_t;
+
+typedef struct { pipe_t *P; int stage, worker, cpu; } worker_arg_t;
+
+static void *stage_worker(void *varg)
+{
+    const worker_arg_t *a = (const worker_arg_t*)varg;
+    pipe_t *P = a->P;
+    const int s = a->stage, last = (s == P->nstages - 1);
+    if (a->cpu >= 0) {
+        cpu_set_t set; CPU_ZERO(&set); CPU_SET(a->cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+    stage_pipe_stats_t loc = { 0, 0, 0.0, 0.0, 0.0 };
+    double lat_sum = 0.0, lat_max = 0.0;
+    long failed = 0;
+    item_t it;
+    while (q_pop(&P->q[s], &it, &loc.starve)) {
+        if (!it.failed) {
+            const double t0 = now_sec();
+            const int rc = P->stages[s].run(s, a->worker, it.job, it.slot, P->arg);
+            loc.busy += now_sec() - t0;
+            if (rc != 0) { it.failed = 1; loc.failed++; }
+        }
+        loc.jobs++;
+        if (!last) { q_push(&P->q[s + 1], it, &loc.blocked); continue; }
+        const double lat = now_sec() - it.t_fed;
+        lat_sum += lat;
+        if (lat > lat_max) lat_max = lat;
+        failed += it.failed;
+        q_push(&P->free_q, it, &loc.blocked);             /* never full: one entry per slot */
+    }
+    pthread_mutex_lock(&P->mu);
+    stage_pipe_stats_t *g = &P->st[s];
+    g->jobs += loc.jobs; g->failed += loc.failed;
+    g->busy += loc.busy; g->starve += loc.starve; g->blocked += loc.blocked;
+    P->lat_sum += lat_sum;
+    if (lat_max > P->lat_max) P->lat_max = lat_max;
+    P->failed += failed;
+    if (--P->live[s] == 0 && !last) q_close(&P->q[s + 1]);   /* the last one out closes downstream */
+    pthread_mutex_unlock(&P->mu);
+    return NULL;
+}
+
+/* --------- Executor --------- */
+
+int stage_pipe_run(const stage_pipe_stage_t *stages, int nstages,
+                   void **slots, int nslots, int qcap, long njobs, void *arg,
+                   stage_pipe_stats_t *st, stage_pipe_summary_t *sum)
+{
+    memset(st, 0, (size_t)(nstages > 0 ? nstages : 0) * sizeof(*st));
+    memset(sum, 0, sizeof(*sum));
+    if (nstages < 1 || nslots < 1 || njobs < 0) return -1;
+    if (qcap < 1) qcap = 1;
+
+    int nworkers = 0;
+    for (int s = 0; s < nstages; ++s) nworkers += stages[s].ncpus > 0 ? stages[s].ncpus : 1;
+    pipe_t P;
+    memset(&P, 0, sizeof(P));
+    P.stages = stages; P.nstages = nstages; P.arg = arg; P.st = st;
+    P.q = (queue_t*)calloc((size_t)nstages, sizeof(queue_t));
+    P.live = (int*)calloc((size_t)nstages, sizeof(int));
+    worker_arg_t *wa = (worker_arg_t*)calloc((size_t)nworkers, sizeof(worker_arg_t));
+    pthread_t *tid = (pthread_t*)calloc((size_t)nworkers, sizeof(pthread_t));
+    int ok = P.q && P.live && wa && tid && q_init(&P.free_q, nslots) == 0;
+    for (int s = 0; ok && s < nstages; ++s) ok = q_init(&P.q[s], qcap) == 0;
+    if (!ok) {
+        for (int s = 0; P.q && s < nstages; ++s) q_destroy(&P.q[s]);
+        q_destroy(&P.free_q);
+        free(tid); free(wa); free(P.live); free(P.q);
+        return -1;
+    }
+    pthread_mutex_init(&P.mu, NULL);
+    double dummy = 0.0;
+    for (int i = 0; i < nslots; ++i) {
+        item_t it = { slots[i], -1, 0, 0.0 };
+        q_push(&P.free_q, it, &dummy);
+    }
+
+    int started = 0, w = 0;
+    for (int s = 0; s < nstages; ++s) {
+        const int nw = stages[s].ncpus > 0 ? stages[s].ncpus : 1;
+        P.live[s] = nw;
+        for (int k = 0; k < nw; ++k, ++w) {
+            wa[w].P = &P; wa[w].stage = s; wa[w].worker = k;
+            wa[w].cpu = stages[s].cpus ? stages[s].cpus[k] : -1;
+        }
+    }
+    for (; started < nworkers; ++started)
+        if (pthread_create(&tid[started], NULL, stage_worker, &wa[started]) != 0) break;
+
+    const double t_start = now_sec();
+    if (started == nworkers) {
+        for (long j = 0; j < njobs; ++j) {
+            item_t it;
+            q_pop(&P.free_q, &it, &sum->feed_wait);
+            it.job = j; it.failed = 0; it.t_fed = now_sec();
+            q_push(&P.q[0], it, &dummy);
+        }
+    } else {
+        fprintf(stderr, "[stage_pipe] pthread_create failed (%d of %d workers)\n", started, nworkers);
+        for (int s = 1; s < nstages; ++s) q_close(&P.q[s]);   /* workers exit on empty, closed queues */
+    }
+    q_close(&P.q[0]);
+    for (int t = 0; t < started; ++t) pthread_join(tid[t], NULL);
+    sum->seconds = now_sec() - t_start;
+    sum->lat_avg = njobs > 0 ? P.lat_sum / njobs : 0.0;
+    sum->lat_max = P.lat_max;
+    const int ret = (started == nworkers) ? (int)P.failed : -1;
+
+    pthread_mutex_destroy(&P.mu);
+    for (int s = 0; s < nstages; ++s) q_destroy(&P.q[s]);
+    q_destroy(&P.free_q);
+    free(tid); free(wa); free(P.live); free(P.q);
+    return ret;
+}
@@ -0,0 +1,59 @@
+// stage_pipe.h — bounded stage pipeline for streams of independent jobs:
+// job i can be in stage s+1 while job i+1 is in stage s, so a memory-bound
+// stage (DSYTRD) and a compute-bound one (the D&C merges) overlap instead
+// of taking turns.
+//
+// Every stage owns a partition of CPUs and runs one worker thread per CPU
+// of it, pinned there (pthread_setaffinity_np, as numa_alloc.c pins its
+// touch threads); a stage therefore scales by working on several jobs at
+// once, each with single-threaded BLAS. One thread per call site is the
+// only split the BLAS backends allow: OpenBLAS and ArmPL size one
+// process-wide thread pool, not one per caller.
+//
+// Jobs live in caller-provided slots (matrix + vectors). The caller's
+// thread feeds job indices 0..njobs-1, each into a free slot; a slot comes
+// back to the free list after the last stage, so at most nslots jobs are in
+// flight and memory stays bounded. Between stages sit FIFO queues of
+// `qcap` entries: a full queue blocks the stage before it (back-pressure),
+// an empty one starves the stage after it; both waits are timed. A job
+// whose stage function returns non-zero skips the remaining stages.
+//
+// Stage functions run concurrently; the LAPACK/BLAS wrapper counters are
+// atomic (wrap_timers.c), so per-routine timings stay exact here, summed
+// over all workers.
+
+#ifndef STAGE_PIPE_H
+#define STAGE_PIPE_H
+
+/* Runs stage `stage` of job `job` in `slot` on worker `worker` (0-based
+   within the stage). Returns 0, or non-zero to drop the job. */
+typedef int (*stage_pipe_fn)(int stage, int worker, long job, void *slot, void *arg);
+
+typedef struct {
+    const char   *name;
+    stage_pipe_fn run;
+    const int    *cpus;      /* the partition: one worker per CPU id        */
+    int           ncpus;     /* >= 1; cpus == NULL: ncpus unpinned workers   */
+} stage_pipe_stage_t;
+
+typedef struct {
+    long   jobs, failed;
+    double busy;             /* seconds in run(), summed over the workers   */
+    double starve;           /* waiting for input                           */
+    double blocked;          /* waiting for room downstream                 */
+} stage_pipe_stats_t;
+
+typedef struct {
+    double seconds;          /* first feed to last job out                  */
+    double lat_avg, lat_max; /* per job: fed into stage 0 to out of the last */
+    double feed_wait;        /* feeder waiting for a free slot              */
+} stage_pipe_summary_t;
+
+/* Runs njobs jobs through nstages stages. st: nstages entries. Returns 0,
+   the number of failed jobs, or -1 when a worker thread cannot be started
+   or on allocation failure (nothing is run then). */
+int stage_pipe_run(const stage_pipe_stage_t *stages, int nstages,
+                   void **slots, int nslots, int qcap, long njobs, void *arg,
+                   stage_pipe_stats_t *st, stage_pipe_summary_t *sum);
+
+#endif /* STAGE_PIPE_H */
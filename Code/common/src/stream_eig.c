@@ -0,0 +1,200 @@
+// stream_eig.c — sliding-window eigen updates (see stream_eig.h).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "stream_eig.h"
+#include "now_sec.h"
+#include "mem_budget.h"   /* eig_dsyevd_lwork / eig_lwork_int */
+
+/* --------- Fortran LAPACK/BLAS symbols (vendor-agnostic) --------- */
+extern void dsyevd_(const char *JOBZ, const char *UPLO, const int *N,
+                    double *A, const int *LDA, double *W,
+                    double *WORK, const int *LWORK,
+                    int *IWORK, const int *LIWORK,
+                    int *INFO);
+extern void dsyr_(const char *UPLO, const int *N, const double *ALPHA,
+                  const double *X, const int *INCX, double *A, const int *LDA);
+extern void dsymv_(const char *UPLO, const int *N, const double *ALPHA,
+                   const double *A, const int *LDA, const double *X, const int *INCX,
+                   const double *BETA, double *Y, const int *INCY);
+extern void dgemv_(const char *TRANS, const int *M, const int *N,
+                   const double *ALPHA, const double *A, const int *LDA,
+                   const double *X, const int *INCX,
+                   const double *BETA, double *Y, const int *INCY);
+
+/* xorshift64* in (-1, 1) for the probe */
+static double srand_pm1(unsigned long long *st) {
+    *st ^= *st >> 12; *st ^= *st << 25; *st ^= *st >> 27;
+    return ((*st * 2685821657736338717ull) >> 11) * (2.0 / 9007199254740992.0) - 1.0;
+}
+
+void stream_eig_free(stream_eig_t *s)
+{
+    if (!s) return;
+    rank1_ws_free(&s->ws);
+    free(s->probe); free(s->iwork); free(s->work);
+    free(s->V); free(s->D); free(s->S);
+    memset(s, 0, sizeof(*s));
+}
+
+int stream_eig_init(stream_eig_t *s, int n, const double *S0, double tol, int refresh_every)
+{
+    memset(s, 0, sizeof(*s));
+    if (n <= 0) return -1;
+    const size_t nn = (size_t)n * n;
+    s->n = n;
+    s->tol = tol > 0.0 ? tol : 1e-10;
+    s->refresh_every = refresh_every > 0 ? refresh_every : 0;
+    s->rng = 0x2545F4914F6CDD1Dull;
+    s->auto_refresh = 1;
+
+    s->S     = (double*)calloc(nn, sizeof(double));
+    s->V     = (double*)calloc(nn, sizeof(double));
+    s->D     = (double*)calloc((size_t)n, sizeof(double));
+    s->probe = (double*)malloc(4 * (size_t)n * sizeof(double));
+    if (!s->S || !s->V || !s->D || !s->probe) { stream_eig_free(s); return -2; }
+
+    /* DSYEVD workspace for refreshes, sized once */
+    const char jobz = 'V', uplo = 'U';
+    int info = 0, lq = -1, liq = -1, iwq = 0;
+    double wq = 0.0;
+    dsyevd_(&jobz, &uplo, &n, s->V, &n, s->D, &wq, &lq, &iwq, &liq, &info);
+    if (info != 0) { stream_eig_free(s); return info; }
+    wq = eig_dsyevd_lwork(jobz, n, wq);
+    if (eig_lwork_int(wq, &s->lwork) != 0) {  /* LP64 LWORK cannot express it */
+        fprintf(stderr, "[stream_eig] n=%d: DSYEVD LWORK %.0f exceeds INT_MAX\n", n, wq);
+        stream_eig_free(s); return -3;
+    }
+    s->liwork = iwq;
+    s->work  = (double*)malloc((size_t)s->lwork * sizeof(double));
+    s->iwork = (int*)malloc((size_t)s->liwork * sizeof(int));
+    if (!s->work || !s->iwork) { stream_eig_free(s); return -2; }
+
+    if (S0) {
+        for (int j = 0; j < n; ++j)
+            memcpy(s->S + (size_t)j * n, S0 + (size_t)j * n, (size_t)(j + 1) * sizeof(double));
+        return stream_eig_refresh(s);
+    }
+    /* empty window: D = 0, V = I */
+    for (int i = 0; i < n; ++i) s->V[i + (size_t)i * n] = 1.0;
+    return 0;
+}
+
+int stream_eig_refresh(stream_eig_t *s)
+{
+    const int n = s->n;
+    const char jobz = 'V', uplo = 'U';
+    int info = 0;
+    for (int j = 0; j < n; ++j)
+        memcpy(s->V + (size_t)j * n, s->S + (size_t)j * n, (size_t)(j + 1) * sizeof(double));
+    const double t0 = now_sec();
+    dsyevd_(&jobz, &uplo, &n, s->V, &n, s->D, s->work, &s->lwork, s->iwork, &s->liwork, &info);
+    const double dt = now_sec() - t0;
+    s->t_full = s->t_full > 0.0 ? 0.75 * s->t_full + 0.25 * dt : dt;
+    s->since_refresh = 0;
+    s->refreshes++;
+    s->err = 0.0;
+    return info;
+}
+
+double stream_eig_error(stream_eig_t *s)
+{
+    const int n = s->n, one = 1;
+    const double d_one = 1.0, d_zero = 0.0;
+    double *g = s->probe, *y = g + n, *sy = y + n, *t = sy + n;
+
+    double gn = 0.0, smax = 0.0;
+    for (int i = 0; i < n; ++i) { g[i] = srand_pm1(&s->rng); gn += g[i] * g[i]; }
+    gn = sqrt(gn);
+    for (int j = 0; j < n; ++j)
+        for (int i = 0; i <= j; ++i) {
+            double a = fabs(s->S[i + (size_t)j * n]);
+            if (a > smax) smax = a;
+        }
+
+    /* orth: V^T (V g) - g */
+    dgemv_("N", &n, &n, &d_one, s->V, &n, g, &one, &d_zero, y, &one);
+    dgemv_("T", &n, &n, &d_one, s->V, &n, y, &one, &d_zero, t, &one);
+    double eo = 0.0;
+    for (int i = 0; i < n; ++i) eo += (t[i] - g[i]) * (t[i] - g[i]);
+    eo = sqrt(eo) / gn;
+
+    /* res: S (V g) - V (D g) */
+    dsymv_("U", &n, &d_one, s->S, &n, y, &one, &d_zero, sy, &one);
+    for (int i = 0; i < n; ++i) t[i] = s->D[i] * g[i];
+    const double m_one = -1.0;
+    dgemv_("N", &n, &n, &m_one, s->V, &n, t, &one, &d_one, sy, &one);
+    double er = 0.0;
+    for (int i = 0; i < n; ++i) er += sy[i] * sy[i];
+    er = (smax > 0.0) ? sqrt(er) / (smax * gn) : 0.0;
+
+    s->err = eo > er ? eo : er;
+    return s->err;
+}
+
+int stream_eig_tick(stream_eig_t *s, int k_add, const double *Xadd, int ldx_add,
+                    int k_drop, const double *Xdrop, int ldx_drop, stream_tick_t *tk)
+{
+    stream_tick_t tl;
+    if (!tk) tk = &tl;
+    memset(tk, 0, sizeof(*tk));
+    const int n = s->n, one = 1;
+    const double p_one = 1.0, m_one = -1.0;
+    rank1_stats_t st;
+    int info = 0;
+
+    /* Past the crossover k * t_merge > t_full a refresh is cheaper than the
+       merges: update S only and rebuild. Every STREAM_REPROBE-th such tick
+       still merges, so t_merge follows the deflation rate of the window. */
+    int merge = 1;
+    if (s->auto_refresh && s->t_full > 0.0 && s->t_merge > 0.0 &&
+        (k_add + k_drop) * s->t_merge > s->t_full) {
+        merge = (++s->bypass_run % STREAM_REPROBE) == 0;
+    } else {
+        s->bypass_run = 0;
+    }
+
+    /* S takes every observation; after a failed merge (secular solver) the
+       remaining merges are skipped and the refresh below rebuilds from S.
+       Additions first: the window stays positive semidefinite in between. */
+    double t0 = now_sec();
+    for (int j = 0; j < k_add; ++j) {
+        const double *x = Xadd + (size_t)j * ldx_add;
+        dsyr_("U", &n, &p_one, x, &one, s->S, &n);
+        if (!merge || info != 0) continue;
+        info = eig_rank1_update(n, s->D, s->V, n, 1.0, x, &s->ws, &st);
+        tk->deflated += st.deflated; tk->merges++;
+    }
+    double t1 = now_sec();
+    for (int j = 0; j < k_drop; ++j) {
+        const double *x = Xdrop + (size_t)j * ldx_drop;
+        dsyr_("U", &n, &m_one, x, &one, s->S, &n);
+        if (!merge || info != 0) continue;
+        info = eig_rank1_update(n, s->D, s->V, n, -1.0, x, &s->ws, &st);
+        tk->deflated += st.deflated; tk->merges++;
+    }
+    double t2 = now_sec();
+    tk->t_add = t1 - t0; tk->t_drop = t2 - t1;
+    s->ticks++; s->since_refresh++;
+    if (merge && info == 0 && tk->merges > 0) {
+        const double per = (t2 - t0) / tk->merges;
+        s->t_merge = s->t_merge > 0.0 ? 0.75 * s->t_merge + 0.25 * per : per;
+    }
+
+    tk->bypassed = !merge;
+    tk->err = (merge && info == 0) ? stream_eig_error(s) : INFINITY;
+    double t3 = now_sec();
+    tk->t_check = t3 - t2;
+
+    if (!merge || info != 0 || tk->err > s->tol ||
+        (s->refresh_every > 0 && s->since_refresh >= s->refresh_every)) {
+        info = stream_eig_refresh(s);
+        tk->refreshed = 1;
+        tk->t_refresh = now_sec() - t3;
+        if (!merge && info == 0) tk->err = 0.0;
+    }
+    return info;
+}
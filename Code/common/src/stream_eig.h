@@ -0,0 +1,85 @@
+// stream_eig.h — sliding-window covariance eigendecomposition for streams.
+//
+// Keeps S = sum_{x in window} x x^T together with S = V diag(D) V^T. Each
+// tick adds k new observations (rank-k addition) and drops the k oldest
+// (rank-k downdate); both are applied as rank-one D&C merges with
+// eig_rank1_update() (rank1_update.h), so a tick costs O(k n^2) plus one
+// GEMM per non-deflated merge instead of a full DSYEVD.
+//
+// Error control: after every tick a random probe g estimates, in O(n^2),
+//   orth = ||V^T V g - g|| / ||g||
+//   res  = ||S V g - V D g|| / (||S||_max ||g||)
+// and when max(orth, res) exceeds `tol` (or every `refresh_every` ticks)
+// the decomposition is rebuilt from S with DSYEVD, which resets the drift
+// to working precision. S itself is maintained exactly with DSYR.
+//
+// Crossover: a merge costs O(n^2) plus a K x K GEMM on the K non-deflated
+// poles, up to 2 n^3 flops, against roughly 4/3 n^3 (DSYTRD) + the D&C and
+// its back-transform for a full DSYEVD. A tick of k merges (observations
+// added + dropped) therefore pays only while k * t_merge < t_full: dense
+// windows with little deflation cross over at k of about 3 (n = 200: one
+// merge ~2.5 ms, a DSYEVD ~8 ms; 4 in + 4 out is 8 merges, ~2.5x a solve),
+// low-rank windows that deflate most poles at much larger k. With auto_refresh
+// (default) both costs are measured as moving averages (t_merge per merge,
+// t_full per refresh, the first one in stream_eig_init when S0 is given)
+// and a tick past the crossover only updates S and refreshes.
+
+#ifndef STREAM_EIG_H
+#define STREAM_EIG_H
+
+#include "rank1_update.h"
+
+#define STREAM_REPROBE 32   /* past the crossover, still merge every N-th tick */
+
+typedef struct {
+    int    n;
+    double *S;            /* window scatter matrix, upper triangle (n x n) */
+    double *D;            /* eigenvalues, ascending                        */
+    double *V;            /* eigenvectors (n x n)                          */
+    double tol;           /* drift bound that triggers a refresh           */
+    int    refresh_every; /* also refresh every N ticks (0: bound only)    */
+    int    since_refresh;
+    long   ticks, refreshes;
+    double err;           /* last probe estimate                           */
+    int    auto_refresh;  /* 1 (default): refresh instead of merging past the crossover */
+    double t_merge;       /* moving average, seconds per rank-one merge (0: none yet) */
+    double t_full;        /* moving average, seconds per refresh DSYEVD (0: none yet) */
+    int    bypass_run;    /* consecutive ticks past the crossover          */
+    /* internals */
+    rank1_ws_t ws;
+    double *work; int lwork;        /* DSYEVD workspace (refresh) */
+    int    *iwork; int liwork;
+    double *probe;                  /* 4n: g, y, Sy, VDg          */
+    unsigned long long rng;
+} stream_eig_t;
+
+typedef struct {
+    double t_add, t_drop;      /* seconds in rank-one merges           */
+    double t_check;            /* seconds in the probe estimate        */
+    double t_refresh;          /* seconds in DSYEVD (0 if none)        */
+    int    deflated;           /* poles deflated over all merges       */
+    int    merges;
+    int    refreshed;          /* 1 if this tick rebuilt from S        */
+    int    bypassed;           /* 1 if it skipped the merges (crossover) */
+    double err;                /* probe estimate after the tick        */
+} stream_tick_t;
+
+/* S0 (n x n, upper triangle used) may be NULL for an empty window.
+   Returns 0, a LAPACK INFO, -2 on allocation failure, or -3 when the
+   DSYEVD workspace does not fit a 32-bit LWORK. */
+int    stream_eig_init(stream_eig_t *s, int n, const double *S0, double tol, int refresh_every);
+
+/* One tick: add the k_add columns of Xadd (n x k_add, ldx) and remove the
+   k_drop columns of Xdrop. Either count may be 0. tk may be NULL. */
+int    stream_eig_tick(stream_eig_t *s, int k_add, const double *Xadd, int ldx_add,
+                       int k_drop, const double *Xdrop, int ldx_drop, stream_tick_t *tk);
+
+/* Probe estimate of the current drift (see above). */
+double stream_eig_error(stream_eig_t *s);
+
+/* Rebuild (D, V) from S with DSYEVD. */
+int    stream_eig_refresh(stream_eig_t *s);
+
+void   stream_eig_free(stream_eig_t *s);
+
+#endif /* STREAM_EIG_H */
@@ -0,0 +1,225 @@
+// struct_op.c — matrix-free operators: FFT-embedded symmetric Toeplitz and
+// dense DSYMV (see struct_op.h).
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "struct_op.h"
+
+extern void dsymv_(const char *UPLO, const int *N, const double *ALPHA, const double *A,
+                   const int *LDA, const double *X, const int *INCX, const double *BETA,
+                   double *Y, const int *INCY);
+
+/* --------- Radix-2 FFT on h complex values (interleaved re, im) --------- */
+
+typedef struct {
+    int     n, m, h;        /* order, embedding size m = 2h                        */
+    double *lam;            /* h + 1 circulant eigenvalues lambda_0 .. lambda_h     */
+    double *tw;             /* e^{-2 pi i k / m}, k < h (interleaved)              */
+    double *ts;             /* per stage: e^{-2 pi i j / len} at [len/2 + j]       */
+    int    *rev;            /* bit reversal of 0 .. h-1                            */
+    double *buf;            /* m doubles = h complex                               */
+} toeplitz_ctx_t;
+
+/* In place; ts holds each stage's twiddles contiguously (the m-point table
+   read with stride h/len misses cache at large h). inv: conjugate
+   twiddles, no 1/h scaling. */
+static void fft_c(int h, double *z, const double *ts, const int *rev, int inv)
+{
+    for (int i = 0; i < h; ++i) {
+        const int j = rev[i];
+        if (j > i) {
+            double t = z[2*i]; z[2*i] = z[2*j]; z[2*j] = t;
+            t = z[2*i+1]; z[2*i+1] = z[2*j+1]; z[2*j+1] = t;
+        }
+    }
+    const double sg = inv ? -1.0 : 1.0;
+    for (int len = 2; len <= h; len <<= 1) {
+        const int half = len >> 1;
+        const double *tw = ts + 2 * (size_t)half;
+        for (int s = 0; s < h; s += len) {
+            double *a = z + 2 * (size_t)s, *b = a + 2 * (size_t)half;
+            for (int j = 0; j < half; ++j) {
+                const double wr = tw[2*j], wi = sg * tw[2*j+1];
+                const double br = b[2*j] * wr - b[2*j+1] * wi;
+                const double bi = b[2*j] * wi + b[2*j+1] * wr;
+                b[2*j]   = a[2*j] - br;   b[2*j+1] = a[2*j+1] - bi;
+                a[2*j]  += br;            a[2*j+1] += bi;
+            }
+        }
+    }
+}
+
+/* y = T x: z = x packed as h complex, Z = FFT(z); per pair (k, h-k) unpack
+   the real m-point spectrum X, scale by lambda, repack for the inverse. */
+static void toeplitz_apply(struct_op_t *op, const double *x, double *y)
+{
+    toeplitz_ctx_t *c = (toeplitz_ctx_t*)op->ctx;
+    const int h = c->h;
+    double *z = c->buf;
+    const double *tw = c->tw, *lam = c->lam;
+    memcpy(z, x, (size_t)c->n * sizeof(double));
+    memset(z + c->n, 0, (size_t)(c->m - c->n) * sizeof(double));
+    fft_c(h, z, c->ts, c->rev, 0);
+
+    {   /* k = 0 and h: X_0 = Re + Im, X_h = Re - Im (both real) */
+        const double y0 = lam[0] * (z[0] + z[1]), yh = lam[h] * (z[0] - z[1]);
+        z[0] = 0.5 * (y0 + yh);
+        z[1] = 0.5 * (y0 - yh);
+    }
+    for (int k = 1; k <= h / 2; ++k) {
+        const int q = h - k;
+        const double ar = z[2*k], ai = z[2*k+1], br = z[2*q], bi = z[2*q+1];
+        const double wr = tw[2*k], wi = tw[2*k+1];             /* w^k = e^{-2 pi i k/m} */
+        /* Fe = (Z_k + conj Z_q)/2, Fo = (Z_k - conj Z_q)/(2i); X_k = Fe + w^k Fo */
+        double er = 0.5 * (ar + br), ei = 0.5 * (ai - bi);
+        double or_ = 0.5 * (ai + bi), oi = -0.5 * (ar - br);
+        const double xkr = er + wr * or_ - wi * oi, xki = ei + wr * oi + wi * or_;
+        /* X_q = conj(Fe) - conj(w^k Fo)  (w^q = -conj w^k) */
+        const double xqr = er - (wr * or_ - wi * oi), xqi = -ei + (wr * oi + wi * or_);
+        const double ykr = lam[k] * xkr, yki = lam[k] * xki;
+        const double yqr = lam[q] * xqr, yqi = lam[q] * xqi;
+        /* inverse: Fe = (Y_k + conj Y_q)/2, Fo = (Y_k - conj Y_q) conj(w^k)/2, Z_k = Fe + i Fo */
+        er = 0.5 * (ykr + yqr); ei = 0.5 * (yki - yqi);
+        double dr = 0.5 * (ykr - yqr), di = 0.5 * (yki + yqi);
+        or_ = dr * wr + di * wi; oi = di * wr - dr * wi;
+        z[2*k] = er - oi; z[2*k+1] = ei + or_;
+        /* Z_q from the same pair: Fe_q = conj Fe, Fo_q = conj(Fo) (by symmetry of the real outputs) */
+        z[2*q] = er + oi; z[2*q+1] = -ei + or_;
+    }
+
+    fft_c(h, z, c->ts, c->rev, 1);
+    const double s = 1.0 / h;
+    for (int i = 0; i < c->n; ++i) y[i] = s * z[i];
+}
+
+static void toeplitz_destroy(struct_op_t *op)
+{
+    toeplitz_ctx_t *c = (toeplitz_ctx_t*)op->ctx;
+    if (!c) return;
+    free(c->buf); free(c->rev); free(c->ts); free(c->tw); free(c->lam); free(c);
+}
+
+struct_op_t *toeplitz_op_create(int n, const double *t)
+{
+    if (n < 1 || !t) return NULL;
+    int m = 4;
+    while (m < 2 * n) {
+        if (m > (1 << 29)) return NULL;
+        m <<= 1;
+    }
+    const int h = m / 2;
+    struct_op_t *op = (struct_op_t*)calloc(1, sizeof(struct_op_t));
+    toeplitz_ctx_t *c = (toeplitz_ctx_t*)calloc(1, sizeof(toeplitz_ctx_t));
+    if (!op || !c) { free(c); free(op); return NULL; }
+    op->ctx = c;
+    op->destroy = toeplitz_destroy;
+    c->n = n; c->m = m; c->h = h;
+    c->lam = (double*)malloc((size_t)(h + 1) * sizeof(double));
+    c->tw  = (double*)malloc((size_t)m * sizeof(double));
+    c->ts  = (double*)malloc((size_t)m * sizeof(double));
+    c->rev = (int*)malloc((size_t)h * sizeof(int));
+    c->buf = (double*)malloc((size_t)m * sizeof(double));
+    if (!c->lam || !c->tw || !c->ts || !c->rev || !c->buf) { struct_op_free(op); return NULL; }
+
+    for (int k = 0; k < h; ++k) {
+        const double a = -2.0 * M_PI * (double)k / (double)m;
+        c->tw[2*k] = cos(a); c->tw[2*k+1] = sin(a);
+    }
+    for (int half = 1; half < h; half <<= 1)
+        for (int j = 0; j < half; ++j) {                /* e^{-2 pi i j / len} = w^{j m / len} */
+            const size_t k = (size_t)j * (size_t)(h / half);
+            c->ts[2 * (half + j)] = c->tw[2 * k]; c->ts[2 * (half + j) + 1] = c->tw[2 * k + 1];
+        }
+    int bits = 0;
+    while ((1 << bits) < h) ++bits;
+    for (int i = 0; i < h; ++i) {
+        int r = 0;
+        for (int b = 0; b < bits; ++b) if (i & (1 << b)) r |= 1 << (bits - 1 - b);
+        c->rev[i] = r;
+    }
+
+    /* lambda = FFT_m(first column of C): forward real transform, unpacked */
+    double *z = c->buf;
+    memset(z, 0, (size_t)m * sizeof(double));
+    for (int j = 0; j < n; ++j) z[j] = t[j];
+    for (int j = 1; j < n; ++j) z[m - j] = t[j];
+    fft_c(h, z, c->ts, c->rev, 0);
+    c->lam[0] = z[0] + z[1];
+    c->lam[h] = z[0] - z[1];
+    for (int k = 1; k < h; ++k) {
+        const int q = h - k;
+        const double ar = z[2*k], ai = z[2*k+1], br = z[2*q], bi = z[2*q+1];
+        const double er = 0.5 * (ar + br), or_ = 0.5 * (ai + bi), oi = -0.5 * (ar - br);
+        c->lam[k] = er + c->tw[2*k] * or_ - c->tw[2*k+1] * oi;   /* imaginary part is 0 */
+    }
+    double nb = 0.0;
+    for (int k = 0; k <= h; ++k) if (fabs(c->lam[k]) > nb) nb = fabs(c->lam[k]);
+
+    op->n = n;
+    op->kind = "toeplitz";
+    op->norm_bound = nb;
+    op->bytes = (size_t)(h + 1 + 3 * (size_t)m) * sizeof(double) + (size_t)h * sizeof(int);
+    op->apply = toeplitz_apply;
+    return op;
+}
+
+struct_op_t *toeplitz_op_kms(int n, double rho, double delta)
+{
+    if (n < 1 || !(rho > -1.0 && rho < 1.0)) return NULL;
+    double *t = (double*)malloc((size_t)n * sizeof(double));
+    if (!t) return NULL;
+    t[0] = 1.0 + delta;
+    double p = 1.0;
+    for (int k = 1; k < n; ++k) { p *= rho; t[k] = p; }
+    struct_op_t *op = toeplitz_op_create(n, t);
+    free(t);
+    return op;
+}
+
+/* --------- Dense (DSYMV, upper triangle) --------- */
+
+typedef struct { const double *A; int lda; } dense_ctx_t;
+
+static void dense_apply(struct_op_t *op, const double *x, double *y)
+{
+    const dense_ctx_t *c = (const dense_ctx_t*)op->ctx;
+    const char uplo = 'U';
+    const int one = 1;
+    const double alpha = 1.0, beta = 0.0;
+    dsymv_(&uplo, &op->n, &alpha, c->A, &c->lda, x, &one, &beta, y, &one);
+}
+
+static void dense_destroy(struct_op_t *op) { free(op->ctx); }
+
+struct_op_t *dense_op_create(int n, const double *A, int lda)
+{
+    if (n < 1 || !A || lda < n) return NULL;
+    struct_op_t *op = (struct_op_t*)calloc(1, sizeof(struct_op_t));
+    dense_ctx_t *c = (dense_ctx_t*)malloc(sizeof(dense_ctx_t));
+    if (!op || !c) { free(c); free(op); return NULL; }
+    c->A = A; c->lda = lda;
+    op->n = n;
+    op->kind = "dense";
+    op->bytes = sizeof(*c);
+    op->apply = dense_apply;
+    op->destroy = dense_destroy;
+    op->ctx = c;
+    return op;
+}
+
+void struct_op_apply_block(struct_op_t *op, int k, const double *X, int ldx, double *Y, int ldy)
+{
+    if (op->apply_block) { op->apply_block(op, k, X, ldx, Y, ldy); return; }
+    for (int j = 0; j < k; ++j) op->apply(op, X + (size_t)j * ldx, Y + (size_t)j * ldy);
+}
+
+void struct_op_free(struct_op_t *op)
+{
+    if (!op) return;
+    if (op->destroy) op->destroy(op);
+    free(op);
+}
@@ -0,0 +1,51 @@
+// struct_op.h — matrix-free symmetric operators y = A x for the iterative
+// eigensolvers (lanczos.h). An operator only knows n and how to apply
+// itself; nothing n x n is stored unless the operator is a dense wrapper.
+//
+//   toeplitz  symmetric Toeplitz T (first column t[0..n-1]), applied by
+//             circulant embedding: C of order m = 2^p >= 2n has the first
+//             column [t_0 .. t_{n-1}, 0 .., t_{n-1} .. t_1], its eigenvalues
+//             lambda = FFT(c) are real (c is even) and computed once, and
+//             T x = (IFFT(lambda .* FFT([x; 0])))[0 .. n-1]. Both FFTs are
+//             real transforms of length m done as complex radix-2 FFTs of
+//             length m/2 (built in, no FFT library), fused around the
+//             multiply: O(m log m) per product, ~3.6 m doubles of state
+//             (eigenvalues, two twiddle tables, bit reversal, one buffer).
+//             max|lambda| bounds ||T||_2 (T is a compression of C).
+//   kms       the Toeplitz operator of the drivers' KMS matrix,
+//             t_k = rho^|k| + delta (k == 0)
+//   dense     DSYMV on a caller-owned n x n matrix (reference / checks)
+//   csr       sparse CSR SpMV / SpMM (csr.h, csr_op_create)
+// apply_block() (Y = A X for k columns) is optional; struct_op_apply_block
+// falls back to k products.
+//
+// apply() uses buffers inside the operator: one operator per thread.
+// Constructors return NULL on bad arguments or allocation failure.
+
+#ifndef STRUCT_OP_H
+#define STRUCT_OP_H
+
+#include <stddef.h>
+
+typedef struct struct_op struct_op_t;
+
+struct struct_op {
+    int         n;
+    const char *kind;                   /* "toeplitz", "dense", "csr"              */
+    double      norm_bound;             /* >= ||A||_2, 0 when unknown               */
+    size_t      bytes;                  /* memory held by the operator              */
+    void (*apply)(struct_op_t *op, const double *x, double *y);
+    void (*apply_block)(struct_op_t *op, int k, const double *X, int ldx, double *Y, int ldy);
+    void (*destroy)(struct_op_t *op);
+    void       *ctx;
+};
+
+struct_op_t *toeplitz_op_create(int n, const double *t);
+struct_op_t *toeplitz_op_kms(int n, double rho, double delta);
+struct_op_t *dense_op_create(int n, const double *A, int lda);   /* A is not copied */
+
+static inline void struct_op_apply(struct_op_t *op, const double *x, double *y) { op->apply(op, x, y); }
+void struct_op_apply_block(struct_op_t *op, int k, const double *X, int ldx, double *Y, int ldy);
+void struct_op_free(struct_op_t *op);
+
+#endif /* STRUCT_OP_H */
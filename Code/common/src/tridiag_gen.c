@@ -0,0 +1,95 @@
+// tridiag_gen.c — tridiagonal test matrices (see tridiag_gen.h).
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#include "tridiag_gen.h"
+#include "band_eig.h"
+
+extern void dsbtrd_(const char *VECT, const char *UPLO, const int *N, const int *KD,
+                    double *AB, const int *LDAB, double *D, double *E,
+                    double *Q, const int *LDQ, double *WORK, int *INFO);
+
+static int gen_kms(int n, double rho, double *D, double *E)
+{
+    int kd = band_width_kms(n, rho, 0.0, DBL_EPSILON / 2);
+    if (kd < 1) kd = 1;
+    const int ldab = kd + 1, ldq = 1;
+    const char vect = 'N', uplo = 'U';
+    double qdummy = 0.0;
+    double *AB = (double*)malloc((size_t)ldab * (size_t)n * sizeof(double));
+    double *WK = (double*)malloc((size_t)n * sizeof(double));
+    if (!AB || !WK) { free(WK); free(AB); return -2; }
+    band_fill_kms(n, kd, rho, 0.0, uplo, AB, ldab);
+    int info = 0;
+    dsbtrd_(&vect, &uplo, &n, &kd, AB, &ldab, D, E, &qdummy, &ldq, WK, &info);
+    free(WK); free(AB);
+    return info ? -2 : 0;
+}
+
+int tridiag_gen(const char *name, int n, double rho, double *D, double *E)
+{
+    if (n < 1) return -1;
+    E[n - 1] = 0.0;
+    if (strcmp(name, "kms") == 0) return gen_kms(n, rho, D, E);
+
+    if (strcmp(name, "121") == 0) {
+        for (int i = 0; i < n; ++i) { D[i] = 2.0; E[i] = -1.0; }
+    } else if (strcmp(name, "wilkinson") == 0) {
+        for (int i = 0; i < n; ++i) { D[i] = fabs(i - (n - 1) / 2.0); E[i] = 1.0; }
+    } else if (strcmp(name, "glued") == 0) {
+        const int b = 21;
+        const double glue = sqrt(DBL_EPSILON);
+        for (int i = 0; i < n; ++i) {
+            const int k = i % b;
+            D[i] = fabs(k - (b - 1) / 2.0);
+            E[i] = (k == b - 1) ? glue : 1.0;
+        }
+    } else if (strcmp(name, "clement") == 0) {
+        for (int i = 0; i < n; ++i) { D[i] = 0.0; E[i] = sqrt((double)(i + 1) * (double)(n - 1 - i)); }
+    } else if (strcmp(name, "random") == 0) {
+        unsigned long long s = 0x9e3779b97f4a7c15ull;
+        for (int i = 0; i < n; ++i) {
+            s = s * 6364136223846793005ull + 1442695040888963407ull;
+            D[i] = (double)(s >> 11) / 4503599627370496.0 - 1.0;     /* 2^52: [-1, 1) */
+            s = s * 6364136223846793005ull + 1442695040888963407ull;
+            E[i] = (double)(s >> 11) / 4503599627370496.0 - 1.0;
+        }
+    } else {
+        return -1;
+    }
+    E[n - 1] = 0.0;
+    return 0;
+}
+
+double tridiag_norm1(int n, const double *D, const double *E)
+{
+    double m = 0.0;
+    for (int i = 0; i < n; ++i) {
+        double c = fabs(D[i]);
+        if (i > 0)     c += fabs(E[i - 1]);
+        if (i < n - 1) c += fabs(E[i]);
+        if (c > m) m = c;
+    }
+    return m;
+}
+
+double tridiag_residual(int n, const double *D, const double *E, int m,
+                        const double *W, const double *Z, int ldz)
+{
+    double r = 0.0;
+    for (int j = 0; j < m; ++j) {
+        const double *z = Z + (size_t)j * ldz;
+        for (int i = 0; i < n; ++i) {
+            double t = (D[i] - W[j]) * z[i];
+            if (i > 0)     t += E[i - 1] * z[i - 1];
+            if (i < n - 1) t += E[i] * z[i + 1];
+            if (fabs(t) > r) r = fabs(t);
+        }
+    }
+    return r;
+}
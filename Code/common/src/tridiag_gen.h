@@ -0,0 +1,30 @@
+// tridiag_gen.h — symmetric tridiagonal test matrices T = tridiag(E, D, E)
+// for the tridiagonal eigensolvers (DSTEDC / DSTEMR / inverse iteration).
+//
+//   kms        KMS(rho) reduced to T: built in band storage (band_eig.h,
+//              kd from the closed-form bandwidth) and reduced with DSBTRD
+//   121        D = 2, E = -1; lambda_k = 2 - 2 cos(k pi / (n+1))
+//   wilkinson  W+_n: D_i = |i - (n-1)/2|, E = 1; eigenvalue pairs agreeing
+//              to many digits at the top of the spectrum
+//   glued      W+_21 blocks glued by E = sqrt(eps): clusters of ~n/21
+//              eigenvalues within a few ulps (the MRRR stress case)
+//   clement    D = 0, E_i = sqrt(i (n - i)); lambda = -(n-1), -(n-3), ..., n-1
+//   random     D, E uniform in [-1, 1] (fixed seed)
+// E has n-1 meaningful entries; callers allocate n (DSTEMR needs n).
+
+#ifndef TRIDIAG_GEN_H
+#define TRIDIAG_GEN_H
+
+#define TRIDIAG_GEN_NAMES "kms 121 wilkinson glued clement random"
+
+/* Fill D[n], E[n] for generator `name` (rho: KMS only). Returns 0, or -1
+   for an unknown name / -2 when the KMS reduction fails. */
+int tridiag_gen(const char *name, int n, double rho, double *D, double *E);
+
+/* max_i |T z_j - lambda_j z_j|_i over the m columns of Z (ldz), and
+   ||T||_1 for scaling it. */
+double tridiag_residual(int n, const double *D, const double *E, int m,
+                        const double *W, const double *Z, int ldz);
+double tridiag_norm1(int n, const double *D, const double *E);
+
+#endif /* TRIDIAG_GEN_H */
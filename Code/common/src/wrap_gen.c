@@ -0,0 +1,119 @@
+// wrap_gen.c — timing wrappers for every routine in wrap_syms.def.
+//
+// Two link modes from the same table:
+//  - default: __wrap_X / __real_X pairs for "ld -Wl,--wrap=X" (static or
+//    dynamic LAPACK/BLAS, program relinked); the build scripts pass one
+//    --wrap per WRAP_FN( line of the table.
+//  - -DWRAP_PRELOAD: exported X in a shared library for LD_PRELOAD, calling
+//    the next definition in lookup order (dlsym(RTLD_NEXT), resolved on first
+//    use). Only calls through the dynamic symbol table are seen: calls from
+//    the program into a shared LAPACK/BLAS, and the library's own internal
+//    calls when they use the PLT (reference LAPACK built with -fPIC does).
+//    Renamed exports (SciPy's bundled OpenBLAS: scipy_dsyevd_, or
+//    scipy_dsyevd_64_ for ILP64) via -DWRAP_SYM_PREFIX= / -DWRAP_SYM_SUFFIX=;
+//    see DSYEVD/script/build_preload.sh.
+//
+// Per call: one mask load + branch, and two clock reads when timed (plus an
+// entry event when a live view is on: WRAP_SHM=1 or the dump signal).
+// Workspace queries pass through untimed. Timings go to wrap_timers.c.
+// With -DWRAP_TIMING_DISABLE this file compiles to nothing.
+
+#ifdef WRAP_PRELOAD
+#define _GNU_SOURCE
+#include <dlfcn.h>
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "wrap_timers.h"
+
+#ifdef WRAP_TIMING_DISABLE
+
+typedef int wrap_gen_disabled_t;   /* keep the translation unit non-empty */
+
+#else
+
+static inline double __t_now(void){
+    struct timespec t; clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+#ifndef WRAP_PRELOAD
+
+/* ================= --wrap mode ================= */
+/* __real_X is weak so that table entries absent from the linked libraries
+   (e.g. CBLAS with a Fortran-only BLAS) do not break the link; they are
+   never called, since the program itself does not reference them. A weak
+   reference does not extract an archive member, so the build scripts also
+   pass -u X: otherwise a routine only the program calls (dsyevd_ from the
+   driver) would be left out of a static link and __real_X would be NULL. */
+#define WRAP_FN(name, query, params, args)                              \
+    extern void __real_##name params __attribute__((weak));             \
+    void __wrap_##name params {                                          \
+        if (!__wrap_on[WRAP_ID_##name] || (query)) {                     \
+            __real_##name args; return;                                  \
+        }                                                                \
+        const double t0 = __t_now();                                     \
+        if (__wrap_live) __wrap_timer_enter(WRAP_ID_##name, t0);        \
+        __real_##name args;                                              \
+        __wrap_timer_add(WRAP_ID_##name, __t_now() - t0);               \
+    }
+#include "wrap_syms.def"
+#undef WRAP_FN
+
+#else
+
+/* ================= LD_PRELOAD mode ================= */
+#ifndef WRAP_SYM_PREFIX
+#define WRAP_SYM_PREFIX
+#endif
+#ifndef WRAP_SYM_SUFFIX
+#define WRAP_SYM_SUFFIX
+#endif
+#define PL_CAT3_(a, b, c) a##b##c
+#define PL_CAT3(a, b, c)  PL_CAT3_(a, b, c)
+#define PL_STR_(x)        #x
+#define PL_STR(x)         PL_STR_(x)
+#define PL_EXPORT(f)      PL_CAT3(WRAP_SYM_PREFIX, f, WRAP_SYM_SUFFIX)
+
+static void wrap_resolve(void);
+
+#define WRAP_FN(name, query, params, args)                              \
+    static void (*real_##name) params;                                   \
+    void PL_EXPORT(name) params {                                        \
+        if (!real_##name) wrap_resolve();                                \
+        if (!__wrap_on[WRAP_ID_##name] || (query)) {                     \
+            real_##name args; return;                                    \
+        }                                                                \
+        const double t0 = __t_now();                                     \
+        if (__wrap_live) __wrap_timer_enter(WRAP_ID_##name, t0);        \
+        real_##name args;                                                \
+        __wrap_timer_add(WRAP_ID_##name, __t_now() - t0);               \
+    }
+#include "wrap_syms.def"
+#undef WRAP_FN
+
+/* resolve all pointers at once, before any other constructor can reach
+   LAPACK/BLAS; first-call resolution covers earlier constructors */
+__attribute__((constructor(101)))
+static void wrap_resolve(void)
+{
+    static int done = 0;
+    if (done) return;
+    done = 1;
+    int missing = 0;
+#define WRAP_FN(name, query, params, args)                              \
+    *(void**)&real_##name = dlsym(RTLD_NEXT, PL_STR(PL_EXPORT(name)));   \
+    missing += (real_##name == NULL);
+#include "wrap_syms.def"
+#undef WRAP_FN
+    /* absent symbols are never called: the program would not have linked */
+    const char *v = getenv("WRAP_VERBOSE");
+    if (v && v[0] == '1')
+        fprintf(stderr, "[wrap_preload] %d of %d symbols not found in the next library\n",
+                missing, WRAP_NSYMS);
+}
+
+#endif /* WRAP_PRELOAD */
+#endif /* WRAP_TIMING_DISABLE */
@@ -0,0 +1,46 @@
+// wrap_shm.h — live timing snapshot shared between a running program
+// (wrap_timers.c, WRAP_SHM=1) and an external viewer (WRAPTOP/src/wrap_top.c).
+//
+// The program maps <WRAP_SHM_DIR>/wrap_timers.<pid> (default /dev/shm) and
+// updates a slot each time a timed routine is entered or returns. Readers
+// copy the segment under a sequence lock: seq is odd while the writer is
+// updating it, so copy when it is even and retry if seq changed. Times are
+// CLOCK_MONOTONIC seconds, which are comparable across processes.
+// The file is removed at normal exit. After a crash or kill it is left behind,
+// so the last state of the run can still be inspected.
+
+#ifndef WRAP_SHM_H
+#define WRAP_SHM_H
+
+#include <stdint.h>
+
+#define WRAP_SHM_MAGIC    0x31304d4853505257ULL   /* "WRPSHM01" */
+#define WRAP_SHM_VERSION  1
+#define WRAP_SHM_SLOTS    256
+#define WRAP_SHM_NAMELEN  32
+#define WRAP_SHM_PREFIX   "wrap_timers."
+
+typedef struct {
+    char     name[WRAP_SHM_NAMELEN];
+    uint64_t calls;            /* completed calls */
+    double   seconds;          /* time in completed calls */
+    double   active_t0;        /* start of the outermost call in flight */
+    int32_t  depth;            /* calls in flight (recursion: dlaed0 -> ...) */
+    int32_t  pad_;
+} wrap_shm_slot_t;
+
+typedef struct {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t nslots;           /* slots in use (<= WRAP_SHM_SLOTS) */
+    int64_t  pid;
+    uint64_t seq;              /* sequence lock, odd while writing */
+    double   t_start;          /* CLOCK_MONOTONIC at program start */
+    double   t_update;         /* last writer update */
+    int32_t  finished;         /* 1 once the destructor has run */
+    int32_t  pad_;
+    char     cmd[64];          /* /proc/self/comm, or "?" */
+    wrap_shm_slot_t slot[WRAP_SHM_SLOTS];
+} wrap_shm_t;
+
+#endif /* WRAP_SHM_H */
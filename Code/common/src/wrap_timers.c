@@ -0,0 +1,498 @@
+// wrap_timers.c — tiny timing registry + helpers (POSIX clock)
+// Features:
+//  - one slot per wrap_syms.def symbol, indexed by id (no lookup per call)
+//  - auto-register any other name first seen via __stedc_timer_add(name, dt)
+//    (up to WRAP_EXTRA_MAX of them; the slot array never moves)
+//  - summary sorted by total time (desc) + totals
+//  - __stedc_timer_reset() zeroes all counters (e.g. after untimed setup work)
+//  - __wrap_timer_count() / __wrap_timer_get(): read access for embedders
+//  - WRAP_MASK: runtime per-symbol enable mask (see wrap_timers.h)
+//  - thread-safe without a lock on the hot path: calls / seconds / depth are
+//    updated with atomics, so wrapped calls from worker pools (inv_iter's
+//    DSTEIN threads, stage_pipe) neither lose counts nor queue on a mutex.
+//    G_LOCK is only taken by what is serial by nature: the WRAP_MEM /
+//    WRAP_FAULTS deltas (process-wide counters attributed to the stage that
+//    just returned), the shared segment's single writer, name registration
+//  - WRAP_MEM=1: attribute resident-set growth to the stage that just returned
+//    (LAPACK allocates nothing itself, so this is first-touch of WORK/BLAS
+//    buffers per stage), plus the process peak RSS in the summary
+//  - WRAP_FAULTS=1: the same attribution for minor/major page faults and
+//    context switches (getrusage), to tell first-touch cost from compute
+//  - WRAP_SHM=1: publish the registry live to a shared-memory file for the
+//    WRAPTOP viewer (layout in wrap_shm.h)
+//  - WRAP_SIGNAL=1 (or USR1; USR2 for SIGUSR2): on that signal print the
+//    current summary, including routines still in flight, without stopping
+//    the run. A pipe-fed helper thread prints it, so a dump also works while
+//    the main thread is inside one long LAPACK call.
+//  - WRAP_PRELOAD (LD_PRELOAD build): no summary from processes that never
+//    called a wrapped routine
+//  - WRAP_TIMING_DISABLE: no registry at all, only no-op entry points
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "wrap_timers.h"
+
+#ifdef WRAP_TIMING_DISABLE
+
+unsigned char __wrap_on[WRAP_NSYMS];
+unsigned char __wrap_live;
+void __wrap_timer_enter(int id, double t0){ (void)id; (void)t0; }
+void __wrap_timer_add(int id, double dt){ (void)id; (void)dt; }
+void __stedc_timer_add(const char *name, double dt){ (void)name; (void)dt; }
+void __stedc_timer_reset(void){}
+int  __wrap_timer_count(void){ return 0; }
+int  __wrap_timer_get(int i, const char **name, unsigned long long *calls, double *seconds){
+    (void)i; (void)name; (void)calls; (void)seconds; return 0;
+}
+
+#else
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+
+#include "wrap_shm.h"
+#include "now_sec.h"
+
+typedef struct {
+    const char *name;
+    unsigned long long calls;   /* atomic */
+    double seconds;             /* atomic (CAS add) */
+    long rss_grow_kb;      /* WRAP_MEM: RSS growth observed at this stage's exits */
+    long minflt, majflt;   /* WRAP_FAULTS: page faults since the previous stage exit */
+    long csw;              /* WRAP_FAULTS: voluntary + involuntary context switches */
+    double active_t0;      /* live mode: start of the outermost call in flight (atomic) */
+    int depth;             /* live mode: calls in flight (atomic) */
+} timer_entry_t;
+
+/* extra names beyond the table (__stedc_timer_add) */
+#define WRAP_EXTRA_MAX 256
+
+/* slots [0, WRAP_NSYMS) are the table symbols in id order, then extra names;
+   allocated once in on_start and never reallocated, so the lock-free
+   updates never see the array move */
+static timer_entry_t *G_TIMERS = NULL;
+static int G_NTIMERS = 0;          /* G_LOCK for writes; atomic loads */
+static int G_CAP = 0;
+
+unsigned char __wrap_on[WRAP_NSYMS];
+unsigned char __wrap_live;          /* 1: wrappers report entry (shm / signal dump) */
+
+static const char *const SYM_NAMES[WRAP_NSYMS] = {
+#define WRAP_FN(name, query, params, args) #name,
+#include "wrap_syms.def"
+#undef WRAP_FN
+};
+
+static int  G_MEM_FD = -1;         /* /proc/self/statm, kept open when WRAP_MEM=1 */
+static long G_PAGE_KB = 4;
+static long G_LAST_RSS_KB = 0;
+
+static int G_FAULTS = 0;           /* WRAP_FAULTS=1 */
+static struct rusage G_LAST_RU;
+
+static double G_T_START = 0.0;
+static pthread_mutex_t G_LOCK = PTHREAD_MUTEX_INITIALIZER;   /* names, WRAP_MEM/FAULTS deltas, shm writes */
+
+static wrap_shm_t *G_SHM = NULL;   /* WRAP_SHM=1 */
+static char G_SHM_PATH[512];
+static int G_SIG_PIPE[2] = {-1, -1};
+
+static void alloc_slots(void){
+    G_CAP = WRAP_NSYMS + WRAP_EXTRA_MAX;
+    G_TIMERS = (timer_entry_t*)calloc((size_t)G_CAP, sizeof(timer_entry_t));
+    if (!G_TIMERS){ fprintf(stderr,"[timers] OOM\n"); abort(); }
+}
+
+/* lock-free double add */
+static inline void add_seconds(double *p, double dt){
+    double old, nw;
+    __atomic_load(p, &old, __ATOMIC_RELAXED);
+    do { nw = old + dt; } while (!__atomic_compare_exchange(p, &old, &nw, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+static inline double load_double(const double *p){
+    double v;
+    __atomic_load(p, &v, __ATOMIC_RELAXED);
+    return v;
+}
+
+static inline void store_double(double *p, double v){
+    __atomic_store(p, &v, __ATOMIC_RELAXED);
+}
+
+/* entry with the atomic fields read atomically (the others as they are) */
+static void snapshot(timer_entry_t *dst, const timer_entry_t *src){
+    dst->name = src->name;
+    dst->rss_grow_kb = src->rss_grow_kb;
+    dst->minflt = src->minflt;
+    dst->majflt = src->majflt;
+    dst->csw = src->csw;
+    dst->calls = __atomic_load_n(&src->calls, __ATOMIC_RELAXED);
+    dst->seconds = load_double(&src->seconds);
+    dst->active_t0 = load_double(&src->active_t0);
+    dst->depth = __atomic_load_n(&src->depth, __ATOMIC_RELAXED);
+}
+
+static int find_index(const char *name){
+    for (int i=0;i<G_NTIMERS;++i){
+        if (strcmp(G_TIMERS[i].name, name)==0) return i;
+    }
+    return -1;
+}
+
+/* G_LOCK held; -1 when the extra slots are used up */
+static int register_name(const char *name){
+    if (G_NTIMERS >= G_CAP){
+        static int warned = 0;
+        if (!warned++) fprintf(stderr, "[timers] more than %d extra names, '%s' not timed\n", WRAP_EXTRA_MAX, name);
+        return -1;
+    }
+    int idx = G_NTIMERS;
+    memset(&G_TIMERS[idx], 0, sizeof(timer_entry_t));
+    G_TIMERS[idx].name = name;              // pointer assumed static literal
+    __atomic_store_n(&G_NTIMERS, G_NTIMERS + 1, __ATOMIC_RELEASE);
+    if (G_SHM && idx < WRAP_SHM_SLOTS){
+        __atomic_add_fetch(&G_SHM->seq, 1, __ATOMIC_ACQ_REL);
+        snprintf(G_SHM->slot[idx].name, WRAP_SHM_NAMELEN, "%s", name);
+        G_SHM->nslots = (uint32_t)(idx + 1);
+        __atomic_add_fetch(&G_SHM->seq, 1, __ATOMIC_RELEASE);
+    }
+    return idx;
+}
+
+/* copy one registry slot to the shared segment (sequence-locked; G_LOCK
+   held, so there is one writer at a time) */
+static void shm_publish(int idx, double t){
+    if (idx >= WRAP_SHM_SLOTS) return;
+    wrap_shm_slot_t *s = &G_SHM->slot[idx];
+    timer_entry_t e;
+    snapshot(&e, &G_TIMERS[idx]);
+    __atomic_add_fetch(&G_SHM->seq, 1, __ATOMIC_ACQ_REL);
+    s->calls = e.calls;
+    s->seconds = e.seconds;
+    s->active_t0 = e.active_t0;
+    s->depth = e.depth;
+    G_SHM->t_update = t;
+    __atomic_add_fetch(&G_SHM->seq, 1, __ATOMIC_RELEASE);
+}
+
+/* resident set in KiB from the kept-open statm fd (lseek+read, no stdio) */
+static long rss_now_kb(void){
+    char buf[128];
+    if (lseek(G_MEM_FD, 0, SEEK_SET) != 0) return G_LAST_RSS_KB;
+    ssize_t k = read(G_MEM_FD, buf, sizeof(buf)-1);
+    if (k <= 0) return G_LAST_RSS_KB;
+    buf[k] = '\0';
+    char *p = strchr(buf, ' ');
+    return p ? strtol(p+1, NULL, 10) * G_PAGE_KB : G_LAST_RSS_KB;
+}
+
+/* WRAP_MEM / WRAP_FAULTS: process-wide deltas since the previous stage exit (G_LOCK held) */
+static void attribute_usage(int idx){
+    if (G_MEM_FD >= 0){
+        long rss = rss_now_kb();
+        if (rss > G_LAST_RSS_KB) G_TIMERS[idx].rss_grow_kb += rss - G_LAST_RSS_KB;
+        G_LAST_RSS_KB = rss;
+    }
+    if (G_FAULTS){
+        struct rusage ru;
+        if (getrusage(RUSAGE_SELF, &ru) == 0){
+            G_TIMERS[idx].minflt += ru.ru_minflt - G_LAST_RU.ru_minflt;
+            G_TIMERS[idx].majflt += ru.ru_majflt - G_LAST_RU.ru_majflt;
+            G_TIMERS[idx].csw += (ru.ru_nvcsw + ru.ru_nivcsw) - (G_LAST_RU.ru_nvcsw + G_LAST_RU.ru_nivcsw);
+            G_LAST_RU = ru;
+        }
+    }
+}
+
+/* lock-free unless WRAP_MEM / WRAP_FAULTS / WRAP_SHM ask for the serial parts */
+static inline void account(int idx, double dt){
+    timer_entry_t *e = &G_TIMERS[idx];
+    __atomic_add_fetch(&e->calls, 1, __ATOMIC_RELAXED);
+    add_seconds(&e->seconds, dt);
+    if (__wrap_live){
+        int d = __atomic_load_n(&e->depth, __ATOMIC_RELAXED);
+        while (d > 0 && !__atomic_compare_exchange_n(&e->depth, &d, d - 1, 1, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {}
+        if (d == 1) store_double(&e->active_t0, 0.0);
+    }
+    if (G_MEM_FD >= 0 || G_FAULTS || G_SHM){
+        pthread_mutex_lock(&G_LOCK);
+        attribute_usage(idx);
+        if (G_SHM) shm_publish(idx, now_sec());
+        pthread_mutex_unlock(&G_LOCK);
+    }
+}
+
+void __wrap_timer_enter(int id, double t0){
+    if (id < 0 || id >= WRAP_NSYMS || !G_TIMERS) return;
+    if (__atomic_fetch_add(&G_TIMERS[id].depth, 1, __ATOMIC_ACQ_REL) == 0) store_double(&G_TIMERS[id].active_t0, t0);
+    if (G_SHM){
+        pthread_mutex_lock(&G_LOCK);
+        shm_publish(id, t0);
+        pthread_mutex_unlock(&G_LOCK);
+    }
+}
+
+void __wrap_timer_add(int id, double dt){
+    if (id < 0 || id >= WRAP_NSYMS || !G_TIMERS) return;
+    account(id, dt);
+}
+
+void __stedc_timer_add(const char *name, double dt){
+    if (!G_TIMERS) return;
+    pthread_mutex_lock(&G_LOCK);                  /* name lookup / registration */
+    int idx = find_index(name);
+    if (idx < 0) idx = register_name(name);
+    pthread_mutex_unlock(&G_LOCK);
+    if (idx >= 0) account(idx, dt);
+}
+
+void __stedc_timer_reset(void){
+    const double t = now_sec();
+    pthread_mutex_lock(&G_LOCK);
+    for (int i=0;i<G_NTIMERS;++i){
+        __atomic_store_n(&G_TIMERS[i].calls, 0, __ATOMIC_RELAXED);
+        store_double(&G_TIMERS[i].seconds, 0.0);
+        G_TIMERS[i].rss_grow_kb = 0;
+        G_TIMERS[i].minflt = G_TIMERS[i].majflt = G_TIMERS[i].csw = 0;
+        if (G_SHM) shm_publish(i, t);
+    }
+    if (G_MEM_FD >= 0) G_LAST_RSS_KB = rss_now_kb();
+    if (G_FAULTS) getrusage(RUSAGE_SELF, &G_LAST_RU);
+    pthread_mutex_unlock(&G_LOCK);
+}
+
+int __wrap_timer_count(void){
+    return __atomic_load_n(&G_NTIMERS, __ATOMIC_ACQUIRE);
+}
+
+int __wrap_timer_get(int i, const char **name, unsigned long long *calls, double *seconds){
+    const int ok = (i >= 0 && i < __atomic_load_n(&G_NTIMERS, __ATOMIC_ACQUIRE));
+    if (ok){
+        if (name)    *name    = G_TIMERS[i].name;
+        if (calls)   *calls   = __atomic_load_n(&G_TIMERS[i].calls, __ATOMIC_RELAXED);
+        if (seconds) *seconds = load_double(&G_TIMERS[i].seconds);
+    }
+    return ok;
+}
+
+/* ---- WRAP_MASK: "all", "none", "name", "prefix*", "-name", "-prefix*" ---- */
+static void apply_mask(const char *spec){
+    memset(__wrap_on, 1, sizeof(__wrap_on));
+    if (!spec || !*spec) return;
+    int first = 1;
+    const char *p = spec;
+    while (*p){
+        const char *q = strchr(p, ',');
+        size_t len = q ? (size_t)(q - p) : strlen(p);
+        int on = 1;
+        if (len && *p == '-'){ on = 0; ++p; --len; }
+        if (len == 3 && strncmp(p, "all", 3) == 0)       memset(__wrap_on, 1, sizeof(__wrap_on));
+        else if (len == 4 && strncmp(p, "none", 4) == 0) memset(__wrap_on, 0, sizeof(__wrap_on));
+        else if (len){
+            if (first && on) memset(__wrap_on, 0, sizeof(__wrap_on));
+            int prefix = (p[len-1] == '*');
+            size_t cmp = prefix ? len - 1 : len;
+            int hits = 0;
+            for (int i=0;i<WRAP_NSYMS;++i){
+                if (strncmp(SYM_NAMES[i], p, cmp) == 0 && (prefix || SYM_NAMES[i][cmp] == '\0')){
+                    __wrap_on[i] = (unsigned char)on; hits++;
+                }
+            }
+            if (!hits) fprintf(stderr, "[timers] WRAP_MASK: no symbol matches '%.*s'\n", (int)len, p);
+        }
+        first = 0;
+        if (!q) break;
+        p = q + 1;
+    }
+}
+
+/* sort by time desc (simple insertion sort on a copy; N is small) */
+static void sort_by_time_desc(timer_entry_t *t, int n){
+    for (int i=1;i<n;++i){
+        timer_entry_t key = t[i];
+        int j = i-1;
+        while (j>=0 && t[j].seconds < key.seconds){
+            t[j+1] = t[j];
+            --j;
+        }
+        t[j+1] = key;
+    }
+}
+
+static void print_summary(void){
+    pthread_mutex_lock(&G_LOCK);
+    const int n = G_NTIMERS;
+    timer_entry_t *t = (timer_entry_t*)malloc((size_t)n * sizeof(timer_entry_t));
+    if (t) for (int i=0;i<n;++i) snapshot(&t[i], &G_TIMERS[i]);
+    pthread_mutex_unlock(&G_LOCK);
+    if (!t) return;
+    sort_by_time_desc(t, n);
+    double total = 0.0; unsigned long long total_calls = 0;
+    fprintf(stderr, "\n==== LAPACK/BLAS Call Timing (wall time) ====\n");
+    for (int i=0;i<n;++i){
+        if (!t[i].calls) continue;
+        total += t[i].seconds;
+        total_calls += t[i].calls;
+        fprintf(stderr, "%-11s calls=%6llu  time=%10.6f s  avg=%9.6f s",
+                t[i].name, t[i].calls, t[i].seconds, t[i].seconds / (double)t[i].calls);
+        if (G_MEM_FD >= 0) fprintf(stderr, "  rss+=%9.1f MB", t[i].rss_grow_kb / 1024.0);
+        if (G_FAULTS) fprintf(stderr, "  minflt=%8ld majflt=%5ld csw=%6ld", t[i].minflt, t[i].majflt, t[i].csw);
+        fprintf(stderr, "\n");
+    }
+    fprintf(stderr, "---------------------------------------------\n");
+    fprintf(stderr, "TOTAL       calls=%6llu  time=%10.6f s  (nested calls counted in each level)\n",
+            total_calls, total);
+    if (G_MEM_FD >= 0){
+        struct rusage ru;
+        if (getrusage(RUSAGE_SELF, &ru) == 0)
+            fprintf(stderr, "PEAK RSS      %.1f MB\n", ru.ru_maxrss / 1024.0);
+    }
+    if (__wrap_live){
+        const double tn = now_sec();
+        for (int i=0;i<n;++i){
+            if (t[i].depth > 0)
+                fprintf(stderr, "IN FLIGHT   %-11s depth=%d  running %10.3f s\n",
+                        t[i].name, t[i].depth, tn - t[i].active_t0);
+        }
+    }
+    fprintf(stderr, "=============================================\n");
+    free(t);
+}
+
+/* ---- live views: shared-memory snapshot and signal-triggered dump ---- */
+static void shm_open_segment(void){
+    const char *dir = getenv("WRAP_SHM_DIR");
+    if (!dir || !*dir) dir = "/dev/shm";
+    snprintf(G_SHM_PATH, sizeof(G_SHM_PATH), "%s/" WRAP_SHM_PREFIX "%ld", dir, (long)getpid());
+    int fd = open(G_SHM_PATH, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0 || ftruncate(fd, (off_t)sizeof(wrap_shm_t)) != 0){
+        fprintf(stderr, "[timers] WRAP_SHM: cannot create %s\n", G_SHM_PATH);
+        if (fd >= 0){ close(fd); unlink(G_SHM_PATH); }
+        return;
+    }
+    void *p = mmap(NULL, sizeof(wrap_shm_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED){ unlink(G_SHM_PATH); return; }
+    G_SHM = (wrap_shm_t*)p;
+    G_SHM->version = WRAP_SHM_VERSION;
+    G_SHM->pid = (int64_t)getpid();
+    G_SHM->t_start = G_SHM->t_update = G_T_START;
+    snprintf(G_SHM->cmd, sizeof(G_SHM->cmd), "?");
+    int cfd = open("/proc/self/comm", O_RDONLY);
+    if (cfd >= 0){
+        ssize_t k = read(cfd, G_SHM->cmd, sizeof(G_SHM->cmd) - 1);
+        if (k > 0){ G_SHM->cmd[k] = '\0'; G_SHM->cmd[strcspn(G_SHM->cmd, "\n")] = '\0'; }
+        close(cfd);
+    }
+    __atomic_store_n(&G_SHM->magic, WRAP_SHM_MAGIC, __ATOMIC_RELEASE);   /* valid from here */
+}
+
+static void on_dump_signal(int sig){
+    (void)sig;
+    const int saved = errno;
+    char c = 1;
+    if (write(G_SIG_PIPE[1], &c, 1) < 0) { /* pipe full: a dump is already pending */ }
+    errno = saved;
+}
+
+static void *dump_thread(void *arg){
+    (void)arg;
+    char c;
+    for (;;){
+        ssize_t k = read(G_SIG_PIPE[0], &c, 1);
+        if (k < 0 && errno == EINTR) continue;
+        if (k <= 0) break;
+        fprintf(stderr, "\n[timers] pid %ld snapshot at %.3f s", (long)getpid(), now_sec() - G_T_START);
+        print_summary();
+    }
+    return NULL;
+}
+
+static void install_dump_signal(void){
+    /* opt-in like WRAP_SHM: a helper thread and entry events cost every run */
+    const char *v = getenv("WRAP_SIGNAL");
+    if (!v || !*v || v[0] == '0' || strcmp(v, "off") == 0) return;
+    int sig = (strcmp(v, "USR2") == 0) ? SIGUSR2 : SIGUSR1;
+    if (pipe(G_SIG_PIPE) != 0) return;
+    fcntl(G_SIG_PIPE[1], F_SETFL, O_NONBLOCK);
+    fcntl(G_SIG_PIPE[0], F_SETFD, FD_CLOEXEC);
+    fcntl(G_SIG_PIPE[1], F_SETFD, FD_CLOEXEC);
+    /* the helper thread must not take the signal itself */
+    sigset_t all, old;
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &old);
+    pthread_t th;
+    int rc = pthread_create(&th, NULL, dump_thread, NULL);
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+    if (rc != 0) return;
+    pthread_detach(th);
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_dump_signal;
+    sa.sa_flags = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    sigaction(sig, &sa, NULL);
+    __wrap_live = 1;
+}
+
+__attribute__((constructor))
+static void on_start(void){
+    G_T_START = now_sec();
+    const char *m = getenv("WRAP_MEM");
+    if (m && m[0] == '1'){
+        G_MEM_FD = open("/proc/self/statm", O_RDONLY);
+        long pg = sysconf(_SC_PAGESIZE);
+        if (pg > 0) G_PAGE_KB = pg / 1024;
+        if (G_MEM_FD >= 0) G_LAST_RSS_KB = rss_now_kb();
+    }
+    const char *f = getenv("WRAP_FAULTS");
+    if (f && f[0] == '1'){
+        G_FAULTS = 1;
+        getrusage(RUSAGE_SELF, &G_LAST_RU);
+    }
+    apply_mask(getenv("WRAP_MASK"));
+    /* table symbols occupy the first slots, in id order */
+    alloc_slots();
+    const char *shm = getenv("WRAP_SHM");
+    if (shm && shm[0] == '1'){
+        shm_open_segment();
+        if (G_SHM) __wrap_live = 1;
+    }
+    pthread_mutex_lock(&G_LOCK);
+    for (int i=0;i<WRAP_NSYMS;++i){
+        register_name(SYM_NAMES[i]);
+    }
+    pthread_mutex_unlock(&G_LOCK);
+    install_dump_signal();
+}
+
+__attribute__((destructor))
+static void on_finish(void){
+#ifdef WRAP_PRELOAD
+    /* preloaded into every child process too: stay quiet where nothing ran */
+    int any = 0;
+    for (int i=0;i<G_NTIMERS;++i) any |= (__atomic_load_n(&G_TIMERS[i].calls, __ATOMIC_RELAXED) != 0);
+    if (!any){
+        if (G_SHM) unlink(G_SHM_PATH);
+        return;
+    }
+    fprintf(stderr, "\n[wrap_preload] pid %ld", (long)getpid());
+#endif
+    print_summary();
+    if (G_SHM){
+        G_SHM->finished = 1;
+        unlink(G_SHM_PATH);              /* mapping stays valid for open viewers */
+    }
+    /* keep memory until process exit */
+}
+
+#endif /* WRAP_TIMING_DISABLE */
@@ -0,0 +1,69 @@
+// wrap_timers.h — timing registry shared by the generated wrappers
+// (wrap_gen.c) and the drivers. Symbols come from wrap_syms.def.
+//
+// Compile-time: -DWRAP_TIMING_DISABLE compiles wrap_gen.c to nothing and the
+// registry to no-op stubs; the build scripts then also drop the --wrap
+// flags (WRAP_TIMING=0), so LAPACK/BLAS calls go straight to the library.
+//
+// Runtime: WRAP_MASK selects the timed symbols, a comma list processed left
+// to right: "all", "none", "name", "prefix*", and "-name" / "-prefix*" to
+// exclude. A list starting with a positive name starts from none, e.g.
+//   WRAP_MASK=dsyevd_,dstedc_,dlaed*        only the D&C path
+//   WRAP_MASK=all,-dcopy_,-dscal_,-drot_    everything but level-1 BLAS
+// Masked symbols cost one load and branch per call.
+// WRAP_MEM=1 adds per-stage RSS growth, WRAP_FAULTS=1 per-stage page faults
+// and context switches (see wrap_timers.c).
+//
+// Live views of a long run (see wrap_timers.c, wrap_shm.h):
+//   WRAP_SHM=1          publish the registry to /dev/shm/wrap_timers.<pid>,
+//                       watched with WRAPTOP/script/build_run.sh [pid]
+//   WRAP_SIGNAL=1       then kill -USR1 <pid> prints the current summary
+//                       (WRAP_SIGNAL=USR2 listens on SIGUSR2 instead)
+// Either one makes timed wrappers also report entry, so routines still in
+// flight show up with their running time.
+
+#ifndef WRAP_TIMERS_H
+#define WRAP_TIMERS_H
+
+/* ---- portable integer types (LP64 / ILP64) ---- */
+#ifndef LAPACK_INT
+#  if defined(OPENBLAS_USE64BITINT) || defined(LAPACK_ILP64) || defined(MKL_ILP64)
+     typedef long long lapack_int;
+#  else
+     typedef int lapack_int;
+#  endif
+#  define LAPACK_INT
+#endif
+#ifndef BLAS_INT
+#  define BLAS_INT lapack_int
+#endif
+/* double complex as Fortran lays it out (the wrappers only forward pointers) */
+#ifndef LAPACK_DCOMPLEX
+   typedef struct { double re, im; } lapack_dcomplex;
+#  define LAPACK_DCOMPLEX
+#endif
+
+enum {
+#define WRAP_FN(name, query, params, args) WRAP_ID_##name,
+#include "wrap_syms.def"
+#undef WRAP_FN
+    WRAP_NSYMS
+};
+
+/* per-symbol enable mask (1 = timed), set from WRAP_MASK at startup */
+extern unsigned char __wrap_on[WRAP_NSYMS];
+/* 1 when a live view (WRAP_SHM / dump signal) needs entry events */
+extern unsigned char __wrap_live;
+
+void __wrap_timer_enter(int id, double t0);            /* table symbols, live only */
+void __wrap_timer_add(int id, double dt);              /* table symbols, O(1)      */
+void __stedc_timer_add(const char *name, double dt);   /* any name (auto-register) */
+void __stedc_timer_reset(void);                        /* zero all counters        */
+
+/* Read access for embedders (e.g. the Python module): number of slots, and
+   slot i's name, calls and seconds. __wrap_timer_get returns 0 when i is
+   out of range. With WRAP_TIMING_DISABLE there are no slots. */
+int  __wrap_timer_count(void);
+int  __wrap_timer_get(int i, const char **name, unsigned long long *calls, double *seconds);
+
+#endif /* WRAP_TIMERS_H */
@@ -0,0 +1,89 @@
+// rank1_update_test.c — eig_rank1_update() against a fresh DSYEVD of
+// A + rho z z^T: eigenvalues, residual and orthogonality, for rho > 0,
+// rho < 0, and a case built to deflate (repeated eigenvalues of A and
+// zero components of V^T z), which must report deflated poles.
+
+#include "rank1_update.h"
+#include "test_util.h"
+
+enum { N = 120 };
+
+/* A = Q diag(D) Q^T, update in place, compare with DSYEVD of A + rho z z^T */
+static int run_case(const char *name, const double *D0, const double *w, double rho, int want_deflation)
+{
+    const int n = N;
+    double *Q = malloc(sizeof(double) * n * n), *B = malloc(sizeof(double) * n * n);
+    double *D = malloc(sizeof(double) * n), *z = malloc(sizeof(double) * n), *Wref = malloc(sizeof(double) * n);
+    if (!Q || !B || !D || !z || !Wref || tu_orthogonal(n, Q, n) != 0) { printf("%s FAIL setup\n", name); return 1; }
+
+    /* z = Q w, so that V^T z = w exactly up to rounding */
+    for (int i = 0; i < n; ++i) {
+        double s = 0.0;
+        for (int j = 0; j < n; ++j) s += Q[i + j * n] * w[j];
+        z[i] = s;
+    }
+    /* B = Q diag(D0) Q^T + rho z z^T (full) */
+    for (int j = 0; j < n; ++j)
+        for (int i = 0; i < n; ++i) {
+            double s = rho * z[i] * z[j];
+            for (int l = 0; l < n; ++l) s += Q[i + l * n] * D0[l] * Q[j + l * n];
+            B[i + j * n] = s;
+        }
+    memcpy(D, D0, sizeof(double) * n);
+
+    rank1_ws_t ws = {0};
+    rank1_stats_t st;
+    int fail = 0;
+    const int info = eig_rank1_update(n, D, Q, n, rho, z, &ws, &st);
+    if (info != 0) { printf("%s FAIL eig_rank1_update info=%d\n", name, info); fail = 1; goto DONE; }
+
+    double *R = malloc(sizeof(double) * n * n);
+    if (!R) { fail = 1; goto DONE; }
+    memcpy(R, B, sizeof(double) * n * n);
+    if (tu_syevd(n, R, n, Wref) != 0) { printf("%s FAIL reference DSYEVD\n", name); free(R); fail = 1; goto DONE; }
+    free(R);
+
+    const double bn = tu_fro(n, B, n);
+    double de = 0.0, asc = 0.0;
+    for (int i = 0; i < n; ++i) de = fmax(de, fabs(D[i] - Wref[i]));
+    for (int i = 1; i < n; ++i) asc = fmax(asc, D[i - 1] - D[i]);
+    fail |= tu_check(name, "max|D - D_dsyevd| / ||B||_F", de / bn, 1e-13);
+    fail |= tu_check(name, "D ascending (max drop)", asc, 0.0);
+    fail |= tu_check(name, "residual", tu_resid(n, n, B, n, D, Q, n), 1e-13);
+    fail |= tu_check(name, "orthogonality", tu_orth(n, n, Q, n), 1e-12);
+    printf("%s K=%d deflated=%d\n", name, st.k, st.deflated);
+    if (want_deflation && st.deflated < want_deflation) {
+        printf("%s FAIL expected at least %d deflated poles\n", name, want_deflation);
+        fail = 1;
+    }
+DONE:
+    rank1_ws_free(&ws);
+    free(Wref); free(z); free(D); free(B); free(Q);
+    return fail;
+}
+
+int main(void)
+{
+    const int n = N;
+    double D[N], Drep[N], w[N], wz[N];
+    tu_seed(12345);
+    for (int i = 0; i < n; ++i) D[i] = -1.0 + 2.0 * i / (n - 1) + 1e-3 * tu_rand();
+    for (int i = 1; i < n; ++i) if (D[i] < D[i - 1]) D[i] = D[i - 1];
+    for (int i = 0; i < n; ++i) w[i] = tu_rand();
+
+    /* repeated eigenvalues (groups of 4) and every third component of w zero:
+       the zeros deflate outright, each group of equal poles collapses by Givens */
+    int zeros = 0;
+    for (int i = 0; i < n; ++i) {
+        Drep[i] = (double)(i / 4);
+        wz[i] = (i % 3 == 0) ? 0.0 : tu_rand();
+        zeros += (i % 3 == 0);
+    }
+
+    int fail = 0;
+    fail |= run_case("rank1 rho>0    ", D, w, 0.7, 0);
+    fail |= run_case("rank1 rho<0    ", D, w, -0.7, 0);
+    fail |= run_case("rank1 deflation", Drep, wz, 0.5, zeros);
+    printf("%s rank1_update_test\n", fail ? "FAIL" : "PASS");
+    return fail;
+}
@@ -0,0 +1,67 @@
+#!/usr/bin/env bash
+# run_tests.sh — build and run the checks in common/test against a backend.
+#   ./run_tests.sh <case_name>        test-openblas | test-netlib | test-armpl
+# LAPACK_LIBS="<link line>" replaces the preset's libraries (e.g. a system
+# liblapack.a + libopenblas.a). Each test is linked like the drivers: the
+# --wrap/-u list from wrap_syms.def and the preset's CFLAGS, so a preset
+# flag that breaks the wrappers (a lapack_int that does not match the
+# library) fails here.
+set -euo pipefail
+
+TAG="${1:-}"
+[ -n "$TAG" ] || { echo "Usage: $0 <case_name>"; exit 1; }
+
+# ====== 1) Compiler setup ======
+CC="${CC:-gcc}"
+CFLAGS_BASE="-O2 -std=c11 -D_POSIX_C_SOURCE=199309L -Wall -Wextra -I../src"
+LIBS_FORTRAN="-lgfortran"
+LIBS_MATH="-lm"
+
+# ====== 2) Library presets (as in */script/build_run.sh) ======
+CFLAGS_NETLIB="$CFLAGS_BASE -I../../LAPACK/build/include"
+LDFLAGS_NETLIB="../../LAPACK/build/lib/liblapack.a ../../LAPACK/build/lib/libblas.a $LIBS_FORTRAN $LIBS_MATH"
+
+CFLAGS_OB="$CFLAGS_BASE -I../../openblas/openblas_install/include"
+LDFLAGS_OB="../../openblas/openblas_install/lib/libopenblas.a $LIBS_FORTRAN $LIBS_MATH -lpthread -ldl"
+
+ARMPL_PREFIX="../../armpl/arm-performance-libraries_25.07_rpm/armpl_local/armpl_25.07_gcc"
+CFLAGS_AP="$CFLAGS_BASE -I$ARMPL_PREFIX/include"
+LDFLAGS_AP="$ARMPL_PREFIX/lib/libarmpl.a -lpthread -ldl $LIBS_FORTRAN $LIBS_MATH"
+
+case "$TAG" in
+  test-openblas) CFLAGS="$CFLAGS_OB";     LDFLAGS="$LDFLAGS_OB" ;;
+  test-netlib)   CFLAGS="$CFLAGS_NETLIB"; LDFLAGS="$LDFLAGS_NETLIB" ;;
+  test-armpl)    CFLAGS="$CFLAGS_AP";     LDFLAGS="$LDFLAGS_AP" ;;
+  *)
+      echo "[X] Unknown TAG: $TAG"
+      echo "    Available: test-openblas | test-netlib | test-armpl"
+      exit 1;;
+esac
+LDFLAGS="${LAPACK_LIBS:-$LDFLAGS}"
+
+# ====== 3) Wrappers ======
+WRAP_SYMS=($(grep -o '^WRAP_FN([A-Za-z_0-9]*' ../src/wrap_syms.def | sed 's/^WRAP_FN(//'))
+WRAP_LDFLAGS=()
+for s in "${WRAP_SYMS[@]}"; do WRAP_LDFLAGS+=("-Wl,--wrap=${s}" "-Wl,-u,${s}"); done
+WRAP_SRCS=("../src/wrap_timers.c" "../src/wrap_gen.c")
+
+# ====== 4) Build & run ======
+BIN_DIR="../output/test"
+mkdir -p "$BIN_DIR"
+TESTS=("wrap_query_test" "rank1_update_test" "stream_eig_test" "inv_iter_test" "lanczos_test" "lobpcg_test")
+# sources under test, per test (test_util.h is header-only)
+declare -A TEST_SRCS=(
+  [rank1_update_test]="../src/rank1_update.c"
+  [stream_eig_test]="../src/stream_eig.c ../src/rank1_update.c ../src/mem_budget.c"
+  [inv_iter_test]="../src/inv_iter.c"
+  [lanczos_test]="../src/lanczos.c ../src/struct_op.c"
+  [lobpcg_test]="../src/lobpcg.c ../src/struct_op.c ../src/csr.c ../src/mat_io.c"
+)
+fail=0
+for t in "${TESTS[@]}"; do
+  echo "[BUILD] $t"
+  $CC $CFLAGS "$t.c" ${TEST_SRCS[$t]:-} "${WRAP_SRCS[@]}" $LDFLAGS "${WRAP_LDFLAGS[@]}" -lpthread -o "$BIN_DIR/$t"
+  echo "[RUN  ] $t"
+  WRAP_MASK=all "$BIN_DIR/$t" 2>/dev/null || fail=1
+done
+exit $fail
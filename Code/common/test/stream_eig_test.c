@@ -0,0 +1,94 @@
+// stream_eig_test.c — a sliding window through stream_eig: after every
+// tick the maintained S must equal sum x x^T recomputed from the window's
+// columns, and (D, V) must be an eigendecomposition of that recomputed S
+// (eigenvalues against DSYEVD, residual, orthogonality). Run once with the
+// crossover bypass and drift refreshes off, so every tick goes through the
+// rank-one merges alone, and once with the defaults.
+
+#include "stream_eig.h"
+#include "test_util.h"
+
+enum { N = 60, WIN = 40, K = 3, TICKS = 12 };
+
+/* S = X(:, c0 : c0+WIN-1) X(:, ...)^T, full */
+static void window_scatter(const double *X, int c0, double *S)
+{
+    memset(S, 0, sizeof(double) * N * N);
+    for (int c = c0; c < c0 + WIN; ++c) {
+        const double *x = X + (size_t)c * N;
+        for (int j = 0; j < N; ++j)
+            for (int i = 0; i < N; ++i) S[i + j * N] += x[i] * x[j];
+    }
+}
+
+static int run(const char *name, const double *X, int merges_only)
+{
+    double *S = malloc(sizeof(double) * N * N), *R = malloc(sizeof(double) * N * N), W[N];
+    stream_eig_t s;
+    int fail = 0;
+    if (!S || !R) { printf("%s FAIL alloc\n", name); free(R); free(S); return 1; }
+
+    window_scatter(X, 0, S);
+    /* merges_only: a drift bound of 1 never refreshes, so the merges alone are checked */
+    if (stream_eig_init(&s, N, S, merges_only ? 1.0 : 1e-10, 0) != 0) { printf("%s FAIL init\n", name); free(R); free(S); return 1; }
+    if (merges_only) s.auto_refresh = 0;
+
+    double es = 0.0, ed = 0.0, er = 0.0, eo = 0.0;
+    int merges = 0;
+    for (int t = 1; t <= TICKS; ++t) {
+        const double *add  = X + (size_t)(WIN + (t - 1) * K) * N;   /* newest K columns */
+        const double *drop = X + (size_t)((t - 1) * K) * N;         /* oldest K columns */
+        stream_tick_t tk;
+        const int info = stream_eig_tick(&s, K, add, N, K, drop, N, &tk);
+        if (info != 0) { printf("%s FAIL tick %d info=%d\n", name, t, info); fail = 1; break; }
+        merges += tk.merges;
+
+        window_scatter(X, t * K, S);
+        const double sn = tu_fro(N, S, N);
+        for (int j = 0; j < N; ++j)                                   /* upper triangle is kept */
+            for (int i = 0; i <= j; ++i) es = fmax(es, fabs(s.S[i + j * N] - S[i + j * N]) / sn);
+        memcpy(R, S, sizeof(double) * N * N);
+        if (tu_syevd(N, R, N, W) != 0) { printf("%s FAIL reference DSYEVD\n", name); fail = 1; break; }
+        for (int i = 0; i < N; ++i) ed = fmax(ed, fabs(s.D[i] - W[i]) / sn);
+        er = fmax(er, tu_resid(N, N, S, N, s.D, s.V, N));
+        eo = fmax(eo, tu_orth(N, N, s.V, N));
+    }
+    fail |= tu_check(name, "S vs window recompute", es, 1e-14);
+    fail |= tu_check(name, "max|D - D_dsyevd| / ||S||_F", ed, 1e-12);
+    fail |= tu_check(name, "residual", er, 1e-12);
+    fail |= tu_check(name, "orthogonality", eo, 1e-11);
+    printf("%s ticks=%ld merges=%d refreshes=%ld\n", name, s.ticks, merges, s.refreshes);
+    if (merges_only && merges != 2 * K * TICKS) {
+        printf("%s FAIL expected %d merges\n", name, 2 * K * TICKS);
+        fail = 1;
+    }
+    stream_eig_free(&s);
+    free(R); free(S);
+    return fail;
+}
+
+int main(void)
+{
+    double *X = malloc(sizeof(double) * N * (WIN + K * TICKS));
+    if (!X) return 1;
+    tu_seed(2024);
+    /* correlated observations: x = L g with a fixed lower-triangular L */
+    double L[N * N];
+    for (int j = 0; j < N; ++j)
+        for (int i = 0; i < N; ++i) L[i + j * N] = (i >= j) ? tu_rand() / (1 + i - j) : 0.0;
+    for (int c = 0; c < WIN + K * TICKS; ++c) {
+        double g[N];
+        for (int i = 0; i < N; ++i) g[i] = tu_rand();
+        for (int i = 0; i < N; ++i) {
+            double v = 0.0;
+            for (int j = 0; j <= i; ++j) v += L[i + j * N] * g[j];
+            X[i + (size_t)c * N] = v;
+        }
+    }
+    int fail = 0;
+    fail |= run("stream merges  ", X, 1);
+    fail |= run("stream defaults", X, 0);
+    printf("%s stream_eig_test\n", fail ? "FAIL" : "PASS");
+    free(X);
+    return fail;
+}
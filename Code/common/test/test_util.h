@@ -0,0 +1,153 @@
+// test_util.h — shared helpers for the common/test checks: a seeded RNG,
+// random symmetric / orthogonal matrices, reference DSYEVD / DSYEVR, and the
+// residual and orthogonality measures every solver test compares against.
+// Header-only (static), each test is one translation unit.
+
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+extern void dsyevd_(const char *JOBZ, const char *UPLO, const int *N,
+                    double *A, const int *LDA, double *W,
+                    double *WORK, const int *LWORK,
+                    int *IWORK, const int *LIWORK,
+                    int *INFO);
+extern void dsyevr_(const char *JOBZ, const char *RANGE, const char *UPLO, const int *N,
+                    double *A, const int *LDA, const double *VL, const double *VU,
+                    const int *IL, const int *IU, const double *ABSTOL, int *M,
+                    double *W, double *Z, const int *LDZ, int *ISUPPZ,
+                    double *WORK, const int *LWORK, int *IWORK, const int *LIWORK,
+                    int *INFO);
+extern void dgemm_(const char *TRANSA, const char *TRANSB, const int *M, const int *N, const int *K,
+                   const double *ALPHA, const double *A, const int *LDA, const double *B, const int *LDB,
+                   const double *BETA, double *C, const int *LDC);
+
+/* xorshift64*: the same sequence on every platform */
+static unsigned long long tu_state = 0x9E3779B97F4A7C15ull;
+static inline void tu_seed(unsigned long long s) { tu_state = s ? s : 0x9E3779B97F4A7C15ull; }
+static inline double tu_rand(void)              /* uniform in [-1, 1) */
+{
+    tu_state ^= tu_state >> 12; tu_state ^= tu_state << 25; tu_state ^= tu_state >> 27;
+    return (double)((tu_state * 0x2545F4914F6CDD1Dull) >> 11) * (2.0 / 9007199254740992.0) - 1.0;
+}
+
+/* random symmetric n x n (both triangles) */
+static inline void tu_sym(int n, double *A, int lda)
+{
+    for (int j = 0; j < n; ++j)
+        for (int i = 0; i <= j; ++i) A[i + (size_t)j * lda] = A[j + (size_t)i * lda] = tu_rand();
+}
+
+/* DSYEVD('V', 'U') in place: W ascending, A <- eigenvectors. Returns INFO. */
+static inline int tu_syevd(int n, double *A, int lda, double *W)
+{
+    const char jobz = 'V', uplo = 'U';
+    int info = 0, lwork = -1, liwork = -1, iwkopt = 0;
+    double wkopt = 0.0;
+    dsyevd_(&jobz, &uplo, &n, A, &lda, W, &wkopt, &lwork, &iwkopt, &liwork, &info);
+    if (info != 0) return info;
+    lwork = (int)wkopt; liwork = iwkopt;
+    double *work = (double*)malloc((size_t)lwork * sizeof(double));
+    int *iwork = (int*)malloc((size_t)liwork * sizeof(int));
+    if (!work || !iwork) { free(iwork); free(work); return -1; }
+    dsyevd_(&jobz, &uplo, &n, A, &lda, W, work, &lwork, iwork, &liwork, &info);
+    free(iwork); free(work);
+    return info;
+}
+
+/* eigenvalues il..iu (1-based, ascending) of a full symmetric n x n by
+   DSYEVR('N', 'I'); A is copied, not overwritten. Returns INFO. */
+static inline int tu_syevr(int n, const double *A, int lda, int il, int iu, double *W)
+{
+    const char jobz = 'N', range = 'I', uplo = 'U';
+    const double vl = 0.0, vu = 0.0, abstol = 0.0;
+    int info = 0, m = 0, lwork = -1, liwork = -1, iwkopt = 0, ldz = 1;
+    double wkopt = 0.0, z = 0.0;
+    double *B = (double*)malloc((size_t)n * n * sizeof(double));
+    int *isuppz = (int*)malloc((size_t)2 * n * sizeof(int));
+    if (!B || !isuppz) { free(isuppz); free(B); return -1; }
+    for (int j = 0; j < n; ++j) memcpy(B + (size_t)j * n, A + (size_t)j * lda, (size_t)n * sizeof(double));
+    dsyevr_(&jobz, &range, &uplo, &n, B, &n, &vl, &vu, &il, &iu, &abstol, &m, W, &z, &ldz,
+            isuppz, &wkopt, &lwork, &iwkopt, &liwork, &info);
+    if (info == 0) {
+        lwork = (int)wkopt; liwork = iwkopt;
+        double *work = (double*)malloc((size_t)lwork * sizeof(double));
+        int *iwork = (int*)malloc((size_t)liwork * sizeof(int));
+        if (!work || !iwork) info = -1;
+        else dsyevr_(&jobz, &range, &uplo, &n, B, &n, &vl, &vu, &il, &iu, &abstol, &m, W, &z, &ldz,
+                     isuppz, work, &lwork, iwork, &liwork, &info);
+        free(iwork); free(work);
+    }
+    free(isuppz); free(B);
+    return (info == 0 && m != iu - il + 1) ? -2 : info;
+}
+
+/* random orthogonal n x n: eigenvectors of a random symmetric matrix */
+static inline int tu_orthogonal(int n, double *Q, int ldq)
+{
+    double *w = (double*)malloc((size_t)n * sizeof(double));
+    if (!w) return -1;
+    tu_sym(n, Q, ldq);
+    const int info = tu_syevd(n, Q, ldq, w);
+    free(w);
+    return info;
+}
+
+/* ||A||_F of a full symmetric n x n */
+static inline double tu_fro(int n, const double *A, int lda)
+{
+    double s = 0.0;
+    for (int j = 0; j < n; ++j)
+        for (int i = 0; i < n; ++i) s += A[i + (size_t)j * lda] * A[i + (size_t)j * lda];
+    return sqrt(s);
+}
+
+/* max |V^T V - I| over the k columns of V (n x k) */
+static inline double tu_orth(int n, int k, const double *V, int ldv)
+{
+    double *G = (double*)malloc((size_t)k * k * sizeof(double));
+    if (!G) return INFINITY;
+    const double one = 1.0, zero = 0.0;
+    dgemm_("T", "N", &k, &k, &n, &one, V, &ldv, V, &ldv, &zero, G, &k);
+    double e = 0.0;
+    for (int j = 0; j < k; ++j)
+        for (int i = 0; i < k; ++i) e = fmax(e, fabs(G[i + (size_t)j * k] - (i == j)));
+    free(G);
+    return e;
+}
+
+/* max_j ||A v_j - w_j v_j||_2 / ||A||_F over the k pairs (A full n x n) */
+static inline double tu_resid(int n, int k, const double *A, int lda, const double *W,
+                              const double *V, int ldv)
+{
+    double *R = (double*)malloc((size_t)n * k * sizeof(double));
+    if (!R) return INFINITY;
+    const double one = 1.0, zero = 0.0;
+    dgemm_("N", "N", &n, &k, &n, &one, A, &lda, V, &ldv, &zero, R, &n);
+    double e = 0.0;
+    for (int j = 0; j < k; ++j) {
+        double s = 0.0;
+        for (int i = 0; i < n; ++i) {
+            const double r = R[i + (size_t)j * n] - W[j] * V[i + (size_t)j * ldv];
+            s += r * r;
+        }
+        e = fmax(e, sqrt(s));
+    }
+    free(R);
+    const double an = tu_fro(n, A, lda);
+    return an > 0.0 ? e / an : e;
+}
+
+/* print one measured value against its bound; returns 1 when it fails */
+static inline int tu_check(const char *test, const char *what, double v, double tol)
+{
+    const int bad = !(v <= tol);
+    printf("%s %-28s %9.2e (tol %.0e)%s\n", test, what, v, tol, bad ? "  FAIL" : "");
+    return bad;
+}
+
+#endif /* TEST_UTIL_H */
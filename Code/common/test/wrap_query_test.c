@@ -0,0 +1,43 @@
+// wrap_query_test.c — a LWORK = -1 workspace query must pass through the
+// --wrap timers untimed: one DSYEVD query + one solve counts calls=1. With
+// lapack_int wider than the library's INTEGER (-DOPENBLAS_USE64BITINT on an
+// LP64 build) the query test reads past the int and the query is counted.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "wrap_timers.h"
+
+extern void dsyevd_(const char *JOBZ, const char *UPLO, const int *N,
+                    double *A, const int *LDA, double *W,
+                    double *WORK, const int *LWORK,
+                    int *IWORK, const int *LIWORK,
+                    int *INFO);
+
+int main(void)
+{
+    enum { N = 8 };
+    double A[N * N], W[N], wkopt = 0.0, work[1024];
+    int iwkopt = 0, iwork[256], info = 0;
+    const int n = N, q = -1;
+    const char jobz = 'V', uplo = 'U';
+    for (int j = 0; j < N; ++j)
+        for (int i = 0; i < N; ++i) A[i + j * N] = (i == j) ? 2.0 : 1.0 / (1 + i + j);
+
+    dsyevd_(&jobz, &uplo, &n, A, &n, W, &wkopt, &q, &iwkopt, &q, &info);
+    const int lwork = (int)wkopt, liwork = iwkopt;
+    if (info != 0 || lwork > 1024 || liwork > 256) { fprintf(stderr, "FAIL query: info=%d\n", info); return 1; }
+    dsyevd_(&jobz, &uplo, &n, A, &n, W, work, &lwork, iwork, &liwork, &info);
+    if (info != 0) { fprintf(stderr, "FAIL solve: info=%d\n", info); return 1; }
+
+    for (int i = 0; i < __wrap_timer_count(); ++i) {
+        const char *name; unsigned long long calls; double sec;
+        if (__wrap_timer_get(i, &name, &calls, &sec) && strcmp(name, "dsyevd_") == 0) {
+            if (calls != 1) { fprintf(stderr, "FAIL dsyevd_ calls=%llu, expected 1\n", calls); return 1; }
+            printf("PASS wrap_query_test (dsyevd_ calls=1)\n");
+            return 0;
+        }
+    }
+    fprintf(stderr, "FAIL dsyevd_ not in the timer registry\n");
+    return 1;
+}
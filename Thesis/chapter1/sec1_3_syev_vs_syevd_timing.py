@@ -8,6 +8,12 @@ Outputs:
 - ./output/result_table.txt (pretty table)
 - ./output/result_table.csv (CSV)
 - ./output/env.txt (environment info)
+
+EIG_PY=native runs both through the pyeig extension (Code/PYEIG/script/
+build_run.sh) instead of scipy.linalg.lapack, as in Code/DSYEV_DSYEVD/src/
+benchmark_dsyev_vs_dsyevd.py; PYTHONPATH must include Code/PYEIG/output/lib.
+pyeig solves in place, so each repeat gets a fresh Fortran-order copy made
+outside the timed window, and the time is the solver call alone (t['solve']).
 """
 
 import os
@@ -21,8 +27,13 @@ import time
 import platform
 import numpy as np
 import pandas as pd
-import scipy as sp
-from scipy.linalg import lapack
+
+NATIVE = os.environ.get("EIG_PY", "scipy") == "native"
+if NATIVE:
+    import pyeig
+else:
+    import scipy as sp
+    from scipy.linalg import lapack
 
 # ------------------ Config ---------------------
 sizes = [500, 1000, 2000, 4000, 8000]   # adjust as needed
@@ -67,7 +78,10 @@ def write_env(path):
         f.write(f"Processor: {platform.processor()}\n")
         f.write(f"Python   : {platform.python_version()}\n")
         f.write(f"NumPy    : {np.__version__}\n")
-        f.write(f"SciPy    : {sp.__version__}\n")
+        if NATIVE:
+            f.write(f"pyeig    : {pyeig.backend}\n")
+        else:
+            f.write(f"SciPy    : {sp.__version__}\n")
         # Optional: record BLAS vendor if available
         try:
             import numpy.distutils.system_info as sysinfo
@@ -77,16 +91,31 @@ def write_env(path):
         except Exception:
             pass
 
+def native_median(name, reps, A, compute_v):
+    """pyeig counterpart of median_time(lapack.<name>, reps, A, compute_v, 0):
+    returns ((None, None, 0), median solver seconds); failures raise."""
+    fn = pyeig.syev if name == "dsyev" else pyeig.syevd
+    times = []
+    for _ in range(reps):
+        a = A.copy(order='F')                   # pyeig overwrites its input
+        w = np.empty(A.shape[0])
+        times.append(fn(a, w, jobz="V" if compute_v else "N", uplo="U")["solve"])
+    return (None, None, 0), float(np.median(times))
+
+def solver_median(name, reps, A, compute_v):
+    """Median time of DSYEV/DSYEVD (upper triangle) on A via scipy or pyeig."""
+    if NATIVE:
+        return native_median(name, reps, A, compute_v)
+    return median_time(getattr(lapack, name), reps, A.copy(order='F'), compute_v, 0)
+
 # ------------------ Warm-up  ---------------------
 def warmup():
     rng = np.random.default_rng(12345)
     A = make_symmetric_f(64, rng)
-    # DSYEV N/V
-    lapack.dsyev(A.copy(order='F'), 0, 0)
-    lapack.dsyev(A.copy(order='F'), 1, 0)
-    # DSYEVD N/V
-    lapack.dsyevd(A.copy(order='F'), 0, 0)
-    lapack.dsyevd(A.copy(order='F'), 1, 0)
+    # DSYEV N/V, DSYEVD N/V
+    for name in ("dsyev", "dsyevd"):
+        for compute_v in (0, 1):
+            solver_median(name, 1, A, compute_v)
 
 # ------------------ Benchmark ---------------------
 def run_benchmark(sizes, reps, seed):
@@ -104,16 +133,16 @@ def run_benchmark(sizes, reps, seed):
 
         # ---------- DSYEV (QR) ----------
         # N: eigenvalues only
-        (_, _, info_qr_N), t_qr_N = median_time(
-            lapack.dsyev, reps, A.copy(order='F'), 0, 0  # compute_v=0, lower=0 (upper)
+        (_, _, info_qr_N), t_qr_N = solver_median(
+            "dsyev", reps, A, 0  # compute_v=0, lower=0 (upper)
         )
         if info_qr_N != 0:
             raise RuntimeError(f"DSYEV(N) failed for n={n}, INFO={info_qr_N}")
         print(f"DSYEV  (N):  {t_qr_N:.3f} s  (median of {reps})")
 
         # V: eigenvalues + eigenvectors
-        (_, _, info_qr_V), t_qr_V = median_time(
-            lapack.dsyev, reps, A.copy(order='F'), 1, 0  # compute_v=1, lower=0
+        (_, _, info_qr_V), t_qr_V = solver_median(
+            "dsyev", reps, A, 1  # compute_v=1, lower=0
         )
         if info_qr_V != 0:
             raise RuntimeError(f"DSYEV(V) failed for n={n}, INFO={info_qr_V}")
@@ -121,16 +150,16 @@ def run_benchmark(sizes, reps, seed):
 
         # ---------- DSYEVD (Divide & Conquer) ----------
         # N: eigenvalues only
-        (_, _, info_dc_N), t_dc_N = median_time(
-            lapack.dsyevd, reps, A.copy(order='F'), 0, 0  # compute_v=0, lower=0
+        (_, _, info_dc_N), t_dc_N = solver_median(
+            "dsyevd", reps, A, 0  # compute_v=0, lower=0
         )
         if info_dc_N != 0:
             raise RuntimeError(f"DSYEVD(N) failed for n={n}, INFO={info_dc_N}")
         print(f"DSYEVD (N):  {t_dc_N:.3f} s  (median of {reps})")
 
         # V: eigenvalues + eigenvectors
-        (_, _, info_dc_V), t_dc_V = median_time(
-            lapack.dsyevd, reps, A.copy(order='F'), 1, 0  # compute_v=1, lower=0
+        (_, _, info_dc_V), t_dc_V = solver_median(
+            "dsyevd", reps, A, 1  # compute_v=1, lower=0
         )
         if info_dc_V != 0:
             raise RuntimeError(f"DSYEVD(V) failed for n={n}, INFO={info_dc_V}")